@@ -12,6 +12,9 @@ qtConfig(alsa): \
 
 QMAKE_USE += gstreamer
 
+qtConfig(gstreamer_allocators): \
+    QMAKE_USE += gstreamer_allocators
+
 qtConfig(resourcepolicy): \
     QMAKE_USE += libresourceqt5
 
@@ -47,6 +47,8 @@ QGstreamerAudioProbeControl::QGstreamerAudioProbeControl(QObject *parent)
 
 QGstreamerAudioProbeControl::~QGstreamerAudioProbeControl()
 {
+    // Release a streaming thread waiting for room in the queue.
+    clearQueue();
 }
 
 void QGstreamerAudioProbeControl::probeCaps(GstCaps *caps)
@@ -78,10 +80,21 @@ bool QGstreamerAudioProbeControl::probeBuffer(GstBuffer *buffer)
 #endif
 
     QMutexLocker locker(&m_bufferMutex);
-    if (m_format.isValid()) {
-        if (!m_pendingBuffer.isValid())
-            QMetaObject::invokeMethod(this, "bufferProbed", Qt::QueuedConnection);
-        m_pendingBuffer = QAudioBuffer(data, m_format, position);
+    if (!m_format.isValid())
+        return true;
+
+    const QAudioBuffer audioBuffer(data, m_format, position);
+    locker.unlock();
+
+    switch (enqueue(audioBuffer)) {
+    case DeliverNow:
+        emit audioBufferProbed(audioBuffer);
+        break;
+    case ScheduleDelivery:
+        QMetaObject::invokeMethod(this, "bufferProbed", Qt::QueuedConnection);
+        break;
+    case Ignore:
+        break;
     }
 
     return true;
@@ -89,13 +102,7 @@ bool QGstreamerAudioProbeControl::probeBuffer(GstBuffer *buffer)
 
 void QGstreamerAudioProbeControl::bufferProbed()
 {
-    QAudioBuffer audioBuffer;
-    {
-        QMutexLocker locker(&m_bufferMutex);
-        if (!m_pendingBuffer.isValid())
-            return;
-        audioBuffer = m_pendingBuffer;
-        m_pendingBuffer = QAudioBuffer();
-    }
-    emit audioBufferProbed(audioBuffer);
+    const QQueue<QAudioBuffer> buffers = takeQueued();
+    for (const QAudioBuffer &buffer : buffers)
+        emit audioBufferProbed(buffer);
 }
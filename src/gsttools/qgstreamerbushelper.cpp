@@ -37,17 +37,25 @@
 **
 ****************************************************************************/
 
-#include <QtCore/qmap.h>
-#include <QtCore/qtimer.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qlist.h>
-#include <QtCore/qabstracteventdispatcher.h>
-#include <QtCore/qcoreapplication.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qmetaobject.h>
+
+#include <private/qmultimediatrace_p.h>
 
 #include "qgstreamerbushelper_p.h"
 
 QT_BEGIN_NAMESPACE
 
+/*
+    Bus messages are taken from the sync handler, on whatever thread posted
+    them, and pushed on a lock-free list. The first message of a batch posts
+    a single queued call, which dispatches everything collected until it runs.
+    Messages that neither a sync filter handled nor anyone subscribed to are
+    dropped right away.
+*/
 
 class QGstreamerBusHelperPrivate : public QObject
 {
@@ -55,105 +63,143 @@ class QGstreamerBusHelperPrivate : public QObject
 public:
     QGstreamerBusHelperPrivate(QGstreamerBusHelper *parent, GstBus* bus) :
         QObject(parent),
-        m_tag(0),
         m_bus(bus),
         m_helper(parent),
-        m_intervalTimer(nullptr)
+        m_pending(nullptr),
+        m_messageTypes(0),
+        signalConnected(false)
     {
-        // glib event loop can be disabled either by env variable or QT_NO_GLIB define, so check the dispacher
-        QAbstractEventDispatcher *dispatcher = QCoreApplication::eventDispatcher();
-        const bool hasGlib = dispatcher && dispatcher->inherits("QEventDispatcherGlib");
-        if (!hasGlib) {
-            m_intervalTimer = new QTimer(this);
-            m_intervalTimer->setInterval(250);
-            connect(m_intervalTimer, SIGNAL(timeout()), SLOT(interval()));
-            m_intervalTimer->start();
-        } else {
-            m_tag = gst_bus_add_watch_full(bus, G_PRIORITY_DEFAULT, busCallback, this, NULL);
-        }
     }
 
     ~QGstreamerBusHelperPrivate()
     {
         m_helper = 0;
-        delete m_intervalTimer;
 
-        if (m_tag)
-#if GST_CHECK_VERSION(1, 6, 0)
-            gst_bus_remove_watch(m_bus);
-#else
-            g_source_remove(m_tag);
-#endif
+        PendingMessage *node = m_pending.fetchAndStoreAcquire(nullptr);
+        while (node) {
+            PendingMessage *next = node->next;
+            gst_message_unref(node->message);
+            delete node;
+            node = next;
+        }
     }
 
     GstBus* bus() const { return m_bus; }
 
-private slots:
-    void interval()
+    bool isSubscribed(GstMessage *message) const
     {
-        GstMessage* message;
-        while ((message = gst_bus_poll(m_bus, GST_MESSAGE_ANY, 0)) != 0) {
-            processMessage(message);
-            gst_message_unref(message);
-        }
+        return m_messageTypes.load() & quint32(GST_MESSAGE_TYPE(message));
     }
 
-private:
-    void processMessage(GstMessage* message)
+    // Takes ownership of the message, can be called from any thread.
+    void queueMessage(GstMessage* message)
     {
-        QGstreamerMessage msg(message);
-        doProcessMessage(msg);
+        PendingMessage *node = new PendingMessage;
+        node->message = message;
+
+        PendingMessage *head = m_pending.loadAcquire();
+        do {
+            node->next = head;
+        } while (!m_pending.testAndSetOrdered(head, node, head));
+
+        if (!head)
+            QMetaObject::invokeMethod(this, "processPendingMessages", Qt::QueuedConnection);
     }
 
-    void queueMessage(GstMessage* message)
+    void updateMessageTypes()
     {
-        QGstreamerMessage msg(message);
-        QMetaObject::invokeMethod(this, "doProcessMessage", Qt::QueuedConnection,
-                                  Q_ARG(QGstreamerMessage, msg));
+        quint32 types = signalConnected ? quint32(GST_MESSAGE_ANY) : 0;
+        for (QHash<QGstreamerBusMessageFilter*, quint32>::const_iterator it = busFilterTypes.constBegin();
+             it != busFilterTypes.constEnd(); ++it) {
+            types |= it.value();
+        }
+        m_messageTypes.store(types);
     }
 
-    static gboolean busCallback(GstBus *bus, GstMessage *message, gpointer data)
+private:
+    struct PendingMessage
     {
-        Q_UNUSED(bus);
-        reinterpret_cast<QGstreamerBusHelperPrivate*>(data)->queueMessage(message);
-        return TRUE;
-    }
+        GstMessage *message;
+        PendingMessage *next;
+    };
 
-    guint m_tag;
     GstBus* m_bus;
     QGstreamerBusHelper*  m_helper;
-    QTimer*     m_intervalTimer;
+    QAtomicPointer<PendingMessage> m_pending;
+    QAtomicInteger<quint32> m_messageTypes;
 
 private slots:
-    void doProcessMessage(const QGstreamerMessage& msg)
+    void processPendingMessages()
     {
-        for (QGstreamerBusMessageFilter *filter : qAsConst(busFilters)) {
-            if (filter->processBusMessage(msg))
-                break;
+        // The list is built newest first, restore the posting order.
+        PendingMessage *node = m_pending.fetchAndStoreAcquire(nullptr);
+        PendingMessage *first = nullptr;
+        int remaining = 0;
+        while (node) {
+            PendingMessage *next = node->next;
+            node->next = first;
+            first = node;
+            node = next;
+            ++remaining;
+        }
+
+        while (first) {
+            PendingMessage *next = first->next;
+            QGstreamerMessage msg(first->message);
+            gst_message_unref(first->message);
+            delete first;
+            first = next;
+
+            Q_MULTIMEDIA_TRACE(QGstreamerBusHelper_dispatch_entry, m_helper,
+                               int(GST_MESSAGE_TYPE(msg.rawMessage())),
+                               GST_CLOCK_TIME_IS_VALID(GST_MESSAGE_TIMESTAMP(msg.rawMessage()))
+                                   ? qint64(GST_TIME_AS_USECONDS(GST_MESSAGE_TIMESTAMP(msg.rawMessage())))
+                                   : qint64(-1),
+                               --remaining);
+
+            const quint32 type = quint32(GST_MESSAGE_TYPE(msg.rawMessage()));
+            for (QGstreamerBusMessageFilter *filter : qAsConst(busFilters)) {
+                if (!(busFilterTypes.value(filter) & type))
+                    continue;
+                if (filter->processBusMessage(msg))
+                    break;
+            }
+            emit m_helper->message(msg);
+
+            Q_MULTIMEDIA_TRACE(QGstreamerBusHelper_dispatch_exit, m_helper,
+                               int(GST_MESSAGE_TYPE(msg.rawMessage())));
         }
-        emit m_helper->message(msg);
     }
 
 public:
     QMutex filterMutex;
     QList<QGstreamerSyncMessageFilter*> syncFilters;
     QList<QGstreamerBusMessageFilter*> busFilters;
+    QHash<QGstreamerBusMessageFilter*, quint32> busFilterTypes;
+    bool signalConnected;
 };
 
 
 static GstBusSyncReply syncGstBusFilter(GstBus* bus, GstMessage* message, QGstreamerBusHelperPrivate *d)
 {
     Q_UNUSED(bus);
-    QMutexLocker lock(&d->filterMutex);
+    {
+        QMutexLocker lock(&d->filterMutex);
 
-    for (QGstreamerSyncMessageFilter *filter : qAsConst(d->syncFilters)) {
-        if (filter->processSyncMessage(QGstreamerMessage(message))) {
-            gst_message_unref(message);
-            return GST_BUS_DROP;
+        for (QGstreamerSyncMessageFilter *filter : qAsConst(d->syncFilters)) {
+            if (filter->processSyncMessage(QGstreamerMessage(message))) {
+                gst_message_unref(message);
+                return GST_BUS_DROP;
+            }
         }
     }
 
-    return GST_BUS_PASS;
+    if (d->isSubscribed(message))
+        d->queueMessage(message);
+    else
+        gst_message_unref(message);
+
+    return GST_BUS_DROP;
 }
 
 
@@ -184,7 +230,12 @@ QGstreamerBusHelper::~QGstreamerBusHelper()
     gst_object_unref(GST_OBJECT(d->bus()));
 }
 
-void QGstreamerBusHelper::installMessageFilter(QObject *filter)
+/*
+    Bus filters only receive the message types they were installed for.
+    Messages nobody asked for, through a filter or a connection to
+    message(), are dropped on the streaming thread.
+*/
+void QGstreamerBusHelper::installMessageFilter(QObject *filter, GstMessageType types)
 {
     QGstreamerSyncMessageFilter *syncFilter = qobject_cast<QGstreamerSyncMessageFilter*>(filter);
     if (syncFilter) {
@@ -194,8 +245,12 @@ void QGstreamerBusHelper::installMessageFilter(QObject *filter)
     }
 
     QGstreamerBusMessageFilter *busFilter = qobject_cast<QGstreamerBusMessageFilter*>(filter);
-    if (busFilter && !d->busFilters.contains(busFilter))
-        d->busFilters.append(busFilter);
+    if (busFilter) {
+        if (!d->busFilters.contains(busFilter))
+            d->busFilters.append(busFilter);
+        d->busFilterTypes[busFilter] |= quint32(types);
+        d->updateMessageTypes();
+    }
 }
 
 void QGstreamerBusHelper::removeMessageFilter(QObject *filter)
@@ -207,8 +262,27 @@ void QGstreamerBusHelper::removeMessageFilter(QObject *filter)
     }
 
     QGstreamerBusMessageFilter *busFilter = qobject_cast<QGstreamerBusMessageFilter*>(filter);
-    if (busFilter)
+    if (busFilter) {
         d->busFilters.removeAll(busFilter);
+        d->busFilterTypes.remove(busFilter);
+        d->updateMessageTypes();
+    }
+}
+
+void QGstreamerBusHelper::connectNotify(const QMetaMethod &signal)
+{
+    if (signal == QMetaMethod::fromSignal(&QGstreamerBusHelper::message)) {
+        d->signalConnected = true;
+        d->updateMessageTypes();
+    }
+}
+
+void QGstreamerBusHelper::disconnectNotify(const QMetaMethod &signal)
+{
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&QGstreamerBusHelper::message)) {
+        d->signalConnected = isSignalConnected(QMetaMethod::fromSignal(&QGstreamerBusHelper::message));
+        d->updateMessageTypes();
+    }
 }
 
 QT_END_NAMESPACE
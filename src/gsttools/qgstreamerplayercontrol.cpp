@@ -67,10 +67,28 @@ QGstreamerPlayerControl::QGstreamerPlayerControl(QGstreamerPlayerSession *sessio
     , m_pendingSeekPosition(-1)
     , m_setMediaPending(false)
     , m_stream(0)
+    , m_preparedSession(0)
 {
     m_resources = QMediaResourcePolicy::createResourceSet<QMediaPlayerResourceSetInterface>();
     Q_ASSERT(m_resources);
 
+    connectSession();
+
+    connect(m_resources, SIGNAL(resourcesGranted()), SLOT(handleResourcesGranted()));
+    //denied signal should be queued to have correct state update process,
+    //since in playOrPause, when acquire is call on resource set, it may trigger a resourcesDenied signal immediately,
+    //so handleResourcesDenied should be processed later, otherwise it will be overwritten by state update later in playOrPause.
+    connect(m_resources, SIGNAL(resourcesDenied()), this, SLOT(handleResourcesDenied()), Qt::QueuedConnection);
+    connect(m_resources, SIGNAL(resourcesLost()), SLOT(handleResourcesLost()));
+}
+
+QGstreamerPlayerControl::~QGstreamerPlayerControl()
+{
+    QMediaResourcePolicy::destroyResourceSet(m_resources);
+}
+
+void QGstreamerPlayerControl::connectSession()
+{
     connect(m_session, SIGNAL(positionChanged(qint64)),
             this, SIGNAL(positionChanged(qint64)));
     connect(m_session, SIGNAL(durationChanged(qint64)),
@@ -97,18 +115,6 @@ QGstreamerPlayerControl::QGstreamerPlayerControl(QGstreamerPlayerSession *sessio
             this, SLOT(handleInvalidMedia()));
     connect(m_session, SIGNAL(playbackRateChanged(qreal)),
             this, SIGNAL(playbackRateChanged(qreal)));
-
-    connect(m_resources, SIGNAL(resourcesGranted()), SLOT(handleResourcesGranted()));
-    //denied signal should be queued to have correct state update process,
-    //since in playOrPause, when acquire is call on resource set, it may trigger a resourcesDenied signal immediately,
-    //so handleResourcesDenied should be processed later, otherwise it will be overwritten by state update later in playOrPause.
-    connect(m_resources, SIGNAL(resourcesDenied()), this, SLOT(handleResourcesDenied()), Qt::QueuedConnection);
-    connect(m_resources, SIGNAL(resourcesLost()), SLOT(handleResourcesLost()));
-}
-
-QGstreamerPlayerControl::~QGstreamerPlayerControl()
-{
-    QMediaResourcePolicy::destroyResourceSet(m_resources);
 }
 
 QMediaPlayerResourceSetInterface* QGstreamerPlayerControl::resources() const
@@ -348,12 +354,97 @@ const QIODevice *QGstreamerPlayerControl::mediaStream() const
     return m_stream;
 }
 
+void QGstreamerPlayerControl::advanceToNextMedia(const QMediaContent &content)
+{
+    // The session switched to the queued uri on its own, without leaving
+    // the current state. Only the bookkeeping needs to follow.
+    m_currentResource = content;
+    m_stream = 0;
+    m_pendingSeekPosition = -1;
+
+    emit mediaChanged(m_currentResource);
+    emit positionChanged(position());
+}
+
+void QGstreamerPlayerControl::setPreparedSession(QGstreamerPlayerSession *session, const QMediaContent &content)
+{
+    m_preparedSession = session;
+    m_preparedResource = session ? content : QMediaContent();
+}
+
+void QGstreamerPlayerControl::switchToPreparedSession()
+{
+#ifdef DEBUG_PLAYBIN
+    qDebug() << Q_FUNC_INFO << m_preparedResource.canonicalUrl();
+#endif
+
+    pushState();
+
+    QGstreamerPlayerSession *previous = m_session;
+    QMediaContent oldMedia = m_currentResource;
+
+    if (!m_resources->isGranted())
+        m_resources->acquire();
+
+    // The video sink can only belong to one pipeline, release it from the
+    // current one before the prepared pipeline takes it over.
+    QObject *videoOutput = previous->videoOutput();
+    disconnect(previous, 0, this, 0);
+    previous->stop();
+    previous->setVideoRenderer(0);
+
+    m_session = m_preparedSession;
+    m_session->setVolume(previous->volume());
+    m_session->setMuted(previous->isMuted());
+    m_session->setPlaybackRate(previous->playbackRate());
+    m_session->showPrerollFrames(false); // do not show prerolled frames until pause() or play() explicitly called
+    m_session->setVideoRenderer(videoOutput);
+    connectSession();
+
+    m_currentResource = m_preparedResource;
+    m_stream = 0;
+    m_preparedSession = 0;
+    m_preparedResource = QMediaContent();
+
+    m_currentState = QMediaPlayer::StoppedState;
+    m_pendingSeekPosition = -1;
+    m_setMediaPending = false;
+
+    if (m_bufferProgress != -1) {
+        m_bufferProgress = -1;
+        emit bufferStatusChanged(0);
+    }
+
+    // The prepared pipeline is usually prerolled already, in which case
+    // the media is loaded right away.
+    m_mediaStatus = QMediaPlayer::LoadingMedia;
+    updateMediaStatus();
+
+    emit sessionChanged(m_session, previous);
+
+    if (m_currentResource != oldMedia)
+        emit mediaChanged(m_currentResource);
+
+    emit durationChanged(m_session->duration());
+    emit seekableChanged(m_session->isSeekable());
+    emit audioAvailableChanged(m_session->isAudioAvailable());
+    emit videoAvailableChanged(m_session->isVideoAvailable());
+    emit positionChanged(position());
+
+    popAndNotifyState();
+}
+
 void QGstreamerPlayerControl::setMedia(const QMediaContent &content, QIODevice *stream)
 {
 #ifdef DEBUG_PLAYBIN
     qDebug() << Q_FUNC_INFO;
 #endif
 
+    if (m_preparedSession && !stream && !content.isNull() && content == m_preparedResource) {
+        switchToPreparedSession();
+        return;
+    }
+
     pushState();
 
     m_currentState = QMediaPlayer::StoppedState;
@@ -67,6 +67,26 @@
 
 QT_BEGIN_NAMESPACE
 
+// The bus messages processBusMessage() acts on, the others are dropped by the bus helper.
+#ifdef DEBUG_PLAYBIN
+static const GstMessageType playerMessageTypes = GST_MESSAGE_ANY;
+#else
+static const GstMessageType playerMessageTypes = GstMessageType(
+        GST_MESSAGE_EOS | GST_MESSAGE_ERROR | GST_MESSAGE_WARNING | GST_MESSAGE_INFO
+        | GST_MESSAGE_TAG | GST_MESSAGE_BUFFERING | GST_MESSAGE_STATE_CHANGED
+        | GST_MESSAGE_ELEMENT | GST_MESSAGE_SEGMENT_START | GST_MESSAGE_DURATION
+#if GST_CHECK_VERSION(0,10,13)
+        | GST_MESSAGE_ASYNC_DONE
+#endif
+#if GST_CHECK_VERSION(1,0,0)
+        | GST_MESSAGE_STREAM_START
+#endif
+        );
+#endif
+
+// The video outputs only watch their sink changing state.
+static const GstMessageType videoOutputMessageTypes = GST_MESSAGE_STATE_CHANGED;
+
 static bool usePlaybinVolume()
 {
     static enum { Yes, No, Unknown } status = Unknown;
@@ -133,6 +153,7 @@ QGstreamerPlayerSession::QGstreamerPlayerSession(QObject *parent)
      m_audioProbe(0),
      m_volume(100),
      m_playbackRate(1.0),
+     m_seekFlags(QMediaSeekControl::NoSeekFlags),
      m_muted(false),
      m_audioAvailable(false),
      m_videoAvailable(false),
@@ -220,7 +241,7 @@ QGstreamerPlayerSession::QGstreamerPlayerSession(QObject *parent)
         // Sort out messages
         m_bus = gst_element_get_bus(m_playbin);
         m_busHelper = new QGstreamerBusHelper(m_bus, this);
-        m_busHelper->installMessageFilter(this);
+        m_busHelper->installMessageFilter(this, playerMessageTypes);
 
         g_object_set(G_OBJECT(m_playbin), "video-sink", m_videoOutputBin, NULL);
 
@@ -237,6 +258,7 @@ QGstreamerPlayerSession::QGstreamerPlayerSession(QObject *parent)
         g_signal_connect(G_OBJECT(m_playbin), "video-changed", G_CALLBACK(handleStreamsChange), this);
         g_signal_connect(G_OBJECT(m_playbin), "audio-changed", G_CALLBACK(handleStreamsChange), this);
         g_signal_connect(G_OBJECT(m_playbin), "text-changed", G_CALLBACK(handleStreamsChange), this);
+        g_signal_connect(G_OBJECT(m_playbin), "about-to-finish", G_CALLBACK(handleAboutToFinish), this);
 
 #if QT_CONFIG(gstreamer_app)
         g_signal_connect(G_OBJECT(m_playbin), "deep-notify::source", G_CALLBACK(configureAppSrcElement), this);
@@ -301,6 +323,14 @@ void QGstreamerPlayerSession::loadFromStream(const QNetworkRequest &request, QIO
     m_request = request;
     m_duration = 0;
     m_lastPosition = 0;
+    // Dropped frame counts are per media.
+    resetProbeCounters();
+
+    {
+        // Loading new media cancels a pending gapless transition.
+        QMutexLocker locker(&m_nextUriMutex);
+        m_queuedUri.clear();
+    }
 
     if (!m_appSrc)
         m_appSrc = new QGstAppSrc(this);
@@ -330,6 +360,14 @@ void QGstreamerPlayerSession::loadFromUri(const QNetworkRequest &request)
     m_request = request;
     m_duration = 0;
     m_lastPosition = 0;
+    // Dropped frame counts are per media.
+    resetProbeCounters();
+
+    {
+        // Loading new media cancels a pending gapless transition.
+        QMutexLocker locker(&m_nextUriMutex);
+        m_queuedUri.clear();
+    }
 
 #if QT_CONFIG(gstreamer_app)
     if (m_appSrc) {
@@ -353,6 +391,65 @@ void QGstreamerPlayerSession::loadFromUri(const QNetworkRequest &request)
     }
 }
 
+QUrl QGstreamerPlayerSession::nextUri() const
+{
+    QMutexLocker locker(&m_nextUriMutex);
+    return m_nextUri;
+}
+
+void QGstreamerPlayerSession::setNextUri(const QUrl &uri)
+{
+    QMutexLocker locker(&m_nextUriMutex);
+    m_nextUri = uri;
+}
+
+void QGstreamerPlayerSession::handleAboutToFinish(GstElement *playbin, gpointer user_data)
+{
+    // Called on a streaming thread once playbin has read all the data of the
+    // current uri. Setting the next uri from here makes playbin preroll it while
+    // the current one drains, and switch over without leaving the PLAYING state.
+    QGstreamerPlayerSession *session = reinterpret_cast<QGstreamerPlayerSession *>(user_data);
+
+    QMutexLocker locker(&session->m_nextUriMutex);
+    if (session->m_nextUri.isEmpty())
+        return;
+
+    g_object_set(G_OBJECT(playbin), "uri", session->m_nextUri.toEncoded().constData(), NULL);
+    session->m_queuedUri = session->m_nextUri;
+    session->m_nextUri.clear();
+
+#if !GST_CHECK_VERSION(1,0,0)
+    // playbin2 posts no stream-start message, consider the switch done.
+    QMetaObject::invokeMethod(session, "finishGaplessTransition", Qt::QueuedConnection);
+#endif
+}
+
+void QGstreamerPlayerSession::finishGaplessTransition()
+{
+    QUrl uri;
+    {
+        QMutexLocker locker(&m_nextUriMutex);
+        uri.swap(m_queuedUri);
+    }
+
+    if (uri.isEmpty())
+        return;
+
+    m_request = QNetworkRequest(uri);
+    m_lastPosition = 0;
+
+    m_tags.clear();
+    emit tagsChanged();
+
+    getStreamsInfo();
+    updateVideoResolutionTag();
+
+    m_durationQueries = 5;
+    updateDuration();
+
+    emit advancedToNextUri(uri);
+}
+
 bool QGstreamerPlayerSession::parsePipeline()
 {
     if (m_request.url().scheme() != QLatin1String("gst-pipeline"))
@@ -409,12 +506,13 @@ bool QGstreamerPlayerSession::setPipeline(GstElement *pipeline)
     m_bus = bus;
     m_busHelper->deleteLater();
     m_busHelper = new QGstreamerBusHelper(m_bus, this);
-    m_busHelper->installMessageFilter(this);
+    m_busHelper->installMessageFilter(this, playerMessageTypes);
 
     if (m_videoOutput)
-        m_busHelper->installMessageFilter(m_videoOutput);
+        m_busHelper->installMessageFilter(m_videoOutput, videoOutputMessageTypes);
 
     if (m_playbin) {
+        flushProbes();
         gst_element_set_state(m_playbin, GST_STATE_NULL);
         gst_object_unref(GST_OBJECT(m_playbin));
     }
@@ -646,7 +744,7 @@ void QGstreamerPlayerSession::setVideoRenderer(QObject *videoOutput)
             connect(m_videoOutput, SIGNAL(readyChanged(bool)),
                    this, SLOT(updateVideoRenderer()));
 
-            m_busHelper->installMessageFilter(m_videoOutput);
+            m_busHelper->installMessageFilter(m_videoOutput, videoOutputMessageTypes);
         }
     }
 
@@ -690,7 +788,7 @@ void QGstreamerPlayerSession::setVideoRenderer(QObject *videoOutput)
         qDebug() << "The pipeline has not started yet, pending state:" << m_pendingState;
 #endif
         //the pipeline has not started yet
-        flushVideoProbes();
+        flushProbes();
         m_pendingVideoSink = 0;
         gst_element_set_state(m_videoSink, GST_STATE_NULL);
         gst_element_set_state(m_playbin, GST_STATE_NULL);
@@ -746,7 +844,7 @@ void QGstreamerPlayerSession::setVideoRenderer(QObject *videoOutput)
             break;
         }
 
-        resumeVideoProbes();
+        resumeProbes();
 
     } else {
         if (m_pendingVideoSink) {
@@ -900,14 +998,14 @@ void QGstreamerPlayerSession::finishVideoOutputChange()
     gst_element_set_state(m_videoSink, state);
 
     if (state == GST_STATE_NULL)
-        flushVideoProbes();
+        flushProbes();
 
     // Set state change that was deferred due the video output
     // change being pending
     gst_element_set_state(m_playbin, state);
 
     if (state != GST_STATE_NULL)
-        resumeVideoProbes();
+        resumeProbes();
 
     //don't have to wait here, it will unblock eventually
     if (gst_pad_is_blocked(srcPad))
@@ -998,7 +1096,7 @@ bool QGstreamerPlayerSession::play()
             m_pendingState = m_state = QMediaPlayer::StoppedState;
             emit stateChanged(m_state);
         } else {
-            resumeVideoProbes();
+            resumeProbes();
             return true;
         }
     }
@@ -1021,7 +1119,7 @@ bool QGstreamerPlayerSession::pause()
             m_pendingState = m_state = QMediaPlayer::StoppedState;
             emit stateChanged(m_state);
         } else {
-            resumeVideoProbes();
+            resumeProbes();
             return true;
         }
     }
@@ -1040,7 +1138,7 @@ void QGstreamerPlayerSession::stop()
         if (m_renderer)
             m_renderer->stopRenderer();
 
-        flushVideoProbes();
+        flushProbes();
         gst_element_set_state(m_pipeline, GST_STATE_NULL);
 
         m_lastPosition = 0;
@@ -1068,7 +1166,7 @@ bool QGstreamerPlayerSession::seek(qint64 ms)
         bool isSeeking = gst_element_seek(m_pipeline,
                                           m_playbackRate,
                                           GST_FORMAT_TIME,
-                                          GstSeekFlags(GST_SEEK_FLAG_FLUSH),
+                                          GstSeekFlags(GST_SEEK_FLAG_FLUSH | QGstUtils::seekFlags(m_seekFlags)),
                                           GST_SEEK_TYPE_SET,
                                           position,
                                           GST_SEEK_TYPE_NONE,
@@ -1252,6 +1350,13 @@ bool QGstreamerPlayerSession::processBusMessage(const QGstreamerMessage &message
                 emit playbackFinished();
                 break;
 
+#if GST_CHECK_VERSION(1,0,0)
+            case GST_MESSAGE_STREAM_START:
+                // Posted once all sinks started on the uri queued in about-to-finish.
+                finishGaplessTransition();
+                break;
+#endif
+
             case GST_MESSAGE_TAG:
             case GST_MESSAGE_STREAM_STATUS:
             case GST_MESSAGE_UNKNOWN:
@@ -1892,6 +1997,8 @@ void QGstreamerPlayerSession::removeProbe(QGstreamerVideoProbeControl* probe)
 {
     Q_ASSERT(m_videoProbe == probe);
     removeVideoBufferProbe();
+    // Release a streaming thread still waiting for room in the queue.
+    probe->clearQueue();
     m_videoProbe = 0;
 }
 
@@ -1906,6 +2013,7 @@ void QGstreamerPlayerSession::removeProbe(QGstreamerAudioProbeControl* probe)
 {
     Q_ASSERT(m_audioProbe == probe);
     removeAudioBufferProbe();
+    probe->clearQueue();
     m_audioProbe = 0;
 }
 
@@ -1917,7 +2025,7 @@ void QGstreamerPlayerSession::endOfMediaReset()
     if (m_renderer)
         m_renderer->stopRenderer();
 
-    flushVideoProbes();
+    flushProbes();
     gst_element_set_state(m_pipeline, GST_STATE_PAUSED);
 
     QMediaPlayer::State oldState = m_state;
@@ -1929,6 +2037,14 @@ void QGstreamerPlayerSession::endOfMediaReset()
         emit stateChanged(m_state);
 }
 
+void QGstreamerPlayerSession::warmUp()
+{
+    // Bringing an idle playbin to READY opens the sinks ahead of time,
+    // which is a good part of the cost of starting playback. No uri is needed for that.
+    if (m_playbin && m_pipeline == m_playbin && m_state == QMediaPlayer::StoppedState)
+        gst_element_set_state(m_playbin, GST_STATE_READY);
+}
+
 void QGstreamerPlayerSession::removeVideoBufferProbe()
 {
     if (!m_videoProbe)
@@ -1977,16 +2093,30 @@ void QGstreamerPlayerSession::addAudioBufferProbe()
     }
 }
 
-void QGstreamerPlayerSession::flushVideoProbes()
+void QGstreamerPlayerSession::flushProbes()
 {
+    // Must happen before going to READY or NULL, the state change waits
+    // for a streaming thread that may be blocked in a full probe queue.
     if (m_videoProbe)
         m_videoProbe->startFlushing();
+    if (m_audioProbe)
+        m_audioProbe->setFlushing(true);
+}
+
+void QGstreamerPlayerSession::resetProbeCounters()
+{
+    if (m_videoProbe)
+        m_videoProbe->resetDroppedCount();
+    if (m_audioProbe)
+        m_audioProbe->resetDroppedCount();
 }
 
-void QGstreamerPlayerSession::resumeVideoProbes()
+void QGstreamerPlayerSession::resumeProbes()
 {
     if (m_videoProbe)
         m_videoProbe->stopFlushing();
+    if (m_audioProbe)
+        m_audioProbe->setFlushing(false);
 }
 
 QT_END_NAMESPACE
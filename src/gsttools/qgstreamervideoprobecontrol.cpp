@@ -44,23 +44,19 @@
 
 QGstreamerVideoProbeControl::QGstreamerVideoProbeControl(QObject *parent)
     : QMediaVideoProbeControl(parent)
-    , m_flushing(false)
     , m_frameProbed(false)
 {
 }
 
 QGstreamerVideoProbeControl::~QGstreamerVideoProbeControl()
 {
+    // Release a streaming thread waiting for room in the queue.
+    clearQueue();
 }
 
 void QGstreamerVideoProbeControl::startFlushing()
 {
-    m_flushing = true;
-
-    {
-        QMutexLocker locker(&m_frameMutex);
-        m_pendingFrame = QVideoFrame();
-    }
+    setFlushing(true);
 
     // only emit flush if at least one frame was probed
     if (m_frameProbed)
@@ -69,7 +65,7 @@ void QGstreamerVideoProbeControl::startFlushing()
 
 void QGstreamerVideoProbeControl::stopFlushing()
 {
-    m_flushing = false;
+    setFlushing(false);
 }
 
 void QGstreamerVideoProbeControl::probeCaps(GstCaps *caps)
@@ -94,7 +90,7 @@ bool QGstreamerVideoProbeControl::probeBuffer(GstBuffer *buffer)
 {
     QMutexLocker locker(&m_frameMutex);
 
-    if (m_flushing || !m_format.isValid())
+    if (isFlushing() || !m_format.isValid())
         return true;
 
     QVideoFrame frame(
@@ -109,23 +105,27 @@ bool QGstreamerVideoProbeControl::probeBuffer(GstBuffer *buffer)
     QGstUtils::setFrameTimeStamps(&frame, buffer);
 
     m_frameProbed = true;
-
-    if (!m_pendingFrame.isValid())
+    locker.unlock();
+
+    // Don't hold the frame mutex here, enqueue() may block until the
+    // receivers caught up and direct receivers may take their time.
+    switch (enqueue(frame)) {
+    case DeliverNow:
+        emit videoFrameProbed(frame);
+        break;
+    case ScheduleDelivery:
         QMetaObject::invokeMethod(this, "frameProbed", Qt::QueuedConnection);
-    m_pendingFrame = frame;
+        break;
+    case Ignore:
+        break;
+    }
 
     return true;
 }
 
 void QGstreamerVideoProbeControl::frameProbed()
 {
-    QVideoFrame frame;
-    {
-        QMutexLocker locker(&m_frameMutex);
-        if (!m_pendingFrame.isValid())
-            return;
-        frame = m_pendingFrame;
-        m_pendingFrame = QVideoFrame();
-    }
-    emit videoFrameProbed(frame);
+    const QQueue<QVideoFrame> frames = takeQueued();
+    for (const QVideoFrame &frame : frames)
+        emit videoFrameProbed(frame);
 }
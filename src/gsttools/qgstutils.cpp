@@ -979,6 +979,12 @@ static const VideoFormat qt_videoFormatLookup[] =
     { QVideoFrame::Format_NV12   , GST_VIDEO_FORMAT_NV12 },
     { QVideoFrame::Format_NV21   , GST_VIDEO_FORMAT_NV21 },
     { QVideoFrame::Format_AYUV444, GST_VIDEO_FORMAT_AYUV },
+    { QVideoFrame::Format_YUV444 , GST_VIDEO_FORMAT_v308 },
+    { QVideoFrame::Format_Y8     , GST_VIDEO_FORMAT_GRAY8 },
+    { QVideoFrame::Format_Y16    , GST_VIDEO_FORMAT_GRAY16_LE },
+#if GST_CHECK_VERSION(1,10,0)
+    { QVideoFrame::Format_P010   , GST_VIDEO_FORMAT_P010_10LE },
+#endif
 #if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
     { QVideoFrame::Format_RGB32 ,  GST_VIDEO_FORMAT_BGRx },
     { QVideoFrame::Format_BGR32 ,  GST_VIDEO_FORMAT_RGBx },
@@ -1474,6 +1480,24 @@ QString QGstUtils::fileExtensionForMimeType(const QString &mimeType)
     return extension;
 }
 
+GstSeekFlags QGstUtils::seekFlags(QMediaSeekControl::SeekFlags flags)
+{
+    int gstFlags = GST_SEEK_FLAG_NONE;
+
+    if (flags & QMediaSeekControl::KeyUnit)
+        gstFlags |= GST_SEEK_FLAG_KEY_UNIT;
+    if (flags & QMediaSeekControl::Accurate)
+        gstFlags |= GST_SEEK_FLAG_ACCURATE;
+#if GST_CHECK_VERSION(1,0,0)
+    if (flags & QMediaSeekControl::SnapBefore)
+        gstFlags |= GST_SEEK_FLAG_SNAP_BEFORE;
+    if (flags & QMediaSeekControl::SnapAfter)
+        gstFlags |= GST_SEEK_FLAG_SNAP_AFTER;
+#endif
+
+    return GstSeekFlags(gstFlags);
+}
+
 void qt_gst_object_ref_sink(gpointer object)
 {
 #if GST_CHECK_VERSION(0,10,24)
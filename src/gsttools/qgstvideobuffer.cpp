@@ -39,6 +39,12 @@
 
 #include "qgstvideobuffer_p.h"
 
+#include <QtMultimedia/private/qtmultimediaglobal_p.h>
+
+#if QT_CONFIG(gstreamer_allocators)
+#include <gst/allocators/gstdmabuf.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 #if GST_CHECK_VERSION(1,0,0)
@@ -91,6 +97,55 @@ QAbstractVideoBuffer::MapMode QGstVideoBuffer::mapMode() const
 
 #if GST_CHECK_VERSION(1,0,0)
 
+/*!
+    Returns a QAbstractVideoBuffer::DmaBufHandle describing the planes of \a buffer, or a null
+    variant if the memory of any plane is not a dma-buf.
+
+    The plane layout is taken from the video meta of the buffer if present, otherwise from
+    \a info.
+*/
+QVariant QGstVideoBuffer::dmaBufHandle(GstBuffer *buffer, const GstVideoInfo &info)
+{
+#if QT_CONFIG(gstreamer_allocators)
+    const GstVideoMeta *meta = gst_buffer_get_video_meta(buffer);
+    const guint planeCount = meta ? meta->n_planes : GST_VIDEO_INFO_N_PLANES(&info);
+    if (planeCount == 0)
+        return QVariant();
+
+    QVariantList fds;
+    QVariantList offsets;
+    QVariantList strides;
+
+    for (guint i = 0; i < planeCount; ++i) {
+        const gsize planeOffset = meta ? meta->offset[i] : GST_VIDEO_INFO_PLANE_OFFSET(&info, i);
+
+        guint index = 0;
+        guint length = 0;
+        gsize skip = 0;
+        if (!gst_buffer_find_memory(buffer, planeOffset, 1, &index, &length, &skip))
+            return QVariant();
+
+        GstMemory *memory = gst_buffer_peek_memory(buffer, index);
+        if (!gst_is_dmabuf_memory(memory))
+            return QVariant();
+
+        fds.append(gst_dmabuf_memory_get_fd(memory));
+        offsets.append(qint64(memory->offset + skip));
+        strides.append(meta ? meta->stride[i] : GST_VIDEO_INFO_PLANE_STRIDE(&info, i));
+    }
+
+    QVariantMap handle;
+    handle.insert(QStringLiteral("fds"), fds);
+    handle.insert(QStringLiteral("offsets"), offsets);
+    handle.insert(QStringLiteral("strides"), strides);
+    return handle;
+#else
+    Q_UNUSED(buffer);
+    Q_UNUSED(info);
+    return QVariant();
+#endif
+}
+
 int QGstVideoBuffer::map(MapMode mode, int *numBytes, int bytesPerLine[4], uchar *data[4])
 {
     const GstMapFlags flags = GstMapFlags(((mode & ReadOnly) ? GST_MAP_READ : 0)
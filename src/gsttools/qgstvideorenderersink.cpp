@@ -46,6 +46,7 @@
 #include <QCoreApplication>
 
 #include <private/qmediapluginloader_p.h>
+#include <private/qmultimediatrace_p.h>
 #include "qgstvideobuffer_p.h"
 
 #include "qgstvideorenderersink_p.h"
@@ -60,6 +61,7 @@ QT_BEGIN_NAMESPACE
 
 QGstDefaultVideoRenderer::QGstDefaultVideoRenderer()
     : m_flushed(true)
+    , m_exportDmaBuf(false)
 {
 }
 
@@ -77,6 +79,14 @@ bool QGstDefaultVideoRenderer::start(QAbstractVideoSurface *surface, GstCaps *ca
     m_flushed = true;
     m_format = QGstUtils::formatForCaps(caps, &m_videoInfo);
 
+    // Surfaces which can import dma-bufs get the file descriptors of the frames along with
+    // the mappable memory, so they don't have to be copied.
+    m_exportDmaBuf = m_format.isValid()
+            && surface->supportedPixelFormats(QAbstractVideoBuffer::DmaBufHandle)
+                   .contains(m_format.pixelFormat());
+    if (m_exportDmaBuf)
+        m_format = QGstUtils::formatForCaps(caps, &m_videoInfo, QAbstractVideoBuffer::DmaBufHandle);
+
     return m_format.isValid() && surface->start(m_format);
 }
 
@@ -91,11 +101,17 @@ bool QGstDefaultVideoRenderer::present(QAbstractVideoSurface *surface, GstBuffer
 {
     m_flushed = false;
     QVideoFrame frame(
-                new QGstVideoBuffer(buffer, m_videoInfo),
+                m_exportDmaBuf
+                    ? new QGstVideoBuffer(buffer, m_videoInfo, QAbstractVideoBuffer::DmaBufHandle,
+                                          QGstVideoBuffer::dmaBufHandle(buffer, m_videoInfo))
+                    : new QGstVideoBuffer(buffer, m_videoInfo),
                 m_format.frameSize(),
                 m_format.pixelFormat());
     QGstUtils::setFrameTimeStamps(&frame, buffer);
 
+    Q_MULTIMEDIA_TRACE(QAbstractVideoSurface_present, surface, frame.startTime(),
+                       frame.pixelFormat(), frame.width(), frame.height());
+
     return surface->present(frame);
 }
 
@@ -242,6 +258,11 @@ void QVideoSurfaceGstDelegate::flush()
 
 GstFlowReturn QVideoSurfaceGstDelegate::render(GstBuffer *buffer)
 {
+    Q_MULTIMEDIA_TRACE(QVideoSurfaceGstDelegate_render_entry, this,
+                       GST_BUFFER_TIMESTAMP_IS_VALID(buffer)
+                           ? qint64(GST_TIME_AS_USECONDS(GST_BUFFER_TIMESTAMP(buffer)))
+                           : qint64(-1));
+
     QMutexLocker locker(&m_mutex);
 
     m_renderReturn = GST_FLOW_OK;
@@ -251,6 +272,8 @@ GstFlowReturn QVideoSurfaceGstDelegate::render(GstBuffer *buffer)
 
     m_renderBuffer = 0;
 
+    Q_MULTIMEDIA_TRACE(QVideoSurfaceGstDelegate_render_exit, this, int(m_renderReturn));
+
     return m_renderReturn;
 }
 
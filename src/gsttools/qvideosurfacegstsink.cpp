@@ -45,6 +45,7 @@
 #include <QThread>
 
 #include <private/qmediapluginloader_p.h>
+#include <private/qmultimediatrace_p.h>
 #include "qgstvideobuffer_p.h"
 
 #include "qgstutils_p.h"
@@ -208,6 +209,11 @@ void QVideoSurfaceGstDelegate::flush()
 
 GstFlowReturn QVideoSurfaceGstDelegate::render(GstBuffer *buffer)
 {
+    Q_MULTIMEDIA_TRACE(QVideoSurfaceGstDelegate_render_entry, this,
+                       GST_BUFFER_TIMESTAMP_IS_VALID(buffer)
+                           ? qint64(GST_TIME_AS_USECONDS(GST_BUFFER_TIMESTAMP(buffer)))
+                           : qint64(-1));
+
     if (!m_surface) {
         qWarning() << "Rendering video frame to deleted surface, skip.";
         //return GST_FLOW_NOT_NEGOTIATED;
@@ -234,6 +240,8 @@ GstFlowReturn QVideoSurfaceGstDelegate::render(GstBuffer *buffer)
     m_renderReturn = GST_FLOW_OK;
 
     if (QThread::currentThread() == thread()) {
+        Q_MULTIMEDIA_TRACE(QAbstractVideoSurface_present, m_surface.data(), m_frame.startTime(),
+                           m_frame.pixelFormat(), m_frame.width(), m_frame.height());
         if (!m_surface.isNull())
             m_surface->present(m_frame);
         else
@@ -244,6 +252,9 @@ GstFlowReturn QVideoSurfaceGstDelegate::render(GstBuffer *buffer)
     }
 
     m_frame = QVideoFrame();
+
+    Q_MULTIMEDIA_TRACE(QVideoSurfaceGstDelegate_render_exit, this, int(m_renderReturn));
+
     return m_renderReturn;
 }
 
@@ -281,6 +292,9 @@ void QVideoSurfaceGstDelegate::queuedRender()
     if (!m_frame.isValid())
         return;
 
+    Q_MULTIMEDIA_TRACE(QAbstractVideoSurface_present, m_surface.data(), m_frame.startTime(),
+                       m_frame.pixelFormat(), m_frame.width(), m_frame.height());
+
     if (m_surface.isNull()) {
         qWarning() << "Rendering video frame to deleted surface, skip the frame";
         m_renderReturn = GST_FLOW_OK;
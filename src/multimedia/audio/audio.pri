@@ -12,7 +12,9 @@ PUBLIC_HEADERS += \
            audio/qsoundeffect.h \
            audio/qsound.h \
            audio/qaudioprobe.h \
-           audio/qaudiodecoder.h
+           audio/qaudiodecoder.h \
+           audio/qaudioanalyzer.h \
+           audio/qaudiostatistics.h
 
 PRIVATE_HEADERS += \
            audio/qaudiobuffer_p.h \
@@ -20,6 +22,11 @@ PRIVATE_HEADERS += \
            audio/qwavedecoder_p.h \
            audio/qsamplecache_p.h \
            audio/qaudiohelpers_p.h \
+           audio/qaudioformatconverter_p.h \
+           audio/qaudioconvertingdevice_p.h \
+           audio/qaudioringbuffer_p.h \
+           audio/qaudioanalyzer_p.h \
+           audio/qaudiostatistics_p.h \
            audio/qaudiosystempluginext_p.h
 
 SOURCES += \
@@ -38,7 +45,17 @@ SOURCES += \
            audio/qaudiobuffer.cpp \
            audio/qaudioprobe.cpp \
            audio/qaudiodecoder.cpp \
-           audio/qaudiohelpers.cpp
+           audio/qaudiohelpers.cpp \
+           audio/qaudioformatconverter.cpp \
+           audio/qaudioconvertingdevice.cpp \
+           audio/qaudioringbuffer.cpp \
+           audio/qaudioanalyzer.cpp \
+           audio/qaudiostatistics.cpp
+
+SSE2_SOURCES += \
+           audio/qaudioanalyzer_sse2.cpp \
+           audio/qaudiobuffer_sse2.cpp \
+           audio/qaudioformatconverter_sse2.cpp
 
 qtConfig(pulseaudio) {
     QMAKE_USE_FOR_PRIVATE += pulseaudio
@@ -0,0 +1,711 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qaudioanalyzer.h"
+#include "qaudioanalyzer_p.h"
+#include "qaudioprobe.h"
+
+#include <QtCore/qmath.h>
+#include <private/qsimd_p.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+static void qRegisterAudioAnalysisMetaTypes()
+{
+    qRegisterMetaType<QAudioAnalysis>();
+}
+
+Q_CONSTRUCTOR_FUNCTION(qRegisterAudioAnalysisMetaTypes)
+
+// Buffers waiting for the worker beyond this are dropped.
+static const int MaxPendingBuffers = 16;
+static const int MinSpectrumSize = 32;
+static const int MaxSpectrumSize = 16384;
+
+typedef void (QT_FASTCALL *AudioLevelsFunc)(const float *samples, int count, float *sumOfSquares, float *peak);
+typedef void (QT_FASTCALL *AudioMultiplyFunc)(const float *a, const float *b, float *out, int count);
+typedef void (QT_FASTCALL *AudioFftStageFunc)(float *re, float *im, int size, int half,
+                                              const float *twiddleRe, const float *twiddleIm);
+typedef void (QT_FASTCALL *AudioMagnitudesFunc)(const float *re, const float *im, float *out, int count, float scale);
+
+static void QT_FASTCALL qt_audio_levels(const float *samples, int count, float *sumOfSquares, float *peak)
+{
+    float sum = 0;
+    float maximum = *peak;
+    for (int i = 0; i < count; ++i) {
+        sum += samples[i] * samples[i];
+        maximum = qMax(maximum, qAbs(samples[i]));
+    }
+    *sumOfSquares += sum;
+    *peak = maximum;
+}
+
+static void QT_FASTCALL qt_audio_multiply(const float *a, const float *b, float *out, int count)
+{
+    for (int i = 0; i < count; ++i)
+        out[i] = a[i] * b[i];
+}
+
+static void QT_FASTCALL qt_audio_fft_stage(float *re, float *im, int size, int half,
+                                           const float *twiddleRe, const float *twiddleIm)
+{
+    for (int start = 0; start < size; start += 2 * half) {
+        for (int k = 0; k < half; ++k) {
+            const int a = start + k;
+            const int b = a + half;
+            const float tRe = re[b] * twiddleRe[k] - im[b] * twiddleIm[k];
+            const float tIm = re[b] * twiddleIm[k] + im[b] * twiddleRe[k];
+            re[b] = re[a] - tRe;
+            im[b] = im[a] - tIm;
+            re[a] += tRe;
+            im[a] += tIm;
+        }
+    }
+}
+
+static void QT_FASTCALL qt_audio_magnitudes(const float *re, const float *im, float *out, int count, float scale)
+{
+    for (int i = 0; i < count; ++i)
+        out[i] = qSqrt(re[i] * re[i] + im[i] * im[i]) * scale;
+}
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+extern void QT_FASTCALL qt_audio_levels_sse2(const float *samples, int count, float *sumOfSquares, float *peak);
+extern void QT_FASTCALL qt_audio_multiply_sse2(const float *a, const float *b, float *out, int count);
+extern void QT_FASTCALL qt_audio_fft_stage_sse2(float *re, float *im, int size, int half,
+                                                 const float *twiddleRe, const float *twiddleIm);
+extern void QT_FASTCALL qt_audio_magnitudes_sse2(const float *re, const float *im, float *out, int count, float scale);
+#endif
+
+namespace {
+
+struct QAudioAnalysisFuncs
+{
+    QAudioAnalysisFuncs()
+        : levels(qt_audio_levels)
+        , multiply(qt_audio_multiply)
+        , fftStage(qt_audio_fft_stage)
+        , magnitudes(qt_audio_magnitudes)
+    {
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+        if (qCpuHasFeature(SSE2)) {
+            levels = qt_audio_levels_sse2;
+            multiply = qt_audio_multiply_sse2;
+            fftStage = qt_audio_fft_stage_sse2;
+            magnitudes = qt_audio_magnitudes_sse2;
+        }
+#endif
+    }
+
+    AudioLevelsFunc levels;
+    AudioMultiplyFunc multiply;
+    AudioFftStageFunc fftStage;
+    AudioMagnitudesFunc magnitudes;
+};
+
+}
+
+static const QAudioAnalysisFuncs &analysisFuncs()
+{
+    static const QAudioAnalysisFuncs funcs;
+    return funcs;
+}
+
+void QAudioSpectrum::setSize(int size)
+{
+    if (size == m_size)
+        return;
+
+    m_size = size;
+    m_window.resize(size);
+    m_bitReversed.resize(size);
+    m_twiddleRe.resize(qMax(0, size - 1));
+    m_twiddleIm.resize(qMax(0, size - 1));
+    m_windowed.resize(size);
+    m_re.resize(size);
+    m_im.resize(size);
+
+    if (size == 0)
+        return;
+
+    // Periodic Hann window, its coherent gain is a half.
+    for (int i = 0; i < size; ++i)
+        m_window[i] = float(0.5 - 0.5 * qCos(2 * M_PI * i / size));
+    m_scale = 4.0f / size;
+
+    int bits = 0;
+    while ((1 << bits) < size)
+        ++bits;
+    for (int i = 0; i < size; ++i) {
+        int reversed = 0;
+        for (int bit = 0; bit < bits; ++bit)
+            reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+        m_bitReversed[i] = reversed;
+    }
+
+    // The twiddles of the stage with groups of half butterflies start at half - 1.
+    for (int half = 1; half < size; half *= 2) {
+        for (int k = 0; k < half; ++k) {
+            m_twiddleRe[half - 1 + k] = float(qCos(M_PI * k / half));
+            m_twiddleIm[half - 1 + k] = float(-qSin(M_PI * k / half));
+        }
+    }
+}
+
+void QAudioSpectrum::transform(const float *samples, float *magnitudes)
+{
+    if (m_size == 0)
+        return;
+
+    const QAudioAnalysisFuncs &funcs = analysisFuncs();
+
+    funcs.multiply(samples, m_window.constData(), m_windowed.data(), m_size);
+    for (int i = 0; i < m_size; ++i)
+        m_re[i] = m_windowed.at(m_bitReversed.at(i));
+    memset(m_im.data(), 0, m_size * sizeof(float));
+
+    for (int half = 1; half < m_size; half *= 2) {
+        const AudioFftStageFunc stage = half >= 4 ? funcs.fftStage : qt_audio_fft_stage;
+        stage(m_re.data(), m_im.data(), m_size, half,
+              m_twiddleRe.constData() + half - 1, m_twiddleIm.constData() + half - 1);
+    }
+
+    funcs.magnitudes(m_re.constData(), m_im.constData(), magnitudes, m_size / 2, m_scale);
+}
+
+void QAudioAnalysisExchange::publish()
+{
+    m_back = m_middle.fetchAndStoreOrdered(m_back | Fresh) & IndexMask;
+}
+
+QAudioAnalysis QAudioAnalysisExchange::read()
+{
+    if (m_middle.load() & Fresh)
+        m_front = m_middle.fetchAndStoreOrdered(m_front) & IndexMask;
+    return m_slots[m_front];
+}
+
+QAudioAnalyzerWorker::QAudioAnalyzerWorker(QAudioAnalyzer *analyzer)
+    : m_analyzer(analyzer)
+{
+}
+
+void QAudioAnalyzerWorker::process(const QAudioBuffer &buffer)
+{
+    QAudioAnalyzerPrivate *d = m_analyzer->d;
+    d->pending.deref();
+
+    // Planar floats are cached on the buffer, other consumers of the probe can reuse them.
+    const float *planar = buffer.constFloatData(QAudioBuffer::Planar);
+    if (!planar)
+        return;
+
+    if (buffer.format() != m_format
+            || m_updateInterval != d->updateInterval.load()
+            || m_spectrum.size() != d->spectrumSize.load()) {
+        configure(buffer.format());
+    }
+
+    const int frames = buffer.frameCount();
+    for (int offset = 0; offset < frames;) {
+        if (m_frames == 0) {
+            m_startTime = buffer.startTime() < 0
+                    ? -1 : buffer.startTime() + m_format.durationForFrames(offset);
+        }
+
+        const int count = qMin(frames - offset, m_framesPerUpdate - m_frames);
+        accumulate(planar, frames, offset, count);
+        offset += count;
+        m_frames += count;
+
+        if (m_frames >= m_framesPerUpdate)
+            publish();
+    }
+}
+
+void QAudioAnalyzerWorker::reset()
+{
+    m_frames = 0;
+    m_sumOfSquares.fill(0);
+    m_peak.fill(0);
+    m_history.fill(0);
+    m_historyPosition = 0;
+}
+
+void QAudioAnalyzerWorker::configure(const QAudioFormat &format)
+{
+    QAudioAnalyzerPrivate *d = m_analyzer->d;
+
+    m_format = format;
+    m_updateInterval = d->updateInterval.load();
+    m_framesPerUpdate = qMax(1, int(qint64(format.sampleRate()) * m_updateInterval / 1000));
+
+    m_sumOfSquares.resize(format.channelCount());
+    m_peak.resize(format.channelCount());
+
+    const int spectrumSize = d->spectrumSize.load();
+    m_spectrum.setSize(spectrumSize);
+    m_history.resize(spectrumSize);
+    m_ordered.resize(spectrumSize);
+
+    reset();
+}
+
+void QAudioAnalyzerWorker::accumulate(const float *planar, int stride, int offset, int frames)
+{
+    const QAudioAnalysisFuncs &funcs = analysisFuncs();
+    const int channels = m_format.channelCount();
+
+    for (int channel = 0; channel < channels; ++channel) {
+        funcs.levels(planar + channel * stride + offset, frames,
+                     &m_sumOfSquares[channel], &m_peak[channel]);
+    }
+
+    const int size = m_history.size();
+    if (size == 0)
+        return;
+
+    // Only the last size frames make it into the spectrum.
+    const float scale = 1.0f / channels;
+    for (int frame = qMax(0, frames - size); frame < frames; ++frame) {
+        float sum = 0;
+        for (int channel = 0; channel < channels; ++channel)
+            sum += planar[channel * stride + offset + frame];
+        m_history[m_historyPosition] = sum * scale;
+        m_historyPosition = (m_historyPosition + 1) & (size - 1);
+    }
+}
+
+void QAudioAnalyzerWorker::publish()
+{
+    QAudioAnalyzerPrivate *d = m_analyzer->d;
+
+    // Detaches only if the reader still holds on to what was last in this slot.
+    QAudioAnalysis &analysis = d->exchange.back();
+    if (!analysis.d)
+        analysis.d = new QAudioAnalysisPrivate;
+    QAudioAnalysisPrivate *result = analysis.d.data();
+
+    const int channels = m_format.channelCount();
+    result->startTime = m_startTime;
+    result->duration = m_format.durationForFrames(m_frames);
+    result->sampleRate = m_format.sampleRate();
+    result->spectrumSize = m_history.size();
+    result->rms.resize(channels);
+    result->peak.resize(channels);
+    for (int channel = 0; channel < channels; ++channel) {
+        result->rms[channel] = qSqrt(m_sumOfSquares.at(channel) / m_frames);
+        result->peak[channel] = m_peak.at(channel);
+    }
+
+    const int size = m_history.size();
+    result->spectrum.resize(size / 2);
+    if (size > 0) {
+        const int tail = size - m_historyPosition;
+        memcpy(m_ordered.data(), m_history.constData() + m_historyPosition, tail * sizeof(float));
+        memcpy(m_ordered.data() + tail, m_history.constData(), m_historyPosition * sizeof(float));
+        m_spectrum.transform(m_ordered.constData(), result->spectrum.data());
+    }
+
+    m_frames = 0;
+    m_sumOfSquares.fill(0);
+    m_peak.fill(0);
+
+    d->exchange.publish();
+    emit m_analyzer->analysisChanged();
+}
+
+/*!
+    \class QAudioAnalysis
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_audio
+    \since 5.13
+
+    \brief The QAudioAnalysis class holds the levels and spectrum of a stretch of audio.
+
+    Analyses are produced by QAudioAnalyzer. Each one covers the audio
+    received during one update interval.
+
+    \sa QAudioAnalyzer
+*/
+
+/*!
+    Constructs an invalid analysis.
+*/
+QAudioAnalysis::QAudioAnalysis()
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QAudioAnalysis::QAudioAnalysis(const QAudioAnalysis &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Assigns \a other to this analysis.
+*/
+QAudioAnalysis &QAudioAnalysis::operator=(const QAudioAnalysis &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    Destroys the analysis.
+*/
+QAudioAnalysis::~QAudioAnalysis()
+{
+}
+
+/*!
+    Returns true if the analysis holds results, false until the analyzer
+    published its first one.
+*/
+bool QAudioAnalysis::isValid() const
+{
+    return d && d->sampleRate > 0;
+}
+
+/*!
+    Returns the time in the stream, in microseconds, of the first frame that
+    was analyzed, or -1 if the buffers had no start time.
+*/
+qint64 QAudioAnalysis::startTime() const
+{
+    return d ? d->startTime : -1;
+}
+
+/*!
+    Returns the duration of the analyzed audio, in microseconds.
+*/
+qint64 QAudioAnalysis::duration() const
+{
+    return d ? d->duration : 0;
+}
+
+/*!
+    Returns the sample rate of the analyzed audio.
+*/
+int QAudioAnalysis::sampleRate() const
+{
+    return d ? d->sampleRate : 0;
+}
+
+/*!
+    Returns the number of channels of the analyzed audio.
+*/
+int QAudioAnalysis::channelCount() const
+{
+    return d ? d->rms.size() : 0;
+}
+
+/*!
+    Returns the root mean square level of \a channel, between 0 and 1.
+*/
+float QAudioAnalysis::rms(int channel) const
+{
+    if (!d || channel < 0 || channel >= d->rms.size())
+        return 0;
+    return d->rms.at(channel);
+}
+
+/*!
+    Returns the peak level of \a channel, between 0 and 1.
+*/
+float QAudioAnalysis::peak(int channel) const
+{
+    if (!d || channel < 0 || channel >= d->peak.size())
+        return 0;
+    return d->peak.at(channel);
+}
+
+/*!
+    Returns the magnitude spectrum of the most recent QAudioAnalyzer::spectrumSize()
+    frames, with all the channels mixed together and a Hann window applied.
+
+    It holds half the spectrum size bins, from 0 Hz up to just below half the
+    sample rate. A full scale sine wave has a magnitude of about 1.
+
+    \sa frequencyAt()
+*/
+QVector<float> QAudioAnalysis::spectrum() const
+{
+    return d ? d->spectrum : QVector<float>();
+}
+
+/*!
+    Returns the frequency, in Hz, of the spectrum \a bin.
+*/
+qreal QAudioAnalysis::frequencyAt(int bin) const
+{
+    if (!d || d->spectrumSize == 0)
+        return 0;
+    return qreal(bin) * d->sampleRate / d->spectrumSize;
+}
+
+/*!
+    \class QAudioAnalyzer
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_audio
+    \since 5.13
+
+    \brief The QAudioAnalyzer class measures the levels and spectrum of probed audio.
+
+    Level meters and spectrum displays are the most common use of
+    QAudioProbe. QAudioAnalyzer does that work on a thread of its own: it
+    computes the root mean square and peak level of every channel, and the
+    magnitude spectrum of the channels mixed together, and publishes the
+    results every updateInterval() milliseconds of audio.
+
+    \code
+        QAudioAnalyzer *analyzer = new QAudioAnalyzer(this);
+        analyzer->setSource(player);
+
+        // In a timer, or when analysisChanged() is emitted
+        const QAudioAnalysis analysis = analyzer->analysis();
+        meter->setLevel(analysis.peak(0));
+    \endcode
+
+    Reading the analysis doesn't take a lock, nor does it copy the results,
+    so the user interface can poll it every frame.
+
+    \sa QAudioProbe, QAudioAnalysis
+*/
+
+/*!
+    \fn void QAudioAnalyzer::analysisChanged()
+
+    This signal is emitted from the analyzer's worker thread when a new
+    analysis has been published.
+*/
+
+/*!
+    Creates an audio analyzer with a \a parent, and starts its worker thread.
+*/
+QAudioAnalyzer::QAudioAnalyzer(QObject *parent)
+    : QObject(parent)
+    , d(new QAudioAnalyzerPrivate)
+{
+    d->worker = new QAudioAnalyzerWorker(this);
+    d->worker->moveToThread(&d->thread);
+    d->thread.setObjectName(QStringLiteral("QAudioAnalyzer"));
+    d->thread.start();
+}
+
+/*!
+    Stops the worker thread and destroys the analyzer.
+*/
+QAudioAnalyzer::~QAudioAnalyzer()
+{
+    setSource(static_cast<QAudioProbe *>(nullptr));
+
+    d->thread.quit();
+    d->thread.wait();
+    delete d->worker;
+    delete d;
+}
+
+/*!
+    Analyzes the buffers of \a probe. The probe must outlive the analyzer,
+    or be set to another source.
+
+    Passing a null probe detaches the analyzer. Always returns true.
+*/
+bool QAudioAnalyzer::setSource(QAudioProbe *probe)
+{
+    if (d->probe)
+        disconnect(d->probe.data(), nullptr, this, nullptr);
+
+    if (d->ownProbe && d->ownProbe != probe) {
+        delete d->ownProbe;
+        d->ownProbe = nullptr;
+    }
+
+    d->probe = probe;
+    if (probe) {
+        // Direct, so that buffers go straight to the worker from whichever thread delivers them.
+        connect(probe, &QAudioProbe::audioBufferProbed, this, &QAudioAnalyzer::analyze, Qt::DirectConnection);
+        connect(probe, &QAudioProbe::flush, this, &QAudioAnalyzer::reset, Qt::DirectConnection);
+    }
+
+    reset();
+    return true;
+}
+
+/*!
+    Analyzes the audio of the media object \a source, through a probe of its
+    own.
+
+    Returns false if \a source can't be probed.
+*/
+bool QAudioAnalyzer::setSource(QMediaObject *source)
+{
+    if (!source)
+        return setSource(static_cast<QAudioProbe *>(nullptr));
+
+    QAudioProbe *probe = new QAudioProbe(this);
+    if (!probe->setSource(source)) {
+        delete probe;
+        return false;
+    }
+
+    setSource(probe);
+    d->ownProbe = probe;
+    return true;
+}
+
+/*!
+    Analyzes the audio recorded by \a source, through a probe of its own.
+
+    Returns false if \a source can't be probed.
+*/
+bool QAudioAnalyzer::setSource(QMediaRecorder *source)
+{
+    if (!source)
+        return setSource(static_cast<QAudioProbe *>(nullptr));
+
+    QAudioProbe *probe = new QAudioProbe(this);
+    if (!probe->setSource(source)) {
+        delete probe;
+        return false;
+    }
+
+    setSource(probe);
+    d->ownProbe = probe;
+    return true;
+}
+
+/*!
+    \property QAudioAnalyzer::updateInterval
+
+    The amount of audio, in milliseconds, covered by each analysis.
+    Defaults to 50 milliseconds.
+*/
+int QAudioAnalyzer::updateInterval() const
+{
+    return d->updateInterval.load();
+}
+
+void QAudioAnalyzer::setUpdateInterval(int milliseconds)
+{
+    d->updateInterval.store(qMax(1, milliseconds));
+}
+
+/*!
+    \property QAudioAnalyzer::spectrumSize
+
+    The number of frames the spectrum is computed from, a power of two
+    between 32 and 16384, or 0 to skip the spectrum. Other sizes are rounded
+    up. Defaults to 1024.
+*/
+int QAudioAnalyzer::spectrumSize() const
+{
+    return d->spectrumSize.load();
+}
+
+void QAudioAnalyzer::setSpectrumSize(int size)
+{
+    if (size > 0) {
+        size = qBound(MinSpectrumSize, size, MaxSpectrumSize);
+        int powerOfTwo = MinSpectrumSize;
+        while (powerOfTwo < size)
+            powerOfTwo *= 2;
+        size = powerOfTwo;
+    }
+    d->spectrumSize.store(qMax(0, size));
+}
+
+/*!
+    Returns the most recent analysis.
+
+    This doesn't lock, nor does it copy the results, but it must only be
+    called from the thread the analyzer lives in.
+*/
+QAudioAnalysis QAudioAnalyzer::analysis() const
+{
+    return d->exchange.read();
+}
+
+/*!
+    Returns the number of buffers dropped because the worker thread couldn't
+    keep up.
+*/
+quint64 QAudioAnalyzer::droppedBufferCount() const
+{
+    return quint64(d->dropped.load());
+}
+
+/*!
+    Queues \a buffer for analysis. Can be called from any thread.
+*/
+void QAudioAnalyzer::analyze(const QAudioBuffer &buffer)
+{
+    if (!buffer.isValid())
+        return;
+
+    if (d->pending.load() >= MaxPendingBuffers) {
+        d->dropped.ref();
+        return;
+    }
+
+    d->pending.ref();
+    QMetaObject::invokeMethod(d->worker, "process", Qt::QueuedConnection, Q_ARG(QAudioBuffer, buffer));
+}
+
+/*!
+    Drops the audio accumulated for the next analysis, for instance after a
+    seek. Can be called from any thread.
+*/
+void QAudioAnalyzer::reset()
+{
+    QMetaObject::invokeMethod(d->worker, "reset", Qt::QueuedConnection);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qaudioanalyzer.cpp"
+#include "moc_qaudioanalyzer_p.cpp"
@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAUDIOANALYZER_H
+#define QAUDIOANALYZER_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtMultimedia/qaudiobuffer.h>
+
+QT_BEGIN_NAMESPACE
+
+class QAudioProbe;
+class QMediaObject;
+class QMediaRecorder;
+
+class QAudioAnalysisPrivate;
+class Q_MULTIMEDIA_EXPORT QAudioAnalysis
+{
+public:
+    QAudioAnalysis();
+    QAudioAnalysis(const QAudioAnalysis &other);
+    QAudioAnalysis &operator=(const QAudioAnalysis &other);
+    ~QAudioAnalysis();
+
+    bool isValid() const;
+
+    qint64 startTime() const;
+    qint64 duration() const;
+
+    int sampleRate() const;
+    int channelCount() const;
+
+    float rms(int channel) const;
+    float peak(int channel) const;
+
+    QVector<float> spectrum() const;
+    qreal frequencyAt(int bin) const;
+
+private:
+    friend class QAudioAnalyzerWorker;
+    QSharedDataPointer<QAudioAnalysisPrivate> d;
+};
+
+class QAudioAnalyzerPrivate;
+class Q_MULTIMEDIA_EXPORT QAudioAnalyzer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval)
+    Q_PROPERTY(int spectrumSize READ spectrumSize WRITE setSpectrumSize)
+public:
+    explicit QAudioAnalyzer(QObject *parent = nullptr);
+    ~QAudioAnalyzer();
+
+    bool setSource(QAudioProbe *probe);
+    bool setSource(QMediaObject *source);
+    bool setSource(QMediaRecorder *source);
+
+    int updateInterval() const;
+    void setUpdateInterval(int milliseconds);
+
+    int spectrumSize() const;
+    void setSpectrumSize(int size);
+
+    QAudioAnalysis analysis() const;
+    quint64 droppedBufferCount() const;
+
+public Q_SLOTS:
+    void analyze(const QAudioBuffer &buffer);
+    void reset();
+
+Q_SIGNALS:
+    void analysisChanged();
+
+private:
+    friend class QAudioAnalyzerWorker;
+    QAudioAnalyzerPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QAudioAnalysis)
+
+#endif // QAUDIOANALYZER_H
@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAUDIOANALYZER_P_H
+#define QAUDIOANALYZER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qaudioanalyzer.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+
+QT_BEGIN_NAMESPACE
+
+class QAudioAnalysisPrivate : public QSharedData
+{
+public:
+    qint64 startTime = -1;
+    qint64 duration = 0;
+    int sampleRate = 0;
+    int spectrumSize = 0;
+    QVector<float> rms;
+    QVector<float> peak;
+    QVector<float> spectrum;
+};
+
+/*
+    Radix-2 FFT of a real signal, windowed with a Hann window. The tables
+    are built once for a size, so transforms don't allocate.
+*/
+class QAudioSpectrum
+{
+public:
+    void setSize(int size);
+    int size() const { return m_size; }
+
+    // Magnitudes of the first size / 2 bins, scaled so that a full scale sine reads 1.
+    void transform(const float *samples, float *magnitudes);
+
+private:
+    int m_size = 0;
+    float m_scale = 0;
+    QVector<float> m_window;
+    QVector<int> m_bitReversed;
+    QVector<float> m_twiddleRe;
+    QVector<float> m_twiddleIm;
+    QVector<float> m_windowed;
+    QVector<float> m_re;
+    QVector<float> m_im;
+};
+
+/*
+    Publishes analyses from the worker thread to a reader without locking.
+    The writer fills the back slot and swaps it with the middle one, the
+    reader swaps the middle slot with its front slot when it is newer.
+*/
+class QAudioAnalysisExchange
+{
+public:
+    QAudioAnalysis &back() { return m_slots[m_back]; }
+    void publish();
+    QAudioAnalysis read();
+
+private:
+    enum { IndexMask = 3, Fresh = 4 };
+
+    QAudioAnalysis m_slots[3];
+    int m_back = 0;
+    int m_front = 2;
+    QAtomicInt m_middle = 1;
+};
+
+class QAudioAnalyzerWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QAudioAnalyzerWorker(QAudioAnalyzer *analyzer);
+
+public Q_SLOTS:
+    void process(const QAudioBuffer &buffer);
+    void reset();
+
+private:
+    void configure(const QAudioFormat &format);
+    void accumulate(const float *planar, int stride, int offset, int frames);
+    void publish();
+
+    QAudioAnalyzer *m_analyzer;
+    QAudioFormat m_format;
+    int m_updateInterval = 0;
+    int m_framesPerUpdate = 0;
+
+    qint64 m_startTime = -1;
+    int m_frames = 0;
+    QVector<float> m_sumOfSquares;
+    QVector<float> m_peak;
+
+    // The last spectrum size frames, mixed down to mono.
+    QVector<float> m_history;
+    QVector<float> m_ordered;
+    int m_historyPosition = 0;
+    QAudioSpectrum m_spectrum;
+};
+
+class QAudioAnalyzerPrivate
+{
+public:
+    QPointer<QAudioProbe> probe;
+    QAudioProbe *ownProbe = nullptr;
+
+    QThread thread;
+    QAudioAnalyzerWorker *worker = nullptr;
+
+    QAtomicInt updateInterval = 50;
+    QAtomicInt spectrumSize = 1024;
+    QAtomicInt pending = 0;
+    QAtomicInt dropped = 0;
+
+    mutable QAudioAnalysisExchange exchange;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOANALYZER_P_H
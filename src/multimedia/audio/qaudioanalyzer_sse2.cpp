@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/qglobal.h>
+#include <private/qsimd_p.h>
+
+#include <cmath>
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+
+QT_BEGIN_NAMESPACE
+
+static inline float horizontalSum(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+static inline float horizontalMax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_max_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+void QT_FASTCALL qt_audio_levels_sse2(const float *samples, int count, float *sumOfSquares, float *peak)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 sum = _mm_setzero_ps();
+    __m128 maximum = _mm_setzero_ps();
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const __m128 v = _mm_loadu_ps(samples + i);
+        sum = _mm_add_ps(sum, _mm_mul_ps(v, v));
+        maximum = _mm_max_ps(maximum, _mm_and_ps(v, absMask));
+    }
+
+    float s = horizontalSum(sum);
+    float m = horizontalMax(maximum);
+
+    // leftovers
+    for (; i < count; ++i) {
+        s += samples[i] * samples[i];
+        m = qMax(m, qAbs(samples[i]));
+    }
+
+    *sumOfSquares += s;
+    *peak = qMax(*peak, m);
+}
+
+void QT_FASTCALL qt_audio_multiply_sse2(const float *a, const float *b, float *out, int count)
+{
+    int i = 0;
+    for (; i < count - 3; i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+    // leftovers
+    for (; i < count; ++i)
+        out[i] = a[i] * b[i];
+}
+
+void QT_FASTCALL qt_audio_fft_stage_sse2(float *re, float *im, int size, int half,
+                                          const float *twiddleRe, const float *twiddleIm)
+{
+    // Only used for stages of at least four butterflies per group.
+    for (int start = 0; start < size; start += 2 * half) {
+        float *aRe = re + start;
+        float *aIm = im + start;
+        float *bRe = aRe + half;
+        float *bIm = aIm + half;
+
+        for (int k = 0; k < half; k += 4) {
+            const __m128 wRe = _mm_loadu_ps(twiddleRe + k);
+            const __m128 wIm = _mm_loadu_ps(twiddleIm + k);
+            const __m128 xRe = _mm_loadu_ps(bRe + k);
+            const __m128 xIm = _mm_loadu_ps(bIm + k);
+            const __m128 tRe = _mm_sub_ps(_mm_mul_ps(xRe, wRe), _mm_mul_ps(xIm, wIm));
+            const __m128 tIm = _mm_add_ps(_mm_mul_ps(xRe, wIm), _mm_mul_ps(xIm, wRe));
+            const __m128 yRe = _mm_loadu_ps(aRe + k);
+            const __m128 yIm = _mm_loadu_ps(aIm + k);
+            _mm_storeu_ps(bRe + k, _mm_sub_ps(yRe, tRe));
+            _mm_storeu_ps(bIm + k, _mm_sub_ps(yIm, tIm));
+            _mm_storeu_ps(aRe + k, _mm_add_ps(yRe, tRe));
+            _mm_storeu_ps(aIm + k, _mm_add_ps(yIm, tIm));
+        }
+    }
+}
+
+void QT_FASTCALL qt_audio_magnitudes_sse2(const float *re, const float *im, float *out, int count, float scale)
+{
+    const __m128 factor = _mm_set1_ps(scale);
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const __m128 r = _mm_loadu_ps(re + i);
+        const __m128 m = _mm_loadu_ps(im + i);
+        const __m128 power = _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sqrt_ps(power), factor));
+    }
+
+    // leftovers
+    for (; i < count; ++i)
+        out[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]) * scale;
+}
+
+QT_END_NAMESPACE
+
+#endif
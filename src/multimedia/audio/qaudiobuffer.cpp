@@ -39,9 +39,15 @@
 
 #include "qaudiobuffer.h"
 #include "qaudiobuffer_p.h"
+#include "qaudioformatconverter_p.h"
 
 #include <QObject>
 #include <QDebug>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/qvector.h>
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -53,10 +59,216 @@ static void qRegisterAudioBufferMetaTypes()
 
 Q_CONSTRUCTOR_FUNCTION(qRegisterAudioBufferMetaTypes)
 
+/*
+    Probe buffers mostly come in the same few sizes, so the storage of
+    converted samples is recycled rather than returned to the heap.
+*/
+class QAudioBufferConversionPool
+{
+public:
+    enum { MaxBlocks = 16 };
+
+    QAudioBufferConversionPool()
+    {
+        mBlocks.reserve(MaxBlocks);
+    }
+
+    ~QAudioBufferConversionPool()
+    {
+        for (const Block &block : qAsConst(mBlocks))
+            free(block.second);
+    }
+
+    void *allocate(int bytes)
+    {
+        QMutexLocker locker(&mMutex);
+        for (int i = 0; i < mBlocks.size(); ++i) {
+            if (mBlocks.at(i).first == bytes)
+                return mBlocks.takeAt(i).second;
+        }
+        locker.unlock();
+        return malloc(bytes);
+    }
+
+    void release(void *block, int bytes)
+    {
+        QMutexLocker locker(&mMutex);
+        if (mBlocks.size() < MaxBlocks) {
+            mBlocks.append(qMakePair(bytes, block));
+            return;
+        }
+        locker.unlock();
+        free(block);
+    }
+
+private:
+    typedef QPair<int, void *> Block;
+
+    QMutex mMutex;
+    QVector<Block> mBlocks;
+};
+
+Q_GLOBAL_STATIC(QAudioBufferConversionPool, conversionPool)
+
+// Buffers can outlive the pool at exit.
+static void *allocateConversion(int bytes)
+{
+    QAudioBufferConversionPool *pool = conversionPool();
+    return pool ? pool->allocate(bytes) : malloc(bytes);
+}
+
+static void releaseConversion(void *data, int bytes)
+{
+    if (QAudioBufferConversionPool *pool = conversionPool())
+        pool->release(data, bytes);
+    else
+        free(data);
+}
+
+typedef void (QT_FASTCALL *DeinterleaveFloatFunc)(const float *src, float *left, float *right, int frames);
+typedef void (QT_FASTCALL *DeinterleaveS16Func)(const qint16 *src, qint16 *left, qint16 *right, int frames);
+
+template <typename T>
+static void QT_FASTCALL qt_audio_deinterleave_stereo(const T *src, T *left, T *right, int frames)
+{
+    for (int i = 0; i < frames; ++i) {
+        left[i] = src[2 * i];
+        right[i] = src[2 * i + 1];
+    }
+}
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+extern void QT_FASTCALL qt_audio_deinterleave_stereo_float_sse2(const float *src, float *left, float *right, int frames);
+extern void QT_FASTCALL qt_audio_deinterleave_stereo_S16_sse2(const qint16 *src, qint16 *left, qint16 *right, int frames);
+#endif
+
+namespace {
+
+struct QAudioDeinterleaveFuncs
+{
+    QAudioDeinterleaveFuncs()
+        : stereoFloat(qt_audio_deinterleave_stereo<float>)
+        , stereoS16(qt_audio_deinterleave_stereo<qint16>)
+    {
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+        if (qCpuHasFeature(SSE2)) {
+            stereoFloat = qt_audio_deinterleave_stereo_float_sse2;
+            stereoS16 = qt_audio_deinterleave_stereo_S16_sse2;
+        }
+#endif
+    }
+
+    DeinterleaveFloatFunc stereoFloat;
+    DeinterleaveS16Func stereoS16;
+};
+
+}
+
+static const QAudioDeinterleaveFuncs &deinterleaveFuncs()
+{
+    static const QAudioDeinterleaveFuncs funcs;
+    return funcs;
+}
+
+static void deinterleave(const float *src, int frames, int channels, float *dst, int stride)
+{
+    if (channels == 2) {
+        deinterleaveFuncs().stereoFloat(src, dst, dst + stride, frames);
+        return;
+    }
+    for (int channel = 0; channel < channels; ++channel) {
+        for (int frame = 0; frame < frames; ++frame)
+            dst[channel * stride + frame] = src[frame * channels + channel];
+    }
+}
+
+static void deinterleave(const qint16 *src, int frames, int channels, qint16 *dst, int stride)
+{
+    if (channels == 2) {
+        deinterleaveFuncs().stereoS16(src, dst, dst + stride, frames);
+        return;
+    }
+    for (int channel = 0; channel < channels; ++channel) {
+        for (int frame = 0; frame < frames; ++frame)
+            dst[channel * stride + frame] = src[frame * channels + channel];
+    }
+}
+
+static QAudioFormat hostFormat(const QAudioFormat &format, int sampleSize, QAudioFormat::SampleType sampleType)
+{
+    QAudioFormat host = format;
+    host.setSampleSize(sampleSize);
+    host.setSampleType(sampleType);
+    host.setByteOrder(QAudioFormat::Endian(QSysInfo::ByteOrder));
+    return host;
+}
+
+/*
+    Converts \a frames frames at \a src to floats or 16 bit integers at \a dst,
+    interleaved or one channel after the other.
+*/
+static void convertSamples(const QAudioFormat &format, const void *src, int frames,
+                           void *dst, bool toInt16, QAudioBuffer::SampleLayout layout)
+{
+    const int channels = format.channelCount();
+    const QAudioFormat floatFormat = hostFormat(format, 32, QAudioFormat::Float);
+    const QAudioFormat int16Format = hostFormat(format, 16, QAudioFormat::SignedInt);
+
+    // Nothing to convert, at most a deinterleave.
+    if (format == (toInt16 ? int16Format : floatFormat)) {
+        if (layout == QAudioBuffer::Interleaved)
+            memcpy(dst, src, frames * format.bytesPerFrame());
+        else if (toInt16)
+            deinterleave(static_cast<const qint16 *>(src), frames, channels, static_cast<qint16 *>(dst), frames);
+        else
+            deinterleave(static_cast<const float *>(src), frames, channels, static_cast<float *>(dst), frames);
+        return;
+    }
+
+    if (!toInt16 && layout == QAudioBuffer::Interleaved) {
+        QAudioFormatConverter::toFloat(format, src, static_cast<float *>(dst), frames * channels);
+        return;
+    }
+
+    // Everything else goes through float, a chunk at a time.
+    enum { ChunkSamples = 2048 };
+    const int chunkFrames = qMax(1, int(ChunkSamples) / channels);
+    QVarLengthArray<float, ChunkSamples> interleaved(chunkFrames * channels);
+    QVarLengthArray<float, ChunkSamples> planar(toInt16 && layout == QAudioBuffer::Planar ? chunkFrames * channels : 0);
+
+    const uchar *in = static_cast<const uchar *>(src);
+    for (int offset = 0; offset < frames; offset += chunkFrames) {
+        const int count = qMin(chunkFrames, frames - offset);
+        QAudioFormatConverter::toFloat(format, in + offset * format.bytesPerFrame(), interleaved.data(), count * channels);
+
+        if (layout == QAudioBuffer::Interleaved) {
+            QAudioFormatConverter::fromFloat(interleaved.constData(), int16Format,
+                                             static_cast<qint16 *>(dst) + offset * channels, count * channels);
+        } else if (!toInt16) {
+            deinterleave(interleaved.constData(), count, channels, static_cast<float *>(dst) + offset, frames);
+        } else {
+            deinterleave(interleaved.constData(), count, channels, planar.data(), count);
+            for (int channel = 0; channel < channels; ++channel) {
+                QAudioFormatConverter::fromFloat(planar.constData() + channel * count, int16Format,
+                                                 static_cast<qint16 *>(dst) + channel * frames + offset, count);
+            }
+        }
+    }
+}
+
 
 class QAudioBufferPrivate : public QSharedData
 {
 public:
+    enum Conversion
+    {
+        FloatInterleaved,
+        FloatPlanar,
+        Int16Interleaved,
+        Int16Planar,
+        ConversionCount
+    };
+
     QAudioBufferPrivate(QAbstractAudioBuffer *provider)
         : mProvider(provider)
         , mCount(1)
@@ -65,6 +277,7 @@ public:
 
     ~QAudioBufferPrivate()
     {
+        clearConversions();
         if (mProvider)
             mProvider->release();
     }
@@ -82,6 +295,9 @@ public:
 
     QAudioBufferPrivate *clone();
 
+    const void *conversion(Conversion conversion);
+    void clearConversions();
+
     static QAudioBufferPrivate *acquire(QAudioBufferPrivate *other)
     {
         if (!other)
@@ -95,6 +311,9 @@ public:
 
     QAbstractAudioBuffer *mProvider;
     QAtomicInt mCount;
+
+    // Converted copies of the samples, shared by all the buffers using this data.
+    QAtomicPointer<void> mConversions[ConversionCount];
 };
 
 // Private class to go in .cpp file
@@ -181,6 +400,47 @@ QAudioBufferPrivate *QAudioBufferPrivate::clone()
     return 0;
 }
 
+static int conversionBytes(QAbstractAudioBuffer *provider, QAudioBufferPrivate::Conversion conversion)
+{
+    const int sampleSize = conversion == QAudioBufferPrivate::Int16Interleaved
+            || conversion == QAudioBufferPrivate::Int16Planar ? int(sizeof(qint16)) : int(sizeof(float));
+    return provider->frameCount() * provider->format().channelCount() * sampleSize;
+}
+
+const void *QAudioBufferPrivate::conversion(Conversion conversion)
+{
+    void *data = mConversions[conversion].loadAcquire();
+    if (data)
+        return data;
+
+    const int bytes = conversionBytes(mProvider, conversion);
+    data = allocateConversion(bytes);
+    if (!data)
+        return 0;
+
+    convertSamples(mProvider->format(), mProvider->constData(), mProvider->frameCount(), data,
+                   conversion == Int16Interleaved || conversion == Int16Planar,
+                   conversion == FloatPlanar || conversion == Int16Planar
+                           ? QAudioBuffer::Planar : QAudioBuffer::Interleaved);
+
+    // Another thread might have converted the same samples meanwhile.
+    void *existing = 0;
+    if (!mConversions[conversion].testAndSetOrdered(0, data, existing)) {
+        releaseConversion(data, bytes);
+        return existing;
+    }
+    return data;
+}
+
+void QAudioBufferPrivate::clearConversions()
+{
+    for (int conversion = 0; conversion < ConversionCount; ++conversion) {
+        void *data = mConversions[conversion].fetchAndStoreAcquire(0);
+        if (data)
+            releaseConversion(data, conversionBytes(mProvider, Conversion(conversion)));
+    }
+}
+
 /*!
     \class QAbstractAudioBuffer
     \internal
@@ -471,6 +731,9 @@ void *QAudioBuffer::data()
         d = newd;
     }
 
+    // The samples are about to change
+    d->clearConversions();
+
     // We're (now) the only user of this qaab, so
     // see if it's writable directly
     void *buffer = d->mProvider->writableData();
@@ -492,6 +755,99 @@ void *QAudioBuffer::data()
     return 0;
 }
 
+/*!
+    \enum QAudioBuffer::SampleLayout
+    \since 5.13
+
+    Describes how converted samples are arranged.
+
+    \value Interleaved One sample per channel for each frame, in turn, like
+           the buffer itself.
+    \value Planar      All the samples of the first channel, then all the
+           samples of the second channel, and so on. Each channel takes
+           frameCount() samples.
+*/
+
+/*!
+    \since 5.13
+
+    Returns the samples of this buffer converted to floats between -1 and 1,
+    arranged according to \a layout.
+
+    The conversion is done on the first call and shared with all the copies
+    of this buffer, so several consumers of the same QAudioProbe buffer
+    don't each convert it. The returned pointer remains valid for as long as
+    the samples aren't modified through data().
+
+    Returns a null pointer if the buffer is invalid or its format can't be
+    converted.
+
+    \sa constInt16Data(), convertTo()
+*/
+const float *QAudioBuffer::constFloatData(SampleLayout layout) const
+{
+    if (!isValid() || !QAudioFormatConverter::canConvert(format(), format()))
+        return 0;
+
+    return static_cast<const float *>(d->conversion(layout == Planar
+            ? QAudioBufferPrivate::FloatPlanar : QAudioBufferPrivate::FloatInterleaved));
+}
+
+/*!
+    \since 5.13
+
+    Returns the samples of this buffer converted to signed 16 bit integers
+    in the host byte order, arranged according to \a layout.
+
+    Like constFloatData(), the conversion is shared with all the copies of
+    this buffer.
+
+    \sa constFloatData(), convertTo()
+*/
+const qint16 *QAudioBuffer::constInt16Data(SampleLayout layout) const
+{
+    if (!isValid() || !QAudioFormatConverter::canConvert(format(), format()))
+        return 0;
+
+    return static_cast<const qint16 *>(d->conversion(layout == Planar
+            ? QAudioBufferPrivate::Int16Planar : QAudioBufferPrivate::Int16Interleaved));
+}
+
+/*!
+    \since 5.13
+
+    Converts the samples of this buffer to floats between -1 and 1, arranged
+    according to \a layout, and writes them to \a destination, which must
+    have room for sampleCount() floats.
+
+    Unlike constFloatData() this doesn't allocate, nor cache anything.
+    Returns false if the buffer is invalid or its format can't be converted.
+*/
+bool QAudioBuffer::convertTo(float *destination, SampleLayout layout) const
+{
+    if (!destination || !isValid() || !QAudioFormatConverter::canConvert(format(), format()))
+        return false;
+
+    convertSamples(format(), constData(), frameCount(), destination, false, layout);
+    return true;
+}
+
+/*!
+    \since 5.13
+    \overload
+
+    Converts the samples of this buffer to signed 16 bit integers and writes
+    them to \a destination, which must have room for sampleCount() samples.
+*/
+bool QAudioBuffer::convertTo(qint16 *destination, SampleLayout layout) const
+{
+    if (!destination || !isValid() || !QAudioFormatConverter::canConvert(format(), format()))
+        return false;
+
+    convertSamples(format(), constData(), frameCount(), destination, true, layout);
+    return true;
+}
+
 // Template helper classes worth documenting
 
 /*!
@@ -87,6 +87,17 @@ public:
     const void* data() const; // Does not detach
     void *data(); // detaches
 
+    // Converted data, shared between copies
+    enum SampleLayout {
+        Interleaved,
+        Planar
+    };
+
+    const float *constFloatData(SampleLayout layout = Interleaved) const;
+    const qint16 *constInt16Data(SampleLayout layout = Interleaved) const;
+    bool convertTo(float *destination, SampleLayout layout = Interleaved) const;
+    bool convertTo(qint16 *destination, SampleLayout layout = Interleaved) const;
+
     // Structures for easier access to stereo data
     template <typename T> struct StereoFrameDefault { enum { Default = 0 }; };
 
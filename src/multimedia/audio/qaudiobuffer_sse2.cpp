@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/qglobal.h>
+#include <private/qsimd_p.h>
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+
+QT_BEGIN_NAMESPACE
+
+void QT_FASTCALL qt_audio_deinterleave_stereo_float_sse2(const float *src, float *left, float *right, int frames)
+{
+    int i = 0;
+    for (; i < frames - 3; i += 4) {
+        const __m128 first = _mm_loadu_ps(src + 2 * i);
+        const __m128 second = _mm_loadu_ps(src + 2 * i + 4);
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    // leftovers
+    for (; i < frames; ++i) {
+        left[i] = src[2 * i];
+        right[i] = src[2 * i + 1];
+    }
+}
+
+void QT_FASTCALL qt_audio_deinterleave_stereo_S16_sse2(const qint16 *src, qint16 *left, qint16 *right, int frames)
+{
+    int i = 0;
+    for (; i < frames - 7; i += 8) {
+        // Each 32 bit lane holds a frame, left in the low half.
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * i));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * i + 8));
+        const __m128i leftSamples = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(first, 16), 16),
+                                                    _mm_srai_epi32(_mm_slli_epi32(second, 16), 16));
+        const __m128i rightSamples = _mm_packs_epi32(_mm_srai_epi32(first, 16),
+                                                     _mm_srai_epi32(second, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(left + i), leftSamples);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(right + i), rightSamples);
+    }
+
+    // leftovers
+    for (; i < frames; ++i) {
+        left[i] = src[2 * i];
+        right[i] = src[2 * i + 1];
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,529 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qaudioconvertingdevice_p.h"
+
+#include <QtCore/qbytearray.h>
+
+#include <limits.h>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Stands in for a backend that doesn't support the format the
+    application asked for. The backend is opened with the nearest format it
+    supports, and the audio is converted on its way to or from it.
+*/
+
+/*
+    Converts the audio read from or written to its target device.
+
+    When reading, at most as much input is read from the target as
+    converts to the requested length. When writing, the input is limited
+    by the room left in the output backend, if there is one, since the
+    converter consumes everything it is given. Converted audio the target
+    doesn't take is kept and written before any further input is accepted.
+*/
+class QAudioConvertingDevice : public QIODevice
+{
+public:
+    QAudioConvertingDevice(QAudioFormatConverter *converter, QIODevice *target,
+                           QAbstractAudioOutput *output, QObject *parent)
+        : QIODevice(parent)
+        , m_converter(converter)
+        , m_target(target)
+        , m_output(output)
+        , m_frameBytes(converter->inputFormat().bytesPerFrame())
+        , m_pending(0)
+    {
+        connect(target, &QIODevice::readyRead, this, &QIODevice::readyRead);
+    }
+
+    bool isSequential() const override
+    {
+        return true;
+    }
+
+    // Audio held back by the device, which the backend doesn't know about.
+    qint64 pendingUSecs() const
+    {
+        return m_converter->inputFormat().durationForBytes(m_pending)
+                + m_converter->outputFormat().durationForBytes(m_unwritten.size());
+    }
+
+    // Input read from the target but not converted yet.
+    int pendingBytes() const
+    {
+        return m_pending;
+    }
+
+    // Converted output the target hasn't taken yet.
+    int unwrittenBytes() const
+    {
+        return m_unwritten.size();
+    }
+
+    void clearPending()
+    {
+        m_pending = 0;
+        m_unwritten.clear();
+    }
+
+    qint64 bytesAvailable() const override
+    {
+        const qint64 available = m_pending + m_target->bytesAvailable();
+        return QIODevice::bytesAvailable() + m_converter->outputBytesFor(int(qMin<qint64>(available, INT_MAX)));
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        const int inputBytes = m_converter->inputBytesFor(int(qMin<qint64>(maxlen, INT_MAX)));
+        if (inputBytes <= m_pending)
+            return 0;
+
+        if (m_buffer.size() < inputBytes)
+            m_buffer.resize(inputBytes);
+
+        const qint64 read = m_target->read(m_buffer.data() + m_pending, inputBytes - m_pending);
+        if (read < 0)
+            return m_pending > 0 ? 0 : -1;
+
+        // A partial frame waits for the rest of it.
+        const int available = m_pending + int(read);
+        const int usable = available - available % m_frameBytes;
+        const int written = m_converter->convert(m_buffer.constData(), usable, data);
+        m_pending = available - usable;
+        if (m_pending > 0)
+            memmove(m_buffer.data(), m_buffer.constData() + usable, m_pending);
+
+        return written;
+    }
+
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        if (!m_unwritten.isEmpty()) {
+            const qint64 written = m_target->write(m_unwritten);
+            if (written < 0)
+                return -1;
+            m_unwritten.remove(0, int(written));
+            if (!m_unwritten.isEmpty())
+                return 0;
+        }
+
+        int inputBytes = int(qMin<qint64>(len, INT_MAX));
+        if (m_output)
+            inputBytes = qMin(inputBytes, m_converter->inputBytesFor(m_output->bytesFree()));
+        inputBytes -= inputBytes % m_frameBytes;
+        if (inputBytes <= 0)
+            return 0;
+
+        const int outputBytes = m_converter->outputBytesFor(inputBytes);
+        if (m_buffer.size() < outputBytes)
+            m_buffer.resize(outputBytes);
+
+        const int converted = m_converter->convert(data, inputBytes, m_buffer.data());
+        if (converted > 0) {
+            const qint64 written = m_target->write(m_buffer.constData(), converted);
+            if (written < 0)
+                return -1;
+
+            // The input is consumed either way, the rest goes out with the next write.
+            if (written < converted)
+                m_unwritten = QByteArray(m_buffer.constData() + written, converted - int(written));
+        }
+
+        return inputBytes;
+    }
+
+private:
+    QAudioFormatConverter *m_converter;
+    QIODevice *m_target;
+    QAbstractAudioOutput *m_output;
+    const int m_frameBytes;
+    int m_pending;
+    QByteArray m_buffer;
+    QByteArray m_unwritten;
+};
+
+static int convertedBytes(int bytes, const QAudioFormat &from, const QAudioFormat &to)
+{
+    return bytes > 0 ? to.bytesForDuration(from.durationForBytes(bytes)) : bytes;
+}
+
+static QAudioStatistics convertedStatistics(QObject *backend, const QAudioFormat &backendFormat,
+                                            const QAudioFormat &format, qint64 pendingUSecs)
+{
+    QAudioStatisticsExtension *extension = qobject_cast<QAudioStatisticsExtension *>(backend);
+    if (!extension)
+        return QAudioStatistics();
+
+    QAudioStatistics statistics = extension->statistics();
+    const qint64 bufferedUSecs = backendFormat.durationForBytes(statistics.bytesBuffered()) + pendingUSecs;
+    statistics.setBytesBuffered(format.bytesForDuration(bufferedUSecs));
+    if (statistics.latencyUSecs() >= 0)
+        statistics.setLatencyUSecs(statistics.latencyUSecs() + pendingUSecs);
+    return statistics;
+}
+
+QAudioConvertingOutput::QAudioConvertingOutput(QAbstractAudioOutput *backend, const QAudioFormat &format,
+                                               QAudioFormatConverter::Quality quality)
+    : m_backend(backend)
+    , m_quality(quality)
+{
+    m_backend->setParent(this);
+    setFormat(format);
+
+    connect(m_backend, &QAbstractAudioOutput::errorChanged, this, &QAbstractAudioOutput::errorChanged);
+    connect(m_backend, &QAbstractAudioOutput::stateChanged, this, &QAbstractAudioOutput::stateChanged);
+    connect(m_backend, &QAbstractAudioOutput::notify, this, &QAbstractAudioOutput::notify);
+}
+
+QAudioConvertingOutput::~QAudioConvertingOutput()
+{
+    // The backend might still be reading from the device.
+    delete m_backend;
+    delete m_device;
+}
+
+void QAudioConvertingOutput::start(QIODevice *device)
+{
+    closeDevice();
+    m_converter->reset();
+
+    m_device = new QAudioConvertingDevice(m_converter.data(), device, nullptr, this);
+    m_device->open(QIODevice::ReadOnly);
+    m_backend->start(m_device);
+}
+
+QIODevice *QAudioConvertingOutput::start()
+{
+    closeDevice();
+    m_converter->reset();
+
+    QIODevice *device = m_backend->start();
+    if (!device)
+        return nullptr;
+
+    m_device = new QAudioConvertingDevice(m_converter.data(), device, m_backend, this);
+    m_device->open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    return m_device;
+}
+
+void QAudioConvertingOutput::stop()
+{
+    m_backend->stop();
+    closeDevice();
+}
+
+void QAudioConvertingOutput::reset()
+{
+    m_backend->reset();
+    m_converter->reset();
+    if (m_device)
+        m_device->clearPending();
+}
+
+void QAudioConvertingOutput::suspend()
+{
+    m_backend->suspend();
+}
+
+void QAudioConvertingOutput::resume()
+{
+    m_backend->resume();
+}
+
+int QAudioConvertingOutput::bytesFree() const
+{
+    const int unwritten = m_device ? m_device->unwrittenBytes() : 0;
+    return m_converter->inputBytesFor(m_backend->bytesFree() - unwritten);
+}
+
+int QAudioConvertingOutput::periodSize() const
+{
+    return convertedBytes(m_backend->periodSize(), m_backend->format(), m_format);
+}
+
+void QAudioConvertingOutput::setBufferSize(int value)
+{
+    m_backend->setBufferSize(convertedBytes(value, m_format, m_backend->format()));
+}
+
+int QAudioConvertingOutput::bufferSize() const
+{
+    return convertedBytes(m_backend->bufferSize(), m_backend->format(), m_format);
+}
+
+void QAudioConvertingOutput::setNotifyInterval(int milliSeconds)
+{
+    m_backend->setNotifyInterval(milliSeconds);
+}
+
+int QAudioConvertingOutput::notifyInterval() const
+{
+    return m_backend->notifyInterval();
+}
+
+qint64 QAudioConvertingOutput::processedUSecs() const
+{
+    return m_backend->processedUSecs();
+}
+
+qint64 QAudioConvertingOutput::elapsedUSecs() const
+{
+    return m_backend->elapsedUSecs();
+}
+
+QAudio::Error QAudioConvertingOutput::error() const
+{
+    return m_backend->error();
+}
+
+QAudio::State QAudioConvertingOutput::state() const
+{
+    return m_backend->state();
+}
+
+void QAudioConvertingOutput::setFormat(const QAudioFormat &format)
+{
+    m_format = format;
+    m_converter.reset(new QAudioFormatConverter(m_format, m_backend->format(), m_quality));
+}
+
+QAudioFormat QAudioConvertingOutput::format() const
+{
+    return m_format;
+}
+
+void QAudioConvertingOutput::setVolume(qreal volume)
+{
+    m_backend->setVolume(volume);
+}
+
+qreal QAudioConvertingOutput::volume() const
+{
+    return m_backend->volume();
+}
+
+QString QAudioConvertingOutput::category() const
+{
+    return m_backend->category();
+}
+
+void QAudioConvertingOutput::setCategory(const QString &category)
+{
+    m_backend->setCategory(category);
+}
+
+QAudioStatistics QAudioConvertingOutput::statistics() const
+{
+    return convertedStatistics(m_backend, m_backend->format(), m_format,
+                               m_device ? m_device->pendingUSecs() : 0);
+}
+
+void QAudioConvertingOutput::closeDevice()
+{
+    // Could be called from a slot connected to the device.
+    if (m_device) {
+        m_device->close();
+        m_device->deleteLater();
+        m_device = nullptr;
+    }
+}
+
+QAudioConvertingInput::QAudioConvertingInput(QAbstractAudioInput *backend, const QAudioFormat &format,
+                                             QAudioFormatConverter::Quality quality)
+    : m_backend(backend)
+    , m_quality(quality)
+{
+    m_backend->setParent(this);
+    setFormat(format);
+
+    connect(m_backend, &QAbstractAudioInput::errorChanged, this, &QAbstractAudioInput::errorChanged);
+    connect(m_backend, &QAbstractAudioInput::stateChanged, this, &QAbstractAudioInput::stateChanged);
+    connect(m_backend, &QAbstractAudioInput::notify, this, &QAbstractAudioInput::notify);
+}
+
+QAudioConvertingInput::~QAudioConvertingInput()
+{
+    // The backend might still be writing to the device.
+    delete m_backend;
+    delete m_device;
+}
+
+void QAudioConvertingInput::start(QIODevice *device)
+{
+    closeDevice();
+    m_converter->reset();
+
+    m_device = new QAudioConvertingDevice(m_converter.data(), device, nullptr, this);
+    m_device->open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    m_backend->start(m_device);
+}
+
+QIODevice *QAudioConvertingInput::start()
+{
+    closeDevice();
+    m_converter->reset();
+
+    QIODevice *device = m_backend->start();
+    if (!device)
+        return nullptr;
+
+    m_device = new QAudioConvertingDevice(m_converter.data(), device, nullptr, this);
+    m_device->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    return m_device;
+}
+
+void QAudioConvertingInput::stop()
+{
+    m_backend->stop();
+    closeDevice();
+}
+
+void QAudioConvertingInput::reset()
+{
+    m_backend->reset();
+    m_converter->reset();
+    if (m_device)
+        m_device->clearPending();
+}
+
+void QAudioConvertingInput::suspend()
+{
+    m_backend->suspend();
+}
+
+void QAudioConvertingInput::resume()
+{
+    m_backend->resume();
+}
+
+int QAudioConvertingInput::bytesReady() const
+{
+    const int pending = m_device ? m_device->pendingBytes() : 0;
+    return m_converter->outputBytesFor(m_backend->bytesReady() + pending);
+}
+
+int QAudioConvertingInput::periodSize() const
+{
+    return convertedBytes(m_backend->periodSize(), m_backend->format(), m_format);
+}
+
+void QAudioConvertingInput::setBufferSize(int value)
+{
+    m_backend->setBufferSize(convertedBytes(value, m_format, m_backend->format()));
+}
+
+int QAudioConvertingInput::bufferSize() const
+{
+    return convertedBytes(m_backend->bufferSize(), m_backend->format(), m_format);
+}
+
+void QAudioConvertingInput::setNotifyInterval(int milliSeconds)
+{
+    m_backend->setNotifyInterval(milliSeconds);
+}
+
+int QAudioConvertingInput::notifyInterval() const
+{
+    return m_backend->notifyInterval();
+}
+
+qint64 QAudioConvertingInput::processedUSecs() const
+{
+    return m_backend->processedUSecs();
+}
+
+qint64 QAudioConvertingInput::elapsedUSecs() const
+{
+    return m_backend->elapsedUSecs();
+}
+
+QAudio::Error QAudioConvertingInput::error() const
+{
+    return m_backend->error();
+}
+
+QAudio::State QAudioConvertingInput::state() const
+{
+    return m_backend->state();
+}
+
+void QAudioConvertingInput::setFormat(const QAudioFormat &format)
+{
+    m_format = format;
+    m_converter.reset(new QAudioFormatConverter(m_backend->format(), m_format, m_quality));
+}
+
+QAudioFormat QAudioConvertingInput::format() const
+{
+    return m_format;
+}
+
+void QAudioConvertingInput::setVolume(qreal volume)
+{
+    m_backend->setVolume(volume);
+}
+
+qreal QAudioConvertingInput::volume() const
+{
+    return m_backend->volume();
+}
+
+QAudioStatistics QAudioConvertingInput::statistics() const
+{
+    return convertedStatistics(m_backend, m_backend->format(), m_format,
+                               m_device ? m_device->pendingUSecs() : 0);
+}
+
+void QAudioConvertingInput::closeDevice()
+{
+    // Could be called from a slot connected to the device.
+    if (m_device) {
+        m_device->close();
+        m_device->deleteLater();
+        m_device = nullptr;
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAUDIOCONVERTINGDEVICE_P_H
+#define QAUDIOCONVERTINGDEVICE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qaudiosystem.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qscopedpointer.h>
+
+#include "qaudioformatconverter_p.h"
+#include "qaudiosystempluginext_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QAudioConvertingDevice;
+
+class Q_MULTIMEDIA_EXPORT QAudioConvertingOutput : public QAbstractAudioOutput, public QAudioStatisticsExtension
+{
+    Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
+public:
+    QAudioConvertingOutput(QAbstractAudioOutput *backend, const QAudioFormat &format,
+                           QAudioFormatConverter::Quality quality);
+    ~QAudioConvertingOutput();
+
+    void start(QIODevice *device) override;
+    QIODevice *start() override;
+    void stop() override;
+    void reset() override;
+    void suspend() override;
+    void resume() override;
+    int bytesFree() const override;
+    int periodSize() const override;
+    void setBufferSize(int value) override;
+    int bufferSize() const override;
+    void setNotifyInterval(int milliSeconds) override;
+    int notifyInterval() const override;
+    qint64 processedUSecs() const override;
+    qint64 elapsedUSecs() const override;
+    QAudio::Error error() const override;
+    QAudio::State state() const override;
+    void setFormat(const QAudioFormat &format) override;
+    QAudioFormat format() const override;
+    void setVolume(qreal volume) override;
+    qreal volume() const override;
+    QString category() const override;
+    void setCategory(const QString &category) override;
+    QAudioStatistics statistics() const override;
+
+private:
+    void closeDevice();
+
+    QAbstractAudioOutput *m_backend;
+    QAudioFormat m_format;
+    QAudioFormatConverter::Quality m_quality;
+    QScopedPointer<QAudioFormatConverter> m_converter;
+    QPointer<QAudioConvertingDevice> m_device;
+};
+
+class Q_MULTIMEDIA_EXPORT QAudioConvertingInput : public QAbstractAudioInput, public QAudioStatisticsExtension
+{
+    Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
+public:
+    QAudioConvertingInput(QAbstractAudioInput *backend, const QAudioFormat &format,
+                          QAudioFormatConverter::Quality quality);
+    ~QAudioConvertingInput();
+
+    void start(QIODevice *device) override;
+    QIODevice *start() override;
+    void stop() override;
+    void reset() override;
+    void suspend() override;
+    void resume() override;
+    int bytesReady() const override;
+    int periodSize() const override;
+    void setBufferSize(int value) override;
+    int bufferSize() const override;
+    void setNotifyInterval(int milliSeconds) override;
+    int notifyInterval() const override;
+    qint64 processedUSecs() const override;
+    qint64 elapsedUSecs() const override;
+    QAudio::Error error() const override;
+    QAudio::State state() const override;
+    void setFormat(const QAudioFormat &format) override;
+    QAudioFormat format() const override;
+    void setVolume(qreal volume) override;
+    qreal volume() const override;
+    QAudioStatistics statistics() const override;
+
+private:
+    void closeDevice();
+
+    QAbstractAudioInput *m_backend;
+    QAudioFormat m_format;
+    QAudioFormatConverter::Quality m_quality;
+    QScopedPointer<QAudioFormatConverter> m_converter;
+    QPointer<QAudioConvertingDevice> m_device;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOCONVERTINGDEVICE_P_H
@@ -45,6 +45,7 @@
 
 #include "qmediapluginloader_p.h"
 #include "qaudiodevicefactory_p.h"
+#include "qaudioconvertingdevice_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -56,6 +57,22 @@ static QString defaultKey()
 #if !defined (QT_NO_LIBRARY) && !defined(QT_NO_SETTINGS)
 Q_GLOBAL_STATIC_WITH_ARGS(QMediaPluginLoader, audioLoader,
         (QAudioSystemFactoryInterface_iid, QLatin1String("audio"), Qt::CaseInsensitive))
+
+/*
+    Returns the format to open the device with. Formats the device doesn't
+    support are converted from or to the nearest one it does.
+*/
+static QAudioFormat deviceFormat(const QAudioDeviceInfo &deviceInfo, const QAudioFormat &format)
+{
+    if (deviceInfo.isFormatSupported(format))
+        return format;
+
+    const QAudioFormat nearest = deviceInfo.nearestFormat(format);
+    if (nearest.isValid() && QAudioFormatConverter::canConvert(format, nearest))
+        return nearest;
+
+    return format;
+}
 #endif
 
 class QNullDeviceInfo : public QAbstractAudioDeviceInfo
@@ -228,7 +245,12 @@ QAbstractAudioInput* QAudioDeviceFactory::createInputDevice(QAudioDeviceInfo con
 
     if (plugin) {
         QAbstractAudioInput* p = plugin->createInput(deviceInfo.handle());
-        if (p) p->setFormat(format);
+        if (p) {
+            const QAudioFormat nativeFormat = deviceFormat(deviceInfo, format);
+            p->setFormat(nativeFormat);
+            if (nativeFormat != format)
+                return new QAudioConvertingInput(p, format, QAudioFormatConverter::defaultQuality());
+        }
         return p;
     }
 #endif
@@ -247,7 +269,12 @@ QAbstractAudioOutput* QAudioDeviceFactory::createOutputDevice(QAudioDeviceInfo c
 
     if (plugin) {
         QAbstractAudioOutput* p = plugin->createOutput(deviceInfo.handle());
-        if (p) p->setFormat(format);
+        if (p) {
+            const QAudioFormat nativeFormat = deviceFormat(deviceInfo, format);
+            p->setFormat(nativeFormat);
+            if (nativeFormat != format)
+                return new QAudioConvertingOutput(p, format, QAudioFormatConverter::defaultQuality());
+        }
         return p;
     }
 #endif
@@ -0,0 +1,821 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qaudioformatconverter_p.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qmath.h>
+#include <private/qsimd_p.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Converts interleaved PCM between two formats: sample type and size,
+    byte order, channel layout and sample rate.
+
+    Samples are decoded to float, remixed with a channel matrix into one
+    plane per output channel, resampled with a polyphase windowed-sinc
+    filter and encoded again. The work is done in chunks of ChunkFrames
+    frames, so all scratch memory is allocated in the constructor and
+    convert() doesn't allocate.
+
+    Input is always consumed entirely; the last few frames are kept as
+    filter history and only come out once more input arrives.
+*/
+
+typedef void (QT_FASTCALL *AudioToFloatFunc)(const void *src, float *dst, int count);
+typedef void (QT_FASTCALL *AudioFromFloatFunc)(const float *src, void *dst, int count);
+typedef float (QT_FASTCALL *AudioDotProductFunc)(const float *a, const float *b, int count);
+
+static const int ChunkFrames = 1024;
+static const int MaxPhases = 256;
+static const int MaxTaps = 256;
+
+static void QT_FASTCALL qt_audio_convert_S16_to_float(const void *src, float *dst, int count)
+{
+    const qint16 *s = static_cast<const qint16 *>(src);
+    for (int i = 0; i < count; ++i)
+        dst[i] = s[i] * (1.0f / 32768.0f);
+}
+
+static void QT_FASTCALL qt_audio_convert_float_to_S16(const float *src, void *dst, int count)
+{
+    qint16 *d = static_cast<qint16 *>(dst);
+    for (int i = 0; i < count; ++i)
+        d[i] = qint16(qBound(-32768, qRound(qBound(-1.0f, src[i], 1.0f) * 32768.0f), 32767));
+}
+
+static float QT_FASTCALL qt_audio_dot_product(const float *a, const float *b, int count)
+{
+    float sum = 0;
+    for (int i = 0; i < count; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+extern void QT_FASTCALL qt_audio_convert_S16_to_float_sse2(const void *src, float *dst, int count);
+extern void QT_FASTCALL qt_audio_convert_float_to_S16_sse2(const float *src, void *dst, int count);
+extern float QT_FASTCALL qt_audio_dot_product_sse2(const float *a, const float *b, int count);
+#endif
+
+namespace {
+
+struct QAudioConvertFuncs
+{
+    QAudioConvertFuncs()
+        : s16ToFloat(qt_audio_convert_S16_to_float)
+        , floatToS16(qt_audio_convert_float_to_S16)
+        , dotProduct(qt_audio_dot_product)
+    {
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+        if (qCpuHasFeature(SSE2)) {
+            s16ToFloat = qt_audio_convert_S16_to_float_sse2;
+            floatToS16 = qt_audio_convert_float_to_S16_sse2;
+            dotProduct = qt_audio_dot_product_sse2;
+        }
+#endif
+    }
+
+    AudioToFloatFunc s16ToFloat;
+    AudioFromFloatFunc floatToS16;
+    AudioDotProductFunc dotProduct;
+};
+
+}
+
+static const QAudioConvertFuncs &audioConvertFuncs()
+{
+    static const QAudioConvertFuncs funcs;
+    return funcs;
+}
+
+static bool isHostEndian(const QAudioFormat &format)
+{
+    return format.byteOrder() == QAudioFormat::Endian(QSysInfo::ByteOrder);
+}
+
+static bool isConvertible(const QAudioFormat &format)
+{
+    if (!format.isValid() || format.codec() != QLatin1String("audio/pcm"))
+        return false;
+
+    switch (format.sampleType()) {
+    case QAudioFormat::SignedInt:
+    case QAudioFormat::UnSignedInt:
+        return format.sampleSize() == 8 || format.sampleSize() == 16
+                || format.sampleSize() == 24 || format.sampleSize() == 32;
+    case QAudioFormat::Float:
+        return format.sampleSize() == 32;
+    default:
+        return false;
+    }
+}
+
+/*
+    Channels follow the WAVE order: front left, front right, front center,
+    LFE, back left, back right, side left, side right. Four channels are
+    taken as quadraphonic, front and back pairs.
+*/
+static QVector<float> defaultChannelMatrix(int inputChannels, int outputChannels)
+{
+    QVector<float> matrix(inputChannels * outputChannels, 0.0f);
+
+    if (inputChannels == 1) {
+        // Mono goes to both front speakers.
+        for (int out = 0; out < qMin(outputChannels, 2); ++out)
+            matrix[out * inputChannels] = 1.0f;
+    } else if (outputChannels <= 2 && inputChannels > outputChannels) {
+        static const float centerGain = float(M_SQRT1_2);
+        for (int in = 0; in < inputChannels; ++in) {
+            float left = 0;
+            float right = 0;
+            if (inputChannels == 4) {
+                left = in % 2 == 0 ? 1.0f : 0.0f;
+                right = 1.0f - left;
+            } else {
+                switch (in) {
+                case 0: left = 1.0f; break;
+                case 1: right = 1.0f; break;
+                case 2: left = right = centerGain; break;
+                case 3: break; // LFE is dropped
+                case 4: case 6: left = centerGain; break;
+                case 5: case 7: right = centerGain; break;
+                default: break;
+                }
+            }
+            if (outputChannels == 1) {
+                matrix[in] = left + right;
+            } else {
+                matrix[in] = left;
+                matrix[inputChannels + in] = right;
+            }
+        }
+
+        // Scale each output so that it can't clip.
+        for (int out = 0; out < outputChannels; ++out) {
+            float sum = 0;
+            for (int in = 0; in < inputChannels; ++in)
+                sum += matrix[out * inputChannels + in];
+            if (sum > 0) {
+                for (int in = 0; in < inputChannels; ++in)
+                    matrix[out * inputChannels + in] /= sum;
+            }
+        }
+    } else {
+        for (int channel = 0; channel < qMin(inputChannels, outputChannels); ++channel)
+            matrix[channel * inputChannels + channel] = 1.0f;
+    }
+
+    return matrix;
+}
+
+static int greatestCommonDivisor(int a, int b)
+{
+    while (b) {
+        const int remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+static double sinc(double x)
+{
+    return qFuzzyIsNull(x) ? 1.0 : qSin(M_PI * x) / (M_PI * x);
+}
+
+class QAudioFormatConverterPrivate
+{
+public:
+    QAudioFormatConverterPrivate(const QAudioFormat &in, const QAudioFormat &out,
+                                 QAudioFormatConverter::Quality q);
+
+    void setMatrix(const QVector<float> &matrix);
+    void createFilter();
+    void reset();
+
+    qint64 outputFramesFor(qint64 inputFrames) const;
+    qint64 inputFramesFor(qint64 outputFrames) const;
+
+    void remix(const float *src, int frames, float *dst, int stride) const;
+    void interleave(const float *src, int frames, int stride, float *dst) const;
+    int resample();
+
+    QAudioFormat inputFormat;
+    QAudioFormat outputFormat;
+    QAudioFormatConverter::Quality quality;
+    bool valid;
+    bool passthrough;
+
+    int inputChannels;
+    int outputChannels;
+    int inputFrameBytes;
+    int outputFrameBytes;
+
+    AudioDotProductFunc dotProduct;
+
+    QVector<float> matrix;
+    bool identityMatrix;
+
+    // Resampling by up / down, both reduced by their gcd.
+    bool resampling;
+    int up;
+    int down;
+    int taps;
+    int phases;
+    QVector<float> filter;
+
+    // Read position in the history, whole frames plus phase / up.
+    int index;
+    int phase;
+
+    QVector<float> history;
+    int historyStride;
+    int historyFrames;
+
+    QVector<float> resampled;
+    int resampledStride;
+
+    QVector<float> planar;
+    QVector<float> interleaved;
+};
+
+QAudioFormatConverterPrivate::QAudioFormatConverterPrivate(const QAudioFormat &in,
+                                                           const QAudioFormat &out,
+                                                           QAudioFormatConverter::Quality q)
+    : inputFormat(in)
+    , outputFormat(out)
+    , quality(q)
+    , valid(QAudioFormatConverter::canConvert(in, out))
+    , passthrough(false)
+    , inputChannels(in.channelCount())
+    , outputChannels(out.channelCount())
+    , inputFrameBytes(in.bytesPerFrame())
+    , outputFrameBytes(out.bytesPerFrame())
+    , dotProduct(nullptr)
+    , identityMatrix(false)
+    , resampling(false)
+    , up(1)
+    , down(1)
+    , taps(0)
+    , phases(0)
+    , index(0)
+    , phase(0)
+    , historyStride(0)
+    , historyFrames(0)
+    , resampledStride(0)
+{
+    if (!valid)
+        return;
+
+    dotProduct = audioConvertFuncs().dotProduct;
+
+    if (in.sampleRate() != out.sampleRate()) {
+        resampling = true;
+        const int divisor = greatestCommonDivisor(in.sampleRate(), out.sampleRate());
+        up = out.sampleRate() / divisor;
+        down = in.sampleRate() / divisor;
+        createFilter();
+
+        historyStride = taps - 1 + ChunkFrames;
+        history.resize(outputChannels * historyStride);
+        resampledStride = int((qint64(ChunkFrames) * up + down - 1) / down) + 1;
+        resampled.resize(outputChannels * resampledStride);
+    }
+
+    planar.resize(outputChannels * ChunkFrames);
+    interleaved.resize(qMax(inputChannels, outputChannels) * qMax(ChunkFrames, resampledStride));
+
+    setMatrix(defaultChannelMatrix(inputChannels, outputChannels));
+    reset();
+}
+
+void QAudioFormatConverterPrivate::setMatrix(const QVector<float> &m)
+{
+    matrix = m;
+
+    identityMatrix = inputChannels == outputChannels;
+    for (int out = 0; identityMatrix && out < outputChannels; ++out) {
+        for (int in = 0; in < inputChannels; ++in) {
+            if (matrix.at(out * inputChannels + in) != (in == out ? 1.0f : 0.0f)) {
+                identityMatrix = false;
+                break;
+            }
+        }
+    }
+
+    passthrough = identityMatrix && !resampling && inputFormat == outputFormat;
+}
+
+void QAudioFormatConverterPrivate::createFilter()
+{
+    double rolloff = 1.0;
+    switch (quality) {
+    case QAudioFormatConverter::FastQuality:
+        taps = 2;
+        break;
+    case QAudioFormatConverter::MediumQuality:
+        taps = 16;
+        rolloff = 0.9;
+        break;
+    case QAudioFormatConverter::HighQuality:
+        taps = 48;
+        rolloff = 0.95;
+        break;
+    }
+
+    // Downsampling lowers the cutoff, which takes a proportionally longer filter.
+    if (quality != QAudioFormatConverter::FastQuality && down > up)
+        taps = qMin(MaxTaps, (taps * down + up - 1) / up + 1) & ~1;
+
+    phases = qMin(up, MaxPhases);
+    filter.resize(phases * taps);
+
+    const double cutoff = 0.5 * qMin(1.0, double(up) / down) * rolloff;
+    const double halfLength = taps / 2;
+
+    for (int p = 0; p < phases; ++p) {
+        float *coefficients = filter.data() + p * taps;
+        const double fraction = double(p) / phases;
+        double sum = 0;
+
+        for (int k = 0; k < taps; ++k) {
+            const double x = k - (halfLength - 1) - fraction;
+            const double t = x / halfLength;
+            double value;
+            switch (quality) {
+            case QAudioFormatConverter::FastQuality:
+                value = qMax(0.0, 1.0 - qAbs(x));
+                break;
+            case QAudioFormatConverter::MediumQuality:
+                // Blackman
+                value = 2 * cutoff * sinc(2 * cutoff * x)
+                        * (0.42 + 0.5 * qCos(M_PI * t) + 0.08 * qCos(2 * M_PI * t));
+                break;
+            case QAudioFormatConverter::HighQuality:
+            default:
+                // Blackman-Harris
+                value = 2 * cutoff * sinc(2 * cutoff * x)
+                        * (0.35875 + 0.48829 * qCos(M_PI * t) + 0.14128 * qCos(2 * M_PI * t)
+                           + 0.01168 * qCos(3 * M_PI * t));
+                break;
+            }
+            coefficients[k] = float(value);
+            sum += value;
+        }
+
+        // Unity gain at DC for every phase, or the output would ripple.
+        if (sum > 0) {
+            for (int k = 0; k < taps; ++k)
+                coefficients[k] = float(coefficients[k] / sum);
+        }
+    }
+}
+
+void QAudioFormatConverterPrivate::reset()
+{
+    index = 0;
+    phase = 0;
+
+    // Center the filter on the first input frame.
+    historyFrames = resampling ? taps / 2 - 1 : 0;
+    history.fill(0.0f);
+}
+
+qint64 QAudioFormatConverterPrivate::outputFramesFor(qint64 inputFrames) const
+{
+    if (!resampling)
+        return inputFrames;
+
+    const qint64 available = historyFrames + inputFrames - index - taps + 1;
+    if (available <= 0)
+        return 0;
+
+    // One frame is produced for every n with phase + n * down < available * up.
+    return (available * up - phase + down - 1) / down;
+}
+
+qint64 QAudioFormatConverterPrivate::inputFramesFor(qint64 outputFrames) const
+{
+    if (!resampling)
+        return outputFrames;
+
+    // The inverse of outputFramesFor(), rounded down.
+    const qint64 available = (outputFrames * down + phase) / up;
+    return qMax<qint64>(0, available + index + taps - 1 - historyFrames);
+}
+
+static inline quint32 readSample(const uchar *src, int bytes, bool bigEndian)
+{
+    switch (bytes) {
+    case 1:
+        return src[0];
+    case 2:
+        return bigEndian ? qFromBigEndian<quint16>(src) : qFromLittleEndian<quint16>(src);
+    case 3:
+        return bigEndian ? quint32(src[0] << 16 | src[1] << 8 | src[2])
+                         : quint32(src[2] << 16 | src[1] << 8 | src[0]);
+    default:
+        return bigEndian ? qFromBigEndian<quint32>(src) : qFromLittleEndian<quint32>(src);
+    }
+}
+
+static inline void writeSample(quint32 value, uchar *dst, int bytes, bool bigEndian)
+{
+    switch (bytes) {
+    case 1:
+        dst[0] = uchar(value);
+        break;
+    case 2:
+        if (bigEndian)
+            qToBigEndian<quint16>(quint16(value), dst);
+        else
+            qToLittleEndian<quint16>(quint16(value), dst);
+        break;
+    case 3:
+        dst[bigEndian ? 0 : 2] = uchar(value >> 16);
+        dst[1] = uchar(value >> 8);
+        dst[bigEndian ? 2 : 0] = uchar(value);
+        break;
+    default:
+        if (bigEndian)
+            qToBigEndian<quint32>(value, dst);
+        else
+            qToLittleEndian<quint32>(value, dst);
+        break;
+    }
+}
+
+static bool isHostInt16(const QAudioFormat &format)
+{
+    return format.sampleSize() == 16 && format.sampleType() == QAudioFormat::SignedInt
+            && isHostEndian(format);
+}
+
+static void decode(const QAudioFormat &format, const uchar *src, float *dst, int count)
+{
+    if (isHostInt16(format)) {
+        audioConvertFuncs().s16ToFloat(src, dst, count);
+        return;
+    }
+
+    const int bytes = format.sampleSize() / 8;
+    const bool bigEndian = format.byteOrder() == QAudioFormat::BigEndian;
+
+    if (format.sampleType() == QAudioFormat::Float) {
+        if (isHostEndian(format)) {
+            memcpy(dst, src, count * sizeof(float));
+            return;
+        }
+        for (int i = 0; i < count; ++i, src += bytes) {
+            const quint32 bits = readSample(src, bytes, bigEndian);
+            memcpy(dst + i, &bits, sizeof(float));
+        }
+        return;
+    }
+
+    // Flipping the sign bit turns unsigned samples into signed ones.
+    const int bits = bytes * 8;
+    const quint32 signBit = format.sampleType() == QAudioFormat::UnSignedInt ? 1u << (bits - 1) : 0;
+    const float scale = float(1.0 / (1u << (bits - 1)));
+
+    for (int i = 0; i < count; ++i, src += bytes) {
+        const quint32 value = (readSample(src, bytes, bigEndian) ^ signBit) << (32 - bits);
+        dst[i] = float(qint32(value) >> (32 - bits)) * scale;
+    }
+}
+
+static void encode(const float *src, const QAudioFormat &format, uchar *dst, int count)
+{
+    if (isHostInt16(format)) {
+        audioConvertFuncs().floatToS16(src, dst, count);
+        return;
+    }
+
+    const int bytes = format.sampleSize() / 8;
+    const bool bigEndian = format.byteOrder() == QAudioFormat::BigEndian;
+
+    if (format.sampleType() == QAudioFormat::Float) {
+        if (isHostEndian(format)) {
+            memcpy(dst, src, count * sizeof(float));
+            return;
+        }
+        for (int i = 0; i < count; ++i, dst += bytes) {
+            quint32 bits;
+            memcpy(&bits, src + i, sizeof(float));
+            writeSample(bits, dst, bytes, bigEndian);
+        }
+        return;
+    }
+
+    const int bits = bytes * 8;
+    const quint32 signBit = format.sampleType() == QAudioFormat::UnSignedInt ? 1u << (bits - 1) : 0;
+    const double scale = double(1u << (bits - 1));
+    const qint64 maximum = (qint64(1) << (bits - 1)) - 1;
+
+    for (int i = 0; i < count; ++i, dst += bytes) {
+        const qint64 value = qBound(-maximum - 1, qRound64(qBound(-1.0, double(src[i]), 1.0) * scale), maximum);
+        writeSample(quint32(value) ^ signBit, dst, bytes, bigEndian);
+    }
+}
+
+void QAudioFormatConverterPrivate::remix(const float *src, int frames, float *dst, int stride) const
+{
+    if (identityMatrix) {
+        for (int channel = 0; channel < outputChannels; ++channel) {
+            float *plane = dst + channel * stride;
+            for (int frame = 0; frame < frames; ++frame)
+                plane[frame] = src[frame * inputChannels + channel];
+        }
+        return;
+    }
+
+    const float *m = matrix.constData();
+    for (int frame = 0; frame < frames; ++frame, src += inputChannels) {
+        for (int out = 0; out < outputChannels; ++out) {
+            const float *row = m + out * inputChannels;
+            float sum = 0;
+            for (int in = 0; in < inputChannels; ++in)
+                sum += row[in] * src[in];
+            dst[out * stride + frame] = sum;
+        }
+    }
+}
+
+void QAudioFormatConverterPrivate::interleave(const float *src, int frames, int stride, float *dst) const
+{
+    if (outputChannels == 1) {
+        memcpy(dst, src, frames * sizeof(float));
+        return;
+    }
+
+    for (int channel = 0; channel < outputChannels; ++channel) {
+        const float *plane = src + channel * stride;
+        for (int frame = 0; frame < frames; ++frame)
+            dst[frame * outputChannels + channel] = plane[frame];
+    }
+}
+
+int QAudioFormatConverterPrivate::resample()
+{
+    int produced = 0;
+
+    while (index + taps <= historyFrames) {
+        const int p = phases == up ? phase : int(qint64(phase) * phases / up);
+        const float *coefficients = filter.constData() + p * taps;
+        for (int channel = 0; channel < outputChannels; ++channel) {
+            resampled[channel * resampledStride + produced]
+                    = dotProduct(history.constData() + channel * historyStride + index, coefficients, taps);
+        }
+        ++produced;
+
+        phase += down;
+        index += phase / up;
+        phase %= up;
+    }
+
+    // Drop what the filter has moved past.
+    const int consumed = qMin(index, historyFrames);
+    if (consumed > 0) {
+        for (int channel = 0; channel < outputChannels; ++channel) {
+            float *plane = history.data() + channel * historyStride;
+            memmove(plane, plane + consumed, (historyFrames - consumed) * sizeof(float));
+        }
+        historyFrames -= consumed;
+        index -= consumed;
+    }
+
+    return produced;
+}
+
+/*!
+    \class QAudioFormatConverter
+    \internal
+
+    Converts PCM audio from one QAudioFormat to another, for backends
+    that can't handle the format the application asked for.
+*/
+
+QAudioFormatConverter::QAudioFormatConverter(const QAudioFormat &inputFormat,
+                                             const QAudioFormat &outputFormat,
+                                             Quality quality)
+    : d(new QAudioFormatConverterPrivate(inputFormat, outputFormat, quality))
+{
+}
+
+QAudioFormatConverter::~QAudioFormatConverter()
+{
+    delete d;
+}
+
+/*!
+    Returns true if PCM in \a inputFormat can be converted to \a outputFormat.
+*/
+bool QAudioFormatConverter::canConvert(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat)
+{
+    return isConvertible(inputFormat) && isConvertible(outputFormat);
+}
+
+/*!
+    Returns the quality set in the QT_AUDIO_CONVERSION_QUALITY environment
+    variable, which can be \c fast, \c medium or \c high. Defaults to
+    MediumQuality.
+*/
+QAudioFormatConverter::Quality QAudioFormatConverter::defaultQuality()
+{
+    const QByteArray quality = qgetenv("QT_AUDIO_CONVERSION_QUALITY").toLower();
+    if (quality == "fast")
+        return FastQuality;
+    if (quality == "high")
+        return HighQuality;
+    return MediumQuality;
+}
+
+bool QAudioFormatConverter::isValid() const
+{
+    return d->valid;
+}
+
+/*!
+    Returns true if the input is copied to the output as is.
+*/
+bool QAudioFormatConverter::isPassthrough() const
+{
+    return d->passthrough;
+}
+
+QAudioFormat QAudioFormatConverter::inputFormat() const
+{
+    return d->inputFormat;
+}
+
+QAudioFormat QAudioFormatConverter::outputFormat() const
+{
+    return d->outputFormat;
+}
+
+QAudioFormatConverter::Quality QAudioFormatConverter::quality() const
+{
+    return d->quality;
+}
+
+/*!
+    Returns the channel matrix, one row of input channel gains for each
+    output channel.
+*/
+QVector<float> QAudioFormatConverter::channelMatrix() const
+{
+    return d->matrix;
+}
+
+/*!
+    Sets the channel \a matrix. It must have a row of input channel gains
+    for each output channel, other sizes are ignored.
+*/
+void QAudioFormatConverter::setChannelMatrix(const QVector<float> &matrix)
+{
+    if (!d->valid || matrix.size() != d->inputChannels * d->outputChannels) {
+        qWarning("QAudioFormatConverter: channel matrix of size %d, expected %d",
+                 matrix.size(), d->inputChannels * d->outputChannels);
+        return;
+    }
+
+    d->setMatrix(matrix);
+}
+
+/*!
+    Returns the number of bytes convert() writes for \a inputBytes of input.
+*/
+int QAudioFormatConverter::outputBytesFor(int inputBytes) const
+{
+    if (!d->valid || inputBytes <= 0)
+        return 0;
+
+    return int(d->outputFramesFor(inputBytes / d->inputFrameBytes) * d->outputFrameBytes);
+}
+
+/*!
+    Returns the largest amount of input, in bytes, that converts to no more
+    than \a outputBytes.
+*/
+int QAudioFormatConverter::inputBytesFor(int outputBytes) const
+{
+    if (!d->valid || outputBytes <= 0)
+        return 0;
+
+    return int(d->inputFramesFor(outputBytes / d->outputFrameBytes) * d->inputFrameBytes);
+}
+
+/*!
+    Converts the whole frames in the \a inputBytes at \a input and writes
+    them to \a output, which must have room for outputBytesFor(\a inputBytes).
+    Returns the number of bytes written.
+*/
+int QAudioFormatConverter::convert(const void *input, int inputBytes, void *output)
+{
+    if (!d->valid || inputBytes <= 0)
+        return 0;
+
+    int frames = inputBytes / d->inputFrameBytes;
+
+    if (d->passthrough) {
+        memcpy(output, input, frames * d->inputFrameBytes);
+        return frames * d->inputFrameBytes;
+    }
+
+    const uchar *src = static_cast<const uchar *>(input);
+    uchar *dst = static_cast<uchar *>(output);
+    float *interleaved = d->interleaved.data();
+
+    while (frames > 0) {
+        const int chunk = qMin(frames, ChunkFrames);
+        decode(d->inputFormat, src, interleaved, chunk * d->inputChannels);
+
+        int produced = chunk;
+        if (d->resampling) {
+            d->remix(interleaved, chunk, d->history.data() + d->historyFrames, d->historyStride);
+            d->historyFrames += chunk;
+            produced = d->resample();
+            d->interleave(d->resampled.constData(), produced, d->resampledStride, interleaved);
+        } else if (!d->identityMatrix) {
+            d->remix(interleaved, chunk, d->planar.data(), ChunkFrames);
+            d->interleave(d->planar.constData(), chunk, ChunkFrames, interleaved);
+        }
+
+        encode(interleaved, d->outputFormat, dst, produced * d->outputChannels);
+
+        src += chunk * d->inputFrameBytes;
+        dst += produced * d->outputFrameBytes;
+        frames -= chunk;
+    }
+
+    return int(dst - static_cast<uchar *>(output));
+}
+
+/*!
+    Converts \a sampleCount samples at \a input, in \a format, to floats
+    between -1 and 1 at \a output. The format must be one canConvert() accepts.
+*/
+void QAudioFormatConverter::toFloat(const QAudioFormat &format, const void *input, float *output, int sampleCount)
+{
+    decode(format, static_cast<const uchar *>(input), output, sampleCount);
+}
+
+/*!
+    Converts \a sampleCount floats at \a input to samples in \a format at
+    \a output, clipping them to the range of the format.
+*/
+void QAudioFormatConverter::fromFloat(const float *input, const QAudioFormat &format, void *output, int sampleCount)
+{
+    encode(input, format, static_cast<uchar *>(output), sampleCount);
+}
+
+/*!
+    Drops the filter history, to start over with unrelated input.
+*/
+void QAudioFormatConverter::reset()
+{
+    d->reset();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAUDIOFORMATCONVERTER_P_H
+#define QAUDIOFORMATCONVERTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <qaudioformat.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QAudioFormatConverterPrivate;
+
+class Q_MULTIMEDIA_EXPORT QAudioFormatConverter
+{
+public:
+    enum Quality
+    {
+        FastQuality,
+        MediumQuality,
+        HighQuality
+    };
+
+    QAudioFormatConverter(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat,
+                          Quality quality = MediumQuality);
+    ~QAudioFormatConverter();
+
+    static bool canConvert(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat);
+    static Quality defaultQuality();
+
+    static void toFloat(const QAudioFormat &format, const void *input, float *output, int sampleCount);
+    static void fromFloat(const float *input, const QAudioFormat &format, void *output, int sampleCount);
+
+    bool isValid() const;
+    bool isPassthrough() const;
+
+    QAudioFormat inputFormat() const;
+    QAudioFormat outputFormat() const;
+    Quality quality() const;
+
+    QVector<float> channelMatrix() const;
+    void setChannelMatrix(const QVector<float> &matrix);
+
+    int outputBytesFor(int inputBytes) const;
+    int inputBytesFor(int outputBytes) const;
+
+    int convert(const void *input, int inputBytes, void *output);
+    void reset();
+
+private:
+    Q_DISABLE_COPY(QAudioFormatConverter)
+    QAudioFormatConverterPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOFORMATCONVERTER_P_H
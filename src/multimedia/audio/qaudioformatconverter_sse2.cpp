@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/qglobal.h>
+#include <private/qsimd_p.h>
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+
+QT_BEGIN_NAMESPACE
+
+void QT_FASTCALL qt_audio_convert_S16_to_float_sse2(const void *src, float *dst, int count)
+{
+    const qint16 *s = static_cast<const qint16 *>(src);
+    const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        // Unpacking a register with itself and shifting back sign-extends to 32 bits.
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+
+    // leftovers
+    for (; i < count; ++i)
+        dst[i] = s[i] * (1.0f / 32768.0f);
+}
+
+void QT_FASTCALL qt_audio_convert_float_to_S16_sse2(const float *src, void *dst, int count)
+{
+    qint16 *d = static_cast<qint16 *>(dst);
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 minimum = _mm_set1_ps(-1.0f);
+    const __m128 maximum = _mm_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        // Clamped first, out of range values would convert to INT_MIN. The pack saturates 32768.
+        const __m128 low = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minimum), maximum);
+        const __m128 high = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minimum), maximum);
+        const __m128i samples = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(low, scale)),
+                                                _mm_cvtps_epi32(_mm_mul_ps(high, scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), samples);
+    }
+
+    // leftovers
+    for (; i < count; ++i)
+        d[i] = qint16(qBound(-32768, qRound(qBound(-1.0f, src[i], 1.0f) * 32768.0f), 32767));
+}
+
+float QT_FASTCALL qt_audio_dot_product_sse2(const float *a, const float *b, int count)
+{
+    __m128 sum = _mm_setzero_ps();
+
+    int i = 0;
+    for (; i < count - 3; i += 4)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+    // Horizontal add of the four partial sums.
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+    float result = _mm_cvtss_f32(sum);
+
+    // leftovers
+    for (; i < count; ++i)
+        result += a[i] * b[i];
+
+    return result;
+}
+
+QT_END_NAMESPACE
+
+#endif
@@ -44,6 +44,7 @@
 #include "qaudioinput.h"
 
 #include "qaudiodevicefactory_p.h"
+#include "qaudiosystempluginext_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -358,6 +359,23 @@ qreal QAudioInput::volume() const
     return d->volume();
 }
 
+/*!
+    \since 5.13
+
+    Returns a snapshot of the latency, fill level, overrun count and callback
+    jitter of the input. The counters are reset by start().
+
+    Values the audio backend doesn't measure are left at their defaults.
+
+    \sa QAudioStatistics
+*/
+QAudioStatistics QAudioInput::statistics() const
+{
+    if (QAudioStatisticsExtension *extension = qobject_cast<QAudioStatisticsExtension *>(d))
+        return extension->statistics();
+    return QAudioStatistics();
+}
+
 /*!
     Returns the amount of audio data processed since start()
     was called in microseconds.
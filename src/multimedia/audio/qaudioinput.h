@@ -49,6 +49,7 @@
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudioformat.h>
 #include <QtMultimedia/qaudiodeviceinfo.h>
+#include <QtMultimedia/qaudiostatistics.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -88,6 +89,8 @@ public:
     void setVolume(qreal volume);
     qreal volume() const;
 
+    QAudioStatistics statistics() const;
+
     qint64 processedUSecs() const;
     qint64 elapsedUSecs() const;
 
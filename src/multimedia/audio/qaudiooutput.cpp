@@ -44,6 +44,7 @@
 #include "qaudiooutput.h"
 
 #include "qaudiodevicefactory_p.h"
+#include "qaudiosystempluginext_p.h"
 
 
 QT_BEGIN_NAMESPACE
@@ -411,6 +412,25 @@ void QAudioOutput::setCategory(const QString &category)
     d->setCategory(category);
 }
 
+/*!
+    \since 5.13
+
+    Returns a snapshot of the latency, fill level, underrun count and callback
+    jitter of the output. The counters are reset by start().
+
+    Polling this periodically is a cheap way to monitor the health of the
+    audio path. Values the audio backend doesn't measure are left at their
+    defaults.
+
+    \sa QAudioStatistics
+*/
+QAudioStatistics QAudioOutput::statistics() const
+{
+    if (QAudioStatisticsExtension *extension = qobject_cast<QAudioStatisticsExtension *>(d))
+        return extension->statistics();
+    return QAudioStatistics();
+}
+
 /*!
     \fn QAudioOutput::stateChanged(QAudio::State state)
     This signal is emitted when the device \a state has changed.
@@ -49,6 +49,7 @@
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudioformat.h>
 #include <QtMultimedia/qaudiodeviceinfo.h>
+#include <QtMultimedia/qaudiostatistics.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -97,6 +98,8 @@ public:
     QString category() const;
     void setCategory(const QString &category);
 
+    QAudioStatistics statistics() const;
+
 Q_SIGNALS:
     void stateChanged(QAudio::State state);
     void notify();
@@ -59,6 +59,13 @@
         recorder->record(); // Now we can do things like calculating levels or performing an FFT
     \endcode
 
+    Probes monitoring the same media object share how its buffers are
+    delivered. DirectDelivery is only used when all of them request it.
+    Otherwise BufferedDelivery is used if any of them requests it, with the
+    largest requested \l bufferSize(). BlockOnOverflow is only honored when
+    all buffering probes request it, otherwise DropOldest takes precedence
+    over DropNewest.
+
     \sa QVideoProbe, QMediaPlayer, QCamera
 */
 
@@ -68,6 +75,7 @@
 #include "qmediarecorder.h"
 #include "qsharedpointer.h"
 #include "qpointer.h"
+#include <private/qmediaprobedelivery_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,6 +83,29 @@ class QAudioProbePrivate {
 public:
     QPointer<QMediaObject> source;
     QPointer<QMediaAudioProbeControl> probee;
+    QAudioProbe::DeliveryMode deliveryMode = QAudioProbe::QueuedDelivery;
+    QAudioProbe::OverflowPolicy overflowPolicy = QAudioProbe::DropOldest;
+    int bufferSize = 8;
+
+    QMediaProbeDelivery *delivery() const
+    {
+        return qobject_cast<QMediaProbeDelivery *>(probee.data());
+    }
+
+    void applyDelivery()
+    {
+        if (QMediaProbeDelivery *control = delivery()) {
+            control->setDeliverySettings(this, QMediaProbeDelivery::Mode(deliveryMode),
+                                         QMediaProbeDelivery::OverflowPolicy(overflowPolicy),
+                                         bufferSize);
+        }
+    }
+
+    void releaseDelivery()
+    {
+        if (QMediaProbeDelivery *control = delivery())
+            control->removeDeliverySettings(this);
+    }
 };
 
 /*!
@@ -98,6 +129,7 @@ QAudioProbe::~QAudioProbe()
     if (d->source) {
         // Disconnect
         if (d->probee) {
+            d->releaseDelivery();
             disconnect(d->probee.data(), SIGNAL(audioBufferProbed(QAudioBuffer)), this, SIGNAL(audioBufferProbed(QAudioBuffer)));
             disconnect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
         }
@@ -127,6 +159,7 @@ bool QAudioProbe::setSource(QMediaObject *source)
 
     // in case source was destroyed but probe control is still valid
     if (!d->source && d->probee) {
+        d->releaseDelivery();
         disconnect(d->probee.data(), SIGNAL(audioBufferProbed(QAudioBuffer)), this, SIGNAL(audioBufferProbed(QAudioBuffer)));
         disconnect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
         d->probee.clear();
@@ -135,6 +168,7 @@ bool QAudioProbe::setSource(QMediaObject *source)
     if (source != d->source.data()) {
         if (d->source) {
             Q_ASSERT(d->probee);
+            d->releaseDelivery();
             disconnect(d->probee.data(), SIGNAL(audioBufferProbed(QAudioBuffer)), this, SIGNAL(audioBufferProbed(QAudioBuffer)));
             disconnect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
             d->source.data()->service()->releaseControl(d->probee.data());
@@ -149,8 +183,10 @@ bool QAudioProbe::setSource(QMediaObject *source)
             }
 
             if (d->probee) {
-                connect(d->probee.data(), SIGNAL(audioBufferProbed(QAudioBuffer)), this, SIGNAL(audioBufferProbed(QAudioBuffer)));
+                // Direct, so that DirectDelivery reaches the receivers on the streaming thread.
+                connect(d->probee.data(), SIGNAL(audioBufferProbed(QAudioBuffer)), this, SIGNAL(audioBufferProbed(QAudioBuffer)), Qt::DirectConnection);
                 connect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
+                d->applyDelivery();
                 d->source = source;
             }
         }
@@ -198,6 +234,135 @@ bool QAudioProbe::isActive() const
     return d->probee != 0;
 }
 
+/*!
+    \enum QAudioProbe::DeliveryMode
+    \since 5.13
+
+    Describes how probed buffers are delivered to the receivers of
+    \l audioBufferProbed().
+
+    \value QueuedDelivery The signal is emitted on the thread the probe lives
+    in. Only the most recent buffer is kept while the receiving thread is
+    busy, older ones are dropped. This is the default.
+    \value DirectDelivery The signal is emitted on the media framework's
+    streaming thread as soon as a buffer is available. Receivers must be
+    thread-safe, connect with Qt::DirectConnection and return quickly, since
+    the media pipeline waits for them.
+    \value BufferedDelivery Probed buffers are kept in a queue of
+    \l bufferSize() entries and delivered on the thread the probe lives in.
+    What happens when the queue is full is decided by overflowPolicy().
+*/
+
+/*!
+    \enum QAudioProbe::OverflowPolicy
+    \since 5.13
+
+    Describes what happens in BufferedDelivery mode when the queue is full.
+
+    \value BlockOnOverflow The streaming thread waits until the queued
+    buffers are delivered. This throttles the media pipeline to the speed of
+    the receivers. If the receivers don't catch up within a second, the new
+    buffer is dropped so a blocked receiving thread can't stall the pipeline.
+    Stopping the media object always releases the streaming thread.
+    \value DropOldest The oldest queued buffer is discarded. This is the
+    default.
+    \value DropNewest The new buffer is discarded.
+*/
+
+/*!
+    \since 5.13
+
+    Returns the delivery mode of this probe.
+
+    \sa isDeliveryModeSupported()
+*/
+QAudioProbe::DeliveryMode QAudioProbe::deliveryMode() const
+{
+    return d->deliveryMode;
+}
+
+/*!
+    \since 5.13
+
+    Sets the delivery \a mode of this probe. Any buffers queued for delivery
+    are discarded when the mode changes.
+*/
+void QAudioProbe::setDeliveryMode(DeliveryMode mode)
+{
+    d->deliveryMode = mode;
+    d->applyDelivery();
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of buffers queued in BufferedDelivery mode. The
+    default is 8.
+*/
+int QAudioProbe::bufferSize() const
+{
+    return d->bufferSize;
+}
+
+/*!
+    \since 5.13
+
+    Sets the number of buffers queued in BufferedDelivery mode to \a size.
+*/
+void QAudioProbe::setBufferSize(int size)
+{
+    d->bufferSize = qMax(1, size);
+    d->applyDelivery();
+}
+
+/*!
+    \since 5.13
+
+    Returns what happens when the queue of BufferedDelivery mode is full.
+*/
+QAudioProbe::OverflowPolicy QAudioProbe::overflowPolicy() const
+{
+    return d->overflowPolicy;
+}
+
+/*!
+    \since 5.13
+
+    Sets what happens when the queue of BufferedDelivery mode is full to
+    \a policy.
+*/
+void QAudioProbe::setOverflowPolicy(OverflowPolicy policy)
+{
+    d->overflowPolicy = policy;
+    d->applyDelivery();
+}
+
+/*!
+    \since 5.13
+
+    Returns true if the monitored media object honors the delivery mode and
+    reports dropped buffers. Otherwise the media backend decides how buffers
+    are delivered.
+*/
+bool QAudioProbe::isDeliveryModeSupported() const
+{
+    return d->delivery() != nullptr;
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of probed buffers that were dropped before they could
+    be delivered, since the current source was set or its media changed.
+
+    \sa deliveryMode(), overflowPolicy()
+*/
+quint64 QAudioProbe::droppedBufferCount() const
+{
+    QMediaProbeDelivery *delivery = d->delivery();
+    return delivery ? delivery->droppedCount(d) : 0;
+}
+
 /*!
     \fn QAudioProbe::audioBufferProbed(const QAudioBuffer &buffer)
 
@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaudioringbuffer_p.h"
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+QAudioRingBuffer::QAudioRingBuffer(int bufferSize)
+    : m_bufferSize(bufferSize)
+    , m_readPos(0)
+    , m_writePos(0)
+    , m_buffer(new char[bufferSize])
+{
+    m_bufferUsed.store(0);
+}
+
+QAudioRingBuffer::~QAudioRingBuffer()
+{
+    delete[] m_buffer;
+}
+
+QAudioRingBuffer::Region QAudioRingBuffer::acquireReadRegion(int size)
+{
+    const int used = m_bufferUsed.loadAcquire();
+    const int readSize = qMin(size, qMin(m_bufferSize - m_readPos, used));
+
+    return readSize > 0 ? Region(m_buffer + m_readPos, readSize) : Region(0, 0);
+}
+
+void QAudioRingBuffer::releaseReadRegion(const Region &region)
+{
+    m_readPos = (m_readPos + region.second) % m_bufferSize;
+
+    m_bufferUsed.fetchAndAddRelease(-region.second);
+}
+
+QAudioRingBuffer::Region QAudioRingBuffer::acquireWriteRegion(int size)
+{
+    const int free = m_bufferSize - m_bufferUsed.loadAcquire();
+    const int writeSize = qMin(size, qMin(m_bufferSize - m_writePos, free));
+
+    return writeSize > 0 ? Region(m_buffer + m_writePos, writeSize) : Region(0, 0);
+}
+
+void QAudioRingBuffer::releaseWriteRegion(const Region &region)
+{
+    m_writePos = (m_writePos + region.second) % m_bufferSize;
+
+    m_bufferUsed.fetchAndAddRelease(region.second);
+}
+
+// Copies as much of data as fits, returns the number of bytes written.
+int QAudioRingBuffer::write(const char *data, int size)
+{
+    int written = 0;
+    while (written < size) {
+        const Region region = acquireWriteRegion(size - written);
+        if (region.second == 0)
+            break;
+
+        memcpy(region.first, data + written, region.second);
+        releaseWriteRegion(region);
+        written += region.second;
+    }
+    return written;
+}
+
+// Copies up to size bytes to data, returns the number of bytes read.
+int QAudioRingBuffer::read(char *data, int size)
+{
+    int read = 0;
+    while (read < size) {
+        const Region region = acquireReadRegion(size - read);
+        if (region.second == 0)
+            break;
+
+        memcpy(data + read, region.first, region.second);
+        releaseReadRegion(region);
+        read += region.second;
+    }
+    return read;
+}
+
+int QAudioRingBuffer::used() const
+{
+    return m_bufferUsed.load();
+}
+
+int QAudioRingBuffer::free() const
+{
+    return m_bufferSize - m_bufferUsed.load();
+}
+
+int QAudioRingBuffer::size() const
+{
+    return m_bufferSize;
+}
+
+// Must not be called while the producer or the consumer is running.
+void QAudioRingBuffer::reset()
+{
+    m_readPos = 0;
+    m_writePos = 0;
+    m_bufferUsed.store(0);
+}
+
+QT_END_NAMESPACE
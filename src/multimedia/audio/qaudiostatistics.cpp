@@ -0,0 +1,207 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qaudiostatistics.h"
+
+QT_BEGIN_NAMESPACE
+
+static void qRegisterAudioStatisticsMetaTypes()
+{
+    qRegisterMetaType<QAudioStatistics>();
+}
+
+Q_CONSTRUCTOR_FUNCTION(qRegisterAudioStatisticsMetaTypes)
+
+class QAudioStatisticsPrivate : public QSharedData
+{
+public:
+    qint64 latency = -1;
+    int bytesBuffered = 0;
+    int underrunCount = 0;
+    int overrunCount = 0;
+    qint64 maxCallbackJitter = 0;
+};
+
+/*!
+    \class QAudioStatistics
+    \brief The QAudioStatistics class holds timing and health measurements of an audio stream.
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_audio
+    \since 5.13
+
+    A snapshot is returned by QAudioOutput::statistics() and
+    QAudioInput::statistics(). It tells how much delay there is between the
+    application and the speaker or microphone, how full the buffers are, and
+    how often the stream ran dry or lost data. The counters are reset when
+    the stream is started.
+
+    Backends that don't measure a value leave it at its default, -1 for the
+    latency and 0 for the others.
+
+    \sa QAudioOutput, QAudioInput
+*/
+
+/*!
+    Constructs statistics with nothing measured.
+*/
+QAudioStatistics::QAudioStatistics()
+    : d(new QAudioStatisticsPrivate)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QAudioStatistics::QAudioStatistics(const QAudioStatistics &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Assigns \a other to these statistics.
+*/
+QAudioStatistics &QAudioStatistics::operator=(const QAudioStatistics &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    Destroys the statistics.
+*/
+QAudioStatistics::~QAudioStatistics()
+{
+}
+
+/*!
+    Returns the latency of the stream in microseconds, or -1 if it is unknown.
+
+    For an output, it is the time until the next byte written is heard: what
+    is buffered on the way to the device plus the device's own delay. For an
+    input, it is the age of the oldest captured byte that hasn't been read yet.
+*/
+qint64 QAudioStatistics::latencyUSecs() const
+{
+    return d->latency;
+}
+
+/*!
+    Sets the latency of the stream to \a usecs.
+*/
+void QAudioStatistics::setLatencyUSecs(qint64 usecs)
+{
+    d->latency = usecs;
+}
+
+/*!
+    Returns the fill level of the stream's buffer, in bytes.
+
+    For an output, it is the data written but not yet played. For an input,
+    it is the data captured and ready to be read.
+*/
+int QAudioStatistics::bytesBuffered() const
+{
+    return d->bytesBuffered;
+}
+
+/*!
+    Sets the fill level of the stream's buffer to \a bytes.
+*/
+void QAudioStatistics::setBytesBuffered(int bytes)
+{
+    d->bytesBuffered = bytes;
+}
+
+/*!
+    Returns how many times the device ran out of data to play while the
+    stream was active.
+*/
+int QAudioStatistics::underrunCount() const
+{
+    return d->underrunCount;
+}
+
+/*!
+    Sets the underrun count to \a count.
+*/
+void QAudioStatistics::setUnderrunCount(int count)
+{
+    d->underrunCount = count;
+}
+
+/*!
+    Returns how many times audio data was lost because a buffer was full,
+    typically captured data the application didn't read in time.
+*/
+int QAudioStatistics::overrunCount() const
+{
+    return d->overrunCount;
+}
+
+/*!
+    Sets the overrun count to \a count.
+*/
+void QAudioStatistics::setOverrunCount(int count)
+{
+    d->overrunCount = count;
+}
+
+/*!
+    Returns the largest deviation, in microseconds, between the interval at
+    which the backend serviced the stream and the interval it expected.
+
+    A large jitter means that the thread running the backend is not
+    scheduled in time, which eventually leads to underruns or overruns.
+*/
+qint64 QAudioStatistics::maxCallbackJitterUSecs() const
+{
+    return d->maxCallbackJitter;
+}
+
+/*!
+    Sets the maximum callback jitter to \a usecs.
+*/
+void QAudioStatistics::setMaxCallbackJitterUSecs(qint64 usecs)
+{
+    d->maxCallbackJitter = usecs;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAUDIOSTATISTICS_P_H
+#define QAUDIOSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qaudiostatistics.h>
+
+#include <QtCore/qelapsedtimer.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Measures how far the intervals between the periodic callbacks of an
+    audio backend stray from the expected one. pause() is meant for when
+    the callbacks stop on purpose, the gap isn't counted as jitter.
+*/
+class QAudioJitterMeter
+{
+public:
+    QAudioJitterMeter() : m_maxJitter(0) {}
+
+    void reset()
+    {
+        m_timer.invalidate();
+        m_maxJitter = 0;
+    }
+
+    void pause() { m_timer.invalidate(); }
+
+    void tick(qint64 expectedUSecs)
+    {
+        if (m_timer.isValid()) {
+            const qint64 jitter = qAbs(m_timer.nsecsElapsed() / 1000 - expectedUSecs);
+            m_maxJitter = qMax(m_maxJitter, jitter);
+        }
+        m_timer.start();
+    }
+
+    qint64 maxJitterUSecs() const { return m_maxJitter; }
+
+private:
+    QElapsedTimer m_timer;
+    qint64 m_maxJitter;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOSTATISTICS_P_H
@@ -51,6 +51,10 @@ QAudioSystemPluginExtension::~QAudioSystemPluginExtension()
 {
 }
 
+QAudioStatisticsExtension::~QAudioStatisticsExtension()
+{
+}
+
 /*!
     \class QAudioSystemPlugin
     \brief The QAudioSystemPlugin class provides an abstract base for audio plugins.
@@ -42,6 +42,7 @@
 
 #include <QtMultimedia/qtmultimediaglobal.h>
 #include <QtMultimedia/qaudio.h>
+#include <QtMultimedia/qaudiostatistics.h>
 #include <QtCore/qplugin.h>
 
 QT_BEGIN_NAMESPACE
@@ -66,6 +67,17 @@ struct Q_MULTIMEDIA_EXPORT QAudioSystemPluginExtension
 #define QAudioSystemPluginExtension_iid "org.qt-project.qt.audiosystempluginextension"
 Q_DECLARE_INTERFACE(QAudioSystemPluginExtension, QAudioSystemPluginExtension_iid)
 
+// Implemented by the QAbstractAudioOutput and QAbstractAudioInput of
+// backends that measure the health of their streams.
+struct Q_MULTIMEDIA_EXPORT QAudioStatisticsExtension
+{
+    virtual QAudioStatistics statistics() const = 0;
+    virtual ~QAudioStatisticsExtension();
+};
+
+#define QAudioStatisticsExtension_iid "org.qt-project.qt.audiostatisticsextension"
+Q_DECLARE_INTERFACE(QAudioStatisticsExtension, QAudioStatisticsExtension_iid)
+
 QT_END_NAMESPACE
 
 #endif // QAUDIOSYSTEMPLUGINEXT_P_H
@@ -39,16 +39,41 @@
 
 #include "qsamplecache_p.h"
 #include "qwavedecoder_p.h"
+#include "qaudiodecoder.h"
+#include "qaudiobuffer.h"
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
 
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/qendian.h>
+
+#include <limits>
 //#define QT_SAMPLECACHE_DEBUG
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// Layout of the decoded sample files, all fields little endian:
+// magic, version, sample rate, channel count, sample size, sample type,
+// byte order, reserved, data size (64 bit), padding up to the PCM data.
+const char DiskCacheMagic[] = "QPCM";
+enum {
+    DiskCacheVersion = 1,
+    DiskCacheHeaderSize = 64
+};
+
+}
+
 
 /*!
     \class QSampleCache
@@ -93,6 +118,16 @@ QT_BEGIN_NAMESPACE
            m_sample = 0;
        }
     \endcode
+
+    WAV files are parsed directly. Any other format is decoded to PCM by
+    QAudioDecoder on the loading thread, and the result is stored in
+    diskCacheDirectory(), named after a hash of the encoded data. The next
+    time the same sound is requested, the decoded file is memory mapped
+    instead of being decoded again.
+
+    The directory defaults to a subdirectory of the application's cache
+    location and can be overridden with the QT_SAMPLECACHE_DIR environment
+    variable. An empty directory disables the disk cache.
 */
 
 QSampleCache::QSampleCache(QObject *parent)
@@ -106,6 +141,14 @@ QSampleCache::QSampleCache(QObject *parent)
     m_loadingThread.setObjectName(QLatin1String("QSampleCache::LoadingThread"));
     connect(&m_loadingThread, SIGNAL(finished()), this, SIGNAL(isLoadingChanged()));
     connect(&m_loadingThread, SIGNAL(started()), this, SIGNAL(isLoadingChanged()));
+
+    if (qEnvironmentVariableIsSet("QT_SAMPLECACHE_DIR")) {
+        m_diskCacheDirectory = qEnvironmentVariable("QT_SAMPLECACHE_DIR");
+    } else {
+        const QString location = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (!location.isEmpty())
+            m_diskCacheDirectory = location + QLatin1String("/qtmultimedia/samples");
+    }
 }
 
 QNetworkAccessManager& QSampleCache::networkAccessManager()
@@ -161,6 +204,20 @@ bool QSampleCache::isCached(const QUrl &url) const
     return m_samples.contains(url);
 }
 
+// Called in application thread
+void QSampleCache::setDiskCacheDirectory(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    m_diskCacheDirectory = path;
+}
+
+// Called in both threads
+QString QSampleCache::diskCacheDirectory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_diskCacheDirectory;
+}
+
 QSample* QSampleCache::requestSample(const QUrl& url)
 {
     //lock and add first to make sure live loadingThread will not be killed during this function call
@@ -281,6 +338,10 @@ QSample::~QSample()
     qDebug() << "~QSample" << this << ": deleted [" << m_url << "]" << QThread::currentThread();
 #endif
     cleanup();
+
+    // The sound data may point into the mapped cache file.
+    m_soundData.clear();
+    delete m_cacheFile;
 }
 
 // Called in application thread
@@ -326,13 +387,23 @@ void QSample::release()
 // must be called locked.
 void QSample::cleanup()
 {
+    if (m_audioDecoder) {
+        m_audioDecoder->disconnect(this);
+        m_audioDecoder->stop();
+        m_audioDecoder->deleteLater();
+    }
     if (m_waveDecoder)
         m_waveDecoder->deleteLater();
+    if (m_buffer)
+        m_buffer->deleteLater();
     if (m_stream)
         m_stream->deleteLater();
 
+    m_audioDecoder = 0;
     m_waveDecoder = 0;
+    m_buffer = 0;
     m_stream = 0;
+    m_encodedData.clear();
 }
 
 // Called in application thread
@@ -370,6 +441,7 @@ void QSample::decoderReady()
 #endif
     m_parent->refresh(m_waveDecoder->size());
 
+    m_audioFormat = m_waveDecoder->audioFormat();
     m_soundData.resize(m_waveDecoder->size());
     m_sampleReadLength = 0;
     qint64 read = m_waveDecoder->read(m_soundData.data(), m_waveDecoder->size());
@@ -396,10 +468,180 @@ void QSample::load()
 #endif
     m_stream = m_parent->networkAccessManager().get(QNetworkRequest(m_url));
     connect(m_stream, SIGNAL(error(QNetworkReply::NetworkError)), SLOT(decoderError()));
-    m_waveDecoder = new QWaveDecoder(m_stream);
-    connect(m_waveDecoder, SIGNAL(formatKnown()), SLOT(decoderReady()));
-    connect(m_waveDecoder, SIGNAL(parsingError()), SLOT(decoderError()));
-    connect(m_waveDecoder, SIGNAL(readyRead()), SLOT(readSample()));
+    connect(m_stream, SIGNAL(finished()), SLOT(sourceFinished()));
+}
+
+// Called in loading thread once the whole file has been received
+void QSample::sourceFinished()
+{
+    Q_ASSERT(QThread::currentThread()->objectName() == QLatin1String("QSampleCache::LoadingThread"));
+    QMutexLocker m(&m_mutex);
+    // The reply also finishes after an error, which already cleaned up.
+    if (!m_stream || sender() != m_stream)
+        return;
+#ifdef QT_SAMPLECACHE_DEBUG
+    qDebug() << "QSample: source finished [" << m_url << "]";
+#endif
+    m_soundData.clear();
+    m_sampleReadLength = 0;
+    m_audioFormat = QAudioFormat();
+
+    m_encodedData = m_stream->readAll();
+    m_buffer = new QBuffer(&m_encodedData);
+    m_buffer->open(QIODevice::ReadOnly);
+
+    const QByteArray chunkId = m_encodedData.left(4);
+    if ((chunkId == "RIFF" || chunkId == "RIFX" || chunkId == "RF64")
+            && m_encodedData.mid(8, 4) == "WAVE") {
+        m_waveDecoder = new QWaveDecoder(m_buffer);
+        connect(m_waveDecoder, SIGNAL(formatKnown()), SLOT(decoderReady()));
+        connect(m_waveDecoder, SIGNAL(parsingError()), SLOT(decoderError()));
+        connect(m_waveDecoder, SIGNAL(readyRead()), SLOT(readSample()));
+        return;
+    }
+
+    m_cacheFileName.clear();
+    const QString directory = m_parent->diskCacheDirectory();
+    if (!directory.isEmpty()) {
+        const QByteArray hash = QCryptographicHash::hash(m_encodedData, QCryptographicHash::Sha1);
+        m_cacheFileName = directory + QLatin1Char('/')
+                + QLatin1String(hash.toHex()) + QLatin1String(".pcm");
+        if (loadFromDiskCache(m_cacheFileName)) {
+            m_parent->refresh(m_soundData.size());
+            onReady();
+            return;
+        }
+    }
+
+    QAudioDecoder *decoder = new QAudioDecoder;
+    connect(decoder, SIGNAL(bufferReady()), SLOT(decodeBuffer()));
+    connect(decoder, SIGNAL(finished()), SLOT(decodingFinished()));
+    connect(decoder, SIGNAL(error(QAudioDecoder::Error)), SLOT(decoderError()));
+    decoder->setSourceDevice(m_buffer);
+    m_audioDecoder = decoder;
+
+    // The decoder may report errors right away, which takes the lock.
+    m.unlock();
+    decoder->start();
+}
+
+// Called in loading thread
+void QSample::decodeBuffer()
+{
+    Q_ASSERT(QThread::currentThread()->objectName() == QLatin1String("QSampleCache::LoadingThread"));
+    if (!m_audioDecoder)
+        return;
+
+    const QAudioBuffer buffer = m_audioDecoder->read();
+    if (!buffer.isValid())
+        return;
+
+    QMutexLocker m(&m_mutex);
+    if (!m_audioFormat.isValid()) {
+        m_audioFormat = buffer.format();
+    } else if (buffer.format() != m_audioFormat) {
+        qWarning() << "QSampleCache: dropping decoded buffer with format" << buffer.format()
+                   << "in [" << m_url << "]";
+        return;
+    }
+    m_soundData.append(static_cast<const char *>(buffer.constData()), buffer.byteCount());
+}
+
+// Called in loading thread
+void QSample::decodingFinished()
+{
+    Q_ASSERT(QThread::currentThread()->objectName() == QLatin1String("QSampleCache::LoadingThread"));
+    QMutexLocker m(&m_mutex);
+#ifdef QT_SAMPLECACHE_DEBUG
+    qDebug() << "QSample: decoding finished, " << m_soundData.size() << "bytes";
+#endif
+    if (m_soundData.isEmpty() || !m_audioFormat.isValid()) {
+        m.unlock();
+        decoderError();
+        return;
+    }
+
+    m_parent->refresh(m_soundData.size());
+    if (!m_cacheFileName.isEmpty())
+        saveToDiskCache(m_cacheFileName);
+    onReady();
+}
+
+// Called in loading thread, locked.
+bool QSample::loadFromDiskCache(const QString &fileName)
+{
+    QScopedPointer<QFile> file(new QFile(fileName));
+    if (!file->open(QIODevice::ReadOnly))
+        return false;
+
+    const QByteArray header = file->read(DiskCacheHeaderSize);
+    if (header.size() != DiskCacheHeaderSize || !header.startsWith(DiskCacheMagic))
+        return false;
+
+    const uchar *h = reinterpret_cast<const uchar *>(header.constData());
+    if (qFromLittleEndian<quint32>(h + 4) != DiskCacheVersion)
+        return false;
+
+    QAudioFormat format;
+    format.setSampleRate(qFromLittleEndian<qint32>(h + 8));
+    format.setChannelCount(qFromLittleEndian<qint32>(h + 12));
+    format.setSampleSize(qFromLittleEndian<qint32>(h + 16));
+    format.setSampleType(QAudioFormat::SampleType(qFromLittleEndian<qint32>(h + 20)));
+    format.setByteOrder(QAudioFormat::Endian(qFromLittleEndian<qint32>(h + 24)));
+    format.setCodec(QLatin1String("audio/pcm"));
+
+    const qint64 size = qFromLittleEndian<qint64>(h + 32);
+    if (!format.isValid() || size <= 0 || size > std::numeric_limits<int>::max()
+            || size != file->size() - DiskCacheHeaderSize) {
+        qWarning() << "QSampleCache: ignoring invalid cache file" << fileName;
+        return false;
+    }
+
+    // Keep the file around as long as the sample, the data points into the mapping.
+    if (uchar *data = file->map(DiskCacheHeaderSize, size)) {
+        m_soundData = QByteArray::fromRawData(reinterpret_cast<const char *>(data), int(size));
+        delete m_cacheFile;
+        m_cacheFile = file.take();
+    } else {
+        m_soundData = file->readAll();
+        if (m_soundData.size() != size) {
+            m_soundData.clear();
+            return false;
+        }
+    }
+
+#ifdef QT_SAMPLECACHE_DEBUG
+    qDebug() << "QSample: loaded" << size << "bytes from" << fileName;
+#endif
+    m_audioFormat = format;
+    return true;
+}
+
+// Called in loading thread, locked.
+void QSample::saveToDiskCache(const QString &fileName)
+{
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+        return;
+
+    QByteArray header(DiskCacheHeaderSize, '\0');
+    uchar *h = reinterpret_cast<uchar *>(header.data());
+    memcpy(h, DiskCacheMagic, 4);
+    qToLittleEndian<quint32>(DiskCacheVersion, h + 4);
+    qToLittleEndian<qint32>(m_audioFormat.sampleRate(), h + 8);
+    qToLittleEndian<qint32>(m_audioFormat.channelCount(), h + 12);
+    qToLittleEndian<qint32>(m_audioFormat.sampleSize(), h + 16);
+    qToLittleEndian<qint32>(m_audioFormat.sampleType(), h + 20);
+    qToLittleEndian<qint32>(m_audioFormat.byteOrder(), h + 24);
+    qToLittleEndian<qint64>(m_soundData.size(), h + 32);
+
+    // Written to a temporary file first, so that another process never maps a partial file.
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)
+            || file.write(header) != header.size()
+            || file.write(m_soundData) != m_soundData.size()
+            || !file.commit()) {
+        qWarning() << "QSampleCache: failed to write" << fileName;
+    }
 }
 
 // Called in loading thread
@@ -423,7 +665,6 @@ void QSample::onReady()
 #ifdef QT_SAMPLECACHE_DEBUG
     qDebug() << "QSample: load ready";
 #endif
-    m_audioFormat = m_waveDecoder->audioFormat();
     cleanup();
     m_state = QSample::Ready;
     qobject_cast<QSampleCache*>(m_parent)->loadingRelease();
@@ -435,6 +676,9 @@ QSample::QSample(const QUrl& url, QSampleCache *parent)
     : m_parent(parent)
     , m_stream(0)
     , m_waveDecoder(0)
+    , m_buffer(0)
+    , m_audioDecoder(0)
+    , m_cacheFile(0)
     , m_url(url)
     , m_sampleReadLength(0)
     , m_state(Creating)
@@ -62,6 +62,9 @@
 
 QT_BEGIN_NAMESPACE
 
+class QAudioDecoder;
+class QBuffer;
+class QFile;
 class QIODevice;
 class QNetworkAccessManager;
 class QSampleCache;
@@ -100,8 +103,13 @@ private Q_SLOTS:
     void decoderError();
     void readSample();
     void decoderReady();
+    void sourceFinished();
+    void decodeBuffer();
+    void decodingFinished();
 
 private:
+    bool loadFromDiskCache(const QString &fileName);
+    void saveToDiskCache(const QString &fileName);
     void onReady();
     void cleanup();
     void addRef();
@@ -115,6 +123,11 @@ private:
     QAudioFormat m_audioFormat;
     QIODevice    *m_stream;
     QWaveDecoder *m_waveDecoder;
+    QByteArray   m_encodedData;
+    QBuffer      *m_buffer;
+    QAudioDecoder *m_audioDecoder;
+    QString      m_cacheFileName;
+    QFile        *m_cacheFile;
     QUrl         m_url;
     qint64       m_sampleReadLength;
     State        m_state;
@@ -136,6 +149,9 @@ public:
     bool isLoading() const;
     bool isCached(const QUrl& url) const;
 
+    void setDiskCacheDirectory(const QString &path);
+    QString diskCacheDirectory() const;
+
 Q_SIGNALS:
     void isLoadingChanged();
 
@@ -147,6 +163,7 @@ private:
     qint64 m_capacity;
     qint64 m_usage;
     QThread m_loadingThread;
+    QString m_diskCacheDirectory;
 
     QNetworkAccessManager& networkAccessManager();
     void refresh(qint64 usageChange);
@@ -42,12 +42,17 @@
 #include <QtCore/qtimer.h>
 #include <QtCore/qendian.h>
 
+#include <stddef.h>
+
 QT_BEGIN_NAMESPACE
 
 QWaveDecoder::QWaveDecoder(QIODevice *s, QObject *parent):
     QIODevice(parent),
     haveFormat(false),
     dataSize(0),
+    dataStart(-1),
+    dataPos(0),
+    ds64DataSize(-1),
     source(s),
     state(QWaveDecoder::InitialState),
     junkToSkip(0),
@@ -72,9 +77,22 @@ QAudioFormat QWaveDecoder::audioFormat() const
 
 int QWaveDecoder::duration() const
 {
+    if (!haveFormat)
+        return 0;
     return size() * 1000 / (format.sampleSize() / 8) / format.channelCount() / format.sampleRate();
 }
 
+/*
+    Returns the position of the sample data in the source device, or -1 until
+    the format is known or if the source is sequential. Together with size() this
+    lets a caller map or read the samples straight from the underlying file,
+    bypassing the decoder.
+*/
+qint64 QWaveDecoder::dataOffset() const
+{
+    return haveFormat ? dataStart : -1;
+}
+
 qint64 QWaveDecoder::size() const
 {
     return haveFormat ? dataSize : 0;
@@ -87,12 +105,35 @@ bool QWaveDecoder::isSequential() const
 
 qint64 QWaveDecoder::bytesAvailable() const
 {
-    return haveFormat ? source->bytesAvailable() : 0;
+    return haveFormat ? qMax(qint64(0), qMin(source->bytesAvailable(), dataSize - dataPos)) : 0;
+}
+
+bool QWaveDecoder::seek(qint64 pos)
+{
+    if (!haveFormat || source->isSequential() || pos < 0 || pos > dataSize)
+        return false;
+
+    if (!source->seek(dataStart + pos))
+        return false;
+
+    dataPos = pos;
+    return QIODevice::seek(pos);
 }
 
 qint64 QWaveDecoder::readData(char *data, qint64 maxlen)
 {
-    return haveFormat ? source->read(data, maxlen) : 0;
+    if (!haveFormat)
+        return 0;
+
+    // Chunks following the data chunk aren't samples.
+    maxlen = qMin(maxlen, dataSize - dataPos);
+    if (maxlen <= 0)
+        return 0;
+
+    const qint64 bytesRead = source->read(data, maxlen);
+    if (bytesRead > 0)
+        dataPos += bytesRead;
+    return bytesRead;
 }
 
 qint64 QWaveDecoder::writeData(const char *data, qint64 len)
@@ -132,13 +173,15 @@ void QWaveDecoder::handleData()
         RIFFHeader riff;
         source->read(reinterpret_cast<char *>(&riff), sizeof(RIFFHeader));
 
-        // RIFF = little endian RIFF, RIFX = big endian RIFF
-        if (((qstrncmp(riff.descriptor.id, "RIFF", 4) != 0) && (qstrncmp(riff.descriptor.id, "RIFX", 4) != 0))
+        // RIFF = little endian RIFF, RIFX = big endian RIFF,
+        // RF64 = little endian RIFF with 64 bit sizes in a ds64 chunk
+        const bool rf64 = qstrncmp(riff.descriptor.id, "RF64", 4) == 0;
+        if (((qstrncmp(riff.descriptor.id, "RIFF", 4) != 0) && (qstrncmp(riff.descriptor.id, "RIFX", 4) != 0) && !rf64)
                 || qstrncmp(riff.type, "WAVE", 4) != 0) {
             parsingFailed();
             return;
         } else {
-            state = QWaveDecoder::WaitingForFormatState;
+            state = rf64 ? QWaveDecoder::WaitingForDataSizeState : QWaveDecoder::WaitingForFormatState;
             if (qstrncmp(riff.descriptor.id, "RIFX", 4) == 0)
                 bigEndian = true;
             else
@@ -146,6 +189,33 @@ void QWaveDecoder::handleData()
         }
     }
 
+    if (state == QWaveDecoder::WaitingForDataSizeState) {
+        if (findChunk("ds64")) {
+            chunk descriptor;
+            peekChunk(&descriptor);
+
+            const qint64 rawChunkSize = qint64(descriptor.size) + sizeof(chunk);
+            if (source->bytesAvailable() < rawChunkSize)
+                return;
+
+            if (rawChunkSize < qint64(sizeof(DS64Header))) {
+                parsingFailed();
+                return;
+            }
+
+            DS64Header ds64;
+            source->read(reinterpret_cast<char *>(&ds64), sizeof(DS64Header));
+
+            if (rawChunkSize > qint64(sizeof(DS64Header)))
+                discardBytes(rawChunkSize - sizeof(DS64Header));
+
+            ds64DataSize = qint64(quint64(qFromLittleEndian<quint32>(ds64.dataSizeHigh)) << 32
+                                  | qFromLittleEndian<quint32>(ds64.dataSizeLow));
+
+            state = QWaveDecoder::WaitingForFormatState;
+        }
+    }
+
     if (state == QWaveDecoder::WaitingForFormatState) {
         if (findChunk("fmt ")) {
             chunk descriptor;
@@ -155,47 +225,14 @@ void QWaveDecoder::handleData()
             if (source->bytesAvailable() < qint64(rawChunkSize))
                 return;
 
-            WAVEHeader wave;
-            source->read(reinterpret_cast<char *>(&wave), sizeof(WAVEHeader));
-
-            if (rawChunkSize > sizeof(WAVEHeader))
-                discardBytes(rawChunkSize - sizeof(WAVEHeader));
+            const QByteArray chunkData = source->read(rawChunkSize);
 
-            // Swizzle this
-            if (bigEndian) {
-                wave.audioFormat = qFromBigEndian<quint16>(wave.audioFormat);
-            } else {
-                wave.audioFormat = qFromLittleEndian<quint16>(wave.audioFormat);
-            }
-
-            if (wave.audioFormat != 0 && wave.audioFormat != 1) {
-                // 32bit wave files have format == 0xFFFE (WAVE_FORMAT_EXTENSIBLE).
-                // but don't support them at the moment.
+            if (!parseFormat(chunkData)) {
                 parsingFailed();
                 return;
-            } else {
-                format.setCodec(QLatin1String("audio/pcm"));
-
-                if (bigEndian) {
-                    int bps = qFromBigEndian<quint16>(wave.bitsPerSample);
-
-                    format.setSampleType(bps == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt);
-                    format.setByteOrder(QAudioFormat::BigEndian);
-                    format.setSampleRate(qFromBigEndian<quint32>(wave.sampleRate));
-                    format.setSampleSize(bps);
-                    format.setChannelCount(qFromBigEndian<quint16>(wave.numChannels));
-                } else {
-                    int bps = qFromLittleEndian<quint16>(wave.bitsPerSample);
-
-                    format.setSampleType(bps == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt);
-                    format.setByteOrder(QAudioFormat::LittleEndian);
-                    format.setSampleRate(qFromLittleEndian<quint32>(wave.sampleRate));
-                    format.setSampleSize(bps);
-                    format.setChannelCount(qFromLittleEndian<quint16>(wave.numChannels));
-                }
-
-                state = QWaveDecoder::WaitingForDataState;
             }
+
+            state = QWaveDecoder::WaitingForDataState;
         }
     }
 
@@ -210,7 +247,13 @@ void QWaveDecoder::handleData()
             else
                 descriptor.size = qFromLittleEndian<quint32>(descriptor.size);
 
-            dataSize = descriptor.size;
+            // RF64 files give the size in the ds64 chunk.
+            if (descriptor.size == 0xffffffff && ds64DataSize >= 0)
+                dataSize = ds64DataSize;
+            else
+                dataSize = descriptor.size;
+            dataStart = source->isSequential() ? -1 : source->pos();
+            dataPos = 0;
 
             haveFormat = true;
             connect(source, SIGNAL(readyRead()), SIGNAL(readyRead()));
@@ -226,6 +269,46 @@ void QWaveDecoder::handleData()
     }
 }
 
+bool QWaveDecoder::parseFormat(const QByteArray &chunkData)
+{
+    if (chunkData.size() < int(sizeof(WAVEHeader)))
+        return false;
+
+    const char *data = chunkData.constData();
+    quint16 audioFormat = fromFileEndian<quint16>(data + offsetof(WAVEHeader, audioFormat));
+    const int channelCount = fromFileEndian<quint16>(data + offsetof(WAVEHeader, numChannels));
+    const int sampleRate = fromFileEndian<quint32>(data + offsetof(WAVEHeader, sampleRate));
+    const int bps = fromFileEndian<quint16>(data + offsetof(WAVEHeader, bitsPerSample));
+
+    if (audioFormat == WaveFormatExtensible) {
+        // The actual format is the first field of the sub format GUID, the samples
+        // are always stored in containers of bitsPerSample bits.
+        if (chunkData.size() < int(sizeof(WAVEHeader) + sizeof(WAVEExtension)))
+            return false;
+        audioFormat = fromFileEndian<quint32>(data + sizeof(WAVEHeader) + offsetof(WAVEExtension, subFormat));
+    }
+
+    QAudioFormat::SampleType sampleType;
+    if (audioFormat == 0 || audioFormat == WaveFormatPcm)
+        sampleType = bps == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt;
+    else if (audioFormat == WaveFormatIeeeFloat && bps == 32)
+        sampleType = QAudioFormat::Float;
+    else
+        return false;
+
+    if (channelCount == 0 || sampleRate == 0 || bps == 0 || bps % 8 != 0)
+        return false;
+
+    format.setCodec(QLatin1String("audio/pcm"));
+    format.setSampleType(sampleType);
+    format.setByteOrder(bigEndian ? QAudioFormat::BigEndian : QAudioFormat::LittleEndian);
+    format.setSampleRate(sampleRate);
+    format.setSampleSize(bps);
+    format.setChannelCount(channelCount);
+
+    return true;
+}
+
 bool QWaveDecoder::enoughDataAvailable()
 {
     chunk descriptor;
@@ -236,9 +319,14 @@ bool QWaveDecoder::enoughDataAvailable()
     // so we have to manually swizzle
     if (qstrncmp(descriptor.id, "RIFX", 4) == 0)
         descriptor.size = qFromBigEndian<quint32>(descriptor.size);
-    if (qstrncmp(descriptor.id, "RIFF", 4) == 0)
+    if (qstrncmp(descriptor.id, "RIFF", 4) == 0 || qstrncmp(descriptor.id, "RF64", 4) == 0)
         descriptor.size = qFromLittleEndian<quint32>(descriptor.size);
 
+    // The real size of an RF64 file follows in its ds64 chunk, a random access
+    // device has all of it available anyway.
+    if (descriptor.size == 0xffffffff && !source->isSequential())
+        return source->bytesAvailable() >= qint64(sizeof(RIFFHeader));
+
     if (source->bytesAvailable() < qint64(sizeof(chunk) + descriptor.size))
         return false;
 
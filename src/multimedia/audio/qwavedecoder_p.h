@@ -52,6 +52,7 @@
 //
 
 #include <QtCore/qiodevice.h>
+#include <QtCore/qendian.h>
 #include <qaudioformat.h>
 
 
@@ -69,10 +70,12 @@ public:
 
     QAudioFormat audioFormat() const;
     int duration() const;
+    qint64 dataOffset() const;
 
     qint64 size() const override;
     bool isSequential() const override;
     qint64 bytesAvailable() const override;
+    bool seek(qint64 pos) override;
 
 Q_SIGNALS:
     void formatKnown();
@@ -89,13 +92,27 @@ private:
     bool findChunk(const char *chunkId);
     void discardBytes(qint64 numBytes);
     void parsingFailed();
+    bool parseFormat(const QByteArray &chunkData);
+
+    template <typename T>
+    T fromFileEndian(const char *data) const
+    {
+        return bigEndian ? qFromBigEndian<T>(data) : qFromLittleEndian<T>(data);
+    }
 
     enum State {
         InitialState,
+        WaitingForDataSizeState,
         WaitingForFormatState,
         WaitingForDataState
     };
 
+    enum FormatTag {
+        WaveFormatPcm = 0x0001,
+        WaveFormatIeeeFloat = 0x0003,
+        WaveFormatExtensible = 0xfffe
+    };
+
     struct chunk
     {
         char        id[4];
@@ -118,9 +135,32 @@ private:
         quint16     blockAlign;
         quint16     bitsPerSample;
     };
+    // WAVE_FORMAT_EXTENSIBLE, following the WAVEHeader fields
+    struct WAVEExtension
+    {
+        quint16     size;
+        quint16     validBitsPerSample;
+        quint32     channelMask;
+        char        subFormat[16];
+    };
+    // The 64 bit sizes of an RF64 file, its RIFF and data chunk sizes are 0xffffffff
+    struct DS64Header
+    {
+        chunk       descriptor;
+        quint32     riffSizeLow;
+        quint32     riffSizeHigh;
+        quint32     dataSizeLow;
+        quint32     dataSizeHigh;
+        quint32     sampleCountLow;
+        quint32     sampleCountHigh;
+        quint32     tableLength;
+    };
 
     bool haveFormat;
     qint64 dataSize;
+    qint64 dataStart;
+    qint64 dataPos;
+    qint64 ds64DataSize;
     QAudioFormat format;
     QIODevice *source;
     State state;
@@ -22,6 +22,9 @@ PUBLIC_HEADERS += \
     controls/qimageencodercontrol.h \
     controls/qmediacontainercontrol.h \
     controls/qmediagaplessplaybackcontrol.h \
+    controls/qmediapreparationcontrol.h \
+    controls/qmediaseekcontrol.h \
+    controls/qmediathumbnailcontrol.h \
     controls/qmedianetworkaccesscontrol.h \
     controls/qmediaplayercontrol.h \
     controls/qmediarecordercontrol.h \
@@ -61,6 +64,9 @@ SOURCES += \
     controls/qimageencodercontrol.cpp \
     controls/qmediacontainercontrol.cpp \
     controls/qmediagaplessplaybackcontrol.cpp \
+    controls/qmediapreparationcontrol.cpp \
+    controls/qmediaseekcontrol.cpp \
+    controls/qmediathumbnailcontrol.cpp \
     controls/qmedianetworkaccesscontrol.cpp \
     controls/qmediaplayercontrol.cpp \
     controls/qmediaplaylistcontrol.cpp \
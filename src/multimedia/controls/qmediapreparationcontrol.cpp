@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediacontrol_p.h"
+#include "qmediapreparationcontrol.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaPreparationControl
+    \inmodule QtMultimedia
+    \ingroup multimedia_control
+    \since 5.13
+
+    \brief The QMediaPreparationControl class provides access to media loaded
+    ahead of time by a media service.
+
+    A media service implementing this control can load a media in the background,
+    while the current media keeps playing. When the media player is later asked to
+    play the prepared media, the service switches to it without having to build and
+    preroll a new pipeline first.
+
+    The functionality provided by this control is exposed to application code through the
+    QMediaPlayer class.
+
+    The interface name of QMediaPreparationControl is \c org.qt-project.qt.mediapreparationcontrol/5.13 as
+    defined in QMediaPreparationControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaPlayer
+*/
+
+/*!
+    \macro QMediaPreparationControl_iid
+
+    \c org.qt-project.qt.mediapreparationcontrol/5.13
+
+    Defines the interface name of the QMediaPreparationControl class.
+
+    \relates QMediaPreparationControl
+*/
+
+/*!
+    Construct a QMediaPreparationControl with the given \a parent.
+*/
+QMediaPreparationControl::QMediaPreparationControl(QObject *parent)
+    : QMediaControl(*new QMediaControlPrivate, parent)
+{
+}
+
+/*!
+    Destroys the media preparation control.
+*/
+QMediaPreparationControl::~QMediaPreparationControl()
+{
+}
+
+/*!
+    \fn QMediaContent QMediaPreparationControl::preparedMedia() const
+
+    Returns the media being prepared, or a null QMediaContent if there is none.
+*/
+
+/*!
+    \fn void QMediaPreparationControl::setPreparedMedia(const QMediaContent &media)
+
+    Starts loading \a media in the background, replacing any media prepared before.
+    Passing a null QMediaContent discards the prepared media.
+
+    The prepared media is consumed when the media player control is set to the same
+    media.
+*/
+
+/*!
+    \fn void QMediaPreparationControl::preparedMediaChanged(const QMediaContent &media)
+
+    Signals that the prepared \a media has changed, either because it was replaced,
+    discarded after an error, or consumed by the media player control.
+*/
+
+#include "moc_qmediapreparationcontrol.cpp"
+QT_END_NAMESPACE
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediacontrol_p.h"
+#include "qmediaseekcontrol.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaSeekControl
+    \inmodule QtMultimedia
+    \ingroup multimedia_control
+    \since 5.13
+
+    \brief The QMediaSeekControl class controls how a media player seeks.
+
+    By default a media service picks its own trade-off between speed and precision
+    when the playback position is changed. This control lets an application ask
+    for fast seeks that land on the closest key frame, which is what a user dragging
+    a position slider usually wants, or for frame accurate seeks, which are slower
+    but land exactly on the requested position.
+
+    The flags apply to all the following calls to QMediaPlayerControl::setPosition().
+
+    The interface name of QMediaSeekControl is \c org.qt-project.qt.mediaseekcontrol/5.13 as
+    defined in QMediaSeekControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaPlayer
+*/
+
+/*!
+    \macro QMediaSeekControl_iid
+
+    \c org.qt-project.qt.mediaseekcontrol/5.13
+
+    Defines the interface name of the QMediaSeekControl class.
+
+    \relates QMediaSeekControl
+*/
+
+/*!
+    \enum QMediaSeekControl::SeekFlag
+
+    \value NoSeekFlags  The media service uses its default seeking behavior.
+    \value KeyUnit      Seek to the key frame closest to the requested position, which
+                        is fast since no frame has to be decoded and dropped.
+    \value SnapBefore   Combined with KeyUnit, seek to the key frame before the
+                        requested position.
+    \value SnapAfter    Combined with KeyUnit, seek to the key frame after the
+                        requested position.
+    \value Accurate     Seek exactly to the requested position, decoding from the
+                        previous key frame if needed.
+*/
+
+/*!
+    Construct a QMediaSeekControl with the given \a parent.
+*/
+QMediaSeekControl::QMediaSeekControl(QObject *parent)
+    : QMediaControl(*new QMediaControlPrivate, parent)
+{
+}
+
+/*!
+    Destroys the media seek control.
+*/
+QMediaSeekControl::~QMediaSeekControl()
+{
+}
+
+/*!
+    \fn QMediaSeekControl::SeekFlags QMediaSeekControl::seekFlags() const
+
+    Returns the flags used when the playback position is changed.
+*/
+
+/*!
+    \fn void QMediaSeekControl::setSeekFlags(QMediaSeekControl::SeekFlags flags)
+
+    Sets the \a flags used when the playback position is changed.
+*/
+
+/*!
+    \fn void QMediaSeekControl::seekFlagsChanged(QMediaSeekControl::SeekFlags flags)
+
+    Signals that the seek \a flags have changed.
+*/
+
+#include "moc_qmediaseekcontrol.cpp"
+QT_END_NAMESPACE
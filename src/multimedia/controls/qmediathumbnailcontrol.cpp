@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediacontrol_p.h"
+#include "qmediathumbnailcontrol.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaThumbnailControl
+    \inmodule QtMultimedia
+    \ingroup multimedia_control
+    \since 5.13
+
+    \brief The QMediaThumbnailControl class grabs frames of the current media
+    without rendering them.
+
+    A media service implementing this control decodes frames of the media being
+    played at arbitrary positions, in the background and independently from the
+    playback. It is meant for timeline scrubbing and similar user interfaces which
+    need many small previews of a media.
+
+    Grabbed frames are kept in a cache, repeated requests for the same position and
+    size are answered without decoding again. The cache is cleared when the media
+    changes.
+
+    The interface name of QMediaThumbnailControl is \c org.qt-project.qt.mediathumbnailcontrol/5.13 as
+    defined in QMediaThumbnailControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaSeekControl
+*/
+
+/*!
+    \macro QMediaThumbnailControl_iid
+
+    \c org.qt-project.qt.mediathumbnailcontrol/5.13
+
+    Defines the interface name of the QMediaThumbnailControl class.
+
+    \relates QMediaThumbnailControl
+*/
+
+/*!
+    Construct a QMediaThumbnailControl with the given \a parent.
+*/
+QMediaThumbnailControl::QMediaThumbnailControl(QObject *parent)
+    : QMediaControl(*new QMediaControlPrivate, parent)
+{
+}
+
+/*!
+    Destroys the media thumbnail control.
+*/
+QMediaThumbnailControl::~QMediaThumbnailControl()
+{
+}
+
+/*!
+    \fn int QMediaThumbnailControl::requestThumbnail(qint64 position, const QSize &size, QMediaSeekControl::SeekFlags flags)
+
+    Requests the frame at \a position, in milliseconds, of the current media,
+    scaled to fit into \a size while keeping its aspect ratio. The \a flags select
+    how precisely the frame is looked up, QMediaSeekControl::KeyUnit being the
+    fastest.
+
+    Returns an identifier for the request. The result is delivered asynchronously
+    through the thumbnailReady() signal, even when it comes from the cache.
+*/
+
+/*!
+    \fn void QMediaThumbnailControl::cancelRequests()
+
+    Drops all the requests which haven't been processed yet. No thumbnailReady()
+    signal is emitted for them.
+*/
+
+/*!
+    \fn int QMediaThumbnailControl::cacheLimit() const
+
+    Returns the maximum size of the thumbnail cache, in kilobytes.
+*/
+
+/*!
+    \fn void QMediaThumbnailControl::setCacheLimit(int kilobytes)
+
+    Sets the maximum size of the thumbnail cache to \a kilobytes. A limit of 0
+    disables the cache.
+*/
+
+/*!
+    \fn void QMediaThumbnailControl::thumbnailReady(int id, qint64 position, const QImage &image)
+
+    Signals that the thumbnail for the request \a id at \a position is available as
+    \a image. The image is null if the frame could not be decoded.
+*/
+
+#include "moc_qmediathumbnailcontrol.cpp"
+QT_END_NAMESPACE
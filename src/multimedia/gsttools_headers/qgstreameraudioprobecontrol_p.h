@@ -59,6 +59,7 @@
 #include <qshareddata.h>
 
 #include <private/qgstreamerbufferprobe_p.h>
+#include <private/qmediaprobedelivery_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,8 +67,10 @@ class Q_GSTTOOLS_EXPORT QGstreamerAudioProbeControl
     : public QMediaAudioProbeControl
     , public QGstreamerBufferProbe
     , public QSharedData
+    , public QMediaProbeQueue<QAudioBuffer>
 {
     Q_OBJECT
+    Q_INTERFACES(QMediaProbeDelivery)
 public:
     explicit QGstreamerAudioProbeControl(QObject *parent);
     virtual ~QGstreamerAudioProbeControl();
@@ -80,7 +83,6 @@ private slots:
     void bufferProbed();
 
 private:
-    QAudioBuffer m_pendingBuffer;
     QAudioFormat m_format;
     QMutex m_bufferMutex;
 };
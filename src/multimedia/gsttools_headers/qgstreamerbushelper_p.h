@@ -89,12 +89,16 @@ public:
     QGstreamerBusHelper(GstBus* bus, QObject* parent = 0);
     ~QGstreamerBusHelper();
 
-    void installMessageFilter(QObject *filter);
+    void installMessageFilter(QObject *filter, GstMessageType types = GST_MESSAGE_ANY);
     void removeMessageFilter(QObject *filter);
 
 signals:
     void message(QGstreamerMessage const& message);
 
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
 private:
     QGstreamerBusHelperPrivate*   d;
 };
@@ -93,6 +93,10 @@ public:
     QMediaContent media() const override;
     const QIODevice *mediaStream() const override;
     void setMedia(const QMediaContent&, QIODevice *) override;
+    void advanceToNextMedia(const QMediaContent &content);
+
+    QGstreamerPlayerSession *preparedSession() const { return m_preparedSession; }
+    void setPreparedSession(QGstreamerPlayerSession *session, const QMediaContent &content);
 
     QMediaPlayerResourceSetInterface* resources() const;
 
@@ -106,6 +110,9 @@ public Q_SLOTS:
     void setVolume(int volume) override;
     void setMuted(bool muted) override;
 
+Q_SIGNALS:
+    void sessionChanged(QGstreamerPlayerSession *session, QGstreamerPlayerSession *previous);
+
 private Q_SLOTS:
     void updateSessionState(QMediaPlayer::State state);
     void updateMediaStatus();
@@ -120,6 +127,8 @@ private Q_SLOTS:
 
 private:
     void playOrPause(QMediaPlayer::State state);
+    void connectSession();
+    void switchToPreparedSession();
 
     void pushState();
     void popAndNotifyState();
@@ -137,6 +146,9 @@ private:
     QMediaContent m_currentResource;
     QIODevice *m_stream;
 
+    QGstreamerPlayerSession *m_preparedSession;
+    QMediaContent m_preparedResource;
+
     QMediaPlayerResourceSetInterface *m_resources;
 };
 
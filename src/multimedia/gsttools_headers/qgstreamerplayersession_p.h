@@ -59,6 +59,7 @@
 #include <private/qgstreamerbushelper_p.h>
 #include <qmediaplayer.h>
 #include <qmediastreamscontrol.h>
+#include <qmediaseekcontrol.h>
 #include <qaudioformat.h>
 
 #if QT_CONFIG(gstreamer_app)
@@ -99,6 +100,9 @@ public:
 
     QNetworkRequest request() const;
 
+    QUrl nextUri() const;
+    void setNextUri(const QUrl &uri);
+
     QMediaPlayer::State state() const { return m_state; }
     QMediaPlayer::State pendingState() const { return m_pendingState; }
 
@@ -111,6 +115,7 @@ public:
     bool isAudioAvailable() const;
 
     void setVideoRenderer(QObject *renderer);
+    QObject *videoOutput() const { return m_videoOutput; }
     QGstreamerVideoRendererInterface *renderer() const { return m_renderer; }
     bool isVideoAvailable() const;
 
@@ -119,6 +124,9 @@ public:
     qreal playbackRate() const;
     void setPlaybackRate(qreal rate);
 
+    QMediaSeekControl::SeekFlags seekFlags() const { return m_seekFlags; }
+    void setSeekFlags(QMediaSeekControl::SeekFlags flags) { m_seekFlags = flags; }
+
     QMediaTimeRange availablePlaybackRanges() const;
 
     QMap<QByteArray ,QVariant> tags() const { return m_tags; }
@@ -145,6 +153,7 @@ public:
     void removeProbe(QGstreamerAudioProbeControl* probe);
 
     void endOfMediaReset();
+    void warmUp();
 
 public slots:
     void loadFromUri(const QNetworkRequest &url);
@@ -178,6 +187,7 @@ signals:
     void playbackRateChanged(qreal);
     void rendererChanged();
     void pipelineChanged();
+    void advancedToNextUri(const QUrl &uri);
 
 private slots:
     void getStreamsInfo();
@@ -188,6 +198,7 @@ private slots:
     void updateVolume();
     void updateMuted();
     void updateDuration();
+    void finishGaplessTransition();
 
 private:
     static void playbinNotifySource(GObject *o, GParamSpec *p, gpointer d);
@@ -198,6 +209,7 @@ private:
 #endif
     static void handleElementAdded(GstBin *bin, GstElement *element, QGstreamerPlayerSession *session);
     static void handleStreamsChange(GstBin *bin, gpointer user_data);
+    static void handleAboutToFinish(GstElement *playbin, gpointer user_data);
     static GstAutoplugSelectResult handleAutoplugSelect(GstBin *bin, GstPad *pad, GstCaps *caps, GstElementFactory *factory, QGstreamerPlayerSession *session);
 
     void processInvalidMedia(QMediaPlayer::Error errorCode, const QString& errorString);
@@ -206,12 +218,17 @@ private:
     void addVideoBufferProbe();
     void removeAudioBufferProbe();
     void addAudioBufferProbe();
-    void flushVideoProbes();
-    void resumeVideoProbes();
+    void flushProbes();
+    void resumeProbes();
+    void resetProbeCounters();
     bool parsePipeline();
     bool setPipeline(GstElement *pipeline);
 
     QNetworkRequest m_request;
+    // Guards the uris handed to playbin from its streaming thread.
+    mutable QMutex m_nextUriMutex;
+    QUrl m_nextUri;
+    QUrl m_queuedUri;
     QMediaPlayer::State m_state;
     QMediaPlayer::State m_pendingState;
     QGstreamerBusHelper* m_busHelper;
@@ -250,6 +267,7 @@ private:
 
     int m_volume;
     qreal m_playbackRate;
+    QMediaSeekControl::SeekFlags m_seekFlags;
     bool m_muted;
     bool m_audioAvailable;
     bool m_videoAvailable;
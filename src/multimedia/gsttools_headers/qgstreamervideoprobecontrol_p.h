@@ -60,6 +60,7 @@
 #include <qvideosurfaceformat.h>
 
 #include <private/qgstreamerbufferprobe_p.h>
+#include <private/qmediaprobedelivery_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -67,8 +68,10 @@ class Q_GSTTOOLS_EXPORT QGstreamerVideoProbeControl
     : public QMediaVideoProbeControl
     , public QGstreamerBufferProbe
     , public QSharedData
+    , public QMediaProbeQueue<QVideoFrame>
 {
     Q_OBJECT
+    Q_INTERFACES(QMediaProbeDelivery)
 public:
     explicit QGstreamerVideoProbeControl(QObject *parent);
     virtual ~QGstreamerVideoProbeControl();
@@ -84,14 +87,12 @@ private slots:
 
 private:
     QVideoSurfaceFormat m_format;
-    QVideoFrame m_pendingFrame;
     QMutex m_frameMutex;
 #if GST_CHECK_VERSION(1,0,0)
     GstVideoInfo m_videoInfo;
 #else
     int m_bytesPerLine;
 #endif
-    bool m_flushing;
     bool m_frameProbed; // true if at least one frame was probed
 };
 
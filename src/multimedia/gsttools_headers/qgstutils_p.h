@@ -59,6 +59,7 @@
 #include <gst/video/video.h>
 #include <qaudioformat.h>
 #include <qcamera.h>
+#include <qmediaseekcontrol.h>
 #include <qabstractvideobuffer.h>
 #include <qvideoframe.h>
 #include <QDebug>
@@ -148,6 +149,8 @@ namespace QGstUtils {
     Q_GSTTOOLS_EXPORT QPair<qreal, qreal> structureFrameRateRange(const GstStructure *s);
 
     Q_GSTTOOLS_EXPORT QString fileExtensionForMimeType(const QString &mimeType);
+
+    Q_GSTTOOLS_EXPORT GstSeekFlags seekFlags(QMediaSeekControl::SeekFlags flags);
 }
 
 Q_GSTTOOLS_EXPORT void qt_gst_object_ref_sink(gpointer object);
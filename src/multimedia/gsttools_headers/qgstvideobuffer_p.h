@@ -89,6 +89,11 @@ public:
     void unmap() override;
 
     QVariant handle() const override { return m_handle; }
+
+#if GST_CHECK_VERSION(1,0,0)
+    static QVariant dmaBufHandle(GstBuffer *buffer, const GstVideoInfo &info);
+#endif
+
 private:
 #if GST_CHECK_VERSION(1,0,0)
     GstVideoInfo m_videoInfo;
@@ -89,6 +89,7 @@ private:
     QVideoSurfaceFormat m_format;
     GstVideoInfo m_videoInfo;
     bool m_flushed;
+    bool m_exportDmaBuf;
 };
 
 class QVideoSurfaceGstDelegate : public QObject
@@ -26,6 +26,8 @@ PRIVATE_HEADERS += \
     qmediaresourceset_p.h \
     qmediastoragelocation_p.h \
     qmediaopenglhelper_p.h \
+    qmediaprobedelivery_p.h \
+    qmultimediatrace_p.h \
     qmultimediautils_p.h
 
 PUBLIC_HEADERS += \
@@ -46,6 +48,7 @@ SOURCES += \
     qmediametadata.cpp \
     qmediaobject.cpp \
     qmediapluginloader.cpp \
+    qmediaprobedelivery.cpp \
     qmediaservice.cpp \
     qmediaserviceprovider.cpp \
     qmediatimerange.cpp \
@@ -54,10 +57,14 @@ SOURCES += \
     qmediaresourceset_p.cpp \
     qmediastoragelocation.cpp \
     qmultimedia.cpp \
+    qmultimediatrace.cpp \
     qmultimediautils.cpp
 
 CONFIG += simd optimize_full
 
+TRACEPOINT_PROVIDER = $$PWD/qtmultimedia.tracepoints
+CONFIG += qt_tracepoints
+
 include(audio/audio.pri)
 include(camera/camera.pri)
 include(controls/controls.pri)
@@ -44,8 +44,44 @@
 #include "qplaylistfileparser_p.h"
 #include "qrandom.h"
 
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
+// Most playlist entries are plain URLs. Those are kept as a QUrl, which is a
+// single shared pointer, and only turned into a QMediaContent when accessed.
+// Anything else, like a content with several resources or a playlist, is
+// kept as is.
+class QMediaNetworkPlaylistEntry
+{
+public:
+    QMediaNetworkPlaylistEntry()
+    {
+    }
+
+    explicit QMediaNetworkPlaylistEntry(const QMediaContent &content)
+    {
+        const QUrl url = content.canonicalUrl();
+        if (!url.isEmpty() && content == QMediaContent(url))
+            m_url = url;
+        else
+            m_content = content;
+    }
+
+    QMediaContent content() const
+    {
+        return m_url.isEmpty() ? m_content : QMediaContent(m_url);
+    }
+
+private:
+    QUrl m_url;
+    QMediaContent m_content;
+};
+
+Q_DECLARE_TYPEINFO(QMediaNetworkPlaylistEntry, Q_MOVABLE_TYPE);
+
 class QMediaNetworkPlaylistProviderPrivate: public QMediaPlaylistProviderPrivate
 {
     Q_DECLARE_NON_CONST_PUBLIC(QMediaNetworkPlaylistProvider)
@@ -53,10 +89,15 @@ public:
     bool load(const QNetworkRequest &request);
 
     QPlaylistFileParser parser;
-    QList<QMediaContent> resources;
+    QVector<QMediaNetworkPlaylistEntry> resources;
+    // Items read by the parser, added to the playlist in batches.
+    QList<QMediaContent> pendingItems;
+
+    void addPendingItems();
 
     void _q_handleParserError(QPlaylistFileParser::ParserError err, const QString &);
     void _q_handleNewItem(const QVariant& content);
+    void _q_handleFinished();
 
     QMediaNetworkPlaylistProvider *q_ptr;
 };
@@ -64,11 +105,24 @@ public:
 bool QMediaNetworkPlaylistProviderPrivate::load(const QNetworkRequest &request)
 {
     parser.abort();
+    addPendingItems();
     parser.start(request);
 
     return true;
 }
 
+void QMediaNetworkPlaylistProviderPrivate::addPendingItems()
+{
+    Q_Q(QMediaNetworkPlaylistProvider);
+
+    if (pendingItems.isEmpty())
+        return;
+
+    const QList<QMediaContent> items = pendingItems;
+    pendingItems.clear();
+    q->addMedia(items);
+}
+
 void QMediaNetworkPlaylistProviderPrivate::_q_handleParserError(QPlaylistFileParser::ParserError err, const QString &errorMessage)
 {
     Q_Q(QMediaNetworkPlaylistProvider);
@@ -92,6 +146,7 @@ void QMediaNetworkPlaylistProviderPrivate::_q_handleParserError(QPlaylistFilePar
     }
 
     parser.abort();
+    addPendingItems();
 
     emit q->loadFailed(playlistError, errorMessage);
 }
@@ -109,7 +164,19 @@ void QMediaNetworkPlaylistProviderPrivate::_q_handleNewItem(const QVariant& cont
         return;
     }
 
-    q->addMedia(QMediaContent(url));
+    pendingItems.append(QMediaContent(url));
+
+    // Large playlists are added in a few batches rather than item by item.
+    if (pendingItems.count() >= 1024)
+        addPendingItems();
+}
+
+void QMediaNetworkPlaylistProviderPrivate::_q_handleFinished()
+{
+    Q_Q(QMediaNetworkPlaylistProvider);
+
+    addPendingItems();
+    emit q->loaded();
 }
 
 QMediaNetworkPlaylistProvider::QMediaNetworkPlaylistProvider(QObject *parent)
@@ -118,7 +185,7 @@ QMediaNetworkPlaylistProvider::QMediaNetworkPlaylistProvider(QObject *parent)
     d_func()->q_ptr = this;
     connect(&d_func()->parser, SIGNAL(newItem(QVariant)),
             this, SLOT(_q_handleNewItem(QVariant)));
-    connect(&d_func()->parser, SIGNAL(finished()), this, SIGNAL(loaded()));
+    connect(&d_func()->parser, SIGNAL(finished()), this, SLOT(_q_handleFinished()));
     connect(&d_func()->parser, SIGNAL(error(QPlaylistFileParser::ParserError,QString)),
             this, SLOT(_q_handleParserError(QPlaylistFileParser::ParserError,QString)));
 }
@@ -145,7 +212,7 @@ int QMediaNetworkPlaylistProvider::mediaCount() const
 
 QMediaContent QMediaNetworkPlaylistProvider::media(int pos) const
 {
-    return d_func()->resources.value(pos);
+    return d_func()->resources.value(pos).content();
 }
 
 bool QMediaNetworkPlaylistProvider::addMedia(const QMediaContent &content)
@@ -155,7 +222,7 @@ bool QMediaNetworkPlaylistProvider::addMedia(const QMediaContent &content)
     int pos = d->resources.count();
 
     emit mediaAboutToBeInserted(pos, pos);
-    d->resources.append(content);
+    d->resources.append(QMediaNetworkPlaylistEntry(content));
     emit mediaInserted(pos, pos);
 
     return true;
@@ -168,14 +235,7 @@ bool QMediaNetworkPlaylistProvider::addMedia(const QList<QMediaContent> &items)
     if (items.isEmpty())
         return true;
 
-    int pos = d->resources.count();
-    int end = pos+items.count()-1;
-
-    emit mediaAboutToBeInserted(pos, end);
-    d->resources.append(items);
-    emit mediaInserted(pos, end);
-
-    return true;
+    return insertMedia(d->resources.count(), items);
 }
 
 
@@ -184,7 +244,7 @@ bool QMediaNetworkPlaylistProvider::insertMedia(int pos, const QMediaContent &co
     Q_D(QMediaNetworkPlaylistProvider);
 
     emit mediaAboutToBeInserted(pos, pos);
-    d->resources.insert(pos, content);
+    d->resources.insert(pos, QMediaNetworkPlaylistEntry(content));
     emit mediaInserted(pos,pos);
 
     return true;
@@ -200,8 +260,9 @@ bool QMediaNetworkPlaylistProvider::insertMedia(int pos, const QList<QMediaConte
     const int last = pos+items.count()-1;
 
     emit mediaAboutToBeInserted(pos, last);
+    d->resources.insert(pos, items.count(), QMediaNetworkPlaylistEntry());
     for (int i=0; i<items.count(); i++)
-        d->resources.insert(pos+i, items.at(i));
+        d->resources[pos+i] = QMediaNetworkPlaylistEntry(items.at(i));
     emit mediaInserted(pos, last);
 
     return true;
@@ -217,8 +278,17 @@ bool QMediaNetworkPlaylistProvider::moveMedia(int from, int to)
     if (from == to)
         return false;
 
-    const QMediaContent media = d->resources.at(from);
-    return removeMedia(from, from) && insertMedia(to, media);
+    const QMediaNetworkPlaylistEntry entry = d->resources.at(from);
+
+    emit mediaAboutToBeRemoved(from, from);
+    d->resources.remove(from);
+    emit mediaRemoved(from, from);
+
+    emit mediaAboutToBeInserted(to, to);
+    d->resources.insert(to, entry);
+    emit mediaInserted(to, to);
+
+    return true;
 }
 
 bool QMediaNetworkPlaylistProvider::removeMedia(int fromPos, int toPos)
@@ -230,7 +300,7 @@ bool QMediaNetworkPlaylistProvider::removeMedia(int fromPos, int toPos)
     Q_ASSERT(toPos < mediaCount());
 
     emit mediaAboutToBeRemoved(fromPos, toPos);
-    d->resources.erase(d->resources.begin()+fromPos, d->resources.begin()+toPos+1);
+    d->resources.remove(fromPos, toPos - fromPos + 1);
     emit mediaRemoved(fromPos, toPos);
 
     return true;
@@ -241,7 +311,7 @@ bool QMediaNetworkPlaylistProvider::removeMedia(int pos)
     Q_D(QMediaNetworkPlaylistProvider);
 
     emit mediaAboutToBeRemoved(pos, pos);
-    d->resources.removeAt(pos);
+    d->resources.remove(pos);
     emit mediaRemoved(pos, pos);
 
     return true;
@@ -264,13 +334,7 @@ void QMediaNetworkPlaylistProvider::shuffle()
 {
     Q_D(QMediaNetworkPlaylistProvider);
     if (!d->resources.isEmpty()) {
-        QList<QMediaContent> resources;
-
-        while (!d->resources.isEmpty()) {
-            resources.append(d->resources.takeAt(QRandomGenerator::global()->bounded(d->resources.size())));
-        }
-
-        d->resources = resources;
+        std::shuffle(d->resources.begin(), d->resources.end(), *QRandomGenerator::global());
         emit mediaChanged(0, mediaCount()-1);
     }
 
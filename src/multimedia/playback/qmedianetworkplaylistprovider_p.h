@@ -88,6 +88,7 @@ private:
     Q_DECLARE_PRIVATE(QMediaNetworkPlaylistProvider)
     Q_PRIVATE_SLOT(d_func(), void _q_handleParserError(QPlaylistFileParser::ParserError err, const QString &))
     Q_PRIVATE_SLOT(d_func(), void _q_handleNewItem(const QVariant& content))
+    Q_PRIVATE_SLOT(d_func(), void _q_handleFinished())
 };
 
 QT_END_NAMESPACE
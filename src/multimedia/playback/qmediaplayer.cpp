@@ -50,6 +50,8 @@
 #include <qmedianetworkaccesscontrol.h>
 #include <qaudiorolecontrol.h>
 #include <qcustomaudiorolecontrol.h>
+#include <qmediagaplessplaybackcontrol.h>
+#include <qmediapreparationcontrol.h>
 
 #include <QtCore/qcoreevent.h>
 #include <QtCore/qmetaobject.h>
@@ -113,6 +115,8 @@ public:
         , control(0)
         , audioRoleControl(0)
         , customAudioRoleControl(0)
+        , gaplessControl(0)
+        , preparationControl(0)
         , playlist(0)
         , networkAccessControl(0)
         , state(QMediaPlayer::StoppedState)
@@ -121,12 +125,15 @@ public:
         , ignoreNextStatusChange(-1)
         , nestedPlaylists(0)
         , hasStreamPlaybackFeature(false)
+        , advancingToNextMedia(false)
     {}
 
     QMediaServiceProvider *provider;
     QMediaPlayerControl* control;
     QAudioRoleControl *audioRoleControl;
     QCustomAudioRoleControl *customAudioRoleControl;
+    QMediaGaplessPlaybackControl *gaplessControl;
+    QMediaPreparationControl *preparationControl;
     QString errorString;
 
     QPointer<QObject> videoOutput;
@@ -144,6 +151,7 @@ public:
     int ignoreNextStatusChange;
     int nestedPlaylists;
     bool hasStreamPlaybackFeature;
+    bool advancingToNextMedia;
 
     QMediaPlaylist *parentPlaylist(QMediaPlaylist *pls);
     bool isInChain(const QUrl &url);
@@ -164,6 +172,8 @@ public:
     void _q_handleMediaChanged(const QMediaContent&);
     void _q_handlePlaylistLoaded();
     void _q_handlePlaylistLoadFailed();
+    void _q_updateNextMedia();
+    void _q_advancedToNextMedia();
 };
 
 QMediaPlaylist *QMediaPlayerPrivate::parentPlaylist(QMediaPlaylist *pls)
@@ -307,6 +317,12 @@ void QMediaPlayerPrivate::_q_updateMedia(const QMediaContent &media)
         return;
     }
 
+    if (advancingToNextMedia && media == control->media()) {
+        // The backend already switched to this media without interrupting playback.
+        _q_updateNextMedia();
+        return;
+    }
+
     const QMediaPlayer::State currentState = state;
 
     setMedia(media, 0);
@@ -397,6 +413,37 @@ void QMediaPlayerPrivate::setMedia(const QMediaContent &media, QIODevice *stream
     }
 
     qrcFile.swap(file); // Cleans up any previous file
+
+    _q_updateNextMedia();
+}
+
+void QMediaPlayerPrivate::_q_updateNextMedia()
+{
+    // Let a backend supporting gapless playback queue the next playlist item,
+    // so it can switch to it without tearing down the pipeline.
+    if (!gaplessControl)
+        return;
+
+    QMediaContent next;
+    if (playlist) {
+        const int nextIndex = playlist->nextIndex();
+        const QMediaContent media = nextIndex >= 0 ? playlist->media(nextIndex) : QMediaContent();
+        // Nested playlists and resource files need the frontend to load them.
+        if (!media.playlist() && media.canonicalUrl().scheme() != QLatin1String("qrc"))
+            next = media;
+    }
+
+    gaplessControl->setNextMedia(next);
+}
+
+void QMediaPlayerPrivate::_q_advancedToNextMedia()
+{
+    if (!playlist)
+        return;
+
+    advancingToNextMedia = true;
+    playlist->next();
+    advancingToNextMedia = false;
 }
 
 void QMediaPlayerPrivate::_q_handleMediaChanged(const QMediaContent &media)
@@ -481,6 +528,13 @@ void QMediaPlayerPrivate::disconnectPlaylist()
         QObject::disconnect(playlist, SIGNAL(currentMediaChanged(QMediaContent)),
                             q, SLOT(_q_updateMedia(QMediaContent)));
         QObject::disconnect(playlist, SIGNAL(destroyed()), q, SLOT(_q_playlistDestroyed()));
+        if (gaplessControl) {
+            QObject::disconnect(playlist, SIGNAL(mediaInserted(int,int)), q, SLOT(_q_updateNextMedia()));
+            QObject::disconnect(playlist, SIGNAL(mediaRemoved(int,int)), q, SLOT(_q_updateNextMedia()));
+            QObject::disconnect(playlist, SIGNAL(mediaChanged(int,int)), q, SLOT(_q_updateNextMedia()));
+            QObject::disconnect(playlist, SIGNAL(playbackModeChanged(QMediaPlaylist::PlaybackMode)),
+                                q, SLOT(_q_updateNextMedia()));
+        }
         q->unbind(playlist);
     }
 }
@@ -493,6 +547,13 @@ void QMediaPlayerPrivate::connectPlaylist()
         QObject::connect(playlist, SIGNAL(currentMediaChanged(QMediaContent)),
                          q, SLOT(_q_updateMedia(QMediaContent)));
         QObject::connect(playlist, SIGNAL(destroyed()), q, SLOT(_q_playlistDestroyed()));
+        if (gaplessControl) {
+            QObject::connect(playlist, SIGNAL(mediaInserted(int,int)), q, SLOT(_q_updateNextMedia()));
+            QObject::connect(playlist, SIGNAL(mediaRemoved(int,int)), q, SLOT(_q_updateNextMedia()));
+            QObject::connect(playlist, SIGNAL(mediaChanged(int,int)), q, SLOT(_q_updateNextMedia()));
+            QObject::connect(playlist, SIGNAL(playbackModeChanged(QMediaPlaylist::PlaybackMode)),
+                             q, SLOT(_q_updateNextMedia()));
+        }
     }
 }
 
@@ -616,6 +677,18 @@ QMediaPlayer::QMediaPlayer(QObject *parent, QMediaPlayer::Flags flags):
 
             d->hasStreamPlaybackFeature = d->provider->supportedFeatures(d->service).testFlag(QMediaServiceProviderHint::StreamPlayback);
 
+            d->gaplessControl = qobject_cast<QMediaGaplessPlaybackControl*>(
+                    d->service->requestControl(QMediaGaplessPlaybackControl_iid));
+            if (d->gaplessControl)
+                connect(d->gaplessControl, SIGNAL(advancedToNextMedia()), SLOT(_q_advancedToNextMedia()));
+
+            d->preparationControl = qobject_cast<QMediaPreparationControl*>(
+                    d->service->requestControl(QMediaPreparationControl_iid));
+            if (d->preparationControl) {
+                connect(d->preparationControl, &QMediaPreparationControl::preparedMediaChanged,
+                        this, &QMediaPlayer::preparedMediaChanged);
+            }
+
             d->audioRoleControl = qobject_cast<QAudioRoleControl*>(d->service->requestControl(QAudioRoleControl_iid));
             if (d->audioRoleControl) {
                 connect(d->audioRoleControl, &QAudioRoleControl::audioRoleChanged,
@@ -659,6 +732,10 @@ QMediaPlayer::~QMediaPlayer()
             d->service->releaseControl(d->audioRoleControl);
         if (d->customAudioRoleControl)
             d->service->releaseControl(d->customAudioRoleControl);
+        if (d->gaplessControl)
+            d->service->releaseControl(d->gaplessControl);
+        if (d->preparationControl)
+            d->service->releaseControl(d->preparationControl);
 
         d->provider->releaseService(d->service);
     }
@@ -719,6 +796,56 @@ void QMediaPlayer::setPlaylist(QMediaPlaylist *playlist)
     setMedia(m);
 }
 
+/*!
+    \since 5.13
+
+    Returns the media being loaded in the background, or a null QMediaContent if
+    there is none.
+
+    \sa prepareMedia()
+*/
+QMediaContent QMediaPlayer::preparedMedia() const
+{
+    Q_D(const QMediaPlayer);
+
+    if (d->preparationControl)
+        return d->preparationControl->preparedMedia();
+
+    return QMediaContent();
+}
+
+/*!
+    \since 5.13
+
+    Asks the media service to load \a media in the background, while the current
+    media keeps playing.
+
+    When \a media is later set with setMedia(), or becomes the current item of the
+    playlist, the player switches to it without building a new pipeline and waiting
+    for it to preroll. Preparing another media replaces the previous one, and a null
+    QMediaContent discards it.
+
+    Preparing media is only supported for plain URLs, and only by some media
+    services. The call has no effect otherwise.
+
+    \sa preparedMedia(), preparedMediaChanged()
+*/
+void QMediaPlayer::prepareMedia(const QMediaContent &media)
+{
+    Q_D(QMediaPlayer);
+
+    if (!d->preparationControl)
+        return;
+
+    // Playlists and resource files are resolved by the player itself when they are set.
+    if (media.playlist() || media.canonicalUrl().scheme() == QLatin1String("qrc")) {
+        qWarning("QMediaPlayer::prepareMedia: only plain URLs can be prepared");
+        return;
+    }
+
+    d->preparationControl->setPreparedMedia(media);
+}
+
 /*!
     Sets the network access points for remote media playback.
     \a configurations contains, in ascending preferential order, a list of
@@ -1346,6 +1473,18 @@ QStringList QMediaPlayer::supportedCustomAudioRoles() const
     \sa currentMedia(), mediaChanged()
 */
 
+/*!
+    \fn void QMediaPlayer::preparedMediaChanged(const QMediaContent &media);
+    \since 5.13
+
+    Signals that the media loaded in the background has changed to \a media.
+
+    The prepared media is cleared when the player switches to it, or when it fails
+    to load.
+
+    \sa prepareMedia(), preparedMedia()
+*/
+
 /*!
     \fn void QMediaPlayer::playbackRateChanged(qreal rate);
 
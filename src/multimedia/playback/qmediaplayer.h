@@ -136,6 +136,7 @@ public:
     const QIODevice *mediaStream() const;
     QMediaPlaylist *playlist() const;
     QMediaContent currentMedia() const;
+    QMediaContent preparedMedia() const;
 
     State state() const;
     MediaStatus mediaStatus() const;
@@ -180,12 +181,14 @@ public Q_SLOTS:
 
     void setMedia(const QMediaContent &media, QIODevice *stream = nullptr);
     void setPlaylist(QMediaPlaylist *playlist);
+    void prepareMedia(const QMediaContent &media);
 
     void setNetworkConfigurations(const QList<QNetworkConfiguration> &configurations);
 
 Q_SIGNALS:
     void mediaChanged(const QMediaContent &media);
     void currentMediaChanged(const QMediaContent &media);
+    void preparedMediaChanged(const QMediaContent &media);
 
     void stateChanged(QMediaPlayer::State newState);
     void mediaStatusChanged(QMediaPlayer::MediaStatus status);
@@ -224,6 +227,8 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_handleMediaChanged(const QMediaContent&))
     Q_PRIVATE_SLOT(d_func(), void _q_handlePlaylistLoaded())
     Q_PRIVATE_SLOT(d_func(), void _q_handlePlaylistLoadFailed())
+    Q_PRIVATE_SLOT(d_func(), void _q_updateNextMedia())
+    Q_PRIVATE_SLOT(d_func(), void _q_advancedToNextMedia())
 };
 
 QT_END_NAMESPACE
@@ -504,9 +504,13 @@ void QMediaPlaylistPrivate::syncControls(QMediaPlaylistControl *oldControl, QMed
     } else {
         const int oldPlaylistSize = oldPlaylist->mediaCount();
 
-        newPlaylist->clear();
+        QList<QMediaContent> items;
+        items.reserve(oldPlaylistSize);
         for (int i = 0; i < oldPlaylistSize; ++i)
-            newPlaylist->addMedia(oldPlaylist->media(i));
+            items.append(oldPlaylist->media(i));
+
+        newPlaylist->clear();
+        newPlaylist->addMedia(items);
     }
 
     newControl->setPlaybackMode(oldControl->playbackMode());
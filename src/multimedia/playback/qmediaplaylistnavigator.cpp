@@ -44,6 +44,10 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qrandom.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -67,7 +71,7 @@ public:
         currentPos(-1),
         lastValidPos(-1),
         playbackMode(QMediaPlaylist::Sequential),
-        randomPositionsOffset(-1)
+        randomOffset(-1)
     {
     }
 
@@ -77,8 +81,17 @@ public:
     QMediaPlaylist::PlaybackMode playbackMode;
     QMediaContent currentItem;
 
-    mutable QList<int> randomModePositions;
-    mutable int randomPositionsOffset;
+    // Random mode plays the items in the order of a shuffled permutation of
+    // the playlist, randomOffset being the index of the current item in it.
+    // The permutation is built on first use and dropped whenever the playlist
+    // changes, so each item is played once per cycle and the history stays
+    // consistent when going back and forth.
+    mutable QVector<int> randomOrder;
+    mutable int randomOffset;
+
+    void resetRandomOrder();
+    void ensureRandomOrder() const;
+    int randomItemPos(int steps) const;
 
     int nextItemPos(int steps = 1) const;
     int previousItemPos(int steps = 1) const;
@@ -90,6 +103,44 @@ public:
     QMediaPlaylistNavigator *q_ptr;
 };
 
+void QMediaPlaylistNavigatorPrivate::resetRandomOrder()
+{
+    randomOrder.clear();
+    randomOffset = -1;
+}
+
+void QMediaPlaylistNavigatorPrivate::ensureRandomOrder() const
+{
+    const int count = playlist->mediaCount();
+    if (randomOrder.size() == count)
+        return;
+
+    randomOrder.resize(count);
+    std::iota(randomOrder.begin(), randomOrder.end(), 0);
+    std::shuffle(randomOrder.begin(), randomOrder.end(), *QRandomGenerator::global());
+
+    if (currentPos >= 0 && currentPos < count) {
+        // Start the cycle from the current item.
+        std::iter_swap(randomOrder.begin(),
+                       std::find(randomOrder.begin(), randomOrder.end(), currentPos));
+        randomOffset = 0;
+    } else {
+        // Nothing is current yet, the next item is the first one of the cycle.
+        randomOffset = count - 1;
+    }
+}
+
+int QMediaPlaylistNavigatorPrivate::randomItemPos(int steps) const
+{
+    ensureRandomOrder();
+
+    const int count = randomOrder.size();
+    int offset = (randomOffset + steps) % count;
+    if (offset < 0)
+        offset += count;
+
+    return randomOrder.at(offset);
+}
 
 int QMediaPlaylistNavigatorPrivate::nextItemPos(int steps) const
 {
@@ -112,25 +163,7 @@ int QMediaPlaylistNavigatorPrivate::nextItemPos(int steps) const
         case QMediaPlaylist::Loop:
             return (currentPos+steps) % playlist->mediaCount();
         case QMediaPlaylist::Random:
-            {
-                //TODO: limit the history size
-
-                if (randomPositionsOffset == -1) {
-                    randomModePositions.clear();
-                    randomModePositions.append(currentPos);
-                    randomPositionsOffset = 0;
-                }
-
-                while (randomModePositions.size() < randomPositionsOffset+steps+1)
-                    randomModePositions.append(-1);
-                int res = randomModePositions[randomPositionsOffset+steps];
-                if (res<0 || res >= playlist->mediaCount()) {
-                    res = QRandomGenerator::global()->bounded(playlist->mediaCount());
-                    randomModePositions[randomPositionsOffset+steps] = res;
-                }
-
-                return res;
-            }
+            return randomItemPos(steps);
     }
 
     return -1;
@@ -162,28 +195,7 @@ int QMediaPlaylistNavigatorPrivate::previousItemPos(int steps) const
                 return prevPos;
             }
         case QMediaPlaylist::Random:
-            {
-                //TODO: limit the history size
-
-                if (randomPositionsOffset == -1) {
-                    randomModePositions.clear();
-                    randomModePositions.append(currentPos);
-                    randomPositionsOffset = 0;
-                }
-
-                while (randomPositionsOffset-steps < 0) {
-                    randomModePositions.prepend(-1);
-                    randomPositionsOffset++;
-                }
-
-                int res = randomModePositions[randomPositionsOffset-steps];
-                if (res<0 || res >= playlist->mediaCount()) {
-                    res = QRandomGenerator::global()->bounded(playlist->mediaCount());
-                    randomModePositions[randomPositionsOffset-steps] = res;
-                }
-
-                return res;
-            }
+            return randomItemPos(-steps);
     }
 
     return -1;
@@ -243,13 +255,8 @@ void QMediaPlaylistNavigator::setPlaybackMode(QMediaPlaylist::PlaybackMode mode)
     if (d->playbackMode == mode)
         return;
 
-    if (mode == QMediaPlaylist::Random) {
-        d->randomPositionsOffset = 0;
-        d->randomModePositions.append(d->currentPos);
-    } else if (d->playbackMode == QMediaPlaylist::Random) {
-        d->randomPositionsOffset = -1;
-        d->randomModePositions.clear();
-    }
+    if (mode == QMediaPlaylist::Random || d->playbackMode == QMediaPlaylist::Random)
+        d->resetRandomOrder();
 
     d->playbackMode = mode;
 
@@ -291,8 +298,7 @@ void QMediaPlaylistNavigator::setPlaylist(QMediaPlaylistProvider *playlist)
     connect(d->playlist, SIGNAL(mediaRemoved(int,int)), SLOT(_q_mediaRemoved(int,int)));
     connect(d->playlist, SIGNAL(mediaChanged(int,int)), SLOT(_q_mediaChanged(int,int)));
 
-    d->randomPositionsOffset = -1;
-    d->randomModePositions.clear();
+    d->resetRandomOrder();
 
     if (d->currentPos != -1) {
         d->currentPos = -1;
@@ -403,8 +409,8 @@ void QMediaPlaylistNavigator::next()
 
     int nextPos = d->nextItemPos();
 
-    if ( playbackMode() == QMediaPlaylist::Random )
-            d->randomPositionsOffset++;
+    if (playbackMode() == QMediaPlaylist::Random && !d->randomOrder.isEmpty())
+        d->randomOffset = (d->randomOffset + 1) % d->randomOrder.size();
 
     jump(nextPos);
 }
@@ -419,8 +425,8 @@ void QMediaPlaylistNavigator::previous()
     Q_D(QMediaPlaylistNavigator);
 
     int prevPos = d->previousItemPos();
-    if ( playbackMode() == QMediaPlaylist::Random )
-        d->randomPositionsOffset--;
+    if (playbackMode() == QMediaPlaylist::Random && !d->randomOrder.isEmpty())
+        d->randomOffset = (d->randomOffset + d->randomOrder.size() - 1) % d->randomOrder.size();
 
     jump(prevPos);
 }
@@ -438,11 +444,12 @@ void QMediaPlaylistNavigator::jump(int position)
     if (position != -1)
         d->lastValidPos = position;
 
-    if (playbackMode() == QMediaPlaylist::Random) {
-        if (d->randomModePositions[d->randomPositionsOffset] != position) {
-            d->randomModePositions.clear();
-            d->randomModePositions.append(position);
-            d->randomPositionsOffset = 0;
+    if (playbackMode() == QMediaPlaylist::Random && !d->randomOrder.isEmpty()) {
+        if (position == -1) {
+            d->randomOffset = d->randomOrder.size() - 1;
+        } else if (d->randomOrder.at(d->randomOffset) != position) {
+            // Continue the cycle from the item jumped to.
+            d->randomOffset = d->randomOrder.indexOf(position);
         }
     }
 
@@ -467,8 +474,10 @@ void QMediaPlaylistNavigatorPrivate::_q_mediaInserted(int start, int end)
 {
     Q_Q(QMediaPlaylistNavigator);
 
+    resetRandomOrder();
+
     if (currentPos >= start) {
-        currentPos = end-start+1;
+        currentPos += end-start+1;
         q->jump(currentPos);
     }
 
@@ -483,8 +492,10 @@ void QMediaPlaylistNavigatorPrivate::_q_mediaRemoved(int start, int end)
 {
     Q_Q(QMediaPlaylistNavigator);
 
+    resetRandomOrder();
+
     if (currentPos > end) {
-        currentPos = currentPos - end-start+1;
+        currentPos -= end-start+1;
         q->jump(currentPos);
     } else if (currentPos >= start) {
         //current item was removed
@@ -503,6 +514,8 @@ void QMediaPlaylistNavigatorPrivate::_q_mediaChanged(int start, int end)
 {
     Q_Q(QMediaPlaylistNavigator);
 
+    resetRandomOrder();
+
     if (currentPos >= start && currentPos<=end) {
         QMediaContent src = playlist->media(currentPos);
         if (src != currentItem) {
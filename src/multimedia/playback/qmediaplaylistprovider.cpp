@@ -246,7 +246,8 @@ bool QMediaPlaylistProvider::removeMedia(int position)
   */
 bool QMediaPlaylistProvider::removeMedia(int start, int end)
 {
-    for (int pos=start; pos<=end; pos++) {
+    // Remove from the end, so the positions of the remaining items don't shift.
+    for (int pos=end; pos>=start; pos--) {
         if (!removeMedia(pos))
             return false;
     }
@@ -0,0 +1,220 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmediaprobedelivery_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QMediaProbeDelivery::QMediaProbeDelivery()
+    : m_deliveryMode(QueuedDelivery)
+    , m_overflowPolicy(DropOldest)
+    , m_bufferSize(8)
+    , m_droppedCount(0)
+    , m_generation(0)
+    , m_deliveryScheduled(false)
+    , m_flushing(false)
+{
+}
+
+QMediaProbeDelivery::~QMediaProbeDelivery()
+{
+}
+
+QMediaProbeDelivery::Mode QMediaProbeDelivery::deliveryMode() const
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    return m_deliveryMode;
+}
+
+void QMediaProbeDelivery::setDeliveryMode(Mode mode)
+{
+    {
+        QMutexLocker locker(&m_deliveryMutex);
+        if (m_deliveryMode == mode)
+            return;
+        m_deliveryMode = mode;
+    }
+    clearQueue();
+}
+
+int QMediaProbeDelivery::bufferSize() const
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    return m_bufferSize;
+}
+
+void QMediaProbeDelivery::setBufferSize(int size)
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    m_bufferSize = qMax(1, size);
+    m_spaceAvailable.wakeAll();
+}
+
+QMediaProbeDelivery::OverflowPolicy QMediaProbeDelivery::overflowPolicy() const
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    return m_overflowPolicy;
+}
+
+void QMediaProbeDelivery::setOverflowPolicy(OverflowPolicy policy)
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    m_overflowPolicy = policy;
+    m_spaceAvailable.wakeAll();
+}
+
+quint64 QMediaProbeDelivery::droppedCount() const
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    return m_droppedCount;
+}
+
+void QMediaProbeDelivery::setDeliverySettings(const void *owner, Mode mode,
+                                              OverflowPolicy policy, int bufferSize)
+{
+    {
+        QMutexLocker locker(&m_deliveryMutex);
+        auto it = m_settings.find(owner);
+        if (it == m_settings.end()) {
+            const DeliverySettings settings = { mode, policy, qMax(1, bufferSize), m_droppedCount };
+            m_settings.insert(owner, settings);
+        } else {
+            it->mode = mode;
+            it->policy = policy;
+            it->bufferSize = qMax(1, bufferSize);
+        }
+    }
+    applyDeliverySettings();
+}
+
+void QMediaProbeDelivery::removeDeliverySettings(const void *owner)
+{
+    {
+        QMutexLocker locker(&m_deliveryMutex);
+        if (!m_settings.remove(owner))
+            return;
+    }
+    applyDeliverySettings();
+}
+
+quint64 QMediaProbeDelivery::droppedCount(const void *owner) const
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    const auto it = m_settings.constFind(owner);
+    return it != m_settings.constEnd() ? m_droppedCount - it->droppedBase : m_droppedCount;
+}
+
+void QMediaProbeDelivery::resetDroppedCount()
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    m_droppedCount = 0;
+    for (DeliverySettings &settings : m_settings)
+        settings.droppedBase = 0;
+}
+
+// The receivers of all probes are called on the streaming thread in
+// DirectDelivery, so that is only used when every probe asked for it.
+// Buffered delivery gives Queued probes every frame instead of the latest
+// one, which is harmless, and blocking is only allowed when no probe
+// wants to drop instead.
+void QMediaProbeDelivery::applyDeliverySettings()
+{
+    {
+        QMutexLocker locker(&m_deliveryMutex);
+        if (m_settings.isEmpty())
+            return;
+
+        bool allDirect = true;
+        bool anyBuffered = false;
+        bool allBlock = true;
+        bool anyDropOldest = false;
+        int bufferSize = 1;
+        for (const DeliverySettings &settings : qAsConst(m_settings)) {
+            allDirect &= settings.mode == DirectDelivery;
+            if (settings.mode != BufferedDelivery)
+                continue;
+            anyBuffered = true;
+            bufferSize = qMax(bufferSize, settings.bufferSize);
+            allBlock &= settings.policy == BlockOnOverflow;
+            anyDropOldest |= settings.policy == DropOldest;
+        }
+
+        Mode mode = QueuedDelivery;
+        if (allDirect)
+            mode = DirectDelivery;
+        else if (anyBuffered)
+            mode = BufferedDelivery;
+
+        if (anyBuffered) {
+            m_bufferSize = bufferSize;
+            if (allBlock)
+                m_overflowPolicy = BlockOnOverflow;
+            else
+                m_overflowPolicy = anyDropOldest ? DropOldest : DropNewest;
+            m_spaceAvailable.wakeAll();
+        }
+
+        if (m_deliveryMode == mode)
+            return;
+        m_deliveryMode = mode;
+    }
+    clearQueue();
+}
+
+bool QMediaProbeDelivery::isFlushing() const
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    return m_flushing;
+}
+
+void QMediaProbeDelivery::setFlushing(bool flushing)
+{
+    {
+        QMutexLocker locker(&m_deliveryMutex);
+        if (m_flushing == flushing)
+            return;
+        m_flushing = flushing;
+    }
+    // Also wakes a streaming thread waiting in enqueue().
+    if (flushing)
+        clearQueue();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,247 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QMEDIAPROBEDELIVERY_P_H
+#define QMEDIAPROBEDELIVERY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_BEGIN_NAMESPACE
+
+// Extension implemented by probe controls that support the delivery modes
+// of QVideoProbe and QAudioProbe. The enum values match the public ones.
+class Q_MULTIMEDIA_EXPORT QMediaProbeDelivery
+{
+public:
+    enum Mode {
+        QueuedDelivery,
+        DirectDelivery,
+        BufferedDelivery
+    };
+
+    enum OverflowPolicy {
+        BlockOnOverflow,
+        DropOldest,
+        DropNewest
+    };
+
+    // What the caller of enqueue() has to do with the probed data.
+    enum Action {
+        Ignore,
+        DeliverNow,
+        ScheduleDelivery
+    };
+
+    QMediaProbeDelivery();
+    virtual ~QMediaProbeDelivery();
+
+    Mode deliveryMode() const;
+    void setDeliveryMode(Mode mode);
+
+    int bufferSize() const;
+    void setBufferSize(int size);
+
+    OverflowPolicy overflowPolicy() const;
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    quint64 droppedCount() const;
+
+    // Every probe sharing the control registers its own settings, the
+    // control uses the combination described in QVideoProbe.
+    void setDeliverySettings(const void *owner, Mode mode, OverflowPolicy policy, int bufferSize);
+    void removeDeliverySettings(const void *owner);
+    // Dropped since the owner registered or the counters were reset.
+    quint64 droppedCount(const void *owner) const;
+    // Called by the backend when the media changes.
+    void resetDroppedCount();
+
+    // While flushing, probed items are ignored and a blocked streaming
+    // thread is released. Set before the pipeline goes to READY or NULL.
+    bool isFlushing() const;
+    void setFlushing(bool flushing);
+
+    virtual void clearQueue() = 0;
+
+protected:
+    // Upper bound for BlockOnOverflow, the item is dropped after that.
+    static const int MaxBlockingWaitMs = 1000;
+
+    struct DeliverySettings
+    {
+        Mode mode;
+        OverflowPolicy policy;
+        int bufferSize;
+        quint64 droppedBase;
+    };
+
+    void applyDeliverySettings();
+
+    mutable QMutex m_deliveryMutex;
+    QWaitCondition m_spaceAvailable;
+    Mode m_deliveryMode;
+    OverflowPolicy m_overflowPolicy;
+    int m_bufferSize;
+    quint64 m_droppedCount;
+    quint64 m_generation;
+    bool m_deliveryScheduled;
+    bool m_flushing;
+    QHash<const void *, DeliverySettings> m_settings;
+};
+
+#define QMediaProbeDelivery_iid "org.qt-project.qt.mediaprobedelivery/5.13"
+Q_DECLARE_INTERFACE(QMediaProbeDelivery, QMediaProbeDelivery_iid)
+
+template <typename T>
+class QMediaProbeQueue : public QMediaProbeDelivery
+{
+public:
+    // Called on the streaming thread for every probed item.
+    Action enqueue(const T &item);
+    // Called on the control's thread from the scheduled delivery.
+    QQueue<T> takeQueued();
+    void clearQueue() override;
+
+private:
+    Action scheduleDelivery();
+
+    QQueue<T> m_queue;
+};
+
+template <typename T>
+typename QMediaProbeDelivery::Action QMediaProbeQueue<T>::enqueue(const T &item)
+{
+    QMutexLocker locker(&m_deliveryMutex);
+
+    if (m_flushing)
+        return Ignore;
+
+    switch (m_deliveryMode) {
+    case DirectDelivery:
+        return DeliverNow;
+
+    case QueuedDelivery:
+        // Only the latest item is kept, anything not yet delivered is replaced.
+        if (!m_queue.isEmpty()) {
+            m_droppedCount += m_queue.size();
+            m_queue.clear();
+        }
+        break;
+
+    case BufferedDelivery: {
+        QDeadlineTimer deadline(QDeadlineTimer::Forever);
+        while (m_queue.size() >= m_bufferSize) {
+            if (m_overflowPolicy == DropNewest) {
+                ++m_droppedCount;
+                return Ignore;
+            } else if (m_overflowPolicy == DropOldest) {
+                m_queue.dequeue();
+                ++m_droppedCount;
+            } else {
+                // Don't stall the pipeline for good when the receivers stopped
+                // consuming, drop the item once the wait took too long.
+                if (deadline.isForever())
+                    deadline.setRemainingTime(MaxBlockingWaitMs);
+                const quint64 generation = m_generation;
+                if (!m_spaceAvailable.wait(&m_deliveryMutex, deadline)) {
+                    ++m_droppedCount;
+                    return Ignore;
+                }
+                // The queue was flushed or the mode changed while waiting.
+                if (generation != m_generation)
+                    return Ignore;
+            }
+        }
+        break;
+    }
+    }
+
+    m_queue.enqueue(item);
+    return scheduleDelivery();
+}
+
+template <typename T>
+QQueue<T> QMediaProbeQueue<T>::takeQueued()
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    QQueue<T> queue;
+    queue.swap(m_queue);
+    m_deliveryScheduled = false;
+    m_spaceAvailable.wakeAll();
+    return queue;
+}
+
+template <typename T>
+void QMediaProbeQueue<T>::clearQueue()
+{
+    QMutexLocker locker(&m_deliveryMutex);
+    m_queue.clear();
+    ++m_generation;
+    m_spaceAvailable.wakeAll();
+}
+
+template <typename T>
+typename QMediaProbeDelivery::Action QMediaProbeQueue<T>::scheduleDelivery()
+{
+    if (m_deliveryScheduled)
+        return Ignore;
+    m_deliveryScheduled = true;
+    return ScheduleDelivery;
+}
+
+QT_END_NAMESPACE
+
+#endif // QMEDIAPROBEDELIVERY_P_H
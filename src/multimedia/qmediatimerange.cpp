@@ -38,6 +38,9 @@
 ****************************************************************************/
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
 
 #include "qmediatimerange.h"
 
@@ -203,6 +206,9 @@ bool operator!=(const QMediaTimeInterval &a, const QMediaTimeInterval &b)
     return a.start() != b.start() || a.end() != b.end();
 }
 
+// Intervals are kept sorted, disjoint and non-adjacent in a contiguous array,
+// so both their starts and their ends are in ascending order and can be
+// binary searched.
 class QMediaTimeRangePrivate : public QSharedData
 {
 public:
@@ -211,10 +217,19 @@ public:
     QMediaTimeRangePrivate(const QMediaTimeRangePrivate &other);
     QMediaTimeRangePrivate(const QMediaTimeInterval &interval);
 
-    QList<QMediaTimeInterval> intervals;
+    QVector<QMediaTimeInterval> intervals;
 
     void addInterval(const QMediaTimeInterval &interval);
     void removeInterval(const QMediaTimeInterval &interval);
+    void addIntervals(const QVector<QMediaTimeInterval> &other);
+    void removeIntervals(const QVector<QMediaTimeInterval> &other);
+
+    // Returns the first interval which ends at or after time - 1, that is the
+    // first one which overlaps or touches an interval starting at time.
+    int firstReaching(qint64 time, bool adjacent) const;
+    // Returns the first interval which starts after time + 1, that is the
+    // first one which neither overlaps nor touches an interval ending at time.
+    int firstAfter(qint64 time, bool adjacent) const;
 };
 
 QMediaTimeRangePrivate::QMediaTimeRangePrivate()
@@ -237,36 +252,45 @@ QMediaTimeRangePrivate::QMediaTimeRangePrivate(const QMediaTimeInterval &interva
         intervals << interval;
 }
 
+int QMediaTimeRangePrivate::firstReaching(qint64 time, bool adjacent) const
+{
+    const auto it = std::lower_bound(intervals.cbegin(), intervals.cend(), time,
+                                     [adjacent](const QMediaTimeInterval &interval, qint64 time) {
+        // Written so that neither side can overflow.
+        return interval.e < time && (!adjacent || interval.e + 1 < time);
+    });
+    return int(it - intervals.cbegin());
+}
+
+int QMediaTimeRangePrivate::firstAfter(qint64 time, bool adjacent) const
+{
+    const auto it = std::upper_bound(intervals.cbegin(), intervals.cend(), time,
+                                     [adjacent](qint64 time, const QMediaTimeInterval &interval) {
+        return time < interval.s && (!adjacent || time < interval.s - 1);
+    });
+    return int(it - intervals.cbegin());
+}
+
 void QMediaTimeRangePrivate::addInterval(const QMediaTimeInterval &interval)
 {
     // Handle normalized intervals only
     if(!interval.isNormal())
         return;
 
-    // Find a place to insert the interval
-    int i;
-    for (i = 0; i < intervals.count(); i++) {
-        // Insert before this element
-        if(interval.s < intervals[i].s) {
-            intervals.insert(i, interval);
-            break;
-        }
-    }
-
-    // Interval needs to be added to the end of the list
-    if (i == intervals.count())
-        intervals.append(interval);
-
-    // Do we need to correct the element before us?
-    if(i > 0 && intervals[i - 1].e >= interval.s - 1)
-        i--;
+    // The intervals in [first, last) overlap or touch the new one.
+    const int first = firstReaching(interval.s, true);
+    const int last = firstAfter(interval.e, true);
 
-    // Merge trailing ranges
-    while (i < intervals.count() - 1
-          && intervals[i].e >= intervals[i + 1].s - 1) {
-        intervals[i].e = qMax(intervals[i].e, intervals[i + 1].e);
-        intervals.removeAt(i + 1);
+    if (first == last) {
+        intervals.insert(first, interval);
+        return;
     }
+
+    // Merge them into the first one
+    intervals[first].s = qMin(intervals[first].s, interval.s);
+    intervals[first].e = qMax(intervals[last - 1].e, interval.e);
+    if (last - first > 1)
+        intervals.remove(first + 1, last - first - 1);
 }
 
 void QMediaTimeRangePrivate::removeInterval(const QMediaTimeInterval &interval)
@@ -275,33 +299,100 @@ void QMediaTimeRangePrivate::removeInterval(const QMediaTimeInterval &interval)
     if(!interval.isNormal())
         return;
 
-    for (int i = 0; i < intervals.count(); i++) {
-        QMediaTimeInterval r = intervals[i];
-
-        if (r.e < interval.s) {
-            // Before the removal interval
-            continue;
-        } else if (interval.e < r.s) {
-            // After the removal interval - stop here
-            break;
-        } else if (r.s < interval.s && interval.e < r.e) {
-            // Split case - a single range has a chunk removed
-            intervals[i].e = interval.s -1;
-            addInterval(QMediaTimeInterval(interval.e + 1, r.e));
-            break;
-        } else if (r.s < interval.s) {
-            // Trimming Tail Case
-            intervals[i].e = interval.s - 1;
-        } else if (interval.e < r.e) {
-            // Trimming Head Case - we can stop after this
-            intervals[i].s = interval.e + 1;
-            break;
-        } else {
-            // Complete coverage case
-            intervals.removeAt(i);
-            --i;
+    // The intervals in [first, last) overlap the removed one.
+    const int first = firstReaching(interval.s, false);
+    const int last = firstAfter(interval.e, false);
+
+    if (first == last)
+        return;
+
+    const QMediaTimeInterval head = intervals.at(first);
+    const QMediaTimeInterval tail = intervals.at(last - 1);
+
+    // What is left of them is the part of the first one before the removed interval
+    // and the part of the last one after it.
+    QMediaTimeInterval remains[2];
+    int remainCount = 0;
+    if (head.s < interval.s)
+        remains[remainCount++] = QMediaTimeInterval(head.s, interval.s - 1);
+    if (interval.e < tail.e)
+        remains[remainCount++] = QMediaTimeInterval(interval.e + 1, tail.e);
+
+    const int overlapping = last - first;
+    if (remainCount > overlapping) {
+        // Split case - a single range has a chunk removed
+        intervals[first] = remains[0];
+        intervals.insert(first + 1, remains[1]);
+        return;
+    }
+
+    for (int i = 0; i < remainCount; ++i)
+        intervals[first + i] = remains[i];
+    if (overlapping > remainCount)
+        intervals.remove(first + remainCount, overlapping - remainCount);
+}
+
+void QMediaTimeRangePrivate::addIntervals(const QVector<QMediaTimeInterval> &other)
+{
+    // A few intervals are cheaper to insert one by one than merging the whole ranges.
+    if (other.count() < 8) {
+        for (const QMediaTimeInterval &interval : other)
+            addInterval(interval);
+        return;
+    }
+
+    QVector<QMediaTimeInterval> merged;
+    merged.reserve(intervals.count() + other.count());
+
+    auto a = intervals.cbegin();
+    auto b = other.cbegin();
+    while (a != intervals.cend() || b != other.cend()) {
+        const QMediaTimeInterval &next = (b == other.cend() || (a != intervals.cend() && a->s < b->s))
+                ? *a++ : *b++;
+
+        if (!merged.isEmpty() && (merged.last().e >= next.s || merged.last().e + 1 == next.s))
+            merged.last().e = qMax(merged.last().e, next.e);
+        else
+            merged.append(next);
+    }
+
+    intervals.swap(merged);
+}
+
+void QMediaTimeRangePrivate::removeIntervals(const QVector<QMediaTimeInterval> &other)
+{
+    if (other.count() < 8) {
+        for (const QMediaTimeInterval &interval : other)
+            removeInterval(interval);
+        return;
+    }
+
+    QVector<QMediaTimeInterval> remaining;
+    remaining.reserve(intervals.count() + other.count());
+
+    auto b = other.cbegin();
+    for (QMediaTimeInterval interval : qAsConst(intervals)) {
+        // Skip the removed intervals ending before this one
+        while (b != other.cend() && b->e < interval.s)
+            ++b;
+
+        // Cut away the ones overlapping it
+        bool empty = false;
+        for (auto c = b; c != other.cend() && c->s <= interval.e; ++c) {
+            if (c->s > interval.s)
+                remaining.append(QMediaTimeInterval(interval.s, c->s - 1));
+            if (c->e >= interval.e) {
+                empty = true;
+                break;
+            }
+            interval.s = c->e + 1;
         }
+
+        if (!empty)
+            remaining.append(interval);
     }
+
+    intervals.swap(remaining);
 }
 
 /*!
@@ -470,7 +561,8 @@ void QMediaTimeRange::addInterval(qint64 start, qint64 end)
     If the specified interval is adjacent to, or overlaps existing
     intervals within the time range, these intervals will be merged.
 
-    This operation takes linear time.
+    The intervals affected are found in logarithmic time, inserting or merging
+    them takes linear time in the worst case.
 
     \sa removeInterval()
 */
@@ -482,14 +574,14 @@ void QMediaTimeRange::addInterval(const QMediaTimeInterval &interval)
 /*!
     Adds each of the intervals in \a range to this time range.
 
-    Equivalent to calling addInterval() for each interval in \a range.
+    Equivalent to calling addInterval() for each interval in \a range,
+    but takes linear time in the total number of intervals.
 */
 void QMediaTimeRange::addTimeRange(const QMediaTimeRange &range)
 {
-    const auto intervals = range.intervals();
-    for (const QMediaTimeInterval &i : intervals) {
-        d->addInterval(i);
-    }
+    // Keep a reference, range may be this time range
+    const QVector<QMediaTimeInterval> intervals = range.d->intervals;
+    d->addIntervals(intervals);
 }
 
 /*!
@@ -518,7 +610,8 @@ void QMediaTimeRange::removeInterval(qint64 start, qint64 end)
     such that no intervals within the time range include any part of the
     target interval.
 
-    This operation takes linear time.
+    The intervals affected are found in logarithmic time, splitting or
+    deleting them takes linear time in the worst case.
 
     \sa addInterval()
 */
@@ -530,14 +623,14 @@ void QMediaTimeRange::removeInterval(const QMediaTimeInterval &interval)
 /*!
     Removes each of the intervals in \a range from this time range.
 
-    Equivalent to calling removeInterval() for each interval in \a range.
+    Equivalent to calling removeInterval() for each interval in \a range,
+    but takes linear time in the total number of intervals.
 */
 void QMediaTimeRange::removeTimeRange(const QMediaTimeRange &range)
 {
-    const auto intervals = range.intervals();
-    for (const QMediaTimeInterval &i : intervals) {
-        d->removeInterval(i);
-    }
+    // Keep a reference, range may be this time range
+    const QVector<QMediaTimeInterval> intervals = range.d->intervals;
+    d->removeIntervals(intervals);
 }
 
 /*!
@@ -592,10 +685,13 @@ void QMediaTimeRange::clear()
     \fn QMediaTimeRange::intervals() const
 
     Returns the list of intervals covered by this time range.
+
+    The list is built on every call, which takes linear time. Use contains(),
+    earliestTime() and latestTime() for frequent queries.
 */
 QList<QMediaTimeInterval> QMediaTimeRange::intervals() const
 {
-    return d->intervals;
+    return d->intervals.toList();
 }
 
 /*!
@@ -625,18 +721,13 @@ bool QMediaTimeRange::isContinuous() const
     \fn QMediaTimeRange::contains(qint64 time) const
 
     Returns true if the specified \a time lies within the time range.
+
+    This operation takes logarithmic time.
 */
 bool QMediaTimeRange::contains(qint64 time) const
 {
-    for (int i = 0; i < d->intervals.count(); i++) {
-        if (d->intervals[i].contains(time))
-            return true;
-
-        if (time < d->intervals[i].s)
-            break;
-    }
-
-    return false;
+    const int i = d->firstReaching(time, false);
+    return i < d->intervals.count() && d->intervals.at(i).s <= time;
 }
 
 /*!
@@ -646,7 +737,7 @@ bool QMediaTimeRange::contains(qint64 time) const
 */
 bool operator==(const QMediaTimeRange &a, const QMediaTimeRange &b)
 {
-    return a.intervals() == b.intervals();
+    return a.d->intervals == b.d->intervals;
 }
 
 /*!
@@ -685,8 +776,7 @@ QDebug operator<<(QDebug dbg, const QMediaTimeRange &range)
     QDebugStateSaver saver(dbg);
     dbg.nospace();
     dbg << "QMediaTimeRange( ";
-    const auto intervals = range.intervals();
-    for (const QMediaTimeInterval &interval : intervals)
+    for (const QMediaTimeInterval &interval : qAsConst(range.d->intervals))
         dbg << '(' <<  interval.start() << ", " << interval.end() << ") ";
     dbg.space();
     dbg << ')';
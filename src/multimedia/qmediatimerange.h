@@ -115,6 +115,11 @@ public:
     void clear();
 
 private:
+    friend Q_MULTIMEDIA_EXPORT bool operator==(const QMediaTimeRange&, const QMediaTimeRange&);
+#ifndef QT_NO_DEBUG_STREAM
+    friend Q_MULTIMEDIA_EXPORT QDebug operator<<(QDebug, const QMediaTimeRange &);
+#endif
+
     QSharedDataPointer<QMediaTimeRangePrivate> d;
 };
 
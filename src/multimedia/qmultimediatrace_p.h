@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMULTIMEDIATRACE_P_H
+#define QMULTIMEDIATRACE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/private/qtmultimediaglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The tracepoints of qtmultimedia.tracepoints are generated into QtMultimedia,
+    the other multimedia libraries and the plugins reach them through these
+    exported wrappers. When Qt is built without a tracing backend,
+    Q_MULTIMEDIA_TRACE expands to nothing and its arguments are not evaluated.
+*/
+
+#if QT_CONFIG(lttng) || QT_CONFIG(etw)
+
+#  define Q_MULTIMEDIA_TRACE(x, ...) QMultimediaTrace::x(__VA_ARGS__)
+
+namespace QMultimediaTrace {
+
+Q_MULTIMEDIA_EXPORT void QVideoSurfaceGstDelegate_render_entry(const void *delegate, qint64 timestamp);
+Q_MULTIMEDIA_EXPORT void QVideoSurfaceGstDelegate_render_exit(const void *delegate, int flowReturn);
+Q_MULTIMEDIA_EXPORT void QAbstractVideoSurface_present(const void *surface, qint64 startTime,
+                                                       int pixelFormat, int width, int height);
+Q_MULTIMEDIA_EXPORT void QDeclarativeVideoRendererBackend_updatePaintNode_entry(const void *backend,
+                                                                                qint64 startTime,
+                                                                                int pendingResults);
+Q_MULTIMEDIA_EXPORT void QDeclarativeVideoRendererBackend_updatePaintNode_exit(const void *backend,
+                                                                               int hasNode);
+Q_MULTIMEDIA_EXPORT void QVideoFilterRunnable_run_entry(const void *runnable, qint64 startTime,
+                                                        int queueDepth);
+Q_MULTIMEDIA_EXPORT void QVideoFilterRunnable_run_exit(const void *runnable, qint64 startTime);
+Q_MULTIMEDIA_EXPORT void QAudioOutput_userFeed(const void *output, int bytesFree);
+Q_MULTIMEDIA_EXPORT void QAudioOutput_write(const void *output, qint64 bytes, int bytesFree);
+Q_MULTIMEDIA_EXPORT void QAudioOutput_underrun(const void *output);
+Q_MULTIMEDIA_EXPORT void QGstreamerBusHelper_dispatch_entry(const void *helper, int messageType,
+                                                            qint64 timestamp, int queueDepth);
+Q_MULTIMEDIA_EXPORT void QGstreamerBusHelper_dispatch_exit(const void *helper, int messageType);
+
+}
+
+#else
+
+#  define Q_MULTIMEDIA_TRACE(x, ...)
+
+#endif
+
+QT_END_NAMESPACE
+
+#endif // QMULTIMEDIATRACE_P_H
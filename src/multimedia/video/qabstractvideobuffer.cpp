@@ -101,6 +101,12 @@ int QAbstractVideoBufferPrivate::map(
     \value CoreImageHandle The handle contains pointer to \macos CIImage.
     \value QPixmapHandle The handle of the buffer is a QPixmap.
     \value EGLImageHandle The handle of the buffer is an EGLImageKHR.
+    \value DmaBufHandle The handle of the buffer is a QVariantMap describing Linux dma-buf
+    planes. The \c fds, \c offsets and \c strides entries are QVariantLists holding one integer
+    per plane: the dma-buf file descriptor, the offset of the plane within that descriptor, and
+    the stride of the plane in bytes. The file descriptors remain owned by the buffer. If the
+    handle is null the memory of the frame is not a dma-buf, and the frame has to be mapped.
+    This value was introduced in Qt 5.13.
     \value UserHandle Start value for user defined handle types.
 
     \sa handleType()
@@ -369,6 +375,10 @@ QDebug operator<<(QDebug dbg, QAbstractVideoBuffer::HandleType type)
         return dbg << "CoreImageHandle";
     case QAbstractVideoBuffer::QPixmapHandle:
         return dbg << "QPixmapHandle";
+    case QAbstractVideoBuffer::EGLImageHandle:
+        return dbg << "EGLImageHandle";
+    case QAbstractVideoBuffer::DmaBufHandle:
+        return dbg << "DmaBufHandle";
     default:
         return dbg << "UserHandle(" << int(type) << ')';
     }
@@ -64,6 +64,7 @@ public:
         CoreImageHandle,
         QPixmapHandle,
         EGLImageHandle,
+        DmaBufHandle,
         UserHandle = 1000
     };
 
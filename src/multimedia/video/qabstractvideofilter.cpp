@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qabstractvideofilter.h"
+#include "qabstractvideofilter_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -247,15 +248,21 @@ QT_BEGIN_NAMESPACE
   graph without invoking any further filters.
  */
 
-class QAbstractVideoFilterPrivate
+void QAbstractVideoFilterPrivate::recordProcessedFrame(qint64 latency)
 {
-public:
-    QAbstractVideoFilterPrivate() :
-        active(true)
-    { }
+    QMutexLocker locker(&statisticsMutex);
+    ++processedFrames;
+    lastLatency = latency;
+    totalLatency += latency;
+    if (latency > maximumLatency)
+        maximumLatency = latency;
+}
 
-    bool active;
-};
+void QAbstractVideoFilterPrivate::recordDroppedFrame()
+{
+    QMutexLocker locker(&statisticsMutex);
+    ++droppedFrames;
+}
 
 /*!
   \internal
@@ -305,6 +312,160 @@ void QAbstractVideoFilter::setActive(bool v)
     }
 }
 
+/*!
+    \property QAbstractVideoFilter::asynchronous
+    \brief whether the filter runs off the scene graph render thread.
+    \since 5.13
+
+    By default filters are synchronous: the VideoOutput type invokes
+    QVideoFilterRunnable::run() on the render thread, before the frame is
+    presented, and rendering waits for the filter to finish.
+
+    When set to \c true, the VideoOutput type hands each incoming frame to a
+    pool of worker threads instead. Asynchronous filters in a filters list
+    form a pipeline: each filter processes one frame at a time, but different
+    filters can work on different frames at the same time. Results are
+    matched to their frames by start time, and the most recent fully filtered
+    frame is presented when it becomes available. Asynchronous filters always
+    run before the synchronous filters of the same VideoOutput.
+
+    The runnable of an asynchronous filter is created, invoked and destroyed
+    on a worker thread without an OpenGL context bound. Such filters should
+    therefore only be used with frames that can be mapped to system memory,
+    and must not use OpenGL themselves.
+
+    \sa maximumPendingFrames
+ */
+bool QAbstractVideoFilter::isAsynchronous() const
+{
+    Q_D(const QAbstractVideoFilter);
+    return d->asynchronous;
+}
+
+void QAbstractVideoFilter::setAsynchronous(bool asynchronous)
+{
+    Q_D(QAbstractVideoFilter);
+    if (d->asynchronous != asynchronous) {
+        d->asynchronous = asynchronous;
+        emit asynchronousChanged();
+    }
+}
+
+/*!
+    \property QAbstractVideoFilter::maximumPendingFrames
+    \brief the maximum number of frames an asynchronous filter pipeline keeps in flight.
+    \since 5.13
+
+    Frames arriving while this many frames are still being filtered are
+    dropped and counted by droppedFrameCount(). When several asynchronous
+    filters are chained, the smallest value among them applies.
+
+    The default is 2. The property has no effect on synchronous filters.
+
+    \sa asynchronous
+ */
+int QAbstractVideoFilter::maximumPendingFrames() const
+{
+    Q_D(const QAbstractVideoFilter);
+    return d->maximumPendingFrames;
+}
+
+void QAbstractVideoFilter::setMaximumPendingFrames(int count)
+{
+    Q_D(QAbstractVideoFilter);
+    count = qMax(1, count);
+    if (d->maximumPendingFrames != count) {
+        d->maximumPendingFrames = count;
+        emit maximumPendingFramesChanged();
+    }
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of frames this filter has processed since it was
+    created or since the last call to resetStatistics().
+ */
+quint64 QAbstractVideoFilter::processedFrameCount() const
+{
+    Q_D(const QAbstractVideoFilter);
+    QMutexLocker locker(&d->statisticsMutex);
+    return d->processedFrames;
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of frames that were not handed to this filter because
+    the asynchronous pipeline was full.
+ */
+quint64 QAbstractVideoFilter::droppedFrameCount() const
+{
+    Q_D(const QAbstractVideoFilter);
+    QMutexLocker locker(&d->statisticsMutex);
+    return d->droppedFrames;
+}
+
+/*!
+    \since 5.13
+
+    Returns the latency, in microseconds, of the most recently processed frame.
+
+    The latency is measured from the moment the frame is handed to the filter
+    until QVideoFilterRunnable::run() returns. For asynchronous filters it
+    includes the time the frame waited for the filter to become available.
+ */
+qint64 QAbstractVideoFilter::lastLatency() const
+{
+    Q_D(const QAbstractVideoFilter);
+    QMutexLocker locker(&d->statisticsMutex);
+    return d->lastLatency;
+}
+
+/*!
+    \since 5.13
+
+    Returns the average latency of the processed frames in microseconds.
+
+    \sa lastLatency()
+ */
+qint64 QAbstractVideoFilter::averageLatency() const
+{
+    Q_D(const QAbstractVideoFilter);
+    QMutexLocker locker(&d->statisticsMutex);
+    return d->processedFrames ? d->totalLatency / qint64(d->processedFrames) : 0;
+}
+
+/*!
+    \since 5.13
+
+    Returns the highest latency of the processed frames in microseconds.
+
+    \sa lastLatency()
+ */
+qint64 QAbstractVideoFilter::maximumLatency() const
+{
+    Q_D(const QAbstractVideoFilter);
+    QMutexLocker locker(&d->statisticsMutex);
+    return d->maximumLatency;
+}
+
+/*!
+    \since 5.13
+
+    Resets the frame counters and latency statistics to zero.
+ */
+void QAbstractVideoFilter::resetStatistics()
+{
+    Q_D(QAbstractVideoFilter);
+    QMutexLocker locker(&d->statisticsMutex);
+    d->processedFrames = 0;
+    d->droppedFrames = 0;
+    d->lastLatency = 0;
+    d->totalLatency = 0;
+    d->maximumLatency = 0;
+}
+
 /*!
   \fn QVideoFilterRunnable *QAbstractVideoFilter::createFilterRunnable()
 
@@ -312,7 +473,8 @@ void QAbstractVideoFilter::setActive(bool v)
   corresponding to this filter.
 
   This function is called on the thread on which the Qt Quick scene graph
-  performs rendering, with the OpenGL context bound. Ownership of the returned
+  performs rendering, with the OpenGL context bound. For \l asynchronous
+  filters it is called on a worker thread instead, without an OpenGL context. Ownership of the returned
   instance is transferred: the returned instance will live on the render thread
   and will be destroyed automatically when necessary.
 
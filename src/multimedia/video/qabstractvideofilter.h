@@ -66,6 +66,8 @@ class Q_MULTIMEDIA_EXPORT QAbstractVideoFilter : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(bool asynchronous READ isAsynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
+    Q_PROPERTY(int maximumPendingFrames READ maximumPendingFrames WRITE setMaximumPendingFrames NOTIFY maximumPendingFramesChanged)
 
 public:
     explicit QAbstractVideoFilter(QObject *parent = nullptr);
@@ -74,10 +76,25 @@ public:
     bool isActive() const;
     void setActive(bool v);
 
+    bool isAsynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
+    int maximumPendingFrames() const;
+    void setMaximumPendingFrames(int count);
+
+    quint64 processedFrameCount() const;
+    quint64 droppedFrameCount() const;
+    qint64 lastLatency() const;
+    qint64 averageLatency() const;
+    qint64 maximumLatency() const;
+    void resetStatistics();
+
     virtual QVideoFilterRunnable *createFilterRunnable() = 0;
 
 Q_SIGNALS:
     void activeChanged();
+    void asynchronousChanged();
+    void maximumPendingFramesChanged();
 
 private:
     Q_DECLARE_PRIVATE(QAbstractVideoFilter)
@@ -40,6 +40,7 @@
 #include "qmemoryvideobuffer_p.h"
 
 #include "qabstractvideobuffer_p.h"
+#include "qvideoallocationcache_p.h"
 #include <qbytearray.h>
 
 QT_BEGIN_NAMESPACE
@@ -53,11 +54,34 @@ public:
     {
     }
 
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+
     int bytesPerLine;
     QAbstractVideoBuffer::MapMode mapMode;
     QByteArray data;
 };
 
+typedef QVideoAllocationCache<sizeof(QMemoryVideoBuffer)> QMemoryVideoBufferCache;
+typedef QVideoAllocationCache<sizeof(QMemoryVideoBufferPrivate)> QMemoryVideoBufferPrivateCache;
+Q_GLOBAL_STATIC(QMemoryVideoBufferCache, memoryVideoBufferCache)
+Q_GLOBAL_STATIC(QMemoryVideoBufferPrivateCache, memoryVideoBufferPrivateCache)
+
+void *QMemoryVideoBufferPrivate::operator new(size_t size)
+{
+    if (QMemoryVideoBufferPrivateCache *cache = memoryVideoBufferPrivateCache())
+        return cache->allocate(size);
+    return ::operator new(size);
+}
+
+void QMemoryVideoBufferPrivate::operator delete(void *block, size_t size)
+{
+    if (QMemoryVideoBufferPrivateCache *cache = memoryVideoBufferPrivateCache())
+        cache->release(block, size);
+    else
+        ::operator delete(block);
+}
+
 /*!
     \class QMemoryVideoBuffer
     \brief The QMemoryVideoBuffer class provides a system memory allocated video data buffer.
@@ -124,4 +148,26 @@ void QMemoryVideoBuffer::unmap()
     d_func()->mapMode = NotMapped;
 }
 
+/*!
+    Allocates memory for a buffer of \a size bytes, reusing the memory of a released buffer
+    if possible.
+*/
+void *QMemoryVideoBuffer::operator new(size_t size)
+{
+    if (QMemoryVideoBufferCache *cache = memoryVideoBufferCache())
+        return cache->allocate(size);
+    return ::operator new(size);
+}
+
+/*!
+    Releases the memory of a buffer of \a size bytes at \a block for reuse.
+*/
+void QMemoryVideoBuffer::operator delete(void *block, size_t size)
+{
+    if (QMemoryVideoBufferCache *cache = memoryVideoBufferCache())
+        cache->release(block, size);
+    else
+        ::operator delete(block);
+}
+
 QT_END_NAMESPACE
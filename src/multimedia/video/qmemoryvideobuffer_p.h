@@ -69,6 +69,9 @@ public:
 
     uchar *map(MapMode mode, int *numBytes, int *bytesPerLine) override;
     void unmap() override;
+
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
 };
 
 QT_END_NAMESPACE
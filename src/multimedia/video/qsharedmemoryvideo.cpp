@@ -0,0 +1,395 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsharedmemoryvideo_p.h"
+
+#include <qvideoframe.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qdebug.h>
+
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QSharedMemoryVideo {
+
+QString socketPath(const QString &name)
+{
+    // Same convention as QLocalServer: relative names live in the temporary directory.
+    if (QDir::isAbsolutePath(name))
+        return name;
+    return QDir::tempPath() + QLatin1Char('/') + name;
+}
+
+static int planeHeight(quint32 pixelFormat, int plane, int height)
+{
+    if (plane == 0)
+        return height;
+
+    switch (pixelFormat) {
+    case QVideoFrame::Format_YUV420P:
+    case QVideoFrame::Format_YV12:
+    case QVideoFrame::Format_NV12:
+    case QVideoFrame::Format_NV21:
+    case QVideoFrame::Format_IMC1:
+    case QVideoFrame::Format_IMC2:
+    case QVideoFrame::Format_IMC3:
+    case QVideoFrame::Format_IMC4:
+    case QVideoFrame::Format_P010:
+    case QVideoFrame::Format_P016:
+        return (height + 1) / 2;
+    default:
+        return height;
+    }
+}
+
+bool isValidFrame(const SlotHeader &header, quint32 slotSize)
+{
+    if (header.pixelFormat == quint32(QVideoFrame::Format_Invalid)
+            || (header.pixelFormat >= quint32(QVideoFrame::NPixelFormats)
+                && header.pixelFormat < quint32(QVideoFrame::Format_User))) {
+        return false;
+    }
+
+    if (header.width < 1 || header.width > MaximumDimension
+            || header.height < 1 || header.height > MaximumDimension
+            || header.planeCount < 1 || header.planeCount > MaximumPlanes
+            || header.mappedBytes < 0 || quint32(header.mappedBytes) > slotSize) {
+        return false;
+    }
+
+    for (int plane = 0; plane < header.planeCount; ++plane) {
+        const qint64 offset = header.planeOffset[plane];
+        const qint64 bytesPerLine = header.bytesPerLine[plane];
+        if (offset < 0 || bytesPerLine < 0)
+            return false;
+        const qint64 end = offset + bytesPerLine * planeHeight(header.pixelFormat, plane, header.height);
+        if (offset >= slotSize || end > slotSize)
+            return false;
+    }
+
+    return true;
+}
+
+#if defined(Q_OS_LINUX)
+
+static qsizetype pageAligned(qsizetype size)
+{
+    const qsizetype pageSize = sysconf(_SC_PAGESIZE);
+    return (size + pageSize - 1) / pageSize * pageSize;
+}
+
+int createRing(const QString &name, quint32 generation, int slotCount, int slotSize,
+               uchar **ring, qsizetype *ringSize)
+{
+#if defined(SYS_memfd_create)
+    const int fd = syscall(SYS_memfd_create, name.toLocal8Bit().constData(), MFD_CLOEXEC);
+#else
+    Q_UNUSED(name);
+    const int fd = -1;
+    errno = ENOSYS;
+#endif
+    if (fd == -1) {
+        qWarning("QSharedMemoryVideo: failed to create the shared memory: %s", strerror(errno));
+        return -1;
+    }
+
+    const qsizetype dataOffset = pageAligned(sizeof(RingHeader) + slotCount * sizeof(SlotHeader));
+    const qsizetype alignedSlotSize = pageAligned(slotSize);
+    const qsizetype size = dataOffset + slotCount * alignedSlotSize;
+
+    if (ftruncate(fd, size) == -1) {
+        qWarning("QSharedMemoryVideo: failed to allocate %lld bytes of shared memory: %s",
+                 qint64(size), strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+
+    uchar *data = mapRing(fd, ringSize);
+    if (!data) {
+        ::close(fd);
+        return -1;
+    }
+
+    RingHeader *header = reinterpret_cast<RingHeader *>(data);
+    header->magic = Magic;
+    header->version = Version;
+    header->generation = generation;
+    header->slotCount = slotCount;
+    header->slotSize = alignedSlotSize;
+    header->dataOffset = dataOffset;
+    header->latestSlot.storeRelease(-1);
+
+    *ring = data;
+    return fd;
+}
+
+uchar *mapRing(int fd, qsizetype *ringSize, RingHeader *layout)
+{
+    struct stat status;
+    if (fstat(fd, &status) == -1 || status.st_size < qsizetype(sizeof(RingHeader)))
+        return 0;
+
+    // Consumers map it writable too, the slot reference counts live in there.
+    void *data = mmap(0, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        qWarning("QSharedMemoryVideo: failed to map the shared memory: %s", strerror(errno));
+        return 0;
+    }
+
+    // Validate a copy, the mapping can be written by the other side at any time.
+    RingHeader header;
+    memcpy(static_cast<void *>(&header), data, sizeof(RingHeader));
+    if (header.magic != Magic || header.version != Version
+            || header.slotCount > quint32(status.st_size) / sizeof(SlotHeader)
+            || header.dataOffset < sizeof(RingHeader) + quint64(header.slotCount) * sizeof(SlotHeader)
+            || header.dataOffset + quint64(header.slotCount) * header.slotSize > quint64(status.st_size)) {
+        qWarning("QSharedMemoryVideo: the shared memory has an unexpected layout");
+        munmap(data, status.st_size);
+        return 0;
+    }
+
+    *ringSize = status.st_size;
+    if (layout)
+        memcpy(static_cast<void *>(layout), &header, sizeof(RingHeader));
+    return static_cast<uchar *>(data);
+}
+
+void unmapRing(uchar *ring, qsizetype ringSize)
+{
+    if (ring)
+        munmap(ring, ringSize);
+}
+
+static bool socketAddress(const QString &path, sockaddr_un *address)
+{
+    const QByteArray encodedPath = QFile::encodeName(path);
+    if (encodedPath.size() >= int(sizeof(address->sun_path))) {
+        qWarning() << "QSharedMemoryVideo: the socket path is too long" << path;
+        return false;
+    }
+
+    memset(address, 0, sizeof(sockaddr_un));
+    address->sun_family = AF_UNIX;
+    memcpy(address->sun_path, encodedPath.constData(), encodedPath.size());
+    return true;
+}
+
+static bool isStaleSocket(const sockaddr_un &address)
+{
+    const int socket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (socket == -1)
+        return false;
+
+    const bool refused = ::connect(socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == -1
+            && errno == ECONNREFUSED;
+    ::close(socket);
+    return refused;
+}
+
+int listen(const QString &path)
+{
+    sockaddr_un address;
+    if (!socketAddress(path, &address))
+        return -1;
+
+    // Sequenced packets keep messages and their attached descriptors together.
+    const int server = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (server == -1)
+        return -1;
+
+    bool bound = ::bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0;
+
+    // A socket left behind by a crashed publisher is replaced, one that still
+    // accepts connections belongs to a live publisher and is left alone.
+    if (!bound && errno == EADDRINUSE) {
+        if (!isStaleSocket(address)) {
+            qWarning() << "QSharedMemoryVideo: failed to listen on" << path << strerror(EADDRINUSE);
+            ::close(server);
+            return -1;
+        }
+        ::unlink(address.sun_path);
+        bound = ::bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0;
+    }
+
+    if (!bound || ::listen(server, 16) == -1) {
+        qWarning() << "QSharedMemoryVideo: failed to listen on" << path << strerror(errno);
+        ::close(server);
+        return -1;
+    }
+
+    return server;
+}
+
+int connect(const QString &path)
+{
+    sockaddr_un address;
+    if (!socketAddress(path, &address))
+        return -1;
+
+    const int socket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (socket == -1)
+        return -1;
+
+    if (::connect(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1) {
+        ::close(socket);
+        return -1;
+    }
+
+    ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) | O_NONBLOCK);
+    return socket;
+}
+
+int accept(int server)
+{
+    return ::accept4(server, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+}
+
+void closeSocket(int socket)
+{
+    if (socket != -1)
+        ::close(socket);
+}
+
+bool sendMessage(int socket, const Message &message, int fd)
+{
+    iovec iov;
+    iov.iov_base = const_cast<Message *>(&message);
+    iov.iov_len = sizeof(Message);
+
+    msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+
+    char control[CMSG_SPACE(sizeof(int))];
+    if (fd != -1) {
+        memset(control, 0, sizeof(control));
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    // Never block the publisher, a consumer too slow to drain its socket misses notifications.
+    return ::sendmsg(socket, &header, MSG_DONTWAIT | MSG_NOSIGNAL) == ssize_t(sizeof(Message));
+}
+
+int receiveMessage(int socket, Message *message, int *fd)
+{
+    *fd = -1;
+
+    iovec iov;
+    iov.iov_base = message;
+    iov.iov_len = sizeof(Message);
+
+    char control[CMSG_SPACE(sizeof(int))];
+
+    msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    const ssize_t bytes = ::recvmsg(socket, &header, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    if (bytes == -1)
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    if (bytes == 0)
+        return -1;
+
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+
+    if (bytes != ssize_t(sizeof(Message))) {
+        if (*fd != -1)
+            ::close(*fd);
+        *fd = -1;
+        return 0;
+    }
+
+    return 1;
+}
+
+#else
+
+int createRing(const QString &, quint32, int, int, uchar **, qsizetype *)
+{
+    qWarning("QSharedMemoryVideo: sharing video frames between processes is not supported on this platform");
+    return -1;
+}
+
+uchar *mapRing(int, qsizetype *, RingHeader *) { return 0; }
+void unmapRing(uchar *, qsizetype) {}
+
+int listen(const QString &) { return -1; }
+int connect(const QString &) { return -1; }
+int accept(int) { return -1; }
+void closeSocket(int) {}
+
+bool sendMessage(int, const Message &, int) { return false; }
+int receiveMessage(int, Message *, int *) { return -1; }
+
+#endif
+
+}
+
+QT_END_NAMESPACE
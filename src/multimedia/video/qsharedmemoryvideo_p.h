@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSHAREDMEMORYVIDEO_P_H
+#define QSHAREDMEMORYVIDEO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+// Layout of the memory shared between a QSharedMemoryVideoSurface and its
+// QSharedMemoryVideoSource consumers:
+//
+//   RingHeader | SlotHeader * slotCount | padding | slot data * slotCount
+//
+// The publisher only ever writes a slot nobody is reading. A slot's readers
+// field is the number of consumers holding a frame from it, or -1 while the
+// publisher fills it. Both sides claim a slot with a compare-and-swap, so
+// neither of them waits for the other: the publisher drops the frame when no
+// slot is free, a consumer skips a slot that is being rewritten.
+
+namespace QSharedMemoryVideo {
+
+enum {
+    Magic = 0x51766d73, // "Qvms"
+    Version = 1,
+    MaximumPlanes = 4,
+    MaximumDimension = 1 << 15,
+    DefaultSlotCount = 4
+};
+
+enum MessageType {
+    RingMessage = 1,    // a new ring, its file descriptor is attached
+    FrameMessage = 2,   // a new frame was published
+    StopMessage = 3     // the publisher stopped
+};
+
+struct Message
+{
+    quint32 type;
+    quint32 generation;
+    quint64 sequence;
+};
+
+struct SlotHeader
+{
+    QBasicAtomicInt readers;
+    quint32 pixelFormat;
+    qint32 width;
+    qint32 height;
+    qint64 startTime;
+    qint64 endTime;
+    quint64 sequence;
+    qint32 mappedBytes;
+    qint32 planeCount;
+    qint32 bytesPerLine[MaximumPlanes];
+    qint32 planeOffset[MaximumPlanes];
+};
+
+struct RingHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 generation;
+    quint32 slotCount;
+    quint32 slotSize;
+    quint32 dataOffset;
+    QBasicAtomicInt latestSlot;
+    quint32 reserved;
+};
+
+inline SlotHeader *slotHeader(uchar *ring, int slot)
+{
+    return reinterpret_cast<SlotHeader *>(ring + sizeof(RingHeader)) + slot;
+}
+
+inline uchar *slotData(uchar *ring, int slot)
+{
+    const RingHeader *header = reinterpret_cast<const RingHeader *>(ring);
+    return ring + header->dataOffset + qsizetype(slot) * header->slotSize;
+}
+
+// Consumers use a copy of the layout, the publisher could change the original.
+inline uchar *slotData(uchar *ring, const RingHeader &layout, int slot)
+{
+    return ring + layout.dataOffset + qsizetype(slot) * layout.slotSize;
+}
+
+// Checks a copy of a slot header written by another process, every plane
+// has to lie within the slot.
+bool isValidFrame(const SlotHeader &header, quint32 slotSize);
+
+QString socketPath(const QString &name);
+
+int createRing(const QString &name, quint32 generation, int slotCount, int slotSize,
+               uchar **ring, qsizetype *ringSize);
+uchar *mapRing(int fd, qsizetype *ringSize, RingHeader *layout = 0);
+void unmapRing(uchar *ring, qsizetype ringSize);
+
+int listen(const QString &path);
+int connect(const QString &path);
+int accept(int server);
+void closeSocket(int socket);
+
+bool sendMessage(int socket, const Message &message, int fd = -1);
+// Returns 1 if a message was read, 0 when none is pending and -1 once the peer is gone.
+int receiveMessage(int socket, Message *message, int *fd);
+
+}
+
+QT_END_NAMESPACE
+
+#endif // QSHAREDMEMORYVIDEO_P_H
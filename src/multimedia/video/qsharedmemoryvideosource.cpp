@@ -0,0 +1,485 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsharedmemoryvideosource.h"
+#include "qsharedmemoryvideo_p.h"
+
+#include <qabstractvideobuffer.h>
+#include <qabstractvideosurface.h>
+#include <qvideosurfaceformat.h>
+
+#include <QtCore/qpointer.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qsocketnotifier.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QSharedMemoryVideo;
+
+namespace {
+
+/*
+    A mapping of a publisher's ring, kept alive by the frames referencing it so
+    they stay valid after the publisher switched to a new ring or went away.
+*/
+class QSharedMemoryVideoRing : public QSharedData
+{
+public:
+    QSharedMemoryVideoRing(uchar *data, qsizetype size, const RingHeader &layout)
+        : data(data)
+        , size(size)
+    {
+        memcpy(static_cast<void *>(&this->layout), &layout, sizeof(RingHeader));
+    }
+
+    ~QSharedMemoryVideoRing()
+    {
+        unmapRing(data, size);
+    }
+
+    uchar *data;
+    qsizetype size;
+    RingHeader layout; // validated copy of the ring's header
+};
+
+/*
+    A frame in a slot of the ring. It holds a reader reference on the slot,
+    which keeps the publisher from rewriting it, and maps it without copying.
+    The planes are taken from the validated copy of the slot header, not from
+    the shared memory.
+*/
+class QSharedMemoryVideoBuffer : public QAbstractPlanarVideoBuffer
+{
+public:
+    QSharedMemoryVideoBuffer(const QExplicitlySharedDataPointer<QSharedMemoryVideoRing> &ring, int slot,
+                             const SlotHeader &header)
+        : QAbstractPlanarVideoBuffer(NoHandle)
+        , m_ring(ring)
+        , m_slot(slot)
+        , m_mapMode(NotMapped)
+    {
+        memcpy(static_cast<void *>(&m_header), &header, sizeof(SlotHeader));
+    }
+
+    ~QSharedMemoryVideoBuffer()
+    {
+        slotHeader(m_ring->data, m_slot)->readers.deref();
+    }
+
+    MapMode mapMode() const override { return m_mapMode; }
+
+    int map(MapMode mode, int *numBytes, int bytesPerLine[4], uchar *data[4]) override
+    {
+        // The memory is shared with the publisher and other consumers.
+        if (mode != ReadOnly || m_mapMode != NotMapped)
+            return 0;
+
+        uchar *bits = slotData(m_ring->data, m_ring->layout, m_slot);
+
+        for (int plane = 0; plane < m_header.planeCount; ++plane) {
+            bytesPerLine[plane] = m_header.bytesPerLine[plane];
+            data[plane] = bits + m_header.planeOffset[plane];
+        }
+        if (numBytes)
+            *numBytes = m_header.mappedBytes;
+
+        m_mapMode = mode;
+        return m_header.planeCount;
+    }
+
+    void unmap() override { m_mapMode = NotMapped; }
+
+private:
+    QExplicitlySharedDataPointer<QSharedMemoryVideoRing> m_ring;
+    const int m_slot;
+    SlotHeader m_header;
+    MapMode m_mapMode;
+};
+
+}
+
+class QSharedMemoryVideoSourcePrivate
+{
+public:
+    QSharedMemoryVideoSourcePrivate(QSharedMemoryVideoSource *q, const QString &name)
+        : q(q)
+        , name(name)
+        , socket(-1)
+        , notifier(0)
+        , lastSequence(0)
+    {
+    }
+
+    void readMessages();
+    void setRing(int fd);
+    void updateFrame();
+    void stopSurface();
+
+    QSharedMemoryVideoSource *q;
+    QString name;
+    int socket;
+    QSocketNotifier *notifier;
+    QPointer<QAbstractVideoSurface> surface;
+    QExplicitlySharedDataPointer<QSharedMemoryVideoRing> ring;
+    QVideoFrame latestFrame;
+    quint64 lastSequence;
+};
+
+void QSharedMemoryVideoSourcePrivate::readMessages()
+{
+    bool frame = false;
+    Message message;
+
+    for (;;) {
+        int fd = -1;
+        const int result = receiveMessage(socket, &message, &fd);
+
+        if (result < 0) {
+            if (fd != -1)
+                closeSocket(fd);
+            q->close();
+            return;
+        }
+        if (result == 0)
+            break;
+
+        switch (message.type) {
+        case RingMessage:
+            setRing(fd);
+            fd = -1;
+            frame = false;
+            break;
+        case FrameMessage:
+            // Only the latest of several pending frames is of interest.
+            frame = true;
+            break;
+        case StopMessage:
+            ring.reset();
+            latestFrame = QVideoFrame();
+            lastSequence = 0;
+            frame = false;
+            stopSurface();
+            break;
+        default:
+            break;
+        }
+
+        if (fd != -1)
+            closeSocket(fd);
+    }
+
+    if (frame)
+        updateFrame();
+}
+
+void QSharedMemoryVideoSourcePrivate::setRing(int fd)
+{
+    ring.reset();
+    lastSequence = 0;
+
+    if (fd == -1)
+        return;
+
+    qsizetype size = 0;
+    RingHeader layout;
+    uchar *data = mapRing(fd, &size, &layout);
+    closeSocket(fd);
+
+    if (data)
+        ring = new QSharedMemoryVideoRing(data, size, layout);
+}
+
+void QSharedMemoryVideoSourcePrivate::updateFrame()
+{
+    if (!ring)
+        return;
+
+    RingHeader *header = reinterpret_cast<RingHeader *>(ring->data);
+    const int slot = header->latestSlot.loadAcquire();
+    if (slot < 0 || quint32(slot) >= ring->layout.slotCount)
+        return;
+
+    // Take a reader reference unless the publisher is already rewriting the slot,
+    // in which case a notification for the newer frame is on its way.
+    SlotHeader *slotHeader = QSharedMemoryVideo::slotHeader(ring->data, slot);
+    for (int readers = slotHeader->readers.loadAcquire(); ; ) {
+        if (readers < 0)
+            return;
+        if (slotHeader->readers.testAndSetAcquire(readers, readers + 1, readers))
+            break;
+    }
+
+    // Read the header once while holding the reference and only use the copy,
+    // the publisher is another process and can't be trusted with the layout.
+    SlotHeader copy;
+    memcpy(static_cast<void *>(&copy), slotHeader, sizeof(SlotHeader));
+
+    if (copy.sequence <= lastSequence || !isValidFrame(copy, ring->layout.slotSize)) {
+        slotHeader->readers.deref();
+        return;
+    }
+
+    lastSequence = copy.sequence;
+
+    QVideoFrame frame(new QSharedMemoryVideoBuffer(ring, slot, copy),
+                      QSize(copy.width, copy.height),
+                      QVideoFrame::PixelFormat(copy.pixelFormat));
+    frame.setStartTime(copy.startTime);
+    frame.setEndTime(copy.endTime);
+    latestFrame = frame;
+
+    if (surface) {
+        const QVideoSurfaceFormat format = surface->surfaceFormat();
+        if (surface->isActive()
+                && (format.pixelFormat() != frame.pixelFormat() || format.frameSize() != frame.size())) {
+            surface->stop();
+        }
+
+        if (!surface->isActive())
+            surface->start(QVideoSurfaceFormat(frame.size(), frame.pixelFormat()));
+
+        if (surface->isActive())
+            surface->present(frame);
+    }
+
+    emit q->frameAvailable(frame);
+}
+
+void QSharedMemoryVideoSourcePrivate::stopSurface()
+{
+    if (surface && surface->isActive())
+        surface->stop();
+}
+
+/*!
+    \class QSharedMemoryVideoSource
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_video
+    \since 5.13
+
+    \brief The QSharedMemoryVideoSource class receives video frames published by
+    another process.
+
+    A QSharedMemoryVideoSource connects to the QSharedMemoryVideoSurface with the same
+    name and presents every frame it publishes to a video surface. Frames are mapped
+    directly from the memory shared with the publisher, no copy is made.
+
+    The source has a \l videoSurface property, so it can be used as the source of a
+    QML VideoOutput. Frames can also be processed directly by connecting to
+    frameAvailable().
+
+    \code
+        QSharedMemoryVideoSource *source = new QSharedMemoryVideoSource("camera");
+        source->setVideoSurface(videoWidget->videoSurface());
+        source->open();
+    \endcode
+
+    Frames can only be mapped read-only. While a frame is referenced, its slot can't
+    be reused by the publisher, so frames should be released as soon as possible.
+
+    \sa QSharedMemoryVideoSurface
+*/
+
+/*!
+    \property QSharedMemoryVideoSource::name
+    \brief the name of the QSharedMemoryVideoSurface to receive frames from
+
+    Changing the name closes the source.
+*/
+
+/*!
+    \property QSharedMemoryVideoSource::videoSurface
+    \brief the surface frames are presented to
+*/
+
+/*!
+    \property QSharedMemoryVideoSource::connected
+    \brief whether the source is connected to a publisher
+*/
+
+/*!
+    Constructs a source with the given \a parent.
+*/
+QSharedMemoryVideoSource::QSharedMemoryVideoSource(QObject *parent)
+    : QObject(parent)
+    , d(new QSharedMemoryVideoSourcePrivate(this, QString()))
+{
+}
+
+/*!
+    Constructs a source for the publisher with the given \a name and \a parent.
+*/
+QSharedMemoryVideoSource::QSharedMemoryVideoSource(const QString &name, QObject *parent)
+    : QObject(parent)
+    , d(new QSharedMemoryVideoSourcePrivate(this, name))
+{
+}
+
+/*!
+    Destroys the source.
+
+    Frames received from it stay valid.
+*/
+QSharedMemoryVideoSource::~QSharedMemoryVideoSource()
+{
+    close();
+    delete d;
+}
+
+QString QSharedMemoryVideoSource::name() const
+{
+    return d->name;
+}
+
+void QSharedMemoryVideoSource::setName(const QString &name)
+{
+    if (d->name == name)
+        return;
+
+    close();
+    d->name = name;
+    emit nameChanged(name);
+}
+
+QAbstractVideoSurface *QSharedMemoryVideoSource::videoSurface() const
+{
+    return d->surface;
+}
+
+void QSharedMemoryVideoSource::setVideoSurface(QAbstractVideoSurface *surface)
+{
+    if (d->surface == surface)
+        return;
+
+    d->stopSurface();
+    d->surface = surface;
+
+    if (surface && d->latestFrame.isValid()) {
+        const QVideoFrame &frame = d->latestFrame;
+        if (surface->isActive())
+            surface->stop();
+        if (surface->start(QVideoSurfaceFormat(frame.size(), frame.pixelFormat())))
+            surface->present(frame);
+    }
+}
+
+bool QSharedMemoryVideoSource::isConnected() const
+{
+    return d->socket != -1;
+}
+
+/*!
+    Returns the latest frame received, or an invalid frame if the publisher isn't
+    playing.
+*/
+QVideoFrame QSharedMemoryVideoSource::latestFrame() const
+{
+    return d->latestFrame;
+}
+
+/*!
+    Connects to the publisher, returns whether that succeeded.
+
+    The source doesn't retry when the publisher isn't running yet, or closes once it
+    exits; open() has to be called again.
+*/
+bool QSharedMemoryVideoSource::open()
+{
+    if (d->socket != -1)
+        return true;
+
+    d->socket = QSharedMemoryVideo::connect(socketPath(d->name));
+    if (d->socket == -1)
+        return false;
+
+    d->notifier = new QSocketNotifier(d->socket, QSocketNotifier::Read, this);
+    QObject::connect(d->notifier, &QSocketNotifier::activated, this, [this]() { d->readMessages(); });
+
+    emit connectedChanged(true);
+    return true;
+}
+
+/*!
+    Disconnects from the publisher and stops the video surface.
+*/
+void QSharedMemoryVideoSource::close()
+{
+    if (d->socket == -1)
+        return;
+
+    // This may run from the notifier's own signal.
+    d->notifier->setEnabled(false);
+    d->notifier->deleteLater();
+    d->notifier = 0;
+
+    closeSocket(d->socket);
+    d->socket = -1;
+
+    d->ring.reset();
+    d->latestFrame = QVideoFrame();
+    d->lastSequence = 0;
+    d->stopSurface();
+
+    emit connectedChanged(false);
+}
+
+/*!
+    \fn void QSharedMemoryVideoSource::nameChanged(const QString &name)
+
+    Signals that the \a name of the publisher changed.
+*/
+
+/*!
+    \fn void QSharedMemoryVideoSource::connectedChanged(bool connected)
+
+    Signals that the source \a connected to or disconnected from the publisher.
+*/
+
+/*!
+    \fn void QSharedMemoryVideoSource::frameAvailable(const QVideoFrame &frame)
+
+    Signals that a new \a frame was received from the publisher.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qsharedmemoryvideosource.cpp"
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSHAREDMEMORYVIDEOSOURCE_H
+#define QSHAREDMEMORYVIDEOSOURCE_H
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtMultimedia/qvideoframe.h>
+#include <QtCore/qobject.h>
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractVideoSurface;
+
+class QSharedMemoryVideoSourcePrivate;
+class Q_MULTIMEDIA_EXPORT QSharedMemoryVideoSource : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(QAbstractVideoSurface *videoSurface READ videoSurface WRITE setVideoSurface)
+    Q_PROPERTY(bool connected READ isConnected NOTIFY connectedChanged)
+public:
+    explicit QSharedMemoryVideoSource(QObject *parent = nullptr);
+    explicit QSharedMemoryVideoSource(const QString &name, QObject *parent = nullptr);
+    ~QSharedMemoryVideoSource();
+
+    QString name() const;
+    void setName(const QString &name);
+
+    QAbstractVideoSurface *videoSurface() const;
+    void setVideoSurface(QAbstractVideoSurface *surface);
+
+    bool isConnected() const;
+    QVideoFrame latestFrame() const;
+
+public Q_SLOTS:
+    bool open();
+    void close();
+
+Q_SIGNALS:
+    void nameChanged(const QString &name);
+    void connectedChanged(bool connected);
+    void frameAvailable(const QVideoFrame &frame);
+
+private:
+    Q_DISABLE_COPY(QSharedMemoryVideoSource)
+    QSharedMemoryVideoSourcePrivate *d;
+    friend class QSharedMemoryVideoSourcePrivate;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSHAREDMEMORYVIDEOSOURCE_H
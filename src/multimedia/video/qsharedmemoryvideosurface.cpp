@@ -0,0 +1,508 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsharedmemoryvideosurface.h"
+#include "qsharedmemoryvideo_p.h"
+
+#include <qvideosurfaceformat.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qsocketnotifier.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QSharedMemoryVideo;
+
+class QSharedMemoryVideoSurfacePrivate
+{
+public:
+    QSharedMemoryVideoSurfacePrivate(QSharedMemoryVideoSurface *q, const QString &name)
+        : q(q)
+        , name(name)
+        , server(-1)
+        , serverNotifier(0)
+        , slotCount(DefaultSlotCount)
+        , ringFd(-1)
+        , ring(0)
+        , ringSize(0)
+        , generation(0)
+        , sequence(0)
+        , nextSlot(0)
+        , droppedFrames(0)
+    {
+    }
+
+    void listen();
+    void acceptConsumers();
+    void readConsumer(int socket);
+    void removeConsumer(int socket);
+    void broadcast(MessageType type, int fd = -1);
+
+    bool allocateRing(int slotSize);
+    void releaseRing();
+    int acquireSlot();
+
+    QSharedMemoryVideoSurface *q;
+    QString name;
+    QString path;
+    int server;
+    QSocketNotifier *serverNotifier;
+    QMap<int, QSocketNotifier *> consumers;
+    int slotCount;
+    int ringFd;
+    uchar *ring;
+    qsizetype ringSize;
+    quint32 generation;
+    quint64 sequence;
+    int nextSlot;
+    int droppedFrames;
+};
+
+void QSharedMemoryVideoSurfacePrivate::listen()
+{
+    path = socketPath(name);
+    server = QSharedMemoryVideo::listen(path);
+    if (server == -1)
+        return;
+
+    serverNotifier = new QSocketNotifier(server, QSocketNotifier::Read, q);
+    QObject::connect(serverNotifier, &QSocketNotifier::activated, q, [this]() { acceptConsumers(); });
+}
+
+void QSharedMemoryVideoSurfacePrivate::acceptConsumers()
+{
+    const int oldCount = consumers.count();
+
+    for (int socket = accept(server); socket != -1; socket = accept(server)) {
+        // Consumers never write, the socket becomes readable when they hang up.
+        QSocketNotifier *notifier = new QSocketNotifier(socket, QSocketNotifier::Read, q);
+        QObject::connect(notifier, &QSocketNotifier::activated, q, [this, socket]() { readConsumer(socket); });
+        consumers.insert(socket, notifier);
+
+        if (ring) {
+            const Message message = { RingMessage, generation, sequence };
+            if (!sendMessage(socket, message, ringFd))
+                removeConsumer(socket);
+        }
+    }
+
+    if (consumers.count() != oldCount)
+        emit q->consumerCountChanged(consumers.count());
+}
+
+void QSharedMemoryVideoSurfacePrivate::readConsumer(int socket)
+{
+    Message message;
+    int fd = -1;
+
+    for (;;) {
+        const int result = receiveMessage(socket, &message, &fd);
+        if (fd != -1)
+            closeSocket(fd);
+        if (result < 0) {
+            removeConsumer(socket);
+            emit q->consumerCountChanged(consumers.count());
+            return;
+        }
+        if (result == 0)
+            return;
+    }
+}
+
+void QSharedMemoryVideoSurfacePrivate::removeConsumer(int socket)
+{
+    QSocketNotifier *notifier = consumers.take(socket);
+    if (!notifier)
+        return;
+
+    // This may run from the notifier's own signal.
+    notifier->setEnabled(false);
+    notifier->deleteLater();
+    closeSocket(socket);
+}
+
+void QSharedMemoryVideoSurfacePrivate::broadcast(MessageType type, int fd)
+{
+    const Message message = { quint32(type), generation, sequence };
+    const int oldCount = consumers.count();
+
+    for (int socket : consumers.keys()) {
+        // A missed frame notification is caught up with by the next one, but a
+        // consumer missing a ring or stop message would be out of sync.
+        if (!sendMessage(socket, message, fd) && type != FrameMessage)
+            removeConsumer(socket);
+    }
+
+    if (consumers.count() != oldCount)
+        emit q->consumerCountChanged(consumers.count());
+}
+
+bool QSharedMemoryVideoSurfacePrivate::allocateRing(int slotSize)
+{
+    // Consumers keep their own mapping of the previous ring for as long as they use its frames.
+    releaseRing();
+
+    ringFd = createRing(name, ++generation, slotCount, slotSize, &ring, &ringSize);
+    if (ringFd == -1)
+        return false;
+
+    nextSlot = 0;
+    broadcast(RingMessage, ringFd);
+    return true;
+}
+
+void QSharedMemoryVideoSurfacePrivate::releaseRing()
+{
+    if (!ring)
+        return;
+
+    unmapRing(ring, ringSize);
+    closeSocket(ringFd);
+
+    ring = 0;
+    ringSize = 0;
+    ringFd = -1;
+}
+
+int QSharedMemoryVideoSurfacePrivate::acquireSlot()
+{
+    RingHeader *header = reinterpret_cast<RingHeader *>(ring);
+    const int count = header->slotCount;
+    const int latest = header->latestSlot.loadAcquire();
+
+    for (int i = 0; i < count; ++i) {
+        const int slot = (nextSlot + i) % count;
+
+        // The latest frame stays available to late consumers until a newer one replaces it.
+        if (slot == latest)
+            continue;
+
+        if (slotHeader(ring, slot)->readers.testAndSetAcquire(0, -1)) {
+            nextSlot = (slot + 1) % count;
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+    \class QSharedMemoryVideoSurface
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_video
+    \since 5.13
+
+    \brief The QSharedMemoryVideoSurface class publishes video frames to other processes.
+
+    A QSharedMemoryVideoSurface copies the frames presented to it into a ring of
+    slots in shared memory. Any number of QSharedMemoryVideoSource instances, in
+    the same or in other processes, can connect to it by name and receive those
+    frames without copying them again. A stream decoded once by a QMediaPlayer or a
+    QCamera can that way be displayed or processed by several applications:
+
+    \code
+        QSharedMemoryVideoSurface *surface = new QSharedMemoryVideoSurface("camera");
+        player->setVideoOutput(surface);
+    \endcode
+
+    The publisher never waits for its consumers. A frame is written to a slot no
+    consumer is reading, and dropped if there is none. Consumers holding on to
+    frames for a long time should be given more slots with setSlotCount().
+
+    The \a name is the path of a local socket, which is placed in the temporary
+    directory unless it is absolute, like with QLocalServer. Frames are shared using
+    anonymous memory passed over that socket, which is only supported on Linux.
+
+    \sa QSharedMemoryVideoSource
+*/
+
+/*!
+    Constructs a surface publishing frames under the given \a name, with the given \a parent.
+
+    A socket left behind under the same name by a publisher which didn't exit cleanly is
+    replaced. If another publisher is still using the name, the surface doesn't listen.
+
+    \sa isListening()
+*/
+QSharedMemoryVideoSurface::QSharedMemoryVideoSurface(const QString &name, QObject *parent)
+    : QAbstractVideoSurface(parent)
+    , d(new QSharedMemoryVideoSurfacePrivate(this, name))
+{
+    d->listen();
+}
+
+/*!
+    Destroys the surface, disconnecting its consumers.
+
+    Frames the consumers still hold remain valid.
+*/
+QSharedMemoryVideoSurface::~QSharedMemoryVideoSurface()
+{
+    stop();
+
+    for (auto it = d->consumers.cbegin(); it != d->consumers.cend(); ++it)
+        closeSocket(it.key());
+
+    if (d->server != -1) {
+        closeSocket(d->server);
+        QFile::remove(d->path);
+    }
+
+    delete d;
+}
+
+/*!
+    Returns the name frames are published under.
+*/
+QString QSharedMemoryVideoSurface::name() const
+{
+    return d->name;
+}
+
+/*!
+    Returns whether consumers can connect to the surface.
+
+    This is false if the name is already in use by another publisher.
+*/
+bool QSharedMemoryVideoSurface::isListening() const
+{
+    return d->server != -1;
+}
+
+/*!
+    Returns the number of frames the shared memory can hold.
+
+    The default is 4.
+*/
+int QSharedMemoryVideoSurface::slotCount() const
+{
+    return d->slotCount;
+}
+
+/*!
+    Sets the number of frames the shared memory can hold to \a count.
+
+    At least two slots are needed, so that the latest frame stays readable while the next
+    one is being written. Each consumer should be given one more slot for every frame it
+    keeps at once. The change takes effect with the next frame presented.
+*/
+void QSharedMemoryVideoSurface::setSlotCount(int count)
+{
+    count = qMax(2, count);
+    if (d->slotCount == count)
+        return;
+
+    d->slotCount = count;
+    d->releaseRing();
+}
+
+/*!
+    Returns the number of consumers connected to the surface.
+*/
+int QSharedMemoryVideoSurface::consumerCount() const
+{
+    return d->consumers.count();
+}
+
+/*!
+    Returns the number of frames dropped because every slot was still in use by consumers.
+*/
+int QSharedMemoryVideoSurface::droppedFrameCount() const
+{
+    return d->droppedFrames;
+}
+
+/*!
+    \reimp
+
+    Frames are copied from system memory, only buffers which can be mapped are supported.
+*/
+QList<QVideoFrame::PixelFormat> QSharedMemoryVideoSurface::supportedPixelFormats(
+        QAbstractVideoBuffer::HandleType type) const
+{
+    if (type != QAbstractVideoBuffer::NoHandle)
+        return QList<QVideoFrame::PixelFormat>();
+
+    return QList<QVideoFrame::PixelFormat>()
+            << QVideoFrame::Format_ARGB32
+            << QVideoFrame::Format_ARGB32_Premultiplied
+            << QVideoFrame::Format_RGB32
+            << QVideoFrame::Format_RGB24
+            << QVideoFrame::Format_RGB565
+            << QVideoFrame::Format_RGB555
+            << QVideoFrame::Format_BGRA32
+            << QVideoFrame::Format_BGRA32_Premultiplied
+            << QVideoFrame::Format_BGR32
+            << QVideoFrame::Format_BGR24
+            << QVideoFrame::Format_ABGR32
+            << QVideoFrame::Format_AYUV444
+            << QVideoFrame::Format_AYUV444_Premultiplied
+            << QVideoFrame::Format_YUV444
+            << QVideoFrame::Format_YUV420P
+            << QVideoFrame::Format_YV12
+            << QVideoFrame::Format_UYVY
+            << QVideoFrame::Format_YUYV
+            << QVideoFrame::Format_NV12
+            << QVideoFrame::Format_NV21
+            << QVideoFrame::Format_Y8
+            << QVideoFrame::Format_Y16;
+}
+
+/*!
+    \reimp
+*/
+bool QSharedMemoryVideoSurface::start(const QVideoSurfaceFormat &format)
+{
+    if (format.handleType() != QAbstractVideoBuffer::NoHandle
+            || !supportedPixelFormats().contains(format.pixelFormat())
+            || format.frameSize().isEmpty()) {
+        setError(UnsupportedFormatError);
+        return false;
+    }
+
+    return QAbstractVideoSurface::start(format);
+}
+
+/*!
+    \reimp
+*/
+void QSharedMemoryVideoSurface::stop()
+{
+    if (!isActive())
+        return;
+
+    d->broadcast(StopMessage);
+    d->releaseRing();
+
+    QAbstractVideoSurface::stop();
+}
+
+/*!
+    \reimp
+
+    Copies \a frame to a free slot of the shared memory and notifies the consumers.
+    The shared memory is reallocated when the frame doesn't fit into a slot.
+*/
+bool QSharedMemoryVideoSurface::present(const QVideoFrame &frame)
+{
+    if (!isActive()) {
+        setError(StoppedError);
+        return false;
+    }
+
+    const QVideoSurfaceFormat format = surfaceFormat();
+    if (frame.pixelFormat() != format.pixelFormat() || frame.size() != format.frameSize()) {
+        setError(IncorrectFormatError);
+        stop();
+        return false;
+    }
+
+    QVideoFrame source(frame);
+    if (!source.map(QAbstractVideoBuffer::ReadOnly)) {
+        setError(ResourceError);
+        return false;
+    }
+
+    const int bytes = source.mappedBytes();
+    const int planeCount = qMin(source.planeCount(), int(MaximumPlanes));
+
+    // The planes are copied in one go, they need to be part of the mapped memory.
+    for (int plane = 0; plane < planeCount; ++plane) {
+        const qptrdiff offset = source.bits(plane) - source.bits();
+        if (offset < 0 || offset >= bytes) {
+            source.unmap();
+            setError(ResourceError);
+            return false;
+        }
+    }
+
+    if (!d->ring || quint32(bytes) > reinterpret_cast<RingHeader *>(d->ring)->slotSize) {
+        if (!d->allocateRing(bytes)) {
+            source.unmap();
+            setError(ResourceError);
+            return false;
+        }
+    }
+
+    const int slot = d->acquireSlot();
+    if (slot == -1) {
+        ++d->droppedFrames;
+        source.unmap();
+        return true;
+    }
+
+    SlotHeader *header = slotHeader(d->ring, slot);
+    memcpy(slotData(d->ring, slot), source.bits(), bytes);
+
+    header->pixelFormat = source.pixelFormat();
+    header->width = source.width();
+    header->height = source.height();
+    header->startTime = source.startTime();
+    header->endTime = source.endTime();
+    header->sequence = ++d->sequence;
+    header->mappedBytes = bytes;
+    header->planeCount = planeCount;
+    for (int plane = 0; plane < planeCount; ++plane) {
+        header->bytesPerLine[plane] = source.bytesPerLine(plane);
+        header->planeOffset[plane] = source.bits(plane) - source.bits();
+    }
+
+    source.unmap();
+
+    header->readers.storeRelease(0);
+    reinterpret_cast<RingHeader *>(d->ring)->latestSlot.storeRelease(slot);
+
+    d->broadcast(FrameMessage);
+
+    return true;
+}
+
+/*!
+    \fn void QSharedMemoryVideoSurface::consumerCountChanged(int count)
+
+    Signals that a consumer connected or disconnected, \a count consumers are connected now.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qsharedmemoryvideosurface.cpp"
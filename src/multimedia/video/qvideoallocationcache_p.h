@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QVIDEOALLOCATIONCACHE_P_H
+#define QVIDEOALLOCATIONCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtCore/qatomic.h>
+
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    A small lock-free cache of memory blocks of a fixed size.
+
+    Video frames and their buffers are allocated and released at the frame rate of
+    every stream, often on different threads. Released blocks are parked in a fixed
+    number of slots and handed out again by the next allocation, so steady state
+    playback doesn't go through the heap. Each slot is claimed and filled with a
+    single atomic exchange, which keeps the cache free of ABA problems.
+*/
+template <size_t Size, int Slots = 32>
+class QVideoAllocationCache
+{
+public:
+    QVideoAllocationCache()
+    {
+        for (QAtomicInteger<quintptr> &slot : m_slots)
+            slot.store(0);
+    }
+
+    ~QVideoAllocationCache()
+    {
+        for (QAtomicInteger<quintptr> &slot : m_slots)
+            ::operator delete(reinterpret_cast<void *>(slot.fetchAndStoreRelaxed(0)));
+    }
+
+    void *allocate(size_t size)
+    {
+        if (size == Size) {
+            for (QAtomicInteger<quintptr> &slot : m_slots) {
+                if (slot.loadAcquire() != 0) {
+                    if (const quintptr block = slot.fetchAndStoreAcquire(0))
+                        return reinterpret_cast<void *>(block);
+                }
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void release(void *block, size_t size)
+    {
+        if (size == Size) {
+            const quintptr value = reinterpret_cast<quintptr>(block);
+            for (QAtomicInteger<quintptr> &slot : m_slots) {
+                if (slot.load() == 0 && slot.testAndSetRelease(0, value))
+                    return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+private:
+    Q_DISABLE_COPY(QVideoAllocationCache)
+
+    QAtomicInteger<quintptr> m_slots[Slots];
+};
+
+QT_END_NAMESPACE
+
+#endif // QVIDEOALLOCATIONCACHE_P_H
@@ -42,6 +42,7 @@
 #include "qvideoframe_p.h"
 #include "qimagevideobuffer_p.h"
 #include "qmemoryvideobuffer_p.h"
+#include "qvideoallocationcache_p.h"
 #include "qvideoframeconversionhelper_p.h"
 
 #include <qimage.h>
@@ -50,6 +51,7 @@
 #include <qvariant.h>
 #include <qvector.h>
 #include <qmutex.h>
+#include <qscopedpointer.h>
 
 #include <QDebug>
 
@@ -76,7 +78,6 @@ public:
         , pixelFormat(QVideoFrame::Format_Invalid)
         , fieldType(QVideoFrame::ProgressiveFrame)
         , buffer(0)
-        , mappedCount(0)
     {
         memset(data, 0, sizeof(data));
         memset(bytesPerLine, 0, sizeof(bytesPerLine));
@@ -91,7 +92,6 @@ public:
         , pixelFormat(format)
         , fieldType(QVideoFrame::ProgressiveFrame)
         , buffer(0)
-        , mappedCount(0)
     {
         memset(data, 0, sizeof(data));
         memset(bytesPerLine, 0, sizeof(bytesPerLine));
@@ -103,6 +103,9 @@ public:
             buffer->release();
     }
 
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+
     QSize size;
     qint64 startTime;
     qint64 endTime;
@@ -113,14 +116,36 @@ public:
     QVideoFrame::PixelFormat pixelFormat;
     QVideoFrame::FieldType fieldType;
     QAbstractVideoBuffer *buffer;
-    int mappedCount;
+    // The number of read only mappings, or -1 if the frame is mapped for writing.
+    // Additional read only mappings only touch the counter, the mutex serializes
+    // mapping and unmapping the buffer itself.
+    QAtomicInt mappedCount;
     QMutex mapMutex;
-    QVariantMap metadata;
+    // Most frames never carry metadata, so it's only allocated when first set.
+    QScopedPointer<QVariantMap> metadata;
 
 private:
     Q_DISABLE_COPY(QVideoFramePrivate)
 };
 
+typedef QVideoAllocationCache<sizeof(QVideoFramePrivate)> QVideoFramePrivateCache;
+Q_GLOBAL_STATIC(QVideoFramePrivateCache, videoFramePrivateCache)
+
+void *QVideoFramePrivate::operator new(size_t size)
+{
+    if (QVideoFramePrivateCache *cache = videoFramePrivateCache())
+        return cache->allocate(size);
+    return ::operator new(size);
+}
+
+void QVideoFramePrivate::operator delete(void *block, size_t size)
+{
+    if (QVideoFramePrivateCache *cache = videoFramePrivateCache())
+        cache->release(block, size);
+    else
+        ::operator delete(block);
+}
+
 /*!
     \class QVideoFrame
     \brief The QVideoFrame class represents a frame of video data.
@@ -284,6 +309,17 @@ private:
     \value Format_AdobeDng
     The frame is stored using raw Adobe Digital Negative (DNG) format.
 
+    \value Format_P010
+    The frame is stored using a 16-bit per component semi-planar YUV format with a Y plane (Y)
+    followed by a horizontally and vertically sub-sampled, packed UV plane (U-V). Only the 10 most
+    significant bits of each component are used.  Little endian.  This value was introduced in
+    Qt 5.13.
+
+    \value Format_P016
+    The frame is stored using a 16-bit per component semi-planar YUV format with a Y plane (Y)
+    followed by a horizontally and vertically sub-sampled, packed UV plane (U-V).  Little endian.
+    This value was introduced in Qt 5.13.
+
     \value Format_User
     Start value for user defined pixel formats.
 */
@@ -565,25 +601,31 @@ QAbstractVideoBuffer::MapMode QVideoFrame::mapMode() const
 */
 bool QVideoFrame::map(QAbstractVideoBuffer::MapMode mode)
 {
-    QMutexLocker lock(&d->mapMutex);
-
     if (!d->buffer)
         return false;
 
     if (mode == QAbstractVideoBuffer::NotMapped)
         return false;
 
-    if (d->mappedCount > 0) {
+    if (mode == QAbstractVideoBuffer::ReadOnly) {
         //it's allowed to map the video frame multiple times in read only mode
-        if (d->buffer->mapMode() == QAbstractVideoBuffer::ReadOnly
-                && mode == QAbstractVideoBuffer::ReadOnly) {
-            d->mappedCount++;
-            return true;
-        } else {
-            return false;
+        for (int count = d->mappedCount.load(); count > 0; count = d->mappedCount.load()) {
+            if (d->mappedCount.testAndSetAcquire(count, count + 1))
+                return true;
         }
     }
 
+    QMutexLocker lock(&d->mapMutex);
+
+    const int count = d->mappedCount.load();
+    if (count > 0 && mode == QAbstractVideoBuffer::ReadOnly) {
+        // Mapped read only by another thread since the check above.
+        d->mappedCount.ref();
+        return true;
+    } else if (count != 0) {
+        return false;
+    }
+
     Q_ASSERT(d->data[0] == 0);
     Q_ASSERT(d->bytesPerLine[0] == 0);
     Q_ASSERT(d->planeCount == 0);
@@ -645,7 +687,9 @@ bool QVideoFrame::map(QAbstractVideoBuffer::MapMode mode)
     case Format_NV12:
     case Format_NV21:
     case Format_IMC2:
-    case Format_IMC4: {
+    case Format_IMC4:
+    case Format_P010:
+    case Format_P016: {
         // Semi planar, Full resolution Y plane with interleaved subsampled U and V planes.
         d->planeCount = 2;
         d->bytesPerLine[1] = d->bytesPerLine[0];
@@ -666,7 +710,7 @@ bool QVideoFrame::map(QAbstractVideoBuffer::MapMode mode)
         break;
     }
 
-    d->mappedCount++;
+    d->mappedCount.storeRelease(mode == QAbstractVideoBuffer::ReadOnly ? 1 : -1);
     return true;
 }
 
@@ -682,26 +726,35 @@ bool QVideoFrame::map(QAbstractVideoBuffer::MapMode mode)
 */
 void QVideoFrame::unmap()
 {
-    QMutexLocker lock(&d->mapMutex);
-
     if (!d->buffer)
         return;
 
-    if (d->mappedCount == 0) {
+    // Releasing one of several read only mappings doesn't need the lock.
+    for (int count = d->mappedCount.load(); count > 1; count = d->mappedCount.load()) {
+        if (d->mappedCount.testAndSetRelease(count, count - 1))
+            return;
+    }
+
+    QMutexLocker lock(&d->mapMutex);
+
+    const int count = d->mappedCount.load();
+    if (count == 0) {
         qWarning() << "QVideoFrame::unmap() was called more times then QVideoFrame::map()";
         return;
     }
 
-    d->mappedCount--;
+    // Another thread may have added a read only mapping without taking the lock.
+    if (count > 1 || !d->mappedCount.testAndSetOrdered(count, 0)) {
+        d->mappedCount.deref();
+        return;
+    }
 
-    if (d->mappedCount == 0) {
-        d->mappedBytes = 0;
-        d->planeCount = 0;
-        memset(d->bytesPerLine, 0, sizeof(d->bytesPerLine));
-        memset(d->data, 0, sizeof(d->data));
+    d->mappedBytes = 0;
+    d->planeCount = 0;
+    memset(d->bytesPerLine, 0, sizeof(d->bytesPerLine));
+    memset(d->data, 0, sizeof(d->data));
 
-        d->buffer->unmap();
-    }
+    d->buffer->unmap();
 }
 
 /*!
@@ -884,7 +937,7 @@ void QVideoFrame::setEndTime(qint64 time)
  */
 QVariantMap QVideoFrame::availableMetaData() const
 {
-    return d->metadata;
+    return d->metadata ? *d->metadata : QVariantMap();
 }
 
 /*!
@@ -898,7 +951,7 @@ QVariantMap QVideoFrame::availableMetaData() const
  */
 QVariant QVideoFrame::metaData(const QString &key) const
 {
-    return d->metadata.value(key);
+    return d->metadata ? d->metadata->value(key) : QVariant();
 }
 
 /*!
@@ -912,10 +965,13 @@ QVariant QVideoFrame::metaData(const QString &key) const
  */
 void QVideoFrame::setMetaData(const QString &key, const QVariant &value)
 {
-    if (!value.isNull())
-        d->metadata.insert(key, value);
-    else
-        d->metadata.remove(key);
+    if (!value.isNull()) {
+        if (!d->metadata)
+            d->metadata.reset(new QVariantMap);
+        d->metadata->insert(key, value);
+    } else if (d->metadata) {
+        d->metadata->remove(key);
+    }
 }
 
 /*!
@@ -1002,6 +1058,8 @@ QImage::Format QVideoFrame::imageFormatFromPixelFormat(PixelFormat format)
     case Format_Jpeg:
     case Format_CameraRaw:
     case Format_AdobeDng:
+    case Format_P010:
+    case Format_P016:
         return QImage::Format_Invalid;
     case Format_User:
     default:
@@ -1057,7 +1115,9 @@ static VideoFrameConvertFunc qConvertFuncs[QVideoFrame::NPixelFormats] = {
     /* Format_Y16 */                    nullptr,
     /* Format_Jpeg */                   nullptr, // Not needed
     /* Format_CameraRaw */              nullptr,
-    /* Format_AdobeDng */               nullptr
+    /* Format_AdobeDng */               nullptr,
+    /* Format_P010 */                   nullptr,
+    /* Format_P016 */                   nullptr
 };
 
 static void qInitConvertFuncsAsm()
@@ -1203,6 +1263,10 @@ QDebug operator<<(QDebug dbg, QVideoFrame::PixelFormat pf)
             return dbg << "Format_AdobeDng";
         case QVideoFrame::Format_CameraRaw:
             return dbg << "Format_CameraRaw";
+        case QVideoFrame::Format_P010:
+            return dbg << "Format_P010";
+        case QVideoFrame::Format_P016:
+            return dbg << "Format_P016";
 
         default:
             return dbg << QString(QLatin1String("UserType(%1)" )).arg(int(pf)).toLatin1().constData();
@@ -102,6 +102,9 @@ public:
         Format_CameraRaw,
         Format_AdobeDng,
 
+        Format_P010,
+        Format_P016,
+
 #ifndef Q_QDOC
         NPixelFormats,
 #endif
@@ -0,0 +1,400 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qvideoframepool.h"
+
+#include "qabstractvideobuffer_p.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qsize.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct QVideoFramePoolKey
+{
+    int bytes;
+    int bytesPerLine;
+    QSize size;
+    QVideoFrame::PixelFormat format;
+};
+
+bool operator==(const QVideoFramePoolKey &a, const QVideoFramePoolKey &b)
+{
+    return a.bytes == b.bytes
+            && a.bytesPerLine == b.bytesPerLine
+            && a.size == b.size
+            && a.format == b.format;
+}
+
+uint qHash(const QVideoFramePoolKey &key, uint seed = 0)
+{
+    QtPrivate::QHashCombine hash;
+    seed = hash(seed, key.bytes);
+    seed = hash(seed, key.bytesPerLine);
+    seed = hash(seed, key.size.width());
+    seed = hash(seed, key.size.height());
+    seed = hash(seed, int(key.format));
+    return seed;
+}
+
+}
+
+class QPooledVideoBuffer;
+
+class QVideoFramePoolPrivate : public QSharedData
+{
+public:
+    QVideoFramePoolPrivate(int maximumBufferCount)
+        : maximumBufferCount(maximumBufferCount)
+        , hits(0)
+        , misses(0)
+        , closed(false)
+    {
+    }
+
+    ~QVideoFramePoolPrivate();
+
+    void recycle(QPooledVideoBuffer *buffer);
+    void clear();
+
+    mutable QMutex mutex;
+    QHash<QVideoFramePoolKey, QVector<QPooledVideoBuffer *>> freeBuffers;
+    int maximumBufferCount;
+    QAtomicInt hits;
+    QAtomicInt misses;
+    bool closed;
+};
+
+/*
+    A system memory buffer which returns to its pool instead of being deleted when the
+    last frame referencing it is destroyed. The buffer keeps the pool data alive, so
+    frames may outlive the QVideoFramePool they were allocated from.
+*/
+class QPooledVideoBuffer : public QAbstractVideoBuffer
+{
+public:
+    QPooledVideoBuffer(QVideoFramePoolPrivate *pool, const QVideoFramePoolKey &key)
+        : QAbstractVideoBuffer(NoHandle)
+        , m_pool(pool)
+        , m_key(key)
+        , m_mapMode(NotMapped)
+    {
+        m_data.resize(key.bytes);
+    }
+
+    bool isNull() const { return m_data.isEmpty(); }
+    const QVideoFramePoolKey &key() const { return m_key; }
+
+    void release() override
+    {
+        m_mapMode = NotMapped;
+        m_pool->recycle(this);
+    }
+
+    MapMode mapMode() const override
+    {
+        return m_mapMode;
+    }
+
+    uchar *map(MapMode mode, int *numBytes, int *bytesPerLine) override
+    {
+        if (m_mapMode != NotMapped || mode == NotMapped)
+            return 0;
+
+        m_mapMode = mode;
+
+        if (numBytes)
+            *numBytes = m_data.size();
+
+        if (bytesPerLine)
+            *bytesPerLine = m_key.bytesPerLine;
+
+        return reinterpret_cast<uchar *>(m_data.data());
+    }
+
+    void unmap() override
+    {
+        m_mapMode = NotMapped;
+    }
+
+private:
+    QExplicitlySharedDataPointer<QVideoFramePoolPrivate> m_pool;
+    QVideoFramePoolKey m_key;
+    MapMode m_mapMode;
+    QByteArray m_data;
+};
+
+QVideoFramePoolPrivate::~QVideoFramePoolPrivate()
+{
+    Q_ASSERT(freeBuffers.isEmpty());
+}
+
+void QVideoFramePoolPrivate::recycle(QPooledVideoBuffer *buffer)
+{
+    {
+        QMutexLocker locker(&mutex);
+
+        if (!closed) {
+            QVector<QPooledVideoBuffer *> &buffers = freeBuffers[buffer->key()];
+            if (buffers.count() < maximumBufferCount) {
+                buffers.append(buffer);
+                return;
+            }
+        }
+    }
+
+    // May release the last reference to the pool data.
+    delete buffer;
+}
+
+void QVideoFramePoolPrivate::clear()
+{
+    QVector<QPooledVideoBuffer *> buffers;
+    {
+        QMutexLocker locker(&mutex);
+
+        for (const QVector<QPooledVideoBuffer *> &keyBuffers : qAsConst(freeBuffers))
+            buffers += keyBuffers;
+        freeBuffers.clear();
+    }
+
+    // Deleted without holding the lock, each buffer holds a reference to this.
+    ref.ref();
+    qDeleteAll(buffers);
+    ref.deref();
+}
+
+/*!
+    \class QVideoFramePool
+    \brief The QVideoFramePool class recycles the memory of video frames.
+    \inmodule QtMultimedia
+    \since 5.13
+
+    \ingroup multimedia
+    \ingroup multimedia_video
+
+    Producers of video frames, such as custom camera sources, typically allocate a new frame
+    in system memory for every image they deliver. QVideoFramePool keeps the memory of frames
+    which are no longer used, and hands it out again for the next frame of the same pixel
+    format, size and layout. Once a stream has started no further memory is allocated.
+
+    Frames allocated from the pool are ordinary QVideoFrame instances. Their memory returns
+    to the pool when the last QVideoFrame referencing it is destroyed, regardless of the
+    thread this happens on. The pool only keeps up to maximumBufferCount() unused buffers for
+    each layout, further buffers are freed.
+
+    \code
+    QVideoFramePool pool;
+
+    QVideoFrame frame = pool.allocate(width * height * 4, QSize(width, height), width * 4,
+                                      QVideoFrame::Format_RGB32);
+    frame.map(QAbstractVideoBuffer::WriteOnly);
+    // fill frame.bits()
+    frame.unmap();
+
+    surface->present(frame);
+    \endcode
+
+    QVideoFramePool is thread-safe. Frames may outlive the pool they were allocated from.
+
+    \sa QVideoFrame
+*/
+
+/*!
+    Constructs a video frame pool which keeps at most \a maximumBufferCount unused buffers
+    of each frame layout.
+*/
+QVideoFramePool::QVideoFramePool(int maximumBufferCount)
+    : d(new QVideoFramePoolPrivate(qMax(0, maximumBufferCount)))
+{
+    d->ref.ref();
+}
+
+/*!
+    Destroys a video frame pool.
+
+    Unused buffers are freed. Buffers of frames which are still referenced are freed when the
+    last reference is destroyed.
+*/
+QVideoFramePool::~QVideoFramePool()
+{
+    {
+        QMutexLocker locker(&d->mutex);
+        d->closed = true;
+    }
+    d->clear();
+
+    if (!d->ref.deref())
+        delete d;
+}
+
+/*!
+    Returns a video frame of the given pixel \a format and \a size in pixels.
+
+    The \a bytesPerLine (stride) is the length of each scan line in bytes, and \a bytes is the
+    total number of bytes of the frame, as in the corresponding QVideoFrame constructor.
+
+    If an unused buffer with the same layout is available in the pool it is reused, otherwise
+    a new buffer is allocated. The content of a reused buffer is undefined.
+
+    Returns an invalid frame if \a bytes is not positive or the memory could not be allocated.
+
+    \sa hitCount(), missCount()
+*/
+QVideoFrame QVideoFramePool::allocate(
+        int bytes, const QSize &size, int bytesPerLine, QVideoFrame::PixelFormat format)
+{
+    if (bytes <= 0)
+        return QVideoFrame();
+
+    const QVideoFramePoolKey key = { bytes, bytesPerLine, size, format };
+
+    QPooledVideoBuffer *buffer = 0;
+    {
+        QMutexLocker locker(&d->mutex);
+
+        auto it = d->freeBuffers.find(key);
+        if (it != d->freeBuffers.end() && !it->isEmpty()) {
+            buffer = it->takeLast();
+            d->hits.ref();
+        }
+    }
+
+    if (!buffer) {
+        d->misses.ref();
+
+        buffer = new QPooledVideoBuffer(d, key);
+        // Check the memory was successfully allocated.
+        if (buffer->isNull()) {
+            delete buffer;
+            return QVideoFrame();
+        }
+    }
+
+    return QVideoFrame(buffer, size, format);
+}
+
+/*!
+    Returns the maximum number of unused buffers kept for each frame layout.
+*/
+int QVideoFramePool::maximumBufferCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumBufferCount;
+}
+
+/*!
+    Sets the maximum number of unused buffers kept for each frame layout to \a count.
+
+    Unused buffers exceeding the new maximum are freed.
+*/
+void QVideoFramePool::setMaximumBufferCount(int count)
+{
+    QVector<QPooledVideoBuffer *> excess;
+    {
+        QMutexLocker locker(&d->mutex);
+
+        d->maximumBufferCount = qMax(0, count);
+
+        for (QVector<QPooledVideoBuffer *> &buffers : d->freeBuffers) {
+            while (buffers.count() > d->maximumBufferCount)
+                excess.append(buffers.takeLast());
+        }
+    }
+    qDeleteAll(excess);
+}
+
+/*!
+    Returns the number of unused buffers held by the pool.
+*/
+int QVideoFramePool::freeBufferCount() const
+{
+    QMutexLocker locker(&d->mutex);
+
+    int count = 0;
+    for (const QVector<QPooledVideoBuffer *> &buffers : qAsConst(d->freeBuffers))
+        count += buffers.count();
+    return count;
+}
+
+/*!
+    Frees all unused buffers held by the pool.
+*/
+void QVideoFramePool::clear()
+{
+    d->clear();
+}
+
+/*!
+    Returns the number of frames allocated with a buffer reused from the pool.
+
+    \sa missCount(), resetStatistics()
+*/
+int QVideoFramePool::hitCount() const
+{
+    return d->hits.load();
+}
+
+/*!
+    Returns the number of frames for which a new buffer had to be allocated.
+
+    \sa hitCount(), resetStatistics()
+*/
+int QVideoFramePool::missCount() const
+{
+    return d->misses.load();
+}
+
+/*!
+    Resets the hit and miss counters to zero.
+*/
+void QVideoFramePool::resetStatistics()
+{
+    d->hits.store(0);
+    d->misses.store(0);
+}
+
+QT_END_NAMESPACE
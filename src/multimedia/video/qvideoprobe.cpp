@@ -63,6 +63,13 @@
     This same approach works with the QCamera object as well, to receive viewfinder or video
     frames as they are captured.
 
+    Probes monitoring the same media object share how its frames are
+    delivered. DirectDelivery is only used when all of them request it.
+    Otherwise BufferedDelivery is used if any of them requests it, with the
+    largest requested \l bufferSize(). BlockOnOverflow is only honored when
+    all buffering probes request it, otherwise DropOldest takes precedence
+    over DropNewest.
+
     \sa QAudioProbe, QMediaPlayer, QCamera
 */
 
@@ -72,6 +79,7 @@
 #include "qmediarecorder.h"
 #include "qsharedpointer.h"
 #include "qpointer.h"
+#include <private/qmediaprobedelivery_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -79,6 +87,29 @@ class QVideoProbePrivate {
 public:
     QPointer<QMediaObject> source;
     QPointer<QMediaVideoProbeControl> probee;
+    QVideoProbe::DeliveryMode deliveryMode = QVideoProbe::QueuedDelivery;
+    QVideoProbe::OverflowPolicy overflowPolicy = QVideoProbe::DropOldest;
+    int bufferSize = 8;
+
+    QMediaProbeDelivery *delivery() const
+    {
+        return qobject_cast<QMediaProbeDelivery *>(probee.data());
+    }
+
+    void applyDelivery()
+    {
+        if (QMediaProbeDelivery *control = delivery()) {
+            control->setDeliverySettings(this, QMediaProbeDelivery::Mode(deliveryMode),
+                                         QMediaProbeDelivery::OverflowPolicy(overflowPolicy),
+                                         bufferSize);
+        }
+    }
+
+    void releaseDelivery()
+    {
+        if (QMediaProbeDelivery *control = delivery())
+            control->removeDeliverySettings(this);
+    }
 };
 
 /*!
@@ -103,6 +134,7 @@ QVideoProbe::~QVideoProbe()
     if (d->source) {
         // Disconnect
         if (d->probee) {
+            d->releaseDelivery();
             disconnect(d->probee.data(), SIGNAL(videoFrameProbed(QVideoFrame)), this, SIGNAL(videoFrameProbed(QVideoFrame)));
             disconnect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
         }
@@ -132,6 +164,7 @@ bool QVideoProbe::setSource(QMediaObject *source)
 
     // in case source was destroyed but probe control is still valid
     if (!d->source && d->probee) {
+        d->releaseDelivery();
         disconnect(d->probee.data(), SIGNAL(videoFrameProbed(QVideoFrame)), this, SIGNAL(videoFrameProbed(QVideoFrame)));
         disconnect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
         d->probee.clear();
@@ -140,6 +173,7 @@ bool QVideoProbe::setSource(QMediaObject *source)
     if (source != d->source.data()) {
         if (d->source) {
             Q_ASSERT(d->probee);
+            d->releaseDelivery();
             disconnect(d->probee.data(), SIGNAL(videoFrameProbed(QVideoFrame)), this, SIGNAL(videoFrameProbed(QVideoFrame)));
             disconnect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
             d->source.data()->service()->releaseControl(d->probee.data());
@@ -154,8 +188,10 @@ bool QVideoProbe::setSource(QMediaObject *source)
             }
 
             if (d->probee) {
-                connect(d->probee.data(), SIGNAL(videoFrameProbed(QVideoFrame)), this, SIGNAL(videoFrameProbed(QVideoFrame)));
+                // Direct, so that DirectDelivery reaches the receivers on the streaming thread.
+                connect(d->probee.data(), SIGNAL(videoFrameProbed(QVideoFrame)), this, SIGNAL(videoFrameProbed(QVideoFrame)), Qt::DirectConnection);
                 connect(d->probee.data(), SIGNAL(flush()), this, SIGNAL(flush()));
+                d->applyDelivery();
                 d->source = source;
             }
         }
@@ -201,6 +237,135 @@ bool QVideoProbe::isActive() const
     return d->probee != 0;
 }
 
+/*!
+    \enum QVideoProbe::DeliveryMode
+    \since 5.13
+
+    Describes how probed frames are delivered to the receivers of
+    \l videoFrameProbed().
+
+    \value QueuedDelivery The signal is emitted on the thread the probe lives
+    in. Only the most recent frame is kept while the receiving thread is
+    busy, older ones are dropped. This is the default.
+    \value DirectDelivery The signal is emitted on the media framework's
+    streaming thread as soon as a frame is available. Receivers must be
+    thread-safe, connect with Qt::DirectConnection and return quickly, since
+    the media pipeline waits for them.
+    \value BufferedDelivery Probed frames are kept in a queue of
+    \l bufferSize() entries and delivered on the thread the probe lives in.
+    What happens when the queue is full is decided by overflowPolicy().
+*/
+
+/*!
+    \enum QVideoProbe::OverflowPolicy
+    \since 5.13
+
+    Describes what happens in BufferedDelivery mode when the queue is full.
+
+    \value BlockOnOverflow The streaming thread waits until the queued
+    frames are delivered. This throttles the media pipeline to the speed of
+    the receivers. If the receivers don't catch up within a second, the new
+    frame is dropped so a blocked receiving thread can't stall the pipeline.
+    Stopping the media object always releases the streaming thread.
+    \value DropOldest The oldest queued frame is discarded. This is the
+    default.
+    \value DropNewest The new frame is discarded.
+*/
+
+/*!
+    \since 5.13
+
+    Returns the delivery mode of this probe.
+
+    \sa isDeliveryModeSupported()
+*/
+QVideoProbe::DeliveryMode QVideoProbe::deliveryMode() const
+{
+    return d->deliveryMode;
+}
+
+/*!
+    \since 5.13
+
+    Sets the delivery \a mode of this probe. Any frames queued for delivery
+    are discarded when the mode changes.
+*/
+void QVideoProbe::setDeliveryMode(DeliveryMode mode)
+{
+    d->deliveryMode = mode;
+    d->applyDelivery();
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of frames queued in BufferedDelivery mode. The
+    default is 8.
+*/
+int QVideoProbe::bufferSize() const
+{
+    return d->bufferSize;
+}
+
+/*!
+    \since 5.13
+
+    Sets the number of frames queued in BufferedDelivery mode to \a size.
+*/
+void QVideoProbe::setBufferSize(int size)
+{
+    d->bufferSize = qMax(1, size);
+    d->applyDelivery();
+}
+
+/*!
+    \since 5.13
+
+    Returns what happens when the queue of BufferedDelivery mode is full.
+*/
+QVideoProbe::OverflowPolicy QVideoProbe::overflowPolicy() const
+{
+    return d->overflowPolicy;
+}
+
+/*!
+    \since 5.13
+
+    Sets what happens when the queue of BufferedDelivery mode is full to
+    \a policy.
+*/
+void QVideoProbe::setOverflowPolicy(OverflowPolicy policy)
+{
+    d->overflowPolicy = policy;
+    d->applyDelivery();
+}
+
+/*!
+    \since 5.13
+
+    Returns true if the monitored media object honors the delivery mode and
+    reports dropped frames. Otherwise the media backend decides how frames
+    are delivered.
+*/
+bool QVideoProbe::isDeliveryModeSupported() const
+{
+    return d->delivery() != nullptr;
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of probed frames that were dropped before they could
+    be delivered, since the current source was set or its media changed.
+
+    \sa deliveryMode(), overflowPolicy()
+*/
+quint64 QVideoProbe::droppedFrameCount() const
+{
+    QMediaProbeDelivery *delivery = d->delivery();
+    return delivery ? delivery->droppedCount(d) : 0;
+}
+
 /*!
     \fn QVideoProbe::videoFrameProbed(const QVideoFrame &frame)
 
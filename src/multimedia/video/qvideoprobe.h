@@ -53,6 +53,20 @@ class Q_MULTIMEDIA_EXPORT QVideoProbe : public QObject
 {
     Q_OBJECT
 public:
+    enum DeliveryMode {
+        QueuedDelivery,
+        DirectDelivery,
+        BufferedDelivery
+    };
+    Q_ENUM(DeliveryMode)
+
+    enum OverflowPolicy {
+        BlockOnOverflow,
+        DropOldest,
+        DropNewest
+    };
+    Q_ENUM(OverflowPolicy)
+
     explicit QVideoProbe(QObject *parent = nullptr);
     ~QVideoProbe();
 
@@ -61,6 +75,18 @@ public:
 
     bool isActive() const;
 
+    DeliveryMode deliveryMode() const;
+    void setDeliveryMode(DeliveryMode mode);
+
+    int bufferSize() const;
+    void setBufferSize(int size);
+
+    OverflowPolicy overflowPolicy() const;
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    bool isDeliveryModeSupported() const;
+    quint64 droppedFrameCount() const;
+
 Q_SIGNALS:
     void videoFrameProbed(const QVideoFrame &frame);
     void flush();
@@ -5,18 +5,24 @@ PUBLIC_HEADERS += \
     video/qabstractvideobuffer.h \
     video/qabstractvideosurface.h \
     video/qvideoframe.h \
+    video/qvideoframepool.h \
     video/qvideosurfaceformat.h \
     video/qvideoprobe.h \
-    video/qabstractvideofilter.h
+    video/qabstractvideofilter.h \
+    video/qsharedmemoryvideosurface.h \
+    video/qsharedmemoryvideosource.h
 
 PRIVATE_HEADERS += \
     video/qabstractvideobuffer_p.h \
+    video/qabstractvideofilter_p.h \
+    video/qvideoallocationcache_p.h \
     video/qimagevideobuffer_p.h \
     video/qmemoryvideobuffer_p.h \
     video/qvideooutputorientationhandler_p.h \
     video/qvideosurfaceoutput_p.h \
     video/qvideoframe_p.h \
-    video/qvideoframeconversionhelper_p.h
+    video/qvideoframeconversionhelper_p.h \
+    video/qsharedmemoryvideo_p.h
 
 SOURCES += \
     video/qabstractvideobuffer.cpp \
@@ -24,12 +30,16 @@ SOURCES += \
     video/qimagevideobuffer.cpp \
     video/qmemoryvideobuffer.cpp \
     video/qvideoframe.cpp \
+    video/qvideoframepool.cpp \
     video/qvideooutputorientationhandler.cpp \
     video/qvideosurfaceformat.cpp \
     video/qvideosurfaceoutput.cpp \
     video/qvideoprobe.cpp \
     video/qabstractvideofilter.cpp \
-    video/qvideoframeconversionhelper.cpp
+    video/qvideoframeconversionhelper.cpp \
+    video/qsharedmemoryvideo.cpp \
+    video/qsharedmemoryvideosurface.cpp \
+    video/qsharedmemoryvideosource.cpp
 
 SSE2_SOURCES += video/qvideoframeconversionhelper_sse2.cpp
 SSSE3_SOURCES += video/qvideoframeconversionhelper_ssse3.cpp
@@ -47,6 +47,9 @@
 
 #include <QtCore/qcoreevent.h>
 #include <QtCore/qpointer.h>
+#include <QtGui/qscreen.h>
+#include <QtGui/qwindow.h>
+#include <QtWidgets/qwidget.h>
 
 #if QT_CONFIG(opengl)
 #include <QtOpenGL/qgl.h>
@@ -351,6 +354,65 @@ QSizeF QGraphicsVideoItem::nativeSize() const
     Signals that the native \a size of the video has changed.
 */
 
+/*!
+    \property QGraphicsVideoItem::framePacingEnabled
+    \brief whether video frames are presented according to their start time.
+    \since 5.13
+
+    With frame pacing enabled, frames are queued and the frame due at the
+    current presentation time is painted on a timer running at the refresh
+    rate of the screen, instead of as soon as the frame is delivered.
+
+    The default is false.
+
+    \sa QVideoWidget::framePacingEnabled
+*/
+
+bool QGraphicsVideoItem::isFramePacingEnabled() const
+{
+    return d_func()->surface->isFramePacingEnabled();
+}
+
+void QGraphicsVideoItem::setFramePacingEnabled(bool enabled)
+{
+    d_func()->surface->setFramePacingEnabled(enabled);
+}
+
+/*!
+    Returns the number of video frames painted by the item.
+
+    \since 5.13
+    \sa droppedFrameCount(), lateFrameCount()
+*/
+int QGraphicsVideoItem::presentedFrameCount() const
+{
+    return d_func()->surface->presentedFrameCount();
+}
+
+/*!
+    Returns the number of video frames discarded without being painted.
+
+    \since 5.13
+    \sa presentedFrameCount(), lateFrameCount()
+*/
+int QGraphicsVideoItem::droppedFrameCount() const
+{
+    return d_func()->surface->droppedFrameCount();
+}
+
+/*!
+    Returns the number of video frames which missed their presentation time.
+
+    Frames are only known to be late when \l framePacingEnabled is true.
+
+    \since 5.13
+    \sa presentedFrameCount(), droppedFrameCount()
+*/
+int QGraphicsVideoItem::lateFrameCount() const
+{
+    return d_func()->surface->lateFrameCount();
+}
+
 /*!
     \reimp
 */
@@ -372,6 +434,11 @@ void QGraphicsVideoItem::paint(
 
     if (d->surface && d->updatePaintDevice) {
         d->updatePaintDevice = false;
+
+        if (const QWindow *window = widget ? widget->window()->windowHandle() : nullptr) {
+            if (const QScreen *screen = window->screen())
+                d->surface->setRefreshRate(screen->refreshRate());
+        }
 #if QT_CONFIG(opengl)
         if (widget)
             connect(widget, SIGNAL(destroyed()), d->surface, SLOT(viewportDestroyed()));
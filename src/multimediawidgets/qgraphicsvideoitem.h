@@ -60,6 +60,7 @@ class Q_MULTIMEDIAWIDGETS_EXPORT QGraphicsVideoItem : public QGraphicsObject, pu
     Q_PROPERTY(QPointF offset READ offset WRITE setOffset)
     Q_PROPERTY(QSizeF size READ size WRITE setSize)
     Q_PROPERTY(QSizeF nativeSize READ nativeSize NOTIFY nativeSizeChanged)
+    Q_PROPERTY(bool framePacingEnabled READ isFramePacingEnabled WRITE setFramePacingEnabled)
 public:
     explicit QGraphicsVideoItem(QGraphicsItem *parent = nullptr);
     ~QGraphicsVideoItem();
@@ -77,6 +78,13 @@ public:
 
     QSizeF nativeSize() const;
 
+    bool isFramePacingEnabled() const;
+    void setFramePacingEnabled(bool enabled);
+
+    int presentedFrameCount() const;
+    int droppedFrameCount() const;
+    int lateFrameCount() const;
+
     QRectF boundingRect() const override;
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
@@ -41,7 +41,10 @@
 
 #include <qmath.h>
 
+#include <qcoreevent.h>
+#include <qguiapplication.h>
 #include <qpainter.h>
+#include <qscreen.h>
 #include <qvariant.h>
 #include <qvideosurfaceformat.h>
 #include <private/qmediaopenglhelper_p.h>
@@ -69,6 +72,9 @@ static void makeCurrent(QGLContext *context)
 #endif
 
 #include <QtDebug>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QVideoSurfacePainter::~QVideoSurfacePainter()
@@ -96,8 +102,14 @@ public:
     void updateColors(int brightness, int contrast, int hue, int saturation) override;
 
 private:
+    bool paintCachedImage(const QRectF &target, QPainter *painter, const QRectF &source,
+                          const QTransform &transform);
+
     QList<QVideoFrame::PixelFormat> m_imagePixelFormats;
     QVideoFrame m_frame;
+    QImage m_scaledImage;
+    QRect m_scaledSourceRect;
+    Qt::TransformationMode m_scaledTransformationMode;
     QSize m_imageSize;
     QImage::Format m_imageFormat;
     QVideoSurfaceFormat::Direction m_scanLineDirection;
@@ -105,7 +117,8 @@ private:
 };
 
 QVideoSurfaceGenericPainter::QVideoSurfaceGenericPainter()
-    : m_imageFormat(QImage::Format_Invalid)
+    : m_scaledTransformationMode(Qt::FastTransformation)
+    , m_imageFormat(QImage::Format_Invalid)
     , m_scanLineDirection(QVideoSurfaceFormat::TopToBottom)
     , m_mirrored(false)
 {
@@ -151,6 +164,7 @@ bool QVideoSurfaceGenericPainter::isFormatSupported(const QVideoSurfaceFormat &f
 QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::start(const QVideoSurfaceFormat &format)
 {
     m_frame = QVideoFrame();
+    m_scaledImage = QImage();
     m_imageFormat = QVideoFrame::imageFormatFromPixelFormat(format.pixelFormat());
     // Do not render into ARGB32 images using QPainter.
     // Using QImage::Format_ARGB32_Premultiplied is significantly faster.
@@ -179,11 +193,13 @@ QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::start(const QVideoSurf
 void QVideoSurfaceGenericPainter::stop()
 {
     m_frame = QVideoFrame();
+    m_scaledImage = QImage();
 }
 
 QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::setCurrentFrame(const QVideoFrame &frame)
 {
     m_frame = frame;
+    m_scaledImage = QImage();
 
     return QAbstractVideoSurface::NoError;
 }
@@ -198,6 +214,26 @@ QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::paint(
 
     if (m_frame.handleType() == QAbstractVideoBuffer::QPixmapHandle) {
         painter->drawPixmap(target, m_frame.handle().value<QPixmap>(), source);
+        return QAbstractVideoSurface::NoError;
+    }
+
+    const QTransform oldTransform = painter->transform();
+    QTransform transform = oldTransform;
+    QRectF targetRect = target;
+    if (m_scanLineDirection == QVideoSurfaceFormat::BottomToTop) {
+        transform.scale(1, -1);
+        transform.translate(0, -target.bottom());
+        targetRect = QRectF(target.x(), 0, target.width(), target.height());
+    }
+
+    if (m_mirrored) {
+        transform.scale(-1, 1);
+        transform.translate(-target.right(), 0);
+        targetRect = QRectF(0, targetRect.y(), target.width(), target.height());
+    }
+
+    if (paintCachedImage(targetRect, painter, source, transform)) {
+        // The frame was already scaled for this target, no need to map it again.
     } else if (m_frame.map(QAbstractVideoBuffer::ReadOnly)) {
         QImage image(
                 m_frame.bits(),
@@ -206,20 +242,6 @@ QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::paint(
                 m_frame.bytesPerLine(),
                 m_imageFormat);
 
-        const QTransform oldTransform = painter->transform();
-        QTransform transform = oldTransform;
-        QRectF targetRect = target;
-        if (m_scanLineDirection == QVideoSurfaceFormat::BottomToTop) {
-            transform.scale(1, -1);
-            transform.translate(0, -target.bottom());
-            targetRect = QRectF(target.x(), 0, target.width(), target.height());
-        }
-
-        if (m_mirrored) {
-            transform.scale(-1, 1);
-            transform.translate(-target.right(), 0);
-            targetRect = QRectF(0, targetRect.y(), target.width(), target.height());
-        }
         painter->setTransform(transform);
         painter->drawImage(targetRect, image, source);
         painter->setTransform(oldTransform);
@@ -237,6 +259,74 @@ void QVideoSurfaceGenericPainter::updateColors(int, int, int, int)
 {
 }
 
+/*
+    Paints the current frame from an image that was scaled to the device size of \a target.
+
+    A widget is repainted far more often than it receives new frames (overlapping windows,
+    resizes of sibling widgets, animations), and letting QPainter rescale the full frame
+    each time is expensive. The scaled image is kept until the next frame arrives or the
+    target size changes, so subsequent paints are a plain blit and don't map the frame.
+
+    Returns false if the painter state doesn't allow caching, in which case the frame has
+    to be painted directly.
+*/
+bool QVideoSurfaceGenericPainter::paintCachedImage(
+        const QRectF &target, QPainter *painter, const QRectF &source, const QTransform &transform)
+{
+    // Rotations and shears would need the scaled image to be transformed again.
+    if (transform.type() > QTransform::TxScale)
+        return false;
+
+    const QRect sourceRect = source.toRect();
+    if (QRectF(sourceRect) != source || sourceRect.isEmpty())
+        return false;
+
+    const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : qreal(1);
+    const QSize deviceSize = (transform.mapRect(target).size() * dpr).toSize();
+    if (deviceSize.isEmpty() || deviceSize == sourceRect.size())
+        return false;
+
+    const Qt::TransformationMode mode =
+            painter->renderHints() & QPainter::SmoothPixmapTransform
+            ? Qt::SmoothTransformation
+            : Qt::FastTransformation;
+
+    if (m_scaledImage.isNull()
+            || m_scaledImage.size() != deviceSize
+            || m_scaledSourceRect != sourceRect
+            || m_scaledTransformationMode != mode) {
+        if (!m_frame.map(QAbstractVideoBuffer::ReadOnly))
+            return false;
+
+        const QImage image(
+                m_frame.bits(),
+                m_imageSize.width(),
+                m_imageSize.height(),
+                m_frame.bytesPerLine(),
+                m_imageFormat);
+
+        // QImage::scaled() uses the SIMD optimized smooth scaling routines of QtGui.
+        // It returns a deep copy, so the frame can be released right away.
+        m_scaledImage = (sourceRect == image.rect() ? image : image.copy(sourceRect))
+                .scaled(deviceSize, Qt::IgnoreAspectRatio, mode);
+        m_scaledImage.setDevicePixelRatio(dpr);
+        m_scaledSourceRect = sourceRect;
+        m_scaledTransformationMode = mode;
+
+        m_frame.unmap();
+
+        if (m_scaledImage.isNull())
+            return false;
+    }
+
+    const QTransform oldTransform = painter->transform();
+    painter->setTransform(transform);
+    painter->drawImage(target, m_scaledImage);
+    painter->setTransform(oldTransform);
+
+    return true;
+}
+
 #if QT_CONFIG(opengl)
 
 #ifndef APIENTRYP
@@ -1389,6 +1479,12 @@ QPainterVideoSurface::QPainterVideoSurface(QObject *parent)
     , m_pixelFormat(QVideoFrame::Format_Invalid)
     , m_colorsDirty(true)
     , m_ready(false)
+    , m_clockOffset(0)
+    , m_refreshRate(0)
+    , m_presentedFrames(0)
+    , m_droppedFrames(0)
+    , m_lateFrames(0)
+    , m_framePacing(false)
 {
 }
 
@@ -1460,6 +1556,8 @@ bool QPainterVideoSurface::start(const QVideoSurfaceFormat &format)
 */
 void QPainterVideoSurface::stop()
 {
+    clearScheduledFrames();
+
     if (isActive()) {
         m_painter->stop();
         m_ready = false;
@@ -1472,30 +1570,57 @@ void QPainterVideoSurface::stop()
 */
 bool QPainterVideoSurface::present(const QVideoFrame &frame)
 {
-    if (!m_ready) {
+    if (m_framePacing && isActive()) {
+        if (frame.isValid()
+                && (frame.pixelFormat() != m_pixelFormat || frame.size() != m_frameSize)) {
+            setError(IncorrectFormatError);
+
+            stop();
+        } else if (!frame.isValid()) {
+            // An empty frame flushes the surface, there is nothing to wait for.
+            clearScheduledFrames();
+
+            return presentFrame(frame);
+        } else {
+            scheduleFrame(frame);
+
+            return true;
+        }
+    } else if (!m_ready) {
         if (!isActive())
             setError(StoppedError);
+        else if (frame.isValid())
+            ++m_droppedFrames;
     } else if (frame.isValid()
             && (frame.pixelFormat() != m_pixelFormat || frame.size() != m_frameSize)) {
         setError(IncorrectFormatError);
 
         stop();
     } else {
-        QAbstractVideoSurface::Error error = m_painter->setCurrentFrame(frame);
+        return presentFrame(frame);
+    }
+    return false;
+}
 
-        if (error != QAbstractVideoSurface::NoError) {
-            setError(error);
+bool QPainterVideoSurface::presentFrame(const QVideoFrame &frame)
+{
+    QAbstractVideoSurface::Error error = m_painter->setCurrentFrame(frame);
 
-            stop();
-        } else {
-            m_ready = false;
+    if (error != QAbstractVideoSurface::NoError) {
+        setError(error);
 
-            emit frameChanged();
+        stop();
 
-            return true;
-        }
+        return false;
     }
-    return false;
+
+    m_ready = false;
+    if (frame.isValid())
+        ++m_presentedFrames;
+
+    emit frameChanged();
+
+    return true;
 }
 
 /*!
@@ -1608,6 +1733,201 @@ void QPainterVideoSurface::paint(QPainter *painter, const QRectF &target, const
     \fn QPainterVideoSurface::frameChanged()
 */
 
+/*!
+    Returns true if presented frames are queued and shown according to their start time.
+*/
+bool QPainterVideoSurface::isFramePacingEnabled() const
+{
+    return m_framePacing;
+}
+
+/*!
+    Enables presentation of frames at their start time if \a enabled is true.
+
+    Frames are queued when they are presented to the surface, and the frame that is due
+    is made current on a timer running at the refresh rate of the display. Frames which
+    are superseded by a later frame before they could be shown are dropped.
+*/
+void QPainterVideoSurface::setFramePacingEnabled(bool enabled)
+{
+    if (m_framePacing == enabled)
+        return;
+
+    m_framePacing = enabled;
+
+    if (!m_framePacing)
+        clearScheduledFrames();
+}
+
+/*!
+    Returns the refresh rate used to time the presentation of frames.
+
+    Unless set explicitly, this is the refresh rate of the primary screen.
+*/
+qreal QPainterVideoSurface::refreshRate() const
+{
+    if (m_refreshRate > 0)
+        return m_refreshRate;
+
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    const qreal rate = screen ? screen->refreshRate() : qreal(0);
+    return rate > 0 ? rate : qreal(60);
+}
+
+/*!
+    Sets the refresh \a rate used to time the presentation of frames.
+*/
+void QPainterVideoSurface::setRefreshRate(qreal rate)
+{
+    if (qFuzzyCompare(m_refreshRate, rate))
+        return;
+
+    m_refreshRate = rate;
+
+    if (m_presentTimer.isActive())
+        m_presentTimer.start(presentInterval(), Qt::PreciseTimer, this);
+}
+
+/*!
+    Returns the number of frames which were made current.
+*/
+int QPainterVideoSurface::presentedFrameCount() const
+{
+    return m_presentedFrames;
+}
+
+/*!
+    Returns the number of frames which were discarded without being made current.
+*/
+int QPainterVideoSurface::droppedFrameCount() const
+{
+    return m_droppedFrames;
+}
+
+/*!
+    Returns the number of frames which missed their presentation time.
+
+    Late frames are dropped if a later frame is due, otherwise they are shown late.
+*/
+int QPainterVideoSurface::lateFrameCount() const
+{
+    return m_lateFrames;
+}
+
+/*!
+    \reimp
+*/
+void QPainterVideoSurface::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == m_presentTimer.timerId())
+        presentScheduledFrame();
+    else
+        QAbstractVideoSurface::timerEvent(event);
+}
+
+namespace {
+
+// A frame further away from the presentation clock than this is the result of a seek,
+// a pause or a rate change, and the clock is resynchronized instead of dropping frames.
+const qint64 ResyncThreshold = 500000;
+
+const int MaxScheduledFrames = 8;
+
+bool startsBefore(const QVideoFrame &a, const QVideoFrame &b)
+{
+    return a.startTime() < b.startTime();
+}
+
+}
+
+void QPainterVideoSurface::scheduleFrame(const QVideoFrame &frame)
+{
+    const qint64 startTime = frame.startTime();
+
+    if (startTime < 0) {
+        m_scheduledFrames.append(frame);
+    } else {
+        if (!m_clock.isValid()) {
+            m_clock.start();
+            m_clockOffset = startTime;
+        } else if (qAbs(clockTime() - startTime) > ResyncThreshold) {
+            m_droppedFrames += m_scheduledFrames.count();
+            m_scheduledFrames.clear();
+            m_clockOffset = startTime - m_clock.nsecsElapsed() / 1000;
+        }
+
+        m_scheduledFrames.insert(
+                    std::upper_bound(m_scheduledFrames.begin(), m_scheduledFrames.end(),
+                                     frame, startsBefore),
+                    frame);
+    }
+
+    if (m_scheduledFrames.count() > MaxScheduledFrames) {
+        // The producer is running ahead of the clock, make the oldest remaining frame due.
+        m_scheduledFrames.removeFirst();
+        ++m_droppedFrames;
+
+        const qint64 firstStartTime = m_scheduledFrames.first().startTime();
+        if (firstStartTime >= 0 && m_clock.isValid())
+            m_clockOffset = firstStartTime - m_clock.nsecsElapsed() / 1000;
+    }
+
+    if (!m_presentTimer.isActive())
+        m_presentTimer.start(presentInterval(), Qt::PreciseTimer, this);
+}
+
+void QPainterVideoSurface::presentScheduledFrame()
+{
+    // Wait until the current frame was painted.
+    if (!m_ready || !isActive())
+        return;
+
+    const qint64 now = m_clock.isValid() ? clockTime() : -1;
+
+    int due = -1;
+    for (int i = 0; i < m_scheduledFrames.count(); ++i) {
+        const qint64 startTime = m_scheduledFrames.at(i).startTime();
+        if (startTime >= 0 && startTime > now)
+            break;
+        due = i;
+    }
+
+    if (due < 0)
+        return;
+
+    // Every frame before the due one has missed its slot.
+    m_droppedFrames += due;
+    m_lateFrames += due;
+
+    const QVideoFrame frame = m_scheduledFrames.at(due);
+    m_scheduledFrames.remove(0, due + 1);
+
+    if (frame.startTime() >= 0 && now - frame.startTime() > presentInterval() * 1000)
+        ++m_lateFrames;
+
+    if (m_scheduledFrames.isEmpty())
+        m_presentTimer.stop();
+
+    presentFrame(frame);
+}
+
+void QPainterVideoSurface::clearScheduledFrames()
+{
+    m_scheduledFrames.clear();
+    m_presentTimer.stop();
+    m_clock.invalidate();
+}
+
+qint64 QPainterVideoSurface::clockTime() const
+{
+    return m_clock.nsecsElapsed() / 1000 + m_clockOffset;
+}
+
+int QPainterVideoSurface::presentInterval() const
+{
+    return qMax(1, qRound(1000 / refreshRate()));
+}
+
 #if QT_CONFIG(opengl)
 
 /*!
@@ -52,7 +52,10 @@
 //
 
 #include <qtmultimediawidgetdefs.h>
+#include <QtCore/qbasictimer.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qsize.h>
+#include <QtCore/qvector.h>
 #include <QtGui/qimage.h>
 #include <QtGui/qmatrix4x4.h>
 #include <QtGui/qpaintengine.h>
@@ -125,6 +128,16 @@ public:
 
     void paint(QPainter *painter, const QRectF &target, const QRectF &source = QRectF(0, 0, 1, 1));
 
+    bool isFramePacingEnabled() const;
+    void setFramePacingEnabled(bool enabled);
+
+    qreal refreshRate() const;
+    void setRefreshRate(qreal rate);
+
+    int presentedFrameCount() const;
+    int droppedFrameCount() const;
+    int lateFrameCount() const;
+
 #if QT_CONFIG(opengl)
     const QGLContext *glContext() const;
     void setGLContext(QGLContext *context);
@@ -150,8 +163,17 @@ public Q_SLOTS:
 Q_SIGNALS:
     void frameChanged();
 
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
 private:
     void createPainter();
+    bool presentFrame(const QVideoFrame &frame);
+    void scheduleFrame(const QVideoFrame &frame);
+    void presentScheduledFrame();
+    void clearScheduledFrames();
+    qint64 clockTime() const;
+    int presentInterval() const;
 
     QVideoSurfacePainter *m_painter;
 #if QT_CONFIG(opengl)
@@ -169,6 +191,16 @@ private:
     QRect m_sourceRect;
     bool m_colorsDirty;
     bool m_ready;
+
+    QVector<QVideoFrame> m_scheduledFrames;
+    QBasicTimer m_presentTimer;
+    QElapsedTimer m_clock;
+    qint64 m_clockOffset;
+    qreal m_refreshRate;
+    int m_presentedFrames;
+    int m_droppedFrames;
+    int m_lateFrames;
+    bool m_framePacing;
 };
 
 #if QT_CONFIG(opengl)
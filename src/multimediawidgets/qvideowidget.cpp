@@ -55,6 +55,7 @@
 #include <qnamespace.h>
 
 #include <qwindow.h>
+#include <qscreen.h>
 #include <private/qhighdpiscaling_p.h>
 
 #ifdef Q_OS_WIN
@@ -214,6 +215,10 @@ QSize QRendererVideoWidgetBackend::sizeHint() const
 
 void QRendererVideoWidgetBackend::showEvent()
 {
+    if (const QWindow *window = m_widget->window()->windowHandle()) {
+        if (const QScreen *screen = window->screen())
+            m_surface->setRefreshRate(screen->refreshRate());
+    }
 }
 
 void QRendererVideoWidgetBackend::hideEvent(QHideEvent *)
@@ -518,6 +523,7 @@ bool QVideoWidgetPrivate::createRendererBackend()
     if (QMediaControl *control = service->requestControl(QVideoRendererControl_iid)) {
         if (QVideoRendererControl *rendererControl = qobject_cast<QVideoRendererControl *>(control)) {
             rendererBackend = new QRendererVideoWidgetBackend(service, rendererControl, q_func());
+            rendererBackend->surface()->setFramePacingEnabled(framePacing);
             currentBackend = rendererBackend;
 
             setCurrentControl(rendererBackend);
@@ -882,6 +888,83 @@ void QVideoWidget::setSaturation(int saturation)
     \sa saturation()
 */
 
+/*!
+    \property QVideoWidget::framePacingEnabled
+    \brief whether video frames are presented according to their start time.
+    \since 5.13
+
+    By default a frame is displayed as soon as it is delivered by the media
+    object. With frame pacing enabled, frames are queued and the frame due at
+    the current presentation time is displayed on a timer running at the
+    refresh rate of the screen. Bursts of frames no longer cause judder, and
+    frames which are superseded before they could be displayed are dropped.
+
+    Frame pacing only applies when the video is rendered by the widget itself,
+    not when the media service provides a native video window.
+
+    The default is false.
+
+    \sa presentedFrameCount(), droppedFrameCount(), lateFrameCount()
+*/
+
+bool QVideoWidget::isFramePacingEnabled() const
+{
+    return d_func()->framePacing;
+}
+
+void QVideoWidget::setFramePacingEnabled(bool enabled)
+{
+    Q_D(QVideoWidget);
+
+    d->framePacing = enabled;
+
+    if (d->rendererBackend)
+        d->rendererBackend->surface()->setFramePacingEnabled(enabled);
+}
+
+/*!
+    Returns the number of video frames displayed since the widget started
+    rendering the video of its media object.
+
+    \since 5.13
+    \sa droppedFrameCount(), lateFrameCount()
+*/
+int QVideoWidget::presentedFrameCount() const
+{
+    Q_D(const QVideoWidget);
+
+    return d->rendererBackend ? d->rendererBackend->surface()->presentedFrameCount() : 0;
+}
+
+/*!
+    Returns the number of video frames discarded without being displayed since
+    the widget started rendering the video of its media object.
+
+    \since 5.13
+    \sa presentedFrameCount(), lateFrameCount()
+*/
+int QVideoWidget::droppedFrameCount() const
+{
+    Q_D(const QVideoWidget);
+
+    return d->rendererBackend ? d->rendererBackend->surface()->droppedFrameCount() : 0;
+}
+
+/*!
+    Returns the number of video frames which missed their presentation time.
+
+    Frames are only known to be late when \l framePacingEnabled is true.
+
+    \since 5.13
+    \sa presentedFrameCount(), droppedFrameCount()
+*/
+int QVideoWidget::lateFrameCount() const
+{
+    Q_D(const QVideoWidget);
+
+    return d->rendererBackend ? d->rendererBackend->surface()->lateFrameCount() : 0;
+}
+
 /*!
   Returns the size hint for the current back end,
   if there is one, or else the size hint from QWidget.
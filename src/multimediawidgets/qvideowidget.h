@@ -62,6 +62,7 @@ class Q_MULTIMEDIAWIDGETS_EXPORT QVideoWidget : public QWidget, public QMediaBin
     Q_PROPERTY(int contrast READ contrast WRITE setContrast NOTIFY contrastChanged)
     Q_PROPERTY(int hue READ hue WRITE setHue NOTIFY hueChanged)
     Q_PROPERTY(int saturation READ saturation WRITE setSaturation NOTIFY saturationChanged)
+    Q_PROPERTY(bool framePacingEnabled READ isFramePacingEnabled WRITE setFramePacingEnabled)
 
 public:
     explicit QVideoWidget(QWidget *parent = nullptr);
@@ -80,6 +81,13 @@ public:
     int hue() const;
     int saturation() const;
 
+    bool isFramePacingEnabled() const;
+    void setFramePacingEnabled(bool enabled);
+
+    int presentedFrameCount() const;
+    int droppedFrameCount() const;
+    int lateFrameCount() const;
+
     QSize sizeHint() const override;
 #if defined(Q_OS_WIN)
     bool nativeEvent(const QByteArray &eventType, void *message, long *result) override;
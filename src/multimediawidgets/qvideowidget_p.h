@@ -134,6 +134,8 @@ public:
     void releaseControl();
     void clearSurface();
 
+    QPainterVideoSurface *surface() const { return m_surface; }
+
     void setBrightness(int brightness) override;
     void setContrast(int contrast) override;
     void setHue(int hue) override;
@@ -238,6 +240,7 @@ public:
         , aspectRatioMode(Qt::KeepAspectRatio)
         , nonFullScreenFlags(0)
         , wasFullScreen(false)
+        , framePacing(false)
     {
     }
 
@@ -256,6 +259,7 @@ public:
     Qt::AspectRatioMode aspectRatioMode;
     Qt::WindowFlags nonFullScreenFlags;
     bool wasFullScreen;
+    bool framePacing;
 
     bool createWidgetBackend();
     bool createWindowBackend();
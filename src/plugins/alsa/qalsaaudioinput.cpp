@@ -77,6 +77,7 @@ QAlsaAudioInput::QAlsaAudioInput(const QByteArray &device)
     resuming = false;
 
     m_volume = 1.0f;
+    overrunCount = 0;
 
     m_device = device;
 
@@ -135,6 +136,8 @@ int QAlsaAudioInput::xrun_recovery(int err)
 #endif
 
     if(err == -EPIPE) {
+        // Captured data was lost, the application didn't read it in time.
+        overrunCount++;
         errorState = QAudio::UnderrunError;
         err = snd_pcm_prepare(handle);
         if(err < 0)
@@ -238,6 +241,8 @@ void QAlsaAudioInput::start(QIODevice* device)
 
     pullMode = true;
     audioSource = device;
+    overrunCount = 0;
+    jitterMeter.reset();
 
     deviceState = QAudio::ActiveState;
 
@@ -258,6 +263,8 @@ QIODevice* QAlsaAudioInput::start()
     pullMode = false;
     audioSource = new AlsaInputPrivate(this);
     audioSource->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    overrunCount = 0;
+    jitterMeter.reset();
 
     deviceState = QAudio::IdleState;
 
@@ -460,6 +467,7 @@ bool QAlsaAudioInput::open()
 void QAlsaAudioInput::close()
 {
     timer->stop();
+    jitterMeter.pause();
 
     if ( handle ) {
         snd_pcm_drop( handle );
@@ -553,6 +561,7 @@ qint64 QAlsaAudioInput::read(char* data, qint64 len)
                 break;
             } else {
                 if(readFrames == -EPIPE) {
+                    overrunCount++;
                     errorState = QAudio::UnderrunError;
                     err = snd_pcm_prepare(handle);
 #ifdef ESTRPIPE
@@ -701,6 +710,7 @@ void QAlsaAudioInput::suspend()
     if(deviceState == QAudio::ActiveState||resuming) {
         snd_pcm_drain(handle);
         timer->stop();
+        jitterMeter.pause();
         deviceState = QAudio::SuspendedState;
         emit stateChanged(deviceState);
     }
@@ -714,6 +724,10 @@ void QAlsaAudioInput::userFeed()
     QTime now(QTime::currentTime());
     qDebug()<<now.second()<<"s "<<now.msec()<<"ms :userFeed() IN";
 #endif
+    // In pull mode this is also called when the device is ready for more data.
+    if (sender() == timer)
+        jitterMeter.tick(qint64(timer->interval()) * 1000);
+
     deviceReady();
 }
 
@@ -762,6 +776,30 @@ qint64 QAlsaAudioInput::elapsedUSecs() const
     return clockStamp.elapsed() * qint64(1000);
 }
 
+QAudioStatistics QAlsaAudioInput::statistics() const
+{
+    QAudioStatistics statistics;
+    statistics.setOverrunCount(overrunCount);
+    statistics.setMaxCallbackJitterUSecs(jitterMeter.maxJitterUSecs());
+
+    if (!handle || (deviceState != QAudio::ActiveState && deviceState != QAudio::IdleState))
+        return statistics;
+
+    // The ring buffer holds data captured before what ALSA still has, both count.
+    const int buffered = ringBuffer.bytesOfDataInBuffer();
+    snd_pcm_sframes_t delay = 0;
+    if (snd_pcm_delay(handle, &delay) == 0 && delay >= 0) {
+        const qint64 frames = delay + snd_pcm_bytes_to_frames(handle, buffered);
+        statistics.setLatencyUSecs(qint64(1000000) * frames / settings.sampleRate());
+    }
+
+    const snd_pcm_sframes_t avail = snd_pcm_avail_update(handle);
+    if (avail >= 0)
+        statistics.setBytesBuffered(snd_pcm_frames_to_bytes(handle, avail) + buffered);
+
+    return statistics;
+}
+
 void QAlsaAudioInput::reset()
 {
     if(handle)
@@ -65,6 +65,8 @@
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudiodeviceinfo.h>
 #include <QtMultimedia/qaudiosystem.h>
+#include <QtMultimedia/private/qaudiostatistics_p.h>
+#include <QtMultimedia/private/qaudiosystempluginext_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -94,9 +96,10 @@ private:
     QByteArray m_data;
 };
 
-class QAlsaAudioInput : public QAbstractAudioInput
+class QAlsaAudioInput : public QAbstractAudioInput, public QAudioStatisticsExtension
 {
     Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
 public:
     QAlsaAudioInput(const QByteArray &device);
     ~QAlsaAudioInput();
@@ -123,6 +126,7 @@ public:
     QAudioFormat format() const;
     void setVolume(qreal);
     qreal volume() const;
+    QAudioStatistics statistics() const;
     bool resuming;
     snd_pcm_t* handle;
     qint64 totalTimeValue;
@@ -162,6 +166,8 @@ private:
     snd_pcm_format_t pcmformat;
     snd_pcm_hw_params_t *hwparams;
     qreal m_volume;
+    int overrunCount;
+    QAudioJitterMeter jitterMeter;
 };
 
 class AlsaInputPrivate : public QIODevice
@@ -51,6 +51,7 @@
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtMultimedia/private/qaudiohelpers_p.h>
+#include <QtMultimedia/private/qmultimediatrace_p.h>
 #include "qalsaaudiooutput.h"
 #include "qalsaaudiodeviceinfo.h"
 
@@ -81,6 +82,7 @@ QAlsaAudioOutput::QAlsaAudioOutput(const QByteArray &device)
     opened = false;
 
     m_volume = 1.0f;
+    underrunCount = 0;
 
     m_device = device;
 
@@ -128,6 +130,8 @@ int QAlsaAudioOutput::xrun_recovery(int err)
 #endif
 
     if(err == -EPIPE) {
+        Q_MULTIMEDIA_TRACE(QAudioOutput_underrun, this);
+        underrunCount++;
         errorState = QAudio::UnderrunError;
         emit errorChanged(errorState);
         err = snd_pcm_prepare(handle);
@@ -234,6 +238,8 @@ void QAlsaAudioOutput::start(QIODevice* device)
     }
 
     close();
+    underrunCount = 0;
+    jitterMeter.reset();
 
     pullMode = true;
     audioSource = device;
@@ -259,6 +265,8 @@ QIODevice* QAlsaAudioOutput::start()
     }
 
     close();
+    underrunCount = 0;
+    jitterMeter.reset();
 
     audioSource = new AlsaOutputPrivate(this);
     audioSource->open(QIODevice::WriteOnly|QIODevice::Unbuffered);
@@ -503,6 +511,7 @@ bool QAlsaAudioOutput::open()
 void QAlsaAudioOutput::close()
 {
     timer->stop();
+    jitterMeter.pause();
 
     if ( handle ) {
         snd_pcm_drain( handle );
@@ -529,6 +538,9 @@ int QAlsaAudioOutput::bytesFree() const
     int frames = snd_pcm_avail_update(handle);
     if (frames == -EPIPE) {
         // Try and handle buffer underrun
+        Q_MULTIMEDIA_TRACE(QAudioOutput_underrun, this);
+        if (deviceState == QAudio::ActiveState)
+            underrunCount++;
         int err = snd_pcm_recover(handle, frames, 0);
         if (err < 0)
             return 0;
@@ -554,7 +566,8 @@ qint64 QAlsaAudioOutput::write( const char *data, qint64 len )
         snd_pcm_bytes_to_frames( handle, (int)len )<<" ("<<len<<") bytes";
 #endif
     int frames, err;
-    int space = bytesFree();
+    const int available = bytesFree();
+    int space = available;
 
     if (!space)
         return 0;
@@ -573,6 +586,9 @@ qint64 QAlsaAudioOutput::write( const char *data, qint64 len )
     }
 
     if(err > 0) {
+        const int written = snd_pcm_frames_to_bytes(handle, err);
+        // Tracing builds evaluate the arguments on every write, don't query the device for them.
+        Q_MULTIMEDIA_TRACE(QAudioOutput_write, this, written, available - written);
         totalTimeValue += err;
         resuming = false;
         errorState = QAudio::NoError;
@@ -580,7 +596,7 @@ qint64 QAlsaAudioOutput::write( const char *data, qint64 len )
             deviceState = QAudio::ActiveState;
             emit stateChanged(deviceState);
         }
-        return snd_pcm_frames_to_bytes( handle, err );
+        return written;
     } else
         err = xrun_recovery(err);
 
@@ -667,6 +683,7 @@ void QAlsaAudioOutput::suspend()
     if(deviceState == QAudio::ActiveState || deviceState == QAudio::IdleState || resuming) {
         snd_pcm_drain(handle);
         timer->stop();
+        jitterMeter.pause();
         deviceState = QAudio::SuspendedState;
         errorState = QAudio::NoError;
         emit stateChanged(deviceState);
@@ -681,9 +698,13 @@ void QAlsaAudioOutput::userFeed()
     QTime now(QTime::currentTime());
     qDebug()<<now.second()<<"s "<<now.msec()<<"ms :userFeed() OUT";
 #endif
+    jitterMeter.tick(qint64(timer->interval()) * 1000);
+
     if(deviceState ==  QAudio::IdleState)
         bytesAvailable = bytesFree();
 
+    Q_MULTIMEDIA_TRACE(QAudioOutput_userFeed, this, bytesAvailable);
+
     deviceReady();
 }
 
@@ -720,10 +741,14 @@ bool QAlsaAudioOutput::deviceReady()
 
         } else if(l == 0) {
             // Did not get any data to output
+            const int underruns = underrunCount;
             bytesAvailable = bytesFree();
             if(bytesAvailable > snd_pcm_frames_to_bytes(handle, buffer_frames-period_frames)) {
-                // Underrun
+                // Underrun, bytesFree() only counted it if the hardware ran dry already
                 if (deviceState != QAudio::IdleState) {
+                    Q_MULTIMEDIA_TRACE(QAudioOutput_underrun, this);
+                    if (underrunCount == underruns)
+                        underrunCount++;
                     errorState = QAudio::UnderrunError;
                     emit errorChanged(errorState);
                     deviceState = QAudio::IdleState;
@@ -739,10 +764,14 @@ bool QAlsaAudioOutput::deviceReady()
             emit stateChanged(deviceState);
         }
     } else {
+        const int underruns = underrunCount;
         bytesAvailable = bytesFree();
         if(bytesAvailable > snd_pcm_frames_to_bytes(handle, buffer_frames-period_frames)) {
-            // Underrun
+            // Underrun, bytesFree() only counted it if the hardware ran dry already
             if (deviceState != QAudio::IdleState) {
+                Q_MULTIMEDIA_TRACE(QAudioOutput_underrun, this);
+                if (underrunCount == underruns)
+                    underrunCount++;
                 errorState = QAudio::UnderrunError;
                 emit errorChanged(errorState);
                 deviceState = QAudio::IdleState;
@@ -770,6 +799,28 @@ qint64 QAlsaAudioOutput::elapsedUSecs() const
     return clockStamp.elapsed() * qint64(1000);
 }
 
+QAudioStatistics QAlsaAudioOutput::statistics() const
+{
+    QAudioStatistics statistics;
+    statistics.setUnderrunCount(underrunCount);
+    statistics.setMaxCallbackJitterUSecs(jitterMeter.maxJitterUSecs());
+
+    if (!handle || (deviceState != QAudio::ActiveState && deviceState != QAudio::IdleState))
+        return statistics;
+
+    // The delay covers what is queued in the ALSA buffer and what is
+    // still on its way through the hardware.
+    snd_pcm_sframes_t delay = 0;
+    if (snd_pcm_delay(handle, &delay) == 0 && delay >= 0)
+        statistics.setLatencyUSecs(qint64(1000000) * delay / settings.sampleRate());
+
+    const snd_pcm_sframes_t avail = snd_pcm_avail_update(handle);
+    if (avail >= 0 && snd_pcm_uframes_t(avail) <= buffer_frames)
+        statistics.setBytesBuffered(snd_pcm_frames_to_bytes(handle, buffer_frames - avail));
+
+    return statistics;
+}
+
 void QAlsaAudioOutput::reset()
 {
     if(handle)
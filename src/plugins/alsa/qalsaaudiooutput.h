@@ -64,13 +64,16 @@
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudiodeviceinfo.h>
 #include <QtMultimedia/qaudiosystem.h>
+#include <QtMultimedia/private/qaudiostatistics_p.h>
+#include <QtMultimedia/private/qaudiosystempluginext_p.h>
 
 QT_BEGIN_NAMESPACE
 
-class QAlsaAudioOutput : public QAbstractAudioOutput
+class QAlsaAudioOutput : public QAbstractAudioOutput, public QAudioStatisticsExtension
 {
     friend class AlsaOutputPrivate;
     Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
 public:
     QAlsaAudioOutput(const QByteArray &device);
     ~QAlsaAudioOutput();
@@ -97,7 +100,7 @@ public:
     QAudioFormat format() const;
     void setVolume(qreal);
     qreal volume() const;
-
+    QAudioStatistics statistics() const;
 
     QIODevice* audioSource;
     QAudioFormat settings;
@@ -141,6 +144,8 @@ private:
     snd_pcm_format_t pcmformat;
     snd_pcm_hw_params_t *hwparams;
     qreal m_volume;
+    mutable int underrunCount;
+    QAudioJitterMeter jitterMeter;
 };
 
 class AlsaOutputPrivate : public QIODevice
@@ -8,7 +8,8 @@ HEADERS += audioencodercontrol.h \
     audiocaptureservice.h \
     audiocaptureserviceplugin.h \
     audiocapturesession.h \
-    audiocaptureprobecontrol.h
+    audiocaptureprobecontrol.h \
+    audiofilewriter.h
 
 SOURCES += audioencodercontrol.cpp \
     audiocontainercontrol.cpp \
@@ -17,7 +18,8 @@ SOURCES += audioencodercontrol.cpp \
     audiocaptureservice.cpp \
     audiocaptureserviceplugin.cpp \
     audiocapturesession.cpp \
-    audiocaptureprobecontrol.cpp
+    audiocaptureprobecontrol.cpp \
+    audiofilewriter.cpp
 
 OTHER_FILES += \
     audiocapture.json
@@ -49,44 +49,6 @@
 
 QT_BEGIN_NAMESPACE
 
-void FileProbeProxy::startProbes(const QAudioFormat &format)
-{
-    m_format = format;
-}
-
-void FileProbeProxy::stopProbes()
-{
-    m_format = QAudioFormat();
-}
-
-void FileProbeProxy::addProbe(AudioCaptureProbeControl *probe)
-{
-    QMutexLocker locker(&m_probeMutex);
-
-    if (m_probes.contains(probe))
-        return;
-
-    m_probes.append(probe);
-}
-
-void FileProbeProxy::removeProbe(AudioCaptureProbeControl *probe)
-{
-    QMutexLocker locker(&m_probeMutex);
-    m_probes.removeOne(probe);
-}
-
-qint64 FileProbeProxy::writeData(const char *data, qint64 len)
-{
-    if (m_format.isValid()) {
-        QMutexLocker locker(&m_probeMutex);
-
-        for (AudioCaptureProbeControl* probe : qAsConst(m_probes))
-            probe->bufferProbed(data, len, m_format);
-    }
-
-    return QFile::writeData(data, len);
-}
-
 AudioCaptureSession::AudioCaptureSession(QObject *parent)
     : QObject(parent)
     , m_state(QMediaRecorder::StoppedState)
@@ -98,6 +60,8 @@ AudioCaptureSession::AudioCaptureSession(QObject *parent)
     , m_muted(false)
 {
     m_format = m_deviceInfo.preferredFormat();
+
+    connect(&file, SIGNAL(writeFailed(QString)), this, SLOT(fileWriteFailed(QString)));
 }
 
 AudioCaptureSession::~AudioCaptureSession()
@@ -298,25 +262,7 @@ void AudioCaptureSession::record()
         setStatus(QMediaRecorder::LoadedStatus);
         setStatus(QMediaRecorder::StartingStatus);
 
-        if (file.open(QIODevice::WriteOnly)) {
-            if (m_wavFile) {
-                memset(&header,0,sizeof(CombinedHeader));
-                memcpy(header.riff.descriptor.id,"RIFF",4);
-                header.riff.descriptor.size = 0xFFFFFFFF; // This should be updated on stop(), filesize-8
-                memcpy(header.riff.type,"WAVE",4);
-                memcpy(header.wave.descriptor.id,"fmt ",4);
-                header.wave.descriptor.size = 16;
-                header.wave.audioFormat = 1; // for PCM data
-                header.wave.numChannels = m_format.channelCount();
-                header.wave.sampleRate = m_format.sampleRate();
-                header.wave.byteRate = m_format.sampleRate()*m_format.channelCount()*m_format.sampleSize()/8;
-                header.wave.blockAlign = m_format.channelCount()*m_format.sampleSize()/8;
-                header.wave.bitsPerSample = m_format.sampleSize();
-                memcpy(header.data.descriptor.id,"data",4);
-                header.data.descriptor.size = 0xFFFFFFFF; // This should be updated on stop(),samples*channels*sampleSize/8
-                file.write((char*)&header,sizeof(CombinedHeader));
-            }
-
+        if (file.open(m_format, m_wavFile)) {
             setVolumeHelper(m_muted ? 0 : m_volume);
 
             file.startProbes(m_format);
@@ -343,18 +289,8 @@ void AudioCaptureSession::stop()
     if(m_audioInput) {
         m_audioInput->stop();
         file.stopProbes();
+        // Waits for the queued data to be written and finalizes the header.
         file.close();
-        if (m_wavFile) {
-            qint32 fileSize = file.size();
-            file.open(QIODevice::ReadWrite | QIODevice::Unbuffered);
-            file.read((char*)&header,sizeof(CombinedHeader));
-            header.riff.descriptor.size = fileSize - 8; // The RIFF chunk size is the file size minus
-                                                        // the first two RIFF fields (8 bytes)
-            header.data.descriptor.size = fileSize - 44; // dataSize = fileSize - headerSize (44 bytes)
-            file.seek(0);
-            file.write((char*)&header,sizeof(CombinedHeader));
-            file.close();
-        }
         delete m_audioInput;
         m_audioInput = 0;
         setStatus(QMediaRecorder::UnloadedStatus);
@@ -393,6 +329,13 @@ void AudioCaptureSession::notify()
     emit positionChanged(position());
 }
 
+void AudioCaptureSession::fileWriteFailed(const QString &errorString)
+{
+    emit error(QMediaRecorder::ResourceError,
+               QStringLiteral("Failed to write to the output location: %1").arg(errorString));
+    setState(QMediaRecorder::StoppedState);
+}
+
 void AudioCaptureSession::setCaptureDevice(const QString &deviceName)
 {
     m_captureDevice = deviceName;
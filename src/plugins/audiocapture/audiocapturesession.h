@@ -40,11 +40,10 @@
 #ifndef AUDIOCAPTURESESSION_H
 #define AUDIOCAPTURESESSION_H
 
-#include <QFile>
 #include <QUrl>
 #include <QDir>
-#include <QMutex>
 
+#include "audiofilewriter.h"
 #include "audioencodercontrol.h"
 #include "audioinputselector.h"
 #include "audiomediarecordercontrol.h"
@@ -57,23 +56,6 @@ QT_BEGIN_NAMESPACE
 
 class AudioCaptureProbeControl;
 
-class FileProbeProxy: public QFile {
-public:
-    void startProbes(const QAudioFormat& format);
-    void stopProbes();
-    void addProbe(AudioCaptureProbeControl *probe);
-    void removeProbe(AudioCaptureProbeControl *probe);
-
-protected:
-    virtual qint64 writeData(const char *data, qint64 len);
-
-private:
-    QAudioFormat m_format;
-    QList<AudioCaptureProbeControl*> m_probes;
-    QMutex m_probeMutex;
-};
-
-
 class AudioCaptureSession : public QObject
 {
     Q_OBJECT
@@ -120,6 +102,7 @@ signals:
 private slots:
     void audioInputStateChanged(QAudio::State state);
     void notify();
+    void fileWriteFailed(const QString &errorString);
 
 private:
     void record();
@@ -135,7 +118,7 @@ private:
                              const QString &extension) const;
     QString generateFileName(const QDir &dir, const QString &extension) const;
 
-    FileProbeProxy file;
+    AudioFileWriter file;
     QString m_captureDevice;
     QUrl m_requestedOutputLocation;
     QUrl m_actualOutputLocation;
@@ -147,46 +130,6 @@ private:
     bool m_wavFile;
     qreal m_volume;
     bool m_muted;
-
-    // WAV header stuff
-
-    struct chunk
-    {
-        char        id[4];
-        quint32     size;
-    };
-
-    struct RIFFHeader
-    {
-        chunk       descriptor;
-        char        type[4];
-    };
-
-    struct WAVEHeader
-    {
-        chunk       descriptor;
-        quint16     audioFormat;        // PCM = 1
-        quint16     numChannels;
-        quint32     sampleRate;
-        quint32     byteRate;
-        quint16     blockAlign;
-        quint16     bitsPerSample;
-    };
-
-    struct DATAHeader
-    {
-        chunk       descriptor;
-//        quint8      data[];
-    };
-
-    struct CombinedHeader
-    {
-        RIFFHeader  riff;
-        WAVEHeader  wave;
-        DATAHeader  data;
-    };
-
-    CombinedHeader      header;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,374 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "audiofilewriter.h"
+#include "audiocaptureprobecontrol.h"
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qendian.h>
+
+#include <limits.h>
+#include <string.h>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+// How often the writer thread wakes up to write queued data to the file.
+static const int FlushInterval = 50;
+// How often the header is brought up to date with the amount of data written.
+static const int HeaderUpdateInterval = 1000;
+// How much audio is queued at most for the writer thread.
+static const qint64 BufferDuration = 2000000;
+
+class AudioFileWriterThread : public QThread
+{
+public:
+    AudioFileWriterThread(AudioFileWriter *writer)
+        : m_writer(writer)
+    {
+    }
+
+protected:
+    void run() override { m_writer->run(); }
+
+private:
+    AudioFileWriter *m_writer;
+};
+
+AudioFileWriter::AudioFileWriter(QObject *parent)
+    : QIODevice(parent)
+    , m_thread(0)
+    , m_buffer(0)
+    , m_dataSize(0)
+    , m_allocatedSize(0)
+    , m_preallocationStep(0)
+    , m_wavHeader(false)
+    , m_preallocate(false)
+{
+}
+
+AudioFileWriter::~AudioFileWriter()
+{
+    close();
+}
+
+QString AudioFileWriter::fileName() const
+{
+    return m_file.fileName();
+}
+
+void AudioFileWriter::setFileName(const QString &fileName)
+{
+    m_file.setFileName(fileName);
+}
+
+bool AudioFileWriter::open(const QAudioFormat &format, bool wavHeader)
+{
+    if (isOpen())
+        return false;
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        setErrorString(m_file.errorString());
+        return false;
+    }
+
+    m_format = format;
+    m_wavHeader = wavHeader;
+    m_dataSize = 0;
+    m_allocatedSize = 0;
+#if defined(Q_OS_LINUX)
+    m_preallocate = true;
+#endif
+    // Extend the file by ten seconds of audio at a time.
+    m_preallocationStep = qMax(qint64(1024 * 1024), format.bytesForDuration(10000000));
+
+    if (m_wavHeader && !writeHeader()) {
+        setErrorString(m_file.errorString());
+        m_file.close();
+        return false;
+    }
+
+    const qint64 bufferSize = qBound(qint64(64 * 1024), format.bytesForDuration(BufferDuration),
+                                     qint64(64 * 1024 * 1024));
+    m_buffer = new QAudioRingBuffer(bufferSize);
+    m_stopping.store(0);
+    m_failed.store(0);
+    m_droppedBytes.store(0);
+
+    QIODevice::open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+
+    m_headerTimer.start();
+    m_thread = new AudioFileWriterThread(this);
+    m_thread->start();
+
+    return true;
+}
+
+void AudioFileWriter::close()
+{
+    if (!isOpen())
+        return;
+
+    QIODevice::close();
+
+    // The writer thread writes out what is left and the final header.
+    m_stopping.storeRelease(1);
+    m_wakeUp.release();
+    m_thread->wait();
+    delete m_thread;
+    m_thread = 0;
+
+    // Give back the space preallocated past the end of the data.
+    if (m_allocatedSize > m_file.size())
+        m_file.resize(m_file.size());
+    m_file.close();
+
+    delete m_buffer;
+    m_buffer = 0;
+
+    if (m_droppedBytes.load() > 0) {
+        qWarning() << "AudioFileWriter: the file couldn't be written fast enough,"
+                   << m_droppedBytes.load() << "bytes were dropped from" << m_file.fileName();
+    }
+}
+
+bool AudioFileWriter::isSequential() const
+{
+    return true;
+}
+
+qint64 AudioFileWriter::droppedBytes() const
+{
+    return m_droppedBytes.load();
+}
+
+void AudioFileWriter::startProbes(const QAudioFormat &format)
+{
+    m_probeFormat = format;
+}
+
+void AudioFileWriter::stopProbes()
+{
+    m_probeFormat = QAudioFormat();
+}
+
+void AudioFileWriter::addProbe(AudioCaptureProbeControl *probe)
+{
+    QMutexLocker locker(&m_probeMutex);
+
+    if (m_probes.contains(probe))
+        return;
+
+    m_probes.append(probe);
+}
+
+void AudioFileWriter::removeProbe(AudioCaptureProbeControl *probe)
+{
+    QMutexLocker locker(&m_probeMutex);
+    m_probes.removeOne(probe);
+}
+
+qint64 AudioFileWriter::readData(char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+
+    return -1;
+}
+
+qint64 AudioFileWriter::writeData(const char *data, qint64 len)
+{
+    if (m_probeFormat.isValid()) {
+        QMutexLocker locker(&m_probeMutex);
+
+        for (AudioCaptureProbeControl* probe : qAsConst(m_probes))
+            probe->bufferProbed(data, len, m_probeFormat);
+    }
+
+    if (m_failed.load())
+        return -1;
+
+    // The audio input can't wait for the file system, what doesn't fit is lost.
+    qint64 written = 0;
+    while (written < len) {
+        const QAudioRingBuffer::Region region = m_buffer->acquireWriteRegion(qMin(len - written, qint64(INT_MAX)));
+        if (region.second == 0)
+            break;
+
+        memcpy(region.first, data + written, region.second);
+        m_buffer->releaseWriteRegion(region);
+        written += region.second;
+    }
+
+    if (written < len)
+        m_droppedBytes.fetchAndAddRelaxed(len - written);
+
+    // Don't wait for the next periodic flush when the buffer fills up.
+    if (m_buffer->used() >= m_buffer->size() / 2 && m_wakeUp.available() == 0)
+        m_wakeUp.release();
+
+    return len;
+}
+
+void AudioFileWriter::run()
+{
+    for (;;) {
+        const bool stopping = m_stopping.loadAcquire();
+
+        flush();
+
+        if (stopping)
+            break;
+
+        if (m_wavHeader && m_headerTimer.elapsed() >= HeaderUpdateInterval) {
+            if (!writeHeader())
+                setFailed();
+            m_headerTimer.restart();
+        }
+
+        m_wakeUp.tryAcquire(1, FlushInterval);
+    }
+
+    if (m_wavHeader && !writeHeader())
+        setFailed();
+}
+
+bool AudioFileWriter::flush()
+{
+    for (;;) {
+        const QAudioRingBuffer::Region region = m_buffer->acquireReadRegion(INT_MAX);
+        if (region.second == 0)
+            return true;
+
+        if (!m_failed.load()) {
+            preallocate(m_file.pos() + region.second);
+
+            if (m_file.write(region.first, region.second) == region.second)
+                m_dataSize += region.second;
+            else
+                setFailed();
+        }
+
+        m_buffer->releaseReadRegion(region);
+    }
+}
+
+void AudioFileWriter::setFailed()
+{
+    // Report only the first error, the recording is lost from there on.
+    if (m_failed.testAndSetRelaxed(0, 1))
+        emit writeFailed(m_file.errorString());
+}
+
+void AudioFileWriter::preallocate(qint64 size)
+{
+#if defined(Q_OS_LINUX)
+    if (!m_preallocate || size <= m_allocatedSize)
+        return;
+
+    // Reserve the extents without changing the file size, which always covers just
+    // the data written.
+    const qint64 allocatedSize = size + m_preallocationStep;
+    if (::fallocate(m_file.handle(), FALLOC_FL_KEEP_SIZE, m_allocatedSize, allocatedSize - m_allocatedSize) == 0)
+        m_allocatedSize = allocatedSize;
+    else
+        m_preallocate = false; // not supported by the file system
+#else
+    Q_UNUSED(size);
+#endif
+}
+
+bool AudioFileWriter::writeHeader()
+{
+    const QByteArray header = wavHeader(m_format, m_dataSize);
+
+    const bool ok = m_file.seek(0) && m_file.write(header) == header.size();
+    m_file.seek(header.size() + m_dataSize);
+
+    return ok;
+}
+
+// Returns the header of a WAV file holding dataSize bytes of audio, which is
+// an RF64 header once the file outgrows 4 GB.
+QByteArray AudioFileWriter::wavHeader(const QAudioFormat &format, qint64 dataSize)
+{
+    Q_STATIC_ASSERT(sizeof(CombinedHeader) == 80);
+
+    CombinedHeader header;
+    memset(&header, 0, sizeof(CombinedHeader));
+
+    const int blockAlign = format.channelCount() * format.sampleSize() / 8;
+    const quint64 riffSize = sizeof(CombinedHeader) - sizeof(chunk) + dataSize;
+    const bool rf64 = riffSize > 0xffffffff;
+
+    memcpy(header.riff.descriptor.id, rf64 ? "RF64" : "RIFF", 4);
+    header.riff.descriptor.size = qToLittleEndian<quint32>(rf64 ? 0xffffffff : riffSize);
+    memcpy(header.riff.type, "WAVE", 4);
+
+    memcpy(header.ds64.descriptor.id, rf64 ? "ds64" : "JUNK", 4);
+    header.ds64.descriptor.size = qToLittleEndian<quint32>(sizeof(DS64Header) - sizeof(chunk));
+    if (rf64) {
+        const quint64 sampleCount = blockAlign > 0 ? dataSize / blockAlign : 0;
+        header.ds64.riffSizeLow = qToLittleEndian<quint32>(riffSize);
+        header.ds64.riffSizeHigh = qToLittleEndian<quint32>(riffSize >> 32);
+        header.ds64.dataSizeLow = qToLittleEndian<quint32>(dataSize);
+        header.ds64.dataSizeHigh = qToLittleEndian<quint32>(quint64(dataSize) >> 32);
+        header.ds64.sampleCountLow = qToLittleEndian<quint32>(sampleCount);
+        header.ds64.sampleCountHigh = qToLittleEndian<quint32>(sampleCount >> 32);
+    }
+
+    memcpy(header.wave.descriptor.id, "fmt ", 4);
+    header.wave.descriptor.size = qToLittleEndian<quint32>(16);
+    header.wave.audioFormat = qToLittleEndian<quint16>(format.sampleType() == QAudioFormat::Float ? 3 : 1);
+    header.wave.numChannels = qToLittleEndian<quint16>(format.channelCount());
+    header.wave.sampleRate = qToLittleEndian<quint32>(format.sampleRate());
+    header.wave.byteRate = qToLittleEndian<quint32>(format.sampleRate() * blockAlign);
+    header.wave.blockAlign = qToLittleEndian<quint16>(blockAlign);
+    header.wave.bitsPerSample = qToLittleEndian<quint16>(format.sampleSize());
+
+    memcpy(header.data.descriptor.id, "data", 4);
+    header.data.descriptor.size = qToLittleEndian<quint32>(rf64 ? 0xffffffff : dataSize);
+
+    return QByteArray(reinterpret_cast<const char *>(&header), sizeof(CombinedHeader));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef AUDIOFILEWRITER_H
+#define AUDIOFILEWRITER_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+
+#include <qaudioformat.h>
+#include <private/qaudioringbuffer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class AudioCaptureProbeControl;
+
+// The device QAudioInput records to. Captured data is handed to the probes and
+// queued, a writer thread appends it to the file, preallocating the file ahead
+// of the data and rewriting the WAV header every second, so that the file stays
+// playable if the application dies while recording.
+class AudioFileWriter : public QIODevice
+{
+    Q_OBJECT
+public:
+    AudioFileWriter(QObject *parent = 0);
+    ~AudioFileWriter();
+
+    QString fileName() const;
+    void setFileName(const QString &fileName);
+
+    bool open(const QAudioFormat &format, bool wavHeader);
+    void close() override;
+
+    bool isSequential() const override;
+    qint64 droppedBytes() const;
+
+    static QByteArray wavHeader(const QAudioFormat &format, qint64 dataSize);
+
+    void startProbes(const QAudioFormat& format);
+    void stopProbes();
+    void addProbe(AudioCaptureProbeControl *probe);
+    void removeProbe(AudioCaptureProbeControl *probe);
+
+Q_SIGNALS:
+    // Emitted from the writer thread.
+    void writeFailed(const QString &errorString);
+
+protected:
+    qint64 readData(char *data, qint64 len) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    friend class AudioFileWriterThread;
+
+    void run();
+    bool flush();
+    void setFailed();
+    void preallocate(qint64 size);
+    bool writeHeader();
+
+    QFile m_file;
+    QThread *m_thread;
+    QAudioRingBuffer *m_buffer;
+    QSemaphore m_wakeUp;
+    QAtomicInt m_stopping;
+    QAtomicInt m_failed;
+    QAtomicInteger<qint64> m_droppedBytes;
+
+    // Owned by the writer thread while recording.
+    qint64 m_dataSize;
+    qint64 m_allocatedSize;
+    qint64 m_preallocationStep;
+    bool m_wavHeader;
+    bool m_preallocate;
+    QElapsedTimer m_headerTimer;
+
+    QAudioFormat m_format;
+    QAudioFormat m_probeFormat;
+    QList<AudioCaptureProbeControl*> m_probes;
+    QMutex m_probeMutex;
+
+    // WAV header stuff, all little endian
+
+    struct chunk
+    {
+        char        id[4];
+        quint32     size;
+    };
+
+    struct RIFFHeader
+    {
+        chunk       descriptor;
+        char        type[4];
+    };
+
+    // A JUNK chunk until the file outgrows 4 GB, then it becomes the ds64 chunk
+    // of an RF64 file.
+    struct DS64Header
+    {
+        chunk       descriptor;
+        quint32     riffSizeLow;
+        quint32     riffSizeHigh;
+        quint32     dataSizeLow;
+        quint32     dataSizeHigh;
+        quint32     sampleCountLow;
+        quint32     sampleCountHigh;
+        quint32     tableLength;
+    };
+
+    struct WAVEHeader
+    {
+        chunk       descriptor;
+        quint16     audioFormat;        // PCM = 1, IEEE float = 3
+        quint16     numChannels;
+        quint32     sampleRate;
+        quint32     byteRate;
+        quint16     blockAlign;
+        quint16     bitsPerSample;
+    };
+
+    struct DATAHeader
+    {
+        chunk       descriptor;
+    };
+
+    struct CombinedHeader
+    {
+        RIFFHeader  riff;
+        DS64Header  ds64;
+        WAVEHeader  wave;
+        DATAHeader  data;
+    };
+};
+
+QT_END_NAMESPACE
+
+#endif
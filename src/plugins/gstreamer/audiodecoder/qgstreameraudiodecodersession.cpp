@@ -97,7 +97,9 @@ QGstreamerAudioDecoderSession::QGstreamerAudioDecoderSession(QObject *parent)
         // Sort out messages
         m_bus = gst_element_get_bus(m_playbin);
         m_busHelper = new QGstreamerBusHelper(m_bus, this);
-        m_busHelper->installMessageFilter(this);
+        m_busHelper->installMessageFilter(this, GstMessageType(
+                GST_MESSAGE_EOS | GST_MESSAGE_ERROR | GST_MESSAGE_WARNING | GST_MESSAGE_INFO
+                | GST_MESSAGE_STATE_CHANGED | GST_MESSAGE_DURATION));
 
         // Set the rest of the pipeline up
         setAudioFlags(true);
@@ -7,6 +7,10 @@ INCLUDEPATH += $$PWD
 HEADERS += \
     $$PWD/qgstreamerplayerservice.h \
     $$PWD/qgstreamerstreamscontrol.h \
+    $$PWD/qgstreamergaplessplaybackcontrol.h \
+    $$PWD/qgstreamerpreparationcontrol.h \
+    $$PWD/qgstreamerseekcontrol.h \
+    $$PWD/qgstreamerplayersessionpool.h \
     $$PWD/qgstreamermetadataprovider.h \
     $$PWD/qgstreameravailabilitycontrol.h \
     $$PWD/qgstreamerplayerserviceplugin.h
@@ -14,10 +18,24 @@ HEADERS += \
 SOURCES += \
     $$PWD/qgstreamerplayerservice.cpp \
     $$PWD/qgstreamerstreamscontrol.cpp \
+    $$PWD/qgstreamergaplessplaybackcontrol.cpp \
+    $$PWD/qgstreamerpreparationcontrol.cpp \
+    $$PWD/qgstreamerseekcontrol.cpp \
+    $$PWD/qgstreamerplayersessionpool.cpp \
     $$PWD/qgstreamermetadataprovider.cpp \
     $$PWD/qgstreameravailabilitycontrol.cpp \
     $$PWD/qgstreamerplayerserviceplugin.cpp
 
+qtConfig(gstreamer_app):qtConfig(gstreamer_1_0) {
+    HEADERS += \
+        $$PWD/qgstreamerthumbnailer.h \
+        $$PWD/qgstreamerthumbnailcontrol.h
+
+    SOURCES += \
+        $$PWD/qgstreamerthumbnailer.cpp \
+        $$PWD/qgstreamerthumbnailcontrol.cpp
+}
+
 OTHER_FILES += \
     mediaplayer.json
 
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamergaplessplaybackcontrol.h"
+#include <private/qgstreamerplayercontrol_p.h>
+#include <private/qgstreamerplayersession_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QGstreamerGaplessPlaybackControl::QGstreamerGaplessPlaybackControl(QGstreamerPlayerControl *control, QObject *parent)
+    : QMediaGaplessPlaybackControl(parent)
+    , m_control(control)
+    , m_session(control->session())
+{
+    connect(m_session, SIGNAL(advancedToNextUri(QUrl)), SLOT(handleAdvancedToNextUri(QUrl)));
+}
+
+QGstreamerGaplessPlaybackControl::~QGstreamerGaplessPlaybackControl()
+{
+}
+
+void QGstreamerGaplessPlaybackControl::setSession(QGstreamerPlayerSession *session)
+{
+    // The queued uri moves along to the new session.
+    const QUrl uri = m_session->nextUri();
+    m_session->setNextUri(QUrl());
+    disconnect(m_session, 0, this, 0);
+
+    m_session = session;
+    m_session->setNextUri(uri);
+    connect(m_session, SIGNAL(advancedToNextUri(QUrl)), SLOT(handleAdvancedToNextUri(QUrl)));
+}
+
+QMediaContent QGstreamerGaplessPlaybackControl::nextMedia() const
+{
+    return m_nextMedia;
+}
+
+void QGstreamerGaplessPlaybackControl::setNextMedia(const QMediaContent &media)
+{
+    // Pipelines and playlists can't be queued in playbin, they are loaded
+    // the usual way once the current media finished.
+    const QUrl uri = media.canonicalUrl();
+    const bool queueable = !media.playlist()
+            && uri.isValid()
+            && uri.scheme() != QLatin1String("gst-pipeline");
+    m_session->setNextUri(queueable ? uri : QUrl());
+
+    if (m_nextMedia != media) {
+        m_nextMedia = media;
+        emit nextMediaChanged(m_nextMedia);
+    }
+}
+
+bool QGstreamerGaplessPlaybackControl::isCrossfadeSupported() const
+{
+    return false;
+}
+
+qreal QGstreamerGaplessPlaybackControl::crossfadeTime() const
+{
+    return 0;
+}
+
+void QGstreamerGaplessPlaybackControl::setCrossfadeTime(qreal crossfadeTime)
+{
+    Q_UNUSED(crossfadeTime);
+}
+
+void QGstreamerGaplessPlaybackControl::handleAdvancedToNextUri(const QUrl &uri)
+{
+    const QMediaContent media = m_nextMedia.canonicalUrl() == uri ? m_nextMedia : QMediaContent(uri);
+    m_control->advanceToNextMedia(media);
+
+    m_nextMedia = QMediaContent();
+    emit nextMediaChanged(m_nextMedia);
+    emit advancedToNextMedia();
+}
+
+QT_END_NAMESPACE
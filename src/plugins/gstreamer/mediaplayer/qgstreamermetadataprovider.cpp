@@ -133,6 +133,15 @@ QGstreamerMetaDataProvider::~QGstreamerMetaDataProvider()
 {
 }
 
+void QGstreamerMetaDataProvider::setSession(QGstreamerPlayerSession *session)
+{
+    disconnect(m_session, 0, this, 0);
+    m_session = session;
+    connect(m_session, SIGNAL(tagsChanged()), SLOT(updateTags()));
+
+    updateTags();
+}
+
 bool QGstreamerMetaDataProvider::isMetaDataAvailable() const
 {
     return !m_session->tags().isEmpty();
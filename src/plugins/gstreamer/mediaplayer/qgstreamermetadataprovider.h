@@ -53,6 +53,8 @@ public:
     QGstreamerMetaDataProvider( QGstreamerPlayerSession *session, QObject *parent );
     virtual ~QGstreamerMetaDataProvider();
 
+    void setSession(QGstreamerPlayerSession *session);
+
     bool isMetaDataAvailable() const override;
     bool isWritable() const;
 
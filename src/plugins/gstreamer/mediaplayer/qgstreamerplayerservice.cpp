@@ -60,6 +60,13 @@
 #endif
 
 #include "qgstreamerstreamscontrol.h"
+#include "qgstreamergaplessplaybackcontrol.h"
+#include "qgstreamerpreparationcontrol.h"
+#include "qgstreamerseekcontrol.h"
+#if QT_CONFIG(gstreamer_app) && QT_CONFIG(gstreamer_1_0)
+#include "qgstreamerthumbnailcontrol.h"
+#endif
+#include "qgstreamerplayersessionpool.h"
 #include <private/qgstreameraudioprobecontrol_p.h>
 #include <private/qgstreamervideoprobecontrol_p.h>
 #include <private/qgstreamerplayersession_p.h>
@@ -73,6 +80,8 @@ QT_BEGIN_NAMESPACE
 
 QGstreamerPlayerService::QGstreamerPlayerService(QObject *parent):
      QMediaService(parent)
+     , m_preparationControl(0)
+     , m_thumbnailControl(0)
      , m_audioProbeControl(0)
      , m_videoProbeControl(0)
      , m_videoOutput(0)
@@ -83,16 +92,24 @@ QGstreamerPlayerService::QGstreamerPlayerService(QObject *parent):
 #endif
      , m_videoReferenceCount(0)
 {
-    m_session = new QGstreamerPlayerSession(this);
+    m_sessionPool = QGstreamerPlayerSessionPool::instance();
+    m_session = m_sessionPool->acquire(this);
     m_control = new QGstreamerPlayerControl(m_session, this);
     m_metaData = new QGstreamerMetaDataProvider(m_session, this);
     m_streamsControl = new QGstreamerStreamsControl(m_session,this);
+    m_gaplessControl = new QGstreamerGaplessPlaybackControl(m_control, this);
+    m_seekControl = new QGstreamerSeekControl(m_session, this);
     m_availabilityControl = new QGStreamerAvailabilityControl(m_control->resources(), this);
 
+    connect(m_control, &QGstreamerPlayerControl::sessionChanged,
+            this, &QGstreamerPlayerService::handleSessionChanged);
+
 #if QT_CONFIG(mirclient) && defined (__arm__)
+    // The mir renderer is bound to a single session, which can't be swapped for a prepared one.
     m_videoRenderer = new QGstreamerMirTextureRenderer(this, m_session);
 #else
     m_videoRenderer = new QGstreamerVideoRenderer(this);
+    m_preparationControl = new QGstreamerPreparationControl(m_control, this);
 #endif
 
     m_videoWindow = new QGstreamerVideoWindow(this);
@@ -118,6 +135,16 @@ QGstreamerPlayerService::QGstreamerPlayerService(QObject *parent):
 
 QGstreamerPlayerService::~QGstreamerPlayerService()
 {
+    // Hand the prepared and the active sessions back to the pool.
+    delete m_preparationControl;
+    m_preparationControl = 0;
+
+    if (m_videoProbeControl)
+        m_session->removeProbe(m_videoProbeControl);
+    if (m_audioProbeControl)
+        m_session->removeProbe(m_audioProbeControl);
+
+    releaseSession(m_session);
 }
 
 QMediaControl *QGstreamerPlayerService::requestControl(const char *name)
@@ -131,9 +158,27 @@ QMediaControl *QGstreamerPlayerService::requestControl(const char *name)
     if (qstrcmp(name,QMediaStreamsControl_iid) == 0)
         return m_streamsControl;
 
+    if (qstrcmp(name, QMediaGaplessPlaybackControl_iid) == 0)
+        return m_gaplessControl;
+
+    if (qstrcmp(name, QMediaPreparationControl_iid) == 0)
+        return m_preparationControl;
+
     if (qstrcmp(name, QMediaAvailabilityControl_iid) == 0)
         return m_availabilityControl;
 
+    if (qstrcmp(name, QMediaSeekControl_iid) == 0)
+        return m_seekControl;
+
+#if QT_CONFIG(gstreamer_app) && QT_CONFIG(gstreamer_1_0)
+    if (qstrcmp(name, QMediaThumbnailControl_iid) == 0) {
+        // The thumbnailer runs its own thread and pipeline, only start it when needed.
+        if (!m_thumbnailControl)
+            m_thumbnailControl = new QGstreamerThumbnailControl(m_control, this);
+        return m_thumbnailControl;
+    }
+#endif
+
     if (qstrcmp(name, QMediaVideoProbeControl_iid) == 0) {
         if (!m_videoProbeControl) {
             increaseVideoRef();
@@ -193,6 +238,38 @@ void QGstreamerPlayerService::releaseControl(QMediaControl *control)
     }
 }
 
+void QGstreamerPlayerService::handleSessionChanged(QGstreamerPlayerSession *session, QGstreamerPlayerSession *previous)
+{
+    // The player control switched to a prepared session, the other controls follow it.
+    session->setParent(this);
+    m_session = session;
+
+    m_metaData->setSession(m_session);
+    m_streamsControl->setSession(m_session);
+    m_gaplessControl->setSession(m_session);
+    m_seekControl->setSession(m_session);
+
+    if (m_videoProbeControl) {
+        previous->removeProbe(m_videoProbeControl);
+        m_session->addProbe(m_videoProbeControl);
+    }
+
+    if (m_audioProbeControl) {
+        previous->removeProbe(m_audioProbeControl);
+        m_session->addProbe(m_audioProbeControl);
+    }
+
+    releaseSession(previous);
+}
+
+void QGstreamerPlayerService::releaseSession(QGstreamerPlayerSession *session)
+{
+    if (m_sessionPool)
+        m_sessionPool->release(session);
+    else
+        session->deleteLater();
+}
+
 void QGstreamerPlayerService::increaseVideoRef()
 {
     m_videoReferenceCount++;
@@ -42,6 +42,7 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qpointer.h>
 
 #include <qmediaservice.h>
 
@@ -55,6 +56,10 @@ class QGstreamerPlayerControl;
 class QGstreamerPlayerSession;
 class QGstreamerMetaDataProvider;
 class QGstreamerStreamsControl;
+class QGstreamerGaplessPlaybackControl;
+class QGstreamerPreparationControl;
+class QGstreamerSeekControl;
+class QGstreamerPlayerSessionPool;
 class QGstreamerVideoRenderer;
 class QGstreamerVideoWindow;
 class QGstreamerVideoWidgetControl;
@@ -72,11 +77,22 @@ public:
     QMediaControl *requestControl(const char *name) override;
     void releaseControl(QMediaControl *control) override;
 
+private Q_SLOTS:
+    void handleSessionChanged(QGstreamerPlayerSession *session, QGstreamerPlayerSession *previous);
+
 private:
+    void releaseSession(QGstreamerPlayerSession *session);
+
+    QPointer<QGstreamerPlayerSessionPool> m_sessionPool;
+
     QGstreamerPlayerControl *m_control;
     QGstreamerPlayerSession *m_session;
     QGstreamerMetaDataProvider *m_metaData;
     QGstreamerStreamsControl *m_streamsControl;
+    QGstreamerGaplessPlaybackControl *m_gaplessControl;
+    QGstreamerPreparationControl *m_preparationControl;
+    QGstreamerSeekControl *m_seekControl;
+    QMediaControl *m_thumbnailControl;
     QGStreamerAvailabilityControl *m_availabilityControl;
 
     QGstreamerAudioProbeControl *m_audioProbeControl;
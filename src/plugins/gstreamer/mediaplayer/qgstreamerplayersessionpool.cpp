@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamerplayersessionpool.h"
+#include <private/qgstreamerplayersession_p.h>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Keeps a number of idle player sessions around, with their pipeline
+    built and brought to the READY state, so that a new media player
+    doesn't have to pay for it when it's created.
+
+    The number of idle sessions is read from QT_GSTREAMER_PLAYER_POOL_SIZE
+    and defaults to 0, in which case sessions are created on demand and
+    deleted when released, as if there was no pool.
+*/
+
+QGstreamerPlayerSessionPool *QGstreamerPlayerSessionPool::instance()
+{
+    // Parented to the application so that the idle pipelines don't outlive it.
+    static QPointer<QGstreamerPlayerSessionPool> pool;
+    if (!pool)
+        pool = new QGstreamerPlayerSessionPool(QCoreApplication::instance());
+    return pool;
+}
+
+QGstreamerPlayerSessionPool::QGstreamerPlayerSessionPool(QObject *parent)
+    : QObject(parent)
+    , m_capacity(0)
+    , m_refillPending(false)
+{
+    bool ok = false;
+    const int capacity = qEnvironmentVariableIntValue("QT_GSTREAMER_PLAYER_POOL_SIZE", &ok);
+    if (ok)
+        m_capacity = qMax(0, capacity);
+
+    scheduleRefill();
+}
+
+QGstreamerPlayerSession *QGstreamerPlayerSessionPool::acquire(QObject *parent)
+{
+    QGstreamerPlayerSession *session = 0;
+    if (m_idleSessions.isEmpty()) {
+        session = new QGstreamerPlayerSession(parent);
+    } else {
+        session = m_idleSessions.takeFirst();
+        session->setParent(parent);
+    }
+
+    scheduleRefill();
+
+    return session;
+}
+
+void QGstreamerPlayerSessionPool::release(QGstreamerPlayerSession *session)
+{
+    if (!session)
+        return;
+
+    // Nothing of the previous owner may stay attached to the session.
+    session->disconnect();
+    session->stop();
+    session->setVideoRenderer(0);
+    session->setParent(this);
+
+    // Sessions running a custom pipeline can't be reused for playbin.
+    if (m_idleSessions.count() >= m_capacity
+            || !session->playbin()
+            || session->pipeline() != session->playbin()) {
+        // Released sessions might still be in the middle of delivering a signal.
+        session->deleteLater();
+        return;
+    }
+
+    session->loadFromUri(QNetworkRequest());
+    session->setNextUri(QUrl());
+    session->setVolume(100);
+    session->setMuted(false);
+    session->setPlaybackRate(1.0);
+    session->setSeekFlags(QMediaSeekControl::NoSeekFlags);
+    session->showPrerollFrames(true);
+    session->warmUp();
+
+    m_idleSessions.append(session);
+}
+
+void QGstreamerPlayerSessionPool::refill()
+{
+    m_refillPending = false;
+
+    if (m_idleSessions.count() >= m_capacity)
+        return;
+
+    QGstreamerPlayerSession *session = new QGstreamerPlayerSession(this);
+    session->warmUp();
+    m_idleSessions.append(session);
+
+    // Build one pipeline per event loop iteration to keep the application responsive.
+    scheduleRefill();
+}
+
+void QGstreamerPlayerSessionPool::scheduleRefill()
+{
+    if (m_refillPending || m_idleSessions.count() >= m_capacity)
+        return;
+
+    m_refillPending = true;
+    QMetaObject::invokeMethod(this, "refill", Qt::QueuedConnection);
+}
+
+QT_END_NAMESPACE
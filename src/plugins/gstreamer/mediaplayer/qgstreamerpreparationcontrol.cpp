@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamerpreparationcontrol.h"
+#include "qgstreamerplayersessionpool.h"
+#include <private/qgstreamerplayercontrol_p.h>
+#include <private/qgstreamerplayersession_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QGstreamerPreparationControl::QGstreamerPreparationControl(QGstreamerPlayerControl *control, QObject *parent)
+    : QMediaPreparationControl(parent)
+    , m_control(control)
+    , m_session(0)
+{
+    connect(m_control, &QGstreamerPlayerControl::sessionChanged,
+            this, &QGstreamerPreparationControl::handleSessionChanged);
+}
+
+QGstreamerPreparationControl::~QGstreamerPreparationControl()
+{
+    discardPreparedSession();
+}
+
+QMediaContent QGstreamerPreparationControl::preparedMedia() const
+{
+    return m_preparedMedia;
+}
+
+void QGstreamerPreparationControl::setPreparedMedia(const QMediaContent &media)
+{
+    if (media == m_preparedMedia)
+        return;
+
+    const QMediaContent oldMedia = m_preparedMedia;
+    discardPreparedSession();
+
+    // Like for gapless playback, only what playbin can load by itself is prepared.
+    const QUrl uri = media.canonicalUrl();
+    const bool preparable = !media.playlist()
+            && uri.isValid()
+            && uri.scheme() != QLatin1String("gst-pipeline");
+
+    if (preparable) {
+        m_session = QGstreamerPlayerSessionPool::instance()->acquire(this);
+        // Failures are handled once the session is done delivering the message.
+        connect(m_session, SIGNAL(invalidMedia()), SLOT(handlePreparationFailed()), Qt::QueuedConnection);
+        connect(m_session, SIGNAL(error(int,QString)), SLOT(handlePreparationFailed()), Qt::QueuedConnection);
+
+        // Pausing prerolls the pipeline, it is then ready to play as soon as it is swapped in.
+        m_session->loadFromUri(media.canonicalRequest());
+        m_session->pause();
+
+        m_preparedMedia = media;
+        m_control->setPreparedSession(m_session, m_preparedMedia);
+    }
+
+    if (m_preparedMedia != oldMedia)
+        emit preparedMediaChanged(m_preparedMedia);
+}
+
+void QGstreamerPreparationControl::handleSessionChanged(QGstreamerPlayerSession *session)
+{
+    if (!m_session || session != m_session)
+        return;
+
+    // The player control took the prepared session over.
+    disconnect(m_session, 0, this, 0);
+    m_session = 0;
+    m_preparedMedia = QMediaContent();
+
+    emit preparedMediaChanged(m_preparedMedia);
+}
+
+void QGstreamerPreparationControl::handlePreparationFailed()
+{
+    // The failure might come from a session discarded in the meantime.
+    if (!m_session || sender() != m_session)
+        return;
+
+    discardPreparedSession();
+    emit preparedMediaChanged(m_preparedMedia);
+}
+
+void QGstreamerPreparationControl::discardPreparedSession()
+{
+    if (!m_session)
+        return;
+
+    m_control->setPreparedSession(0, QMediaContent());
+
+    QGstreamerPlayerSession *session = m_session;
+    m_session = 0;
+    m_preparedMedia = QMediaContent();
+
+    QGstreamerPlayerSessionPool::instance()->release(session);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamerseekcontrol.h"
+#include <private/qgstreamerplayersession_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QGstreamerSeekControl::QGstreamerSeekControl(QGstreamerPlayerSession *session, QObject *parent)
+    : QMediaSeekControl(parent)
+    , m_session(session)
+    , m_seekFlags(session->seekFlags())
+{
+}
+
+QGstreamerSeekControl::~QGstreamerSeekControl()
+{
+}
+
+void QGstreamerSeekControl::setSession(QGstreamerPlayerSession *session)
+{
+    m_session = session;
+    m_session->setSeekFlags(m_seekFlags);
+}
+
+QMediaSeekControl::SeekFlags QGstreamerSeekControl::seekFlags() const
+{
+    return m_seekFlags;
+}
+
+void QGstreamerSeekControl::setSeekFlags(SeekFlags flags)
+{
+    if (m_seekFlags == flags)
+        return;
+
+    m_seekFlags = flags;
+    m_session->setSeekFlags(m_seekFlags);
+
+    emit seekFlagsChanged(m_seekFlags);
+}
+
+QT_END_NAMESPACE
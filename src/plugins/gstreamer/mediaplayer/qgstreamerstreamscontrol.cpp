@@ -50,6 +50,15 @@ QGstreamerStreamsControl::~QGstreamerStreamsControl()
 {
 }
 
+void QGstreamerStreamsControl::setSession(QGstreamerPlayerSession *session)
+{
+    disconnect(m_session, 0, this, 0);
+    m_session = session;
+    connect(m_session, SIGNAL(streamsChanged()), SIGNAL(streamsChanged()));
+
+    emit streamsChanged();
+}
+
 int QGstreamerStreamsControl::streamCount()
 {
     return m_session->streamCount();
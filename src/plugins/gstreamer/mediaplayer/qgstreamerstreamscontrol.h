@@ -53,6 +53,8 @@ public:
     QGstreamerStreamsControl(QGstreamerPlayerSession *session, QObject *parent);
     virtual ~QGstreamerStreamsControl();
 
+    void setSession(QGstreamerPlayerSession *session);
+
     int streamCount() override;
     StreamType streamType(int streamNumber) override;
 
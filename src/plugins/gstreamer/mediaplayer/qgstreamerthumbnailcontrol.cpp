@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamerthumbnailcontrol.h"
+#include "qgstreamerthumbnailer.h"
+#include <private/qgstreamerplayercontrol_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// Default cache limit, in kilobytes, enough for a few hundred small thumbnails.
+static const int qt_thumbnailCacheLimit = 32 * 1024;
+
+QGstreamerThumbnailControl::QGstreamerThumbnailControl(QGstreamerPlayerControl *control, QObject *parent)
+    : QMediaThumbnailControl(parent)
+    , m_control(control)
+    , m_thumbnailer(new QGstreamerThumbnailer)
+    , m_cache(qt_thumbnailCacheLimit)
+    , m_nextRequestId(0)
+{
+    m_thread.setObjectName(QStringLiteral("QGstreamerThumbnailer"));
+    m_thumbnailer->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_thumbnailer, &QObject::deleteLater);
+    connect(m_thumbnailer, &QGstreamerThumbnailer::thumbnailGrabbed,
+            this, &QGstreamerThumbnailControl::handleThumbnailGrabbed);
+    connect(m_control, &QMediaPlayerControl::mediaChanged,
+            this, &QGstreamerThumbnailControl::handleMediaChanged);
+
+    m_thread.start(QThread::LowPriority);
+
+    handleMediaChanged(m_control->media());
+}
+
+QGstreamerThumbnailControl::~QGstreamerThumbnailControl()
+{
+    m_thumbnailer->cancel();
+    m_thread.quit();
+    m_thread.wait();
+}
+
+int QGstreamerThumbnailControl::requestThumbnail(qint64 position, const QSize &size,
+                                                 QMediaSeekControl::SeekFlags flags)
+{
+    const int id = ++m_nextRequestId;
+    const QGstreamerThumbnailKey key = { position, size, int(flags) };
+
+    // Results are always delivered asynchronously, the caller doesn't know
+    // the request id yet.
+    if (const QImage *image = m_cache.object(key)) {
+        QMetaObject::invokeMethod(this, "thumbnailReady", Qt::QueuedConnection,
+                                  Q_ARG(int, id), Q_ARG(qint64, position), Q_ARG(QImage, *image));
+        return id;
+    }
+
+    m_pendingRequests.insert(id);
+    QMetaObject::invokeMethod(m_thumbnailer, "grab", Qt::QueuedConnection,
+                              Q_ARG(int, m_thumbnailer->generation()),
+                              Q_ARG(int, id),
+                              Q_ARG(qint64, position),
+                              Q_ARG(QSize, size),
+                              Q_ARG(int, int(flags)));
+
+    return id;
+}
+
+void QGstreamerThumbnailControl::cancelRequests()
+{
+    m_thumbnailer->cancel();
+    m_pendingRequests.clear();
+}
+
+int QGstreamerThumbnailControl::cacheLimit() const
+{
+    return m_cache.maxCost();
+}
+
+void QGstreamerThumbnailControl::setCacheLimit(int kilobytes)
+{
+    m_cache.setMaxCost(qMax(kilobytes, 0));
+}
+
+void QGstreamerThumbnailControl::handleMediaChanged(const QMediaContent &media)
+{
+    cancelRequests();
+    m_cache.clear();
+
+    // Streams, playlists and custom pipelines can't be opened a second time.
+    const QUrl url = media.canonicalUrl();
+    const bool supported = !media.playlist()
+            && !m_control->mediaStream()
+            && url.isValid()
+            && url.scheme() != QLatin1String("gst-pipeline")
+            && url.scheme() != QLatin1String("qrc");
+
+    QMetaObject::invokeMethod(m_thumbnailer, "setMedia", Qt::QueuedConnection,
+                              Q_ARG(QUrl, supported ? url : QUrl()));
+}
+
+void QGstreamerThumbnailControl::handleThumbnailGrabbed(int id, qint64 position, const QSize &size,
+                                                       int flags, const QImage &image)
+{
+    // Cancelled after the frame was grabbed.
+    if (!m_pendingRequests.remove(id))
+        return;
+
+    if (!image.isNull()) {
+        const QGstreamerThumbnailKey key = { position, size, flags };
+        const int cost = qMax(1, int(image.sizeInBytes() / 1024));
+        m_cache.insert(key, new QImage(image), cost);
+    }
+
+    emit thumbnailReady(id, position, image);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGSTREAMERTHUMBNAILCONTROL_H
+#define QGSTREAMERTHUMBNAILCONTROL_H
+
+#include <qmediathumbnailcontrol.h>
+#include <qmediacontent.h>
+
+#include <QtCore/qcache.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+#include <QtCore/qsize.h>
+#include <QtCore/qthread.h>
+#include <QtGui/qimage.h>
+
+QT_BEGIN_NAMESPACE
+
+class QGstreamerPlayerControl;
+class QGstreamerThumbnailer;
+
+struct QGstreamerThumbnailKey
+{
+    qint64 position;
+    QSize size;
+    int flags;
+};
+
+inline bool operator==(const QGstreamerThumbnailKey &a, const QGstreamerThumbnailKey &b)
+{
+    return a.position == b.position && a.size == b.size && a.flags == b.flags;
+}
+
+inline uint qHash(const QGstreamerThumbnailKey &key, uint seed = 0)
+{
+    return qHash(key.position, seed) ^ qHash(key.size.width() << 16 | key.size.height(), seed) ^ uint(key.flags);
+}
+
+class QGstreamerThumbnailControl : public QMediaThumbnailControl
+{
+    Q_OBJECT
+public:
+    QGstreamerThumbnailControl(QGstreamerPlayerControl *control, QObject *parent);
+    virtual ~QGstreamerThumbnailControl();
+
+    int requestThumbnail(qint64 position, const QSize &size, QMediaSeekControl::SeekFlags flags) override;
+    void cancelRequests() override;
+
+    int cacheLimit() const override;
+    void setCacheLimit(int kilobytes) override;
+
+private Q_SLOTS:
+    void handleMediaChanged(const QMediaContent &media);
+    void handleThumbnailGrabbed(int id, qint64 position, const QSize &size, int flags, const QImage &image);
+
+private:
+    QGstreamerPlayerControl *m_control;
+    QThread m_thread;
+    QGstreamerThumbnailer *m_thumbnailer;
+    QCache<QGstreamerThumbnailKey, QImage> m_cache;
+    QSet<int> m_pendingRequests;
+    int m_nextRequestId;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGSTREAMERTHUMBNAILCONTROL_H
@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamerthumbnailer.h"
+#include <private/qgstutils_p.h>
+#include <qmediaseekcontrol.h>
+
+#include <gst/app/gstappsink.h>
+
+QT_BEGIN_NAMESPACE
+
+// Opening a network media or seeking in it can be slow, but a request
+// never blocks the following ones for longer than this.
+static const GstClockTime qt_thumbnailerTimeout = 5 * GST_SECOND;
+
+// playbin flags, see GstPlayFlags
+static const int qt_playFlagVideo = 0x00000001;
+
+QGstreamerThumbnailer::QGstreamerThumbnailer()
+    : m_pipeline(0)
+    , m_videoSink(0)
+    , m_failed(false)
+{
+}
+
+QGstreamerThumbnailer::~QGstreamerThumbnailer()
+{
+    closePipeline();
+}
+
+void QGstreamerThumbnailer::setMedia(const QUrl &url)
+{
+    closePipeline();
+
+    m_url = url;
+    m_failed = false;
+}
+
+void QGstreamerThumbnailer::grab(int generation, int id, qint64 position, const QSize &size, int flags)
+{
+    // The request was cancelled while it was queued.
+    if (generation != m_generation.load())
+        return;
+
+    QImage image = grabFrame(position, flags);
+    if (!image.isNull() && size.isValid() && image.size() != size)
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    emit thumbnailGrabbed(id, position, size, flags, image);
+}
+
+bool QGstreamerThumbnailer::openPipeline()
+{
+    if (m_pipeline)
+        return true;
+
+    // Don't try again for every request if the media can't be opened.
+    if (m_failed || !m_url.isValid())
+        return false;
+
+    m_pipeline = gst_element_factory_make(QT_GSTREAMER_PLAYBIN_ELEMENT_NAME, NULL);
+    m_videoSink = gst_element_factory_make("appsink", NULL);
+
+    if (!m_pipeline || !m_videoSink) {
+        if (m_videoSink)
+            gst_object_unref(GST_OBJECT(m_videoSink));
+        m_videoSink = 0;
+        closePipeline();
+        m_failed = true;
+        return false;
+    }
+
+    qt_gst_object_ref_sink(GST_OBJECT(m_pipeline));
+
+    GstCaps *caps = gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING, "RGBx", NULL);
+    g_object_set(G_OBJECT(m_videoSink), "caps", caps, "sync", FALSE, NULL);
+    gst_caps_unref(caps);
+
+    // Only the video stream is decoded, the pipeline takes the sink over.
+    g_object_set(G_OBJECT(m_pipeline),
+                 "uri", m_url.toEncoded().constData(),
+                 "flags", qt_playFlagVideo,
+                 "video-sink", m_videoSink,
+                 NULL);
+
+    // Nobody listens to the bus, errors show up as failed state changes.
+    GstBus *bus = gst_element_get_bus(m_pipeline);
+    gst_bus_set_flushing(bus, TRUE);
+    gst_object_unref(GST_OBJECT(bus));
+
+    if (gst_element_set_state(m_pipeline, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE
+            || gst_element_get_state(m_pipeline, 0, 0, qt_thumbnailerTimeout) != GST_STATE_CHANGE_SUCCESS) {
+        qWarning() << "QGstreamerThumbnailer: could not open" << m_url;
+        closePipeline();
+        m_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+void QGstreamerThumbnailer::closePipeline()
+{
+    if (m_pipeline) {
+        gst_element_set_state(m_pipeline, GST_STATE_NULL);
+        gst_object_unref(GST_OBJECT(m_pipeline));
+    }
+
+    m_pipeline = 0;
+    m_videoSink = 0;
+}
+
+QImage QGstreamerThumbnailer::grabFrame(qint64 position, int flags)
+{
+    if (!openPipeline())
+        return QImage();
+
+    const GstSeekFlags seekFlags = GstSeekFlags(GST_SEEK_FLAG_FLUSH
+            | QGstUtils::seekFlags(QMediaSeekControl::SeekFlags(flags)));
+
+    // The paused pipeline prerolls the frame at the new position.
+    if (!gst_element_seek_simple(m_pipeline, GST_FORMAT_TIME, seekFlags, qMax(position, qint64(0)) * GST_MSECOND)
+            || gst_element_get_state(m_pipeline, 0, 0, qt_thumbnailerTimeout) != GST_STATE_CHANGE_SUCCESS) {
+        return QImage();
+    }
+
+    // Null when the position is past the end of the media.
+    GstSample *sample = gst_app_sink_pull_preroll(GST_APP_SINK(m_videoSink));
+    if (!sample)
+        return QImage();
+
+    QImage image;
+    GstCaps *caps = gst_sample_get_caps(sample);
+    GstBuffer *buffer = gst_sample_get_buffer(sample);
+    GstVideoInfo info;
+    if (caps && buffer && gst_video_info_from_caps(&info, caps))
+        image = QGstUtils::bufferToImage(buffer, info);
+
+    gst_sample_unref(sample);
+
+    return image;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGSTREAMERTHUMBNAILER_H
+#define QGSTREAMERTHUMBNAILER_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qsize.h>
+#include <QtCore/qurl.h>
+#include <QtGui/qimage.h>
+
+#include <gst/gst.h>
+
+QT_BEGIN_NAMESPACE
+
+// Decodes single frames of a media in a pipeline of its own, independent from
+// the playback session. The object lives in a worker thread, requests are
+// queued to it with QMetaObject::invokeMethod().
+class QGstreamerThumbnailer : public QObject
+{
+    Q_OBJECT
+public:
+    QGstreamerThumbnailer();
+    ~QGstreamerThumbnailer();
+
+    // Thread safe, drops the requests queued so far.
+    int generation() const { return m_generation.load(); }
+    void cancel() { m_generation.ref(); }
+
+public Q_SLOTS:
+    void setMedia(const QUrl &url);
+    void grab(int generation, int id, qint64 position, const QSize &size, int flags);
+
+Q_SIGNALS:
+    void thumbnailGrabbed(int id, qint64 position, const QSize &size, int flags, const QImage &image);
+
+private:
+    bool openPipeline();
+    void closePipeline();
+    QImage grabFrame(qint64 position, int flags);
+
+    QAtomicInt m_generation;
+    QUrl m_url;
+    GstElement *m_pipeline;
+    GstElement *m_videoSink;
+    bool m_failed;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGSTREAMERTHUMBNAILER_H
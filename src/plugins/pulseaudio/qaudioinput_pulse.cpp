@@ -55,9 +55,9 @@ const int PeriodTimeMs = 50;
 
 static void inputStreamReadCallback(pa_stream *stream, size_t length, void *userdata)
 {
-    Q_UNUSED(userdata);
     Q_UNUSED(length);
     Q_UNUSED(stream);
+    static_cast<QPulseAudioInput*>(userdata)->fillRingBuffer();
     QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
     pa_threaded_mainloop_signal(pulseEngine->mainloop(), 0);
 }
@@ -107,8 +107,8 @@ static void inputStreamUnderflowCallback(pa_stream *stream, void *userdata)
 
 static void inputStreamOverflowCallback(pa_stream *stream, void *userdata)
 {
-    Q_UNUSED(stream)
     Q_UNUSED(userdata)
+    Q_UNUSED(stream)
     qWarning() << "Got a buffer overflow!";
 }
 
@@ -140,6 +140,9 @@ QPulseAudioInput::QPulseAudioInput(const QByteArray &device)
     , m_periodTime(PeriodTimeMs)
     , m_stream(0)
     , m_device(device)
+    , m_ringBuffer(0)
+    , m_peekOffset(0)
+    , m_streamFull(false)
 {
     m_timer = new QTimer(this);
     connect(m_timer, SIGNAL(timeout()), SLOT(userFeed()));
@@ -203,6 +206,8 @@ void QPulseAudioInput::start(QIODevice *device)
     }
 
     close();
+    m_overrunCount.store(0);
+    m_jitterMeter.reset();
 
     if (!open())
         return;
@@ -224,6 +229,8 @@ QIODevice *QPulseAudioInput::start()
     }
 
     close();
+    m_overrunCount.store(0);
+    m_jitterMeter.reset();
 
     if (!open())
         return nullptr;
@@ -304,6 +311,16 @@ bool QPulseAudioInput::open()
 
     m_periodSize = pa_usec_to_bytes(PeriodTimeMs*1000, &spec);
 
+    // Room for a few fragments, so that the mainloop doesn't have to wait for the
+    // application. Fragments that don't fit are picked up piece by piece.
+    const int frameSize = pa_frame_size(&spec);
+    int ringBufferSize = 4 * (m_bufferSize > 0 ? m_bufferSize : m_periodSize);
+    ringBufferSize = qMax(ringBufferSize - ringBufferSize % frameSize, frameSize);
+    m_ringBuffer = new QAudioRingBuffer(ringBufferSize);
+    m_peekOffset = 0;
+    m_streamFull = false;
+    m_backlog.store(0);
+
     int flags = 0;
     pa_buffer_attr buffer_attr;
     buffer_attr.maxlength = (uint32_t) -1;
@@ -311,6 +328,8 @@ bool QPulseAudioInput::open()
     buffer_attr.tlength = (uint32_t) -1;
     buffer_attr.minreq = (uint32_t) -1;
     flags |= PA_STREAM_ADJUST_LATENCY;
+    // Timing updates let statistics() interpolate the latency without a round trip to the server.
+    flags |= PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE;
 
     if (m_bufferSize > 0)
         buffer_attr.fragsize = (uint32_t) m_bufferSize;
@@ -321,6 +340,8 @@ bool QPulseAudioInput::open()
         qWarning() << "pa_stream_connect_record() failed!";
         pa_stream_unref(m_stream);
         m_stream = 0;
+        delete m_ringBuffer;
+        m_ringBuffer = 0;
         pulseEngine->unlock();
         setError(QAudio::OpenError);
         setState(QAudio::StoppedState);
@@ -357,6 +378,7 @@ void QPulseAudioInput::close()
         return;
 
     m_timer->stop();
+    m_jitterMeter.pause();
 
     QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
 
@@ -377,6 +399,9 @@ void QPulseAudioInput::close()
 
     disconnect(pulseEngine, &QPulseAudioEngine::contextFailed, this, &QPulseAudioInput::onPulseContextFailed);
 
+    delete m_ringBuffer;
+    m_ringBuffer = 0;
+
     if (!m_pullMode && m_audioSource) {
         delete m_audioSource;
         m_audioSource = 0;
@@ -389,7 +414,7 @@ int QPulseAudioInput::checkBytesReady()
     if (m_deviceState != QAudio::ActiveState && m_deviceState != QAudio::IdleState) {
         m_bytesAvailable = 0;
     } else {
-        m_bytesAvailable = pa_stream_readable_size(m_stream);
+        m_bytesAvailable = m_ringBuffer ? m_ringBuffer->used() : 0;
     }
 
     return m_bytesAvailable;
@@ -402,102 +427,139 @@ int QPulseAudioInput::bytesReady() const
 
 qint64 QPulseAudioInput::read(char *data, qint64 len)
 {
-    m_bytesAvailable = checkBytesReady();
+    if (!m_ringBuffer)
+        return 0;
 
     setError(QAudio::NoError);
     setState(QAudio::ActiveState);
 
-    int readBytes = 0;
+    // Pick up what the mainloop had to leave in the stream because the ring was full.
+    if (m_backlog.loadAcquire()) {
+        QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
+        pulseEngine->lock();
+        fillRingBuffer();
+        pulseEngine->unlock();
+    }
 
-    if (!m_pullMode && !m_tempBuffer.isEmpty()) {
-        readBytes = qMin(static_cast<int>(len), m_tempBuffer.size());
-        memcpy(data, m_tempBuffer.constData(), readBytes);
-        m_totalTimeValue += readBytes;
+    qint64 readBytes = 0;
 
-        if (readBytes < m_tempBuffer.size()) {
-            m_tempBuffer.remove(0, readBytes);
-            return readBytes;
+    if (m_pullMode) {
+        for (;;) {
+            const QAudioRingBuffer::Region region = m_ringBuffer->acquireReadRegion(m_ringBuffer->size());
+            if (region.second == 0)
+                break;
+
+            const qint64 actualLength = qMax(m_audioSource->write(region.first, region.second), qint64(0));
+            m_ringBuffer->releaseReadRegion(QAudioRingBuffer::Region(region.first, int(actualLength)));
+            m_totalTimeValue += actualLength;
+            readBytes += actualLength;
+
+#ifdef DEBUG_PULSE
+            qDebug() << "QPulseAudioInput::read -- wrote " << actualLength << " to client";
+#endif
+
+            if (actualLength < region.second) {
+                setError(QAudio::UnderrunError);
+                setState(QAudio::IdleState);
+                break;
+            }
+        }
+    } else {
+        while (readBytes < len) {
+            const int size = int(qMin(len - readBytes, qint64(m_ringBuffer->size())));
+            const int actualLength = m_ringBuffer->read(data + readBytes, size);
+            if (actualLength == 0)
+                break;
+
+            m_totalTimeValue += actualLength;
+            readBytes += actualLength;
         }
 
-        m_tempBuffer.clear();
+        // Only a reader whose buffer was too small is told about the rest right away,
+        // data arriving after the ring ran dry waits for the timer. Posting the call
+        // allocates, a reader keeping up mustn't cause that for every period.
+        if (readBytes == len && m_ringBuffer->used() > 0)
+            QMetaObject::invokeMethod(this, "userFeed", Qt::QueuedConnection);
     }
 
-    while (pa_stream_readable_size(m_stream) > 0) {
-        size_t readLength = 0;
+    m_bytesAvailable = checkBytesReady();
+
+    if (m_intervalTime && (m_timeStamp.elapsed() + m_elapsedTimeOffset) > m_intervalTime) {
+        emit notify();
+        m_elapsedTimeOffset = m_timeStamp.elapsed() + m_elapsedTimeOffset - m_intervalTime;
+        m_timeStamp.restart();
+    }
 
 #ifdef DEBUG_PULSE
-        qDebug() << "QPulseAudioInput::read -- " << pa_stream_readable_size(m_stream) << " bytes available from pulse audio";
+    qDebug() << "QPulseAudioInput::read -- returning after reading " << readBytes << " bytes";
 #endif
 
-        QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
-        pulseEngine->lock();
+    return readBytes;
+}
 
-        const void *audioBuffer;
+// Moves the captured data from the stream to the ring buffer, with the volume
+// applied. Called with the mainloop locked, usually from the read callback.
+// What doesn't fit stays in the stream until the application caught up.
+//
+// The overflow callback is only called for playback streams, so capture
+// overruns are detected here: the server drops captured data once the
+// stream holds maxlength bytes, and a hole in the stream means data is
+// missing.
+void QPulseAudioInput::fillRingBuffer()
+{
+    if (!m_stream || !m_ringBuffer)
+        return;
+
+    const int frameSize = pa_frame_size(&m_spec);
+
+    while (pa_stream_readable_size(m_stream) > 0) {
+        const void *audioBuffer = 0;
+        size_t readLength = 0;
 
-        // Second and third parameters (audioBuffer and length) to pa_stream_peek are output parameters,
-        // the audioBuffer pointer is set to point to the actual pulse audio data,
-        // and the length is set to the length of this data.
         if (pa_stream_peek(m_stream, &audioBuffer, &readLength) < 0) {
             qWarning() << QString("pa_stream_peek() failed: %1").arg(pa_strerror(pa_context_errno(pa_stream_get_context(m_stream))));
-            pulseEngine->unlock();
-            return 0;
+            return;
         }
 
-        qint64 actualLength = 0;
-        if (m_pullMode) {
-            QByteArray adjusted(readLength, Qt::Uninitialized);
-            applyVolume(audioBuffer, adjusted.data(), readLength);
-            actualLength = m_audioSource->write(adjusted);
-
-            if (actualLength < qint64(readLength)) {
-                pulseEngine->unlock();
+        if (readLength == 0)
+            break;
 
-                setError(QAudio::UnderrunError);
-                setState(QAudio::IdleState);
+        // A null buffer is a hole in the stream, the data is lost.
+        if (audioBuffer) {
+            const char *src = static_cast<const char *>(audioBuffer);
+            while (m_peekOffset < int(readLength)) {
+                QAudioRingBuffer::Region region = m_ringBuffer->acquireWriteRegion(int(readLength) - m_peekOffset);
+                // Keep whole frames together, the volume is applied per sample.
+                region.second -= region.second % frameSize;
+                if (region.second == 0)
+                    break;
+
+                applyVolume(src + m_peekOffset, region.first, region.second);
+                m_ringBuffer->releaseWriteRegion(region);
+                m_peekOffset += region.second;
+            }
 
-                return actualLength;
+            if (m_peekOffset < int(readLength)) {
+                // Count an overrun once each time the stream fills up.
+                const pa_buffer_attr *bufferAttr = pa_stream_get_buffer_attr(m_stream);
+                const size_t readable = pa_stream_readable_size(m_stream);
+                const bool full = bufferAttr && readable != size_t(-1) && readable >= bufferAttr->maxlength;
+                if (full && !m_streamFull)
+                    m_overrunCount.ref();
+                m_streamFull = full;
+                m_backlog.storeRelease(1);
+                return;
             }
         } else {
-            actualLength = qMin(static_cast<int>(len - readBytes), static_cast<int>(readLength));
-            applyVolume(audioBuffer, data + readBytes, actualLength);
-        }
-
-#ifdef DEBUG_PULSE
-        qDebug() << "QPulseAudioInput::read -- wrote " << actualLength << " to client";
-#endif
-
-        if (actualLength < qint64(readLength)) {
-#ifdef DEBUG_PULSE
-            qDebug() << "QPulseAudioInput::read -- appending " << readLength - actualLength << " bytes of data to temp buffer";
-#endif
-            int diff = readLength - actualLength;
-            int oldSize = m_tempBuffer.size();
-            m_tempBuffer.resize(m_tempBuffer.size() + diff);
-            applyVolume(static_cast<const char *>(audioBuffer) + actualLength, m_tempBuffer.data() + oldSize, diff);
-            QMetaObject::invokeMethod(this, "userFeed", Qt::QueuedConnection);
+            m_overrunCount.ref();
         }
 
-        m_totalTimeValue += actualLength;
-        readBytes += actualLength;
-
         pa_stream_drop(m_stream);
-        pulseEngine->unlock();
-
-        if (!m_pullMode && readBytes >= len)
-            break;
-
-        if (m_intervalTime && (m_timeStamp.elapsed() + m_elapsedTimeOffset) > m_intervalTime) {
-            emit notify();
-            m_elapsedTimeOffset = m_timeStamp.elapsed() + m_elapsedTimeOffset - m_intervalTime;
-            m_timeStamp.restart();
-        }
+        m_peekOffset = 0;
     }
 
-#ifdef DEBUG_PULSE
-    qDebug() << "QPulseAudioInput::read -- returning after reading " << readBytes << " bytes";
-#endif
-
-    return readBytes;
+    m_streamFull = false;
+    m_backlog.storeRelease(0);
 }
 
 void QPulseAudioInput::applyVolume(const void *src, void *dest, int len)
@@ -582,6 +644,7 @@ void QPulseAudioInput::suspend()
         setState(QAudio::SuspendedState);
 
         m_timer->stop();
+        m_jitterMeter.pause();
 
         QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
         pa_operation *operation;
@@ -604,6 +667,10 @@ void QPulseAudioInput::userFeed()
 //    QTime now(QTime::currentTime());
 //    qDebug()<< now.second() << "s " << now.msec() << "ms :userFeed() IN";
 #endif
+    // Reads that left data behind are followed by queued calls.
+    if (sender() == m_timer)
+        m_jitterMeter.tick(qint64(m_timer->interval()) * 1000);
+
     deviceReady();
 }
 
@@ -641,6 +708,40 @@ qint64 QPulseAudioInput::elapsedUSecs() const
     return m_clockStamp.elapsed() * qint64(1000);
 }
 
+QAudioStatistics QPulseAudioInput::statistics() const
+{
+    QAudioStatistics statistics;
+    statistics.setOverrunCount(m_overrunCount.load());
+    statistics.setMaxCallbackJitterUSecs(m_jitterMeter.maxJitterUSecs());
+
+    if (!m_stream || !m_ringBuffer
+            || (m_deviceState != QAudio::ActiveState && m_deviceState != QAudio::IdleState)) {
+        return statistics;
+    }
+
+    QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
+    pulseEngine->lock();
+
+    // The latency covers the data still in the stream, the ring buffer
+    // holds data captured before that.
+    const int buffered = m_ringBuffer->used();
+    pa_usec_t latency = 0;
+    int negative = 0;
+    if (pa_stream_get_latency(m_stream, &latency, &negative) == 0) {
+        const qint64 streamLatency = negative ? 0 : qint64(latency);
+        statistics.setLatencyUSecs(streamLatency + qint64(pa_bytes_to_usec(buffered, &m_spec)));
+    }
+
+    // The part of the current fragment that was peeked is in the ring buffer already.
+    const size_t readable = pa_stream_readable_size(m_stream);
+    if (readable != size_t(-1))
+        statistics.setBytesBuffered(buffered + qMax(int(readable) - m_peekOffset, 0));
+
+    pulseEngine->unlock();
+
+    return statistics;
+}
+
 void QPulseAudioInput::reset()
 {
     stop();
@@ -57,10 +57,14 @@
 #include <QtCore/qstringlist.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qatomic.h>
 
 #include "qaudio.h"
 #include "qaudiodeviceinfo.h"
 #include "qaudiosystem.h"
+#include <private/qaudioringbuffer_p.h>
+#include <private/qaudiostatistics_p.h>
+#include <private/qaudiosystempluginext_p.h>
 
 #include <pulse/pulseaudio.h>
 
@@ -68,15 +72,17 @@ QT_BEGIN_NAMESPACE
 
 class PulseInputPrivate;
 
-class QPulseAudioInput : public QAbstractAudioInput
+class QPulseAudioInput : public QAbstractAudioInput, public QAudioStatisticsExtension
 {
     Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
 
 public:
     QPulseAudioInput(const QByteArray &device);
     ~QPulseAudioInput();
 
     qint64 read(char *data, qint64 len);
+    void fillRingBuffer();
 
     void start(QIODevice *device);
     QIODevice *start();
@@ -100,6 +106,8 @@ public:
     void setVolume(qreal volume);
     qreal volume() const;
 
+    QAudioStatistics statistics() const;
+
     qint64 m_totalTimeValue;
     QIODevice *m_audioSource;
     QAudioFormat m_format;
@@ -136,8 +144,15 @@ private:
     QTime m_clockStamp;
     QByteArray m_streamName;
     QByteArray m_device;
-    QByteArray m_tempBuffer;
+    QAudioRingBuffer *m_ringBuffer;
+    int m_peekOffset;
+    QAtomicInt m_backlog;
     pa_sample_spec m_spec;
+
+    // Updated from the mainloop thread
+    QAtomicInt m_overrunCount;
+    bool m_streamFull;
+    QAudioJitterMeter m_jitterMeter;
 };
 
 class PulseInputPrivate : public QIODevice
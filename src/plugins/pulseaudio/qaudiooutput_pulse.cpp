@@ -41,6 +41,7 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qmath.h>
 #include <private/qaudiohelpers_p.h>
+#include <private/qmultimediatrace_p.h>
 
 #include "qaudiooutput_pulse.h"
 #include "qaudiodeviceinfo_pulse.h"
@@ -97,8 +98,8 @@ static void outputStreamUnderflowCallback(pa_stream *stream, void *userdata)
 static void outputStreamOverflowCallback(pa_stream *stream, void *userdata)
 {
     Q_UNUSED(stream)
-    Q_UNUSED(userdata)
     qWarning() << "Got a buffer overflow!";
+    ((QPulseAudioOutput*)userdata)->streamOverflowCallback();
 }
 
 static void outputStreamLatencyCallback(pa_stream *stream, void *userdata)
@@ -211,11 +212,18 @@ QAudio::State QPulseAudioOutput::state() const
 void QPulseAudioOutput::streamUnderflowCallback()
 {
     if (m_deviceState != QAudio::IdleState && !m_resuming) {
+        Q_MULTIMEDIA_TRACE(QAudioOutput_underrun, this);
+        m_underrunCount.ref();
         setError(QAudio::UnderrunError);
         setState(QAudio::IdleState);
     }
 }
 
+void QPulseAudioOutput::streamOverflowCallback()
+{
+    m_overrunCount.ref();
+}
+
 void QPulseAudioOutput::start(QIODevice *device)
 {
     setState(QAudio::StoppedState);
@@ -228,6 +236,9 @@ void QPulseAudioOutput::start(QIODevice *device)
     m_audioSource = 0;
 
     close();
+    m_underrunCount.store(0);
+    m_overrunCount.store(0);
+    m_jitterMeter.reset();
 
     m_pullMode = true;
     m_audioSource = device;
@@ -252,6 +263,9 @@ QIODevice *QPulseAudioOutput::start()
     m_audioSource = 0;
 
     close();
+    m_underrunCount.store(0);
+    m_overrunCount.store(0);
+    m_jitterMeter.reset();
 
     m_pullMode = false;
 
@@ -331,7 +345,9 @@ bool QPulseAudioOutput::open()
     requestedBuffer.prebuf = (uint32_t)-1;
     requestedBuffer.tlength = m_bufferSize;
 
-    if (pa_stream_connect_playback(m_stream, m_device.data(), (m_bufferSize > 0) ? &requestedBuffer : NULL, (pa_stream_flags_t)0, NULL, NULL) < 0) {
+    // Timing updates let statistics() interpolate the latency without a round trip to the server.
+    const pa_stream_flags_t flags = pa_stream_flags_t(PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE);
+    if (pa_stream_connect_playback(m_stream, m_device.data(), (m_bufferSize > 0) ? &requestedBuffer : NULL, flags, NULL, NULL) < 0) {
         qWarning() << "pa_stream_connect_playback() failed!";
         pa_stream_unref(m_stream);
         m_stream = 0;
@@ -392,6 +408,7 @@ void QPulseAudioOutput::close()
         return;
 
     m_tickTimer->stop();
+    m_jitterMeter.pause();
 
     QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
 
@@ -435,8 +452,13 @@ void QPulseAudioOutput::userFeed()
 
     m_resuming = false;
 
+    // Writes that didn't fill PulseAudio's request are followed by queued calls.
+    if (sender() == m_tickTimer)
+        m_jitterMeter.tick(qint64(m_tickTimer->interval()) * 1000);
+
     if (m_pullMode) {
         int writableSize = bytesFree();
+        Q_MULTIMEDIA_TRACE(QAudioOutput_userFeed, this, writableSize);
         int chunks = writableSize / m_periodSize;
         if (chunks == 0)
             return;
@@ -480,7 +502,8 @@ qint64 QPulseAudioOutput::write(const char *data, qint64 len)
 
     pulseEngine->lock();
 
-    len = qMin(len, static_cast<qint64>(pa_stream_writable_size(m_stream)));
+    const qint64 writableSize = static_cast<qint64>(pa_stream_writable_size(m_stream));
+    len = qMin(len, writableSize);
 
     if (m_volume < 1.0f) {
         // Don't use PulseAudio volume, as it might affect all other streams of the same category
@@ -507,6 +530,8 @@ qint64 QPulseAudioOutput::write(const char *data, qint64 len)
     }
 
     pulseEngine->unlock();
+    // bytesFree() would take the mainloop lock again.
+    Q_MULTIMEDIA_TRACE(QAudioOutput_write, this, len, writableSize - len);
     m_totalTimeValue += len;
 
     setError(QAudio::NoError);
@@ -598,6 +623,32 @@ void QPulseAudioOutput::resume()
     }
 }
 
+QAudioStatistics QPulseAudioOutput::statistics() const
+{
+    QAudioStatistics statistics;
+    statistics.setUnderrunCount(m_underrunCount.load());
+    statistics.setOverrunCount(m_overrunCount.load());
+    statistics.setMaxCallbackJitterUSecs(m_jitterMeter.maxJitterUSecs());
+
+    if (!m_stream || (m_deviceState != QAudio::ActiveState && m_deviceState != QAudio::IdleState))
+        return statistics;
+
+    QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
+    pulseEngine->lock();
+
+    // Covers what is buffered in the server and the sink's own latency.
+    pa_usec_t latency = 0;
+    int negative = 0;
+    if (pa_stream_get_latency(m_stream, &latency, &negative) == 0)
+        statistics.setLatencyUSecs(negative ? 0 : qint64(latency));
+
+    statistics.setBytesBuffered(qMax(m_bufferSize - int(pa_stream_writable_size(m_stream)), 0));
+
+    pulseEngine->unlock();
+
+    return statistics;
+}
+
 void QPulseAudioOutput::setFormat(const QAudioFormat &format)
 {
     m_format = format;
@@ -615,6 +666,7 @@ void QPulseAudioOutput::suspend()
         setState(QAudio::SuspendedState);
 
         m_tickTimer->stop();
+        m_jitterMeter.pause();
 
         QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
         pa_operation *operation;
@@ -57,19 +57,23 @@
 #include <QtCore/qstringlist.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qatomic.h>
 
 #include "qaudio.h"
 #include "qaudiodeviceinfo.h"
 #include "qaudiosystem.h"
+#include <private/qaudiostatistics_p.h>
+#include <private/qaudiosystempluginext_p.h>
 
 #include <pulse/pulseaudio.h>
 
 QT_BEGIN_NAMESPACE
 
-class QPulseAudioOutput : public QAbstractAudioOutput
+class QPulseAudioOutput : public QAbstractAudioOutput, public QAudioStatisticsExtension
 {
     friend class PulseOutputPrivate;
     Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
 
 public:
     QPulseAudioOutput(const QByteArray &device);
@@ -100,8 +104,11 @@ public:
     void setCategory(const QString &category);
     QString category() const;
 
+    QAudioStatistics statistics() const;
+
 public:
     void streamUnderflowCallback();
+    void streamOverflowCallback();
 
 private:
     void setState(QAudio::State state);
@@ -142,6 +149,11 @@ private:
 
     qreal m_volume;
     pa_sample_spec m_spec;
+
+    // Updated from the mainloop thread
+    QAtomicInt m_underrunCount;
+    QAtomicInt m_overrunCount;
+    QAudioJitterMeter m_jitterMeter;
 };
 
 class PulseOutputPrivate : public QIODevice
@@ -0,0 +1,264 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qdeclarativevideofilterpipeline_p.h"
+#include <QtMultimedia/qabstractvideofilter.h>
+#include <private/qabstractvideofilter_p.h>
+#include <private/qmultimediatrace_p.h>
+#include <QtCore/qrunnable.h>
+
+QT_BEGIN_NAMESPACE
+
+class QDeclarativeVideoFilterStageTask : public QRunnable
+{
+public:
+    QDeclarativeVideoFilterStageTask(QDeclarativeVideoFilterPipeline *pipeline, int stage)
+        : m_pipeline(pipeline), m_stage(stage) { }
+    void run() override { m_pipeline->runStage(m_stage); }
+private:
+    QDeclarativeVideoFilterPipeline *m_pipeline;
+    int m_stage;
+};
+
+class QDeclarativeVideoFilterRunnableDeleter : public QRunnable
+{
+public:
+    QDeclarativeVideoFilterRunnableDeleter(const QList<QVideoFilterRunnable *> &runnables)
+        : m_runnables(runnables) { }
+    void run() override {
+        for (QVideoFilterRunnable *runnable : qAsConst(m_runnables))
+            delete runnable;
+    }
+private:
+    QList<QVideoFilterRunnable *> m_runnables;
+};
+
+QDeclarativeVideoFilterPipeline::QDeclarativeVideoFilterPipeline(QObject *parent)
+    : QObject(parent)
+    , m_nextSequence(0)
+    , m_pendingFrames(0)
+    , m_lastInChain(false)
+{
+    m_threadPool.setExpiryTimeout(-1);
+    m_clock.start();
+}
+
+QDeclarativeVideoFilterPipeline::~QDeclarativeVideoFilterPipeline()
+{
+    clear();
+}
+
+QList<QAbstractVideoFilter *> QDeclarativeVideoFilterPipeline::filters() const
+{
+    QMutexLocker locker(&m_mutex);
+    QList<QAbstractVideoFilter *> filters;
+    for (const Stage &stage : m_stages)
+        filters.append(stage.filter);
+    return filters;
+}
+
+void QDeclarativeVideoFilterPipeline::setFilters(const QList<QAbstractVideoFilter *> &filters,
+                                                 bool lastInChain)
+{
+    clear();
+
+    QMutexLocker locker(&m_mutex);
+    m_stages.resize(filters.count());
+    for (int i = 0; i < filters.count(); ++i)
+        m_stages[i].filter = filters.at(i);
+    m_lastInChain = lastInChain;
+    m_threadPool.setMaxThreadCount(qMax(1, filters.count()));
+}
+
+void QDeclarativeVideoFilterPipeline::clear()
+{
+    // Stage tasks queue up their successors, waitForDone() covers all of them.
+    m_threadPool.waitForDone();
+
+    QMutexLocker locker(&m_mutex);
+    QList<QVideoFilterRunnable *> runnables;
+    for (const Stage &stage : qAsConst(m_stages)) {
+        if (stage.runnable)
+            runnables.append(stage.runnable);
+    }
+    m_stages.clear();
+    m_results.clear();
+    locker.unlock();
+
+    // The runnables were created on the worker threads, destroy them there as well.
+    if (!runnables.isEmpty()) {
+        m_threadPool.start(new QDeclarativeVideoFilterRunnableDeleter(runnables));
+        m_threadPool.waitForDone();
+    }
+}
+
+bool QDeclarativeVideoFilterPipeline::isEmpty() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stages.isEmpty();
+}
+
+int QDeclarativeVideoFilterPipeline::pendingFrameCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_pendingFrames;
+}
+
+bool QDeclarativeVideoFilterPipeline::submit(const QVideoFrame &frame,
+                                             const QVideoSurfaceFormat &format)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_stages.isEmpty())
+        return false;
+
+    int maximumPending = m_stages.first().filter->maximumPendingFrames();
+    for (const Stage &stage : qAsConst(m_stages))
+        maximumPending = qMin(maximumPending, stage.filter->maximumPendingFrames());
+
+    if (m_pendingFrames >= maximumPending) {
+        for (const Stage &stage : qAsConst(m_stages))
+            QAbstractVideoFilterPrivate::get(stage.filter)->recordDroppedFrame();
+        return false;
+    }
+
+    Job job;
+    job.frame = frame;
+    job.format = format;
+    job.startTime = frame.startTime();
+    job.endTime = frame.endTime();
+    job.queuedAt = m_clock.nsecsElapsed() / 1000;
+    job.sequence = m_nextSequence++;
+
+    ++m_pendingFrames;
+    m_stages[0].queue.enqueue(job);
+    scheduleStage(0);
+    return true;
+}
+
+QVideoFrame QDeclarativeVideoFilterPipeline::takeResult()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_results.isEmpty())
+        return QVideoFrame();
+
+    // Only the most recently submitted frame is of interest, older ones were
+    // superseded before the scene graph got to render them.
+    const QVideoFrame frame = m_results.last();
+    m_results.clear();
+    return frame;
+}
+
+void QDeclarativeVideoFilterPipeline::discardResults()
+{
+    QMutexLocker locker(&m_mutex);
+    m_results.clear();
+}
+
+void QDeclarativeVideoFilterPipeline::scheduleStage(int index)
+{
+    // Must be called with m_mutex locked.
+    Stage &stage = m_stages[index];
+    if (stage.busy || stage.queue.isEmpty())
+        return;
+
+    stage.busy = true;
+    m_threadPool.start(new QDeclarativeVideoFilterStageTask(this, index));
+}
+
+void QDeclarativeVideoFilterPipeline::runStage(int index)
+{
+    QMutexLocker locker(&m_mutex);
+    // The stage is marked busy, so neither the queue head nor the runnable are
+    // touched by anyone else while the lock is released below.
+    Job job = m_stages[index].queue.dequeue();
+    QAbstractVideoFilter *filter = m_stages[index].filter;
+    QVideoFilterRunnable *runnable = m_stages[index].runnable;
+    const bool lastInChain = m_lastInChain && index == m_stages.count() - 1;
+    locker.unlock();
+
+    if (filter->isActive()) {
+        if (!runnable)
+            runnable = filter->createFilterRunnable();
+
+        if (runnable) {
+            QVideoFilterRunnable::RunFlags flags = 0;
+            if (lastInChain)
+                flags |= QVideoFilterRunnable::LastInChain;
+
+            Q_MULTIMEDIA_TRACE(QVideoFilterRunnable_run_entry, runnable, job.startTime,
+                               pendingFrameCount());
+            QVideoFrame newFrame = runnable->run(&job.frame, job.format, flags);
+            Q_MULTIMEDIA_TRACE(QVideoFilterRunnable_run_exit, runnable, job.startTime);
+            if (newFrame.isValid() && newFrame != job.frame) {
+                // Attach the result to the timestamp of the frame it was computed from.
+                if (newFrame.startTime() < 0) {
+                    newFrame.setStartTime(job.startTime);
+                    newFrame.setEndTime(job.endTime);
+                }
+                job.frame = newFrame;
+            }
+
+            const qint64 now = m_clock.nsecsElapsed() / 1000;
+            QAbstractVideoFilterPrivate::get(filter)->recordProcessedFrame(now - job.queuedAt);
+        }
+    }
+
+    locker.relock();
+    m_stages[index].runnable = runnable;
+    m_stages[index].busy = false;
+
+    bool finished = false;
+    if (index + 1 < m_stages.count()) {
+        job.queuedAt = m_clock.nsecsElapsed() / 1000;
+        m_stages[index + 1].queue.enqueue(job);
+        scheduleStage(index + 1);
+    } else {
+        m_results.insert(job.sequence, job.frame);
+        --m_pendingFrames;
+        finished = true;
+    }
+    scheduleStage(index);
+    locker.unlock();
+
+    if (finished)
+        emit resultReady();
+}
+
+QT_END_NAMESPACE
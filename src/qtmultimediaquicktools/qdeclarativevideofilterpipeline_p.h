@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QDECLARATIVEVIDEOFILTERPIPELINE_P_H
+#define QDECLARATIVEVIDEOFILTERPIPELINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvector.h>
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/qvideosurfaceformat.h>
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractVideoFilter;
+class QVideoFilterRunnable;
+
+// Runs asynchronous video filters on a private thread pool. Every filter is a
+// pipeline stage processing one frame at a time, so consecutive stages work on
+// different frames concurrently.
+class QDeclarativeVideoFilterPipeline : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QDeclarativeVideoFilterPipeline(QObject *parent = nullptr);
+    ~QDeclarativeVideoFilterPipeline();
+
+    QList<QAbstractVideoFilter *> filters() const;
+    void setFilters(const QList<QAbstractVideoFilter *> &filters, bool lastInChain);
+    void clear();
+
+    bool isEmpty() const;
+    int pendingFrameCount() const;
+
+    bool submit(const QVideoFrame &frame, const QVideoSurfaceFormat &format);
+    QVideoFrame takeResult();
+    void discardResults();
+
+Q_SIGNALS:
+    void resultReady();
+
+private:
+    friend class QDeclarativeVideoFilterStageTask;
+
+    struct Job {
+        QVideoFrame frame;
+        QVideoSurfaceFormat format;
+        qint64 startTime;
+        qint64 endTime;
+        qint64 queuedAt;
+        quint64 sequence;
+    };
+
+    struct Stage {
+        QAbstractVideoFilter *filter = nullptr;
+        QVideoFilterRunnable *runnable = nullptr;
+        QQueue<Job> queue;
+        bool busy = false;
+    };
+
+    void scheduleStage(int index);
+    void runStage(int index);
+
+    mutable QMutex m_mutex;
+    QThreadPool m_threadPool;
+    QElapsedTimer m_clock;
+    QVector<Stage> m_stages;
+    // Keyed by submission order, timestamps can be missing or repeat.
+    QMap<quint64, QVideoFrame> m_results;
+    quint64 m_nextSequence;
+    int m_pendingFrames;
+    bool m_lastInChain;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDECLARATIVEVIDEOFILTERPIPELINE_P_H
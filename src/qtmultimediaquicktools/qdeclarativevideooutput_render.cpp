@@ -41,15 +41,18 @@
 #include "qdeclarativevideooutput_render_p.h"
 #include "qdeclarativevideooutput_p.h"
 #include <QtMultimedia/qabstractvideofilter.h>
+#include <private/qabstractvideofilter_p.h>
 #include <QtMultimedia/qvideorenderercontrol.h>
 #include <QtMultimedia/qmediaservice.h>
 #include <QtCore/qloggingcategory.h>
 #include <private/qmediapluginloader_p.h>
 #include <private/qsgvideonode_p.h>
+#include <private/qmultimediatrace_p.h>
 
 #include <QtGui/QOpenGLContext>
 #include <QtQuick/QQuickWindow>
 #include <QtCore/QRunnable>
+#include <QtCore/QElapsedTimer>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,6 +69,8 @@ QDeclarativeVideoRendererBackend::QDeclarativeVideoRendererBackend(QDeclarativeV
     m_surface = new QSGVideoItemSurface(this);
     QObject::connect(m_surface, SIGNAL(surfaceFormatChanged(QVideoSurfaceFormat)),
                      q, SLOT(_q_updateNativeSize()), Qt::QueuedConnection);
+    QObject::connect(&m_filterPipeline, SIGNAL(resultReady()),
+                     q, SLOT(update()), Qt::QueuedConnection);
 
     // Prioritize the plugin requested by the environment
     QString requestedVideoNode = QString::fromLatin1(qgetenv("QT_VIDEONODE"));
@@ -121,9 +126,36 @@ void QDeclarativeVideoRendererBackend::appendFilter(QAbstractVideoFilter *filter
 
 void QDeclarativeVideoRendererBackend::clearFilters()
 {
-    QMutexLocker lock(&m_frameMutex);
-    scheduleDeleteFilterResources();
-    m_filters.clear();
+    QMutexLocker pipelineLock(&m_filterPipelineMutex);
+    {
+        QMutexLocker lock(&m_frameMutex);
+        scheduleDeleteFilterResources();
+        m_filters.clear();
+    }
+    m_filterPipeline.clear();
+}
+
+bool QDeclarativeVideoRendererBackend::updateFilterPipeline()
+{
+    // Must be called with m_filterPipelineMutex locked. Active asynchronous
+    // filters run in the pipeline, in list order, before the synchronous ones.
+    QList<QAbstractVideoFilter *> filters;
+    bool lastInChain = false;
+    {
+        QMutexLocker lock(&m_frameMutex);
+        for (const Filter &f : qAsConst(m_filters)) {
+            if (f.filter && f.filter->isActive() && f.filter->isAsynchronous())
+                filters.append(f.filter);
+        }
+        lastInChain = !filters.isEmpty() && filters.last() == m_filters.last().filter;
+    }
+
+    // Replacing the filters waits for the running ones, the render thread
+    // mustn't be blocked on m_frameMutex meanwhile.
+    if (filters != m_filterPipeline.filters())
+        m_filterPipeline.setFilters(filters, lastInChain);
+
+    return !filters.isEmpty();
 }
 
 class FilterRunnableDeleter : public QRunnable
@@ -278,6 +310,9 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
 
     QMutexLocker lock(&m_frameMutex);
 
+    Q_MULTIMEDIA_TRACE(QDeclarativeVideoRendererBackend_updatePaintNode_entry, this,
+                       m_frame.startTime(), m_filterPipeline.pendingFrameCount());
+
     if (!m_glContext) {
         m_glContext = QOpenGLContext::currentContext();
         m_surface->scheduleOpenGLContextUpdate();
@@ -291,6 +326,14 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
     }
 
     bool isFrameModified = false;
+    // Pick up the most recent result of the asynchronous filters, if any.
+    const QVideoFrame filteredFrame = m_filterPipeline.takeResult();
+    if (filteredFrame.isValid()) {
+        m_frame = filteredFrame;
+        m_frameChanged = true;
+        isFrameModified = true;
+    }
+
     if (m_frameChanged) {
         // Run the VideoFilter if there is one. This must be done before potentially changing the videonode below.
         if (m_frame.isValid() && !m_filters.isEmpty()) {
@@ -298,7 +341,7 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
             for (int i = 0; i < m_filters.count(); ++i) {
                 QAbstractVideoFilter *filter = m_filters[i].filter;
                 QVideoFilterRunnable *&runnable = m_filters[i].runnable;
-                if (filter && filter->isActive()) {
+                if (filter && filter->isActive() && !filter->isAsynchronous()) {
                     // Create the filter runnable if not yet done. Ownership is taken and is tied to this thread, on which rendering happens.
                     if (!runnable)
                         runnable = filter->createFilterRunnable();
@@ -309,7 +352,12 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
                     if (i == m_filters.count() - 1)
                         flags |= QVideoFilterRunnable::LastInChain;
 
+                    QElapsedTimer timer;
+                    timer.start();
+                    Q_MULTIMEDIA_TRACE(QVideoFilterRunnable_run_entry, runnable, m_frame.startTime(), 0);
                     QVideoFrame newFrame = runnable->run(&m_frame, surfaceFormat, flags);
+                    Q_MULTIMEDIA_TRACE(QVideoFilterRunnable_run_exit, runnable, m_frame.startTime());
+                    QAbstractVideoFilterPrivate::get(filter)->recordProcessedFrame(timer.nsecsElapsed() / 1000);
 
                     if (newFrame.isValid() && newFrame != m_frame) {
                         isFrameModified = true;
@@ -328,6 +376,7 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
         if (!m_frame.isValid()) {
             qCDebug(qLcVideo) << "updatePaintNode: no frames yet";
             m_frameChanged = false;
+            Q_MULTIMEDIA_TRACE(QDeclarativeVideoRendererBackend_updatePaintNode_exit, this, 0);
             return 0;
         }
 
@@ -356,6 +405,7 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
     if (!videoNode) {
         m_frameChanged = false;
         m_frame = QVideoFrame();
+        Q_MULTIMEDIA_TRACE(QDeclarativeVideoRendererBackend_updatePaintNode_exit, this, 0);
         return 0;
     }
 
@@ -371,6 +421,7 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
         m_frameChanged = false;
         m_frame = QVideoFrame();
     }
+    Q_MULTIMEDIA_TRACE(QDeclarativeVideoRendererBackend_updatePaintNode_exit, this, 1);
     return videoNode;
 }
 
@@ -402,6 +453,22 @@ QOpenGLContext *QDeclarativeVideoRendererBackend::glContext() const
 
 void QDeclarativeVideoRendererBackend::present(const QVideoFrame &frame)
 {
+    Q_MULTIMEDIA_TRACE(QAbstractVideoSurface_present, m_surface, frame.startTime(),
+                       frame.pixelFormat(), frame.width(), frame.height());
+
+    m_filterPipelineMutex.lock();
+    if (frame.isValid() && updateFilterPipeline()) {
+        // The frame is presented once the asynchronous filters are done with it,
+        // the pipeline schedules the update.
+        m_filterPipeline.submit(frame, m_surface->surfaceFormat());
+        m_filterPipelineMutex.unlock();
+        return;
+    }
+
+    if (!frame.isValid())
+        m_filterPipeline.clear();
+    m_filterPipelineMutex.unlock();
+
     m_frameMutex.lock();
     m_frame = frame;
     m_frameChanged = true;
@@ -56,6 +56,7 @@
 #include <private/qsgvideonode_yuv_p.h>
 #include <private/qsgvideonode_rgb_p.h>
 #include <private/qsgvideonode_texture_p.h>
+#include "qdeclarativevideofilterpipeline_p.h"
 
 #include <QtCore/qmutex.h>
 #include <QtMultimedia/qabstractvideosurface.h>
@@ -96,6 +97,7 @@ public:
 
 private:
     void scheduleDeleteFilterResources();
+    bool updateFilterPipeline();
 
     QPointer<QVideoRendererControl> m_rendererControl;
     QList<QSGVideoNodeFactoryInterface*> m_videoNodeFactories;
@@ -107,6 +109,9 @@ private:
     QSGVideoNodeFactory_RGB m_rgbFactory;
     QSGVideoNodeFactory_Texture m_textureFactory;
     QMutex m_frameMutex;
+    // Serializes reconfiguring and feeding the filter pipeline, which waits for
+    // the running filters, so that m_frameMutex isn't held meanwhile.
+    QMutex m_filterPipelineMutex;
     QRectF m_renderedRect;         // Destination pixel coordinates, clipped
     QRectF m_sourceTextureRect;    // Source texture coordinates
 
@@ -117,6 +122,7 @@ private:
         QVideoFilterRunnable *runnable;
     };
     QList<Filter> m_filters;
+    QDeclarativeVideoFilterPipeline m_filterPipeline;
 };
 
 class QSGVideoItemSurface : public QAbstractVideoSurface
@@ -65,6 +65,21 @@
 #ifndef GL_TEXTURE_SWIZZLE_A
 #define GL_TEXTURE_SWIZZLE_A 0x8E45
 #endif
+#ifndef GL_R16
+#define GL_R16 0x822A
+#endif
+#ifndef GL_RG16
+#define GL_RG16 0x822C
+#endif
+#ifndef GL_LUMINANCE16
+#define GL_LUMINANCE16 0x8042
+#endif
+#ifndef GL_LUMINANCE16_ALPHA16
+#define GL_LUMINANCE16_ALPHA16 0x8048
+#endif
+#ifndef GL_UNPACK_SWAP_BYTES
+#define GL_UNPACK_SWAP_BYTES 0x0CF0
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -76,7 +91,12 @@ QList<QVideoFrame::PixelFormat> QSGVideoNodeFactory_YUV::supportedPixelFormats(
     if (handleType == QAbstractVideoBuffer::NoHandle) {
         formats << QVideoFrame::Format_YUV420P << QVideoFrame::Format_YV12
                 << QVideoFrame::Format_NV12 << QVideoFrame::Format_NV21
-                << QVideoFrame::Format_UYVY << QVideoFrame::Format_YUYV;
+                << QVideoFrame::Format_UYVY << QVideoFrame::Format_YUYV
+                << QVideoFrame::Format_IMC1 << QVideoFrame::Format_IMC2
+                << QVideoFrame::Format_IMC3 << QVideoFrame::Format_IMC4
+                << QVideoFrame::Format_AYUV444 << QVideoFrame::Format_YUV444
+                << QVideoFrame::Format_Y8 << QVideoFrame::Format_Y16
+                << QVideoFrame::Format_P010 << QVideoFrame::Format_P016;
     }
 
     return formats;
@@ -193,6 +213,64 @@ public:
 };
 
 
+class QSGVideoMaterialShader_YUV_BiPlanar_16bit : public QSGVideoMaterialShader_YUV_BiPlanar
+{
+public:
+    QSGVideoMaterialShader_YUV_BiPlanar_16bit()
+        : QSGVideoMaterialShader_YUV_BiPlanar()
+    {
+        setShaderSourceFile(QOpenGLShader::Fragment, QStringLiteral(":/qtmultimediaquicktools/shaders/biplanaryuvvideo_16bit.frag"));
+    }
+
+    void updateState(const RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
+
+protected:
+    void initialize() override {
+        m_id_yWeights = program()->uniformLocation("yWeights");
+        m_id_uWeights = program()->uniformLocation("uWeights");
+        m_id_vWeights = program()->uniformLocation("vWeights");
+        QSGVideoMaterialShader_YUV_BiPlanar::initialize();
+    }
+
+    int m_id_yWeights;
+    int m_id_uWeights;
+    int m_id_vWeights;
+};
+
+
+class QSGVideoMaterialShader_Y : public QSGVideoMaterialShader_YUV_BiPlanar_16bit
+{
+public:
+    QSGVideoMaterialShader_Y()
+        : QSGVideoMaterialShader_YUV_BiPlanar_16bit()
+    {
+        setShaderSourceFile(QOpenGLShader::Fragment, QStringLiteral(":/qtmultimediaquicktools/shaders/yvideo.frag"));
+    }
+};
+
+
+class QSGVideoMaterialShader_AYUV : public QSGVideoMaterialShader_YUV_BiPlanar
+{
+public:
+    QSGVideoMaterialShader_AYUV()
+        : QSGVideoMaterialShader_YUV_BiPlanar()
+    {
+        setShaderSourceFile(QOpenGLShader::Fragment, QStringLiteral(":/qtmultimediaquicktools/shaders/ayuvvideo.frag"));
+    }
+};
+
+
+class QSGVideoMaterialShader_YUV444 : public QSGVideoMaterialShader_YUV_BiPlanar
+{
+public:
+    QSGVideoMaterialShader_YUV444()
+        : QSGVideoMaterialShader_YUV_BiPlanar()
+    {
+        setShaderSourceFile(QOpenGLShader::Fragment, QStringLiteral(":/qtmultimediaquicktools/shaders/yuv444video.frag"));
+    }
+};
+
+
 class QSGVideoMaterialShader_YUV_TriPlanar : public QSGVideoMaterialShader_YUV_BiPlanar
 {
 public:
@@ -209,11 +287,15 @@ protected:
     void initialize() override {
         m_id_plane3Width = program()->uniformLocation("plane3Width");
         m_id_plane3Texture = program()->uniformLocation("plane3Texture");
+        m_id_plane2Offset = program()->uniformLocation("plane2Offset");
+        m_id_plane3Offset = program()->uniformLocation("plane3Offset");
         QSGVideoMaterialShader_YUV_BiPlanar::initialize();
     }
 
     int m_id_plane3Width;
     int m_id_plane3Texture;
+    int m_id_plane2Offset;
+    int m_id_plane3Offset;
 };
 
 
@@ -224,18 +306,29 @@ public:
     ~QSGVideoMaterial_YUV();
 
     QSGMaterialType *type() const override {
-        static QSGMaterialType biPlanarType, biPlanarSwizzleType, triPlanarType, uyvyType, yuyvType;
+        static QSGMaterialType biPlanarType, biPlanarSwizzleType, biPlanar16bitType, triPlanarType,
+                uyvyType, yuyvType, ayuvType, yuv444Type, yType;
 
         switch (m_format.pixelFormat()) {
         case QVideoFrame::Format_NV12:
             return &biPlanarType;
         case QVideoFrame::Format_NV21:
             return &biPlanarSwizzleType;
+        case QVideoFrame::Format_P010:
+        case QVideoFrame::Format_P016:
+            return &biPlanar16bitType;
         case QVideoFrame::Format_UYVY:
             return &uyvyType;
         case QVideoFrame::Format_YUYV:
             return &yuyvType;
-        default: // Currently: YUV420P and YV12
+        case QVideoFrame::Format_AYUV444:
+            return &ayuvType;
+        case QVideoFrame::Format_YUV444:
+            return &yuv444Type;
+        case QVideoFrame::Format_Y8:
+        case QVideoFrame::Format_Y16:
+            return &yType;
+        default: // Currently: YUV420P, YV12 and IMC1 to IMC4
             return &triPlanarType;
         }
     }
@@ -246,11 +339,21 @@ public:
             return new QSGVideoMaterialShader_YUV_BiPlanar;
         case QVideoFrame::Format_NV21:
             return new QSGVideoMaterialShader_YUV_BiPlanar_swizzle;
+        case QVideoFrame::Format_P010:
+        case QVideoFrame::Format_P016:
+            return new QSGVideoMaterialShader_YUV_BiPlanar_16bit;
         case QVideoFrame::Format_UYVY:
             return new QSGVideoMaterialShader_UYVY;
         case QVideoFrame::Format_YUYV:
             return new QSGVideoMaterialShader_YUYV;
-        default: // Currently: YUV420P and YV12
+        case QVideoFrame::Format_AYUV444:
+            return new QSGVideoMaterialShader_AYUV;
+        case QVideoFrame::Format_YUV444:
+            return new QSGVideoMaterialShader_YUV444;
+        case QVideoFrame::Format_Y8:
+        case QVideoFrame::Format_Y16:
+            return new QSGVideoMaterialShader_Y;
+        default: // Currently: YUV420P, YV12 and IMC1 to IMC4
             return new QSGVideoMaterialShader_YUV_TriPlanar;
         }
     }
@@ -279,14 +382,24 @@ public:
     }
 
     void bind();
-    void bindTexture(int id, int w, int h, const uchar *bits, GLenum format);
+    void bindTexture(int id, int w, int h, const uchar *bits, GLenum format,
+                     GLenum internalFormat = 0, GLenum type = GL_UNSIGNED_BYTE);
+    void bind16BitTextures(bool planar, int fw, int fh);
 
     QVideoSurfaceFormat m_format;
     QSize m_textureSize;
     int m_planeCount;
+    int m_textureCount;
+    bool m_hasAlpha;
 
     GLuint m_textureIds[3];
     GLfloat m_planeWidth[3];
+    GLfloat m_planeOffset[3];
+
+    // Selects the components of each texture that make up the Y, U and V samples.
+    QVector4D m_yWeights;
+    QVector4D m_uWeights;
+    QVector4D m_vWeights;
 
     qreal m_opacity;
     QMatrix4x4 m_colorMatrix;
@@ -297,17 +410,34 @@ public:
 
 QSGVideoMaterial_YUV::QSGVideoMaterial_YUV(const QVideoSurfaceFormat &format) :
     m_format(format),
+    m_hasAlpha(format.pixelFormat() == QVideoFrame::Format_AYUV444),
+    m_yWeights(1, 0, 0, 0),
+    m_uWeights(1, 0, 0, 0),
+    m_vWeights(0, 0, 0, 1),
     m_opacity(1.0)
 {
     memset(m_textureIds, 0, sizeof(m_textureIds));
+    memset(m_planeOffset, 0, sizeof(m_planeOffset));
 
     switch (format.pixelFormat()) {
+    case QVideoFrame::Format_AYUV444:
+    case QVideoFrame::Format_YUV444:
+    case QVideoFrame::Format_Y8:
+    case QVideoFrame::Format_Y16:
+        m_planeCount = 1;
+        break;
     case QVideoFrame::Format_NV12:
     case QVideoFrame::Format_NV21:
+    case QVideoFrame::Format_P010:
+    case QVideoFrame::Format_P016:
         m_planeCount = 2;
         break;
     case QVideoFrame::Format_YUV420P:
     case QVideoFrame::Format_YV12:
+    case QVideoFrame::Format_IMC1:
+    case QVideoFrame::Format_IMC2:
+    case QVideoFrame::Format_IMC3:
+    case QVideoFrame::Format_IMC4:
         m_planeCount = 3;
         break;
     case QVideoFrame::Format_UYVY:
@@ -317,6 +447,10 @@ QSGVideoMaterial_YUV::QSGVideoMaterial_YUV(const QVideoSurfaceFormat &format) :
         break;
     }
 
+    // The U and V lines of IMC2 and IMC4 share a texture, sampled at different offsets.
+    m_textureCount = format.pixelFormat() == QVideoFrame::Format_IMC2
+            || format.pixelFormat() == QVideoFrame::Format_IMC4 ? 2 : m_planeCount;
+
     switch (format.yCbCrColorSpace()) {
     case QVideoSurfaceFormat::YCbCr_JPEG:
         m_colorMatrix = QMatrix4x4(
@@ -341,14 +475,14 @@ QSGVideoMaterial_YUV::QSGVideoMaterial_YUV(const QVideoSurfaceFormat &format) :
                     0.0f,    0.000f,  0.000f,  1.0000f);
     }
 
-    setFlag(Blending, false);
+    setFlag(Blending, m_hasAlpha);
 }
 
 QSGVideoMaterial_YUV::~QSGVideoMaterial_YUV()
 {
     if (!m_textureSize.isEmpty()) {
         if (QOpenGLContext *current = QOpenGLContext::currentContext())
-            current->functions()->glDeleteTextures(m_planeCount, m_textureIds);
+            current->functions()->glDeleteTextures(m_textureCount, m_textureIds);
         else
             qWarning() << "QSGVideoMaterial_YUV: Cannot obtain GL context, unable to delete textures";
     }
@@ -368,8 +502,10 @@ void QSGVideoMaterial_YUV::bind()
             // Frame has changed size, recreate textures...
             if (m_textureSize != m_frame.size()) {
                 if (!m_textureSize.isEmpty())
-                    functions->glDeleteTextures(m_planeCount, m_textureIds);
-                functions->glGenTextures(m_planeCount, m_textureIds);
+                    functions->glDeleteTextures(m_textureCount, m_textureIds);
+                functions->glGenTextures(m_textureCount, m_textureIds);
+                if (m_textureCount < m_planeCount)
+                    m_textureIds[2] = m_textureIds[1];
                 m_textureSize = m_frame.size();
             }
 
@@ -408,10 +544,45 @@ void QSGVideoMaterial_YUV::bind()
                 functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
                 bindTexture(m_textureIds[0], m_frame.bytesPerLine(y), fh, m_frame.bits(y), texFormat1);
 
-            } else { // YUV420P || YV12
+            } else if (m_format.pixelFormat() == QVideoFrame::Format_P010
+                    || m_format.pixelFormat() == QVideoFrame::Format_P016) {
+                bind16BitTextures(true, fw, fh);
+            } else if (m_format.pixelFormat() == QVideoFrame::Format_Y16) {
+                bind16BitTextures(false, fw, fh);
+            } else if (m_format.pixelFormat() == QVideoFrame::Format_Y8) {
+                m_planeWidth[0] = qreal(fw) / m_frame.bytesPerLine(0);
+                bindTexture(m_textureIds[0], m_frame.bytesPerLine(0), fh, m_frame.bits(0), texFormat1);
+            } else if (m_format.pixelFormat() == QVideoFrame::Format_AYUV444) {
+                m_planeWidth[0] = qreal(fw) / (m_frame.bytesPerLine(0) / 4);
+                bindTexture(m_textureIds[0], m_frame.bytesPerLine(0) / 4, fh, m_frame.bits(0), GL_RGBA);
+            } else if (m_format.pixelFormat() == QVideoFrame::Format_YUV444) {
+                // Lines padded to 4 bytes match the unpack alignment of a texture a third as wide.
+                const int bytesPerLine = m_frame.bytesPerLine(0);
+                m_planeWidth[0] = qreal(fw) / (bytesPerLine / 3);
+                functions->glPixelStorei(GL_UNPACK_ALIGNMENT, bytesPerLine % 4 == 0 ? 4 : 1);
+                bindTexture(m_textureIds[0], bytesPerLine / 3, fh, m_frame.bits(0), GL_RGB);
+            } else if (m_format.pixelFormat() == QVideoFrame::Format_IMC2
+                    || m_format.pixelFormat() == QVideoFrame::Format_IMC4) {
+                // Each line of the second plane holds a line of U and a line of V side by side.
+                const bool uFirst = m_frame.pixelFormat() == QVideoFrame::Format_IMC2;
+
+                m_planeWidth[0] = qreal(fw) / m_frame.bytesPerLine(0);
+                m_planeWidth[1] = m_planeWidth[2] = qreal(fw) / (2 * m_frame.bytesPerLine(1));
+                m_planeOffset[1] = uFirst ? 0 : 0.5;
+                m_planeOffset[2] = uFirst ? 0.5 : 0;
+
+                functions->glActiveTexture(GL_TEXTURE1);
+                bindTexture(m_textureIds[1], m_frame.bytesPerLine(1), fh / 2, m_frame.bits(1), texFormat1);
+                functions->glActiveTexture(GL_TEXTURE2);
+                functions->glBindTexture(GL_TEXTURE_2D, m_textureIds[2]);
+                functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
+                bindTexture(m_textureIds[0], m_frame.bytesPerLine(0), fh, m_frame.bits(0), texFormat1);
+            } else { // YUV420P || YV12 || IMC1 || IMC3
                 const int y = 0;
-                const int u = m_frame.pixelFormat() == QVideoFrame::Format_YUV420P ? 1 : 2;
-                const int v = m_frame.pixelFormat() == QVideoFrame::Format_YUV420P ? 2 : 1;
+                const bool uFirst = m_frame.pixelFormat() == QVideoFrame::Format_YUV420P
+                        || m_frame.pixelFormat() == QVideoFrame::Format_IMC1;
+                const int u = uFirst ? 1 : 2;
+                const int v = uFirst ? 2 : 1;
 
                 m_planeWidth[0] = qreal(fw) / m_frame.bytesPerLine(y);
                 m_planeWidth[1] = m_planeWidth[2] = qreal(fw) / (2 * m_frame.bytesPerLine(u));
@@ -438,11 +609,64 @@ void QSGVideoMaterial_YUV::bind()
     }
 }
 
-void QSGVideoMaterial_YUV::bindTexture(int id, int w, int h, const uchar *bits, GLenum format)
+void QSGVideoMaterial_YUV::bind16BitTextures(bool planar, int fw, int fh)
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    QOpenGLFunctions *functions = context->functions();
+    const bool coreProfile = context->format().profile() == QSurfaceFormat::CoreProfile;
+    const int y = 0;
+    const int uv = 1;
+
+    // Samples are 16-bit little endian, planar UV has a U and a V sample per texel.
+    m_planeWidth[0] = qreal(fw) / (m_frame.bytesPerLine(y) / 2);
+    if (planar)
+        m_planeWidth[1] = qreal(fw / 2) / (m_frame.bytesPerLine(uv) / 4);
+
+    if (!context->isOpenGLES()) {
+        m_yWeights = m_uWeights = QVector4D(1, 0, 0, 0);
+        m_vWeights = QVector4D(0, 0, 0, 1);
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        functions->glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_TRUE);
+#endif
+        if (planar) {
+            functions->glActiveTexture(GL_TEXTURE1);
+            bindTexture(m_textureIds[1], m_frame.bytesPerLine(uv) / 4, fh / 2, m_frame.bits(uv),
+                        coreProfile ? GL_RG : GL_LUMINANCE_ALPHA,
+                        coreProfile ? GL_RG16 : GL_LUMINANCE16_ALPHA16, GL_UNSIGNED_SHORT);
+            functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
+        }
+        bindTexture(m_textureIds[0], m_frame.bytesPerLine(y) / 2, fh, m_frame.bits(y),
+                    coreProfile ? GL_RED : GL_LUMINANCE,
+                    coreProfile ? GL_R16 : GL_LUMINANCE16, GL_UNSIGNED_SHORT);
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        functions->glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_FALSE);
+#endif
+    } else {
+        // OpenGL ES 2 has no normalized 16-bit textures, the low and the high byte of
+        // each sample land in separate 8-bit channels and are recombined in the shader.
+        const float low = 255.0f / 65535.0f;
+        const float high = 65280.0f / 65535.0f;
+        m_yWeights = QVector4D(low, 0, 0, high);
+        m_uWeights = QVector4D(low, high, 0, 0);
+        m_vWeights = QVector4D(0, 0, low, high);
+
+        if (planar) {
+            functions->glActiveTexture(GL_TEXTURE1);
+            bindTexture(m_textureIds[1], m_frame.bytesPerLine(uv) / 4, fh / 2, m_frame.bits(uv), GL_RGBA);
+            functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
+        }
+        bindTexture(m_textureIds[0], m_frame.bytesPerLine(y) / 2, fh, m_frame.bits(y), GL_LUMINANCE_ALPHA);
+    }
+}
+
+void QSGVideoMaterial_YUV::bindTexture(int id, int w, int h, const uchar *bits, GLenum format,
+                                       GLenum internalFormat, GLenum type)
 {
     QOpenGLFunctions *functions = QOpenGLContext::currentContext()->functions();
     functions->glBindTexture(GL_TEXTURE_2D, id);
-    functions->glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, bits);
+    functions->glTexImage2D(GL_TEXTURE_2D, 0, internalFormat ? internalFormat : format,
+                            w, h, 0, format, type, bits);
     // replacement for GL_LUMINANCE_ALPHA in core profile
     if (format == GL_RG) {
         functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
@@ -506,6 +730,20 @@ void QSGVideoMaterialShader_YUV_TriPlanar::updateState(const RenderState &state,
     QSGVideoMaterial_YUV *mat = static_cast<QSGVideoMaterial_YUV *>(newMaterial);
     program()->setUniformValue(m_id_plane3Texture, 2);
     program()->setUniformValue(m_id_plane3Width, mat->m_planeWidth[2]);
+    program()->setUniformValue(m_id_plane2Offset, mat->m_planeOffset[1]);
+    program()->setUniformValue(m_id_plane3Offset, mat->m_planeOffset[2]);
+}
+
+void QSGVideoMaterialShader_YUV_BiPlanar_16bit::updateState(const RenderState &state,
+                                                            QSGMaterial *newMaterial,
+                                                            QSGMaterial *oldMaterial)
+{
+    QSGVideoMaterialShader_YUV_BiPlanar::updateState(state, newMaterial, oldMaterial);
+
+    QSGVideoMaterial_YUV *mat = static_cast<QSGVideoMaterial_YUV *>(newMaterial);
+    program()->setUniformValue(m_id_yWeights, mat->m_yWeights);
+    program()->setUniformValue(m_id_uWeights, mat->m_uWeights);
+    program()->setUniformValue(m_id_vWeights, mat->m_vWeights);
 }
 
 void QSGVideoMaterialShader_UYVY::updateState(const RenderState &state,
@@ -17,6 +17,7 @@ PRIVATE_HEADERS += \
 HEADERS += \
     $$PRIVATE_HEADERS \
     qdeclarativevideooutput_render_p.h \
+    qdeclarativevideofilterpipeline_p.h \
     qdeclarativevideooutput_window_p.h \
     qsgvideonode_yuv_p.h \
     qsgvideonode_rgb_p.h \
@@ -26,6 +27,7 @@ SOURCES += \
     qsgvideonode_p.cpp \
     qdeclarativevideooutput.cpp \
     qdeclarativevideooutput_render.cpp \
+    qdeclarativevideofilterpipeline.cpp \
     qdeclarativevideooutput_window.cpp \
     qsgvideonode_yuv.cpp \
     qsgvideonode_rgb.cpp \
@@ -0,0 +1,11 @@
+uniform sampler2D plane1Texture; // AYUV passed as RGBA
+uniform mediump mat4 colorMatrix;
+uniform lowp float opacity;
+varying highp vec2 plane1TexCoord;
+
+void main()
+{
+    mediump vec4 AYUV = texture2D(plane1Texture, plane1TexCoord);
+    // Converting alpha * YUV gives premultiplied RGB, the offsets are scaled by the last component.
+    gl_FragColor = colorMatrix * vec4(AYUV.gba * AYUV.r, AYUV.r) * opacity;
+}
@@ -0,0 +1,12 @@
+#version 150 core
+uniform sampler2D plane1Texture; // AYUV passed as RGBA
+uniform mat4 colorMatrix;
+uniform float opacity;
+in vec2 plane1TexCoord;
+out vec4 fragColor;
+
+void main()
+{
+    vec4 AYUV = texture(plane1Texture, plane1TexCoord);
+    fragColor = colorMatrix * vec4(AYUV.gba * AYUV.r, AYUV.r) * opacity;
+}
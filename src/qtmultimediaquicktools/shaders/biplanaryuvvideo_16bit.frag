@@ -0,0 +1,17 @@
+uniform sampler2D plane1Texture;
+uniform sampler2D plane2Texture;
+uniform mediump vec4 yWeights; // Combines the bytes of 16-bit samples uploaded as 8-bit channels
+uniform mediump vec4 uWeights;
+uniform mediump vec4 vWeights;
+uniform mediump mat4 colorMatrix;
+uniform lowp float opacity;
+varying highp vec2 plane1TexCoord;
+varying highp vec2 plane2TexCoord;
+
+void main()
+{
+    mediump float Y = dot(texture2D(plane1Texture, plane1TexCoord), yWeights);
+    mediump vec4 UV = texture2D(plane2Texture, plane2TexCoord);
+    mediump vec4 color = vec4(Y, dot(UV, uWeights), dot(UV, vWeights), 1.);
+    gl_FragColor = colorMatrix * color * opacity;
+}
@@ -0,0 +1,19 @@
+#version 150 core
+uniform sampler2D plane1Texture;
+uniform sampler2D plane2Texture;
+uniform vec4 yWeights;
+uniform vec4 uWeights;
+uniform vec4 vWeights;
+uniform mat4 colorMatrix;
+uniform float opacity;
+in vec2 plane1TexCoord;
+in vec2 plane2TexCoord;
+out vec4 fragColor;
+
+void main()
+{
+    float Y = dot(texture(plane1Texture, plane1TexCoord), yWeights);
+    vec4 UV = texture(plane2Texture, plane2TexCoord);
+    vec4 color = vec4(Y, dot(UV, uWeights), dot(UV, vWeights), 1.);
+    fragColor = colorMatrix * color * opacity;
+}
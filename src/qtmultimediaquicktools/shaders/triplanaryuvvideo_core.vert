@@ -3,6 +3,8 @@ uniform mat4 qt_Matrix;
 uniform float plane1Width;
 uniform float plane2Width;
 uniform float plane3Width;
+uniform float plane2Offset;
+uniform float plane3Offset;
 in vec4 qt_VertexPosition;
 in vec2 qt_VertexTexCoord;
 out vec2 plane1TexCoord;
@@ -11,7 +13,7 @@ out vec2 plane3TexCoord;
 
 void main() {
     plane1TexCoord = qt_VertexTexCoord * vec2(plane1Width, 1);
-    plane2TexCoord = qt_VertexTexCoord * vec2(plane2Width, 1);
-    plane3TexCoord = qt_VertexTexCoord * vec2(plane3Width, 1);
+    plane2TexCoord = qt_VertexTexCoord * vec2(plane2Width, 1) + vec2(plane2Offset, 0);
+    plane3TexCoord = qt_VertexTexCoord * vec2(plane3Width, 1) + vec2(plane3Offset, 0);
     gl_Position = qt_Matrix * qt_VertexPosition;
 }
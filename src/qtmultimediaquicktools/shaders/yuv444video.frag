@@ -0,0 +1,10 @@
+uniform sampler2D plane1Texture; // YUV passed as RGB
+uniform mediump mat4 colorMatrix;
+uniform lowp float opacity;
+varying highp vec2 plane1TexCoord;
+
+void main()
+{
+    mediump vec3 YUV = texture2D(plane1Texture, plane1TexCoord).rgb;
+    gl_FragColor = colorMatrix * vec4(YUV, 1.) * opacity;
+}
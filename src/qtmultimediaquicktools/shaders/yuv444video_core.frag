@@ -0,0 +1,12 @@
+#version 150 core
+uniform sampler2D plane1Texture; // YUV passed as RGB
+uniform mat4 colorMatrix;
+uniform float opacity;
+in vec2 plane1TexCoord;
+out vec4 fragColor;
+
+void main()
+{
+    vec3 YUV = texture(plane1Texture, plane1TexCoord).rgb;
+    fragColor = colorMatrix * vec4(YUV, 1.) * opacity;
+}
@@ -0,0 +1,10 @@
+uniform sampler2D plane1Texture;
+uniform mediump vec4 yWeights; // Combines the bytes of 16-bit samples uploaded as two 8-bit channels
+uniform lowp float opacity;
+varying highp vec2 plane1TexCoord;
+
+void main()
+{
+    mediump float Y = dot(texture2D(plane1Texture, plane1TexCoord), yWeights);
+    gl_FragColor = vec4(Y, Y, Y, 1.) * opacity;
+}
@@ -0,0 +1,12 @@
+#version 150 core
+uniform sampler2D plane1Texture;
+uniform vec4 yWeights;
+uniform float opacity;
+in vec2 plane1TexCoord;
+out vec4 fragColor;
+
+void main()
+{
+    float Y = dot(texture(plane1Texture, plane1TexCoord), yWeights);
+    fragColor = vec4(Y, Y, Y, 1.) * opacity;
+}
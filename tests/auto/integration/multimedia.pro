@@ -16,4 +16,10 @@ qtHaveModule(quick) {
         qdeclarativevideooutput_window
 }
 
+qtHaveModule(multimediagsttools): \
+    SUBDIRS += qgstvideobuffer
+
+qtConfig(pulseaudio): \
+    SUBDIRS += qpulseaudioinput
+
 !qtHaveModule(widgets): SUBDIRS -= qcamerabackend
@@ -101,6 +101,8 @@ private slots:
     void volume_data();
     void volume();
 
+    void statistics();
+
 private:
     typedef QSharedPointer<QFile> FilePtr;
 
@@ -997,6 +999,50 @@ void tst_QAudioOutput::volume()
     QTRY_VERIFY(qRound(audioOutput.volume()*10.0f) == expectedInt);
 }
 
+void tst_QAudioOutput::statistics()
+{
+    QAudioOutput audioOutput(audioDevice.preferredFormat(), this);
+    QCOMPARE(audioOutput.statistics().underrunCount(), 0);
+
+    // Starve the device after the first period, which may cause underruns.
+    QIODevice *feed = audioOutput.start();
+    QVERIFY(feed);
+    feed->write(QByteArray(audioOutput.periodSize(), 0));
+    QTest::qWait(500);
+
+    QAudioStatistics statistics = audioOutput.statistics();
+    if (statistics.latencyUSecs() == -1)
+        QSKIP("The audio backend doesn't report statistics");
+    QVERIFY(statistics.latencyUSecs() >= 0);
+    QVERIFY(statistics.bytesBuffered() >= 0);
+    QVERIFY(statistics.underrunCount() >= 0);
+    // Every underrun reported as an error is counted.
+    if (audioOutput.error() == QAudio::UnderrunError)
+        QVERIFY(statistics.underrunCount() > 0);
+
+    audioOutput.stop();
+
+    // A pull mode source running dry is an underrun as well.
+    QBuffer source;
+    source.setData(QByteArray(audioOutput.periodSize(), 0));
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    audioOutput.start(&source);
+    QTRY_COMPARE(audioOutput.state(), QAudio::IdleState);
+    if (audioOutput.error() == QAudio::UnderrunError)
+        QVERIFY(audioOutput.statistics().underrunCount() > 0);
+
+    audioOutput.stop();
+
+    // The counters start over with every stream.
+    feed = audioOutput.start();
+    QVERIFY(feed);
+    statistics = audioOutput.statistics();
+    QCOMPARE(statistics.underrunCount(), 0);
+    QCOMPARE(statistics.maxCallbackJitterUSecs(), qint64(0));
+
+    audioOutput.stop();
+}
+
 QTEST_MAIN(tst_QAudioOutput)
 
 #include "tst_qaudiooutput.moc"
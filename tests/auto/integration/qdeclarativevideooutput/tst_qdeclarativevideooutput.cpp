@@ -32,6 +32,9 @@
 
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
+#include <QtQuick/qquickitem.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/qsgrendererinterface.h>
 
 #include "private/qdeclarativevideooutput_p.h"
 
@@ -110,6 +113,9 @@ private slots:
     void surfaceSource();
     void sourceRect();
 
+    void renderFormat();
+    void renderFormat_data();
+
     void contentRect();
     void contentRect_data();
 
@@ -389,6 +395,135 @@ void tst_QDeclarativeVideoOutput::sourceRect()
     delete videoOutput;
 }
 
+// Fills each plane of a frame with a repeated pattern of bytes.
+static QVideoFrame patternFrame(QVideoFrame::PixelFormat pixelFormat, const QSize &size,
+                                int bytes, int bytesPerLine, const QList<QByteArray> &planes)
+{
+    QVideoFrame frame(bytes, size, bytesPerLine, pixelFormat);
+    if (!frame.map(QAbstractVideoBuffer::WriteOnly) || frame.planeCount() != planes.count())
+        return QVideoFrame();
+
+    for (int plane = 0; plane < frame.planeCount(); ++plane) {
+        uchar *begin = frame.bits(plane);
+        uchar *end = plane + 1 < frame.planeCount() ? frame.bits(plane + 1) : frame.bits() + frame.mappedBytes();
+        const QByteArray &pattern = planes.at(plane);
+        for (uchar *data = begin; data < end; ++data)
+            *data = pattern.at((data - begin) % pattern.size());
+    }
+
+    frame.unmap();
+    return frame;
+}
+
+static QColor centerColor(QQuickWindow *window)
+{
+    const QImage image = window->grabWindow();
+    return image.pixelColor(image.width() / 2, image.height() / 2);
+}
+
+static bool fuzzyCompareColor(const QColor &actual, const QColor &expected)
+{
+    return qAbs(actual.red() - expected.red()) <= 8
+            && qAbs(actual.green() - expected.green()) <= 8
+            && qAbs(actual.blue() - expected.blue()) <= 8;
+}
+
+void tst_QDeclarativeVideoOutput::renderFormat_data()
+{
+    QTest::addColumn<QVideoFrame::PixelFormat>("pixelFormat");
+    QTest::addColumn<int>("bytes");
+    QTest::addColumn<int>("bytesPerLine");
+    QTest::addColumn<QList<QByteArray> >("planes");
+    QTest::addColumn<QColor>("expected");
+
+    // Y = 81, U = 90 and V = 240 is red in BT.601 video range.
+    const int w = 16;
+    const int h = 16;
+    const QColor red(255, 0, 0);
+    const QColor grey(128, 128, 128);
+    const QByteArray y(1, char(81));
+    const QByteArray u(1, char(90));
+    const QByteArray v(1, char(240));
+
+    QTest::newRow("YUV420P") << QVideoFrame::Format_YUV420P << w * h * 3 / 2 << w
+                             << (QList<QByteArray>() << y << u << v) << red;
+    QTest::newRow("YV12") << QVideoFrame::Format_YV12 << w * h * 3 / 2 << w
+                          << (QList<QByteArray>() << y << v << u) << red;
+    QTest::newRow("NV12") << QVideoFrame::Format_NV12 << w * h * 3 / 2 << w
+                          << (QList<QByteArray>() << y << u + v) << red;
+    QTest::newRow("NV21") << QVideoFrame::Format_NV21 << w * h * 3 / 2 << w
+                          << (QList<QByteArray>() << y << v + u) << red;
+    QTest::newRow("UYVY") << QVideoFrame::Format_UYVY << w * h * 2 << w * 2
+                          << (QList<QByteArray>() << u + y + v + y) << red;
+    QTest::newRow("YUYV") << QVideoFrame::Format_YUYV << w * h * 2 << w * 2
+                          << (QList<QByteArray>() << y + u + y + v) << red;
+    QTest::newRow("IMC1") << QVideoFrame::Format_IMC1 << w * h * 2 << w
+                          << (QList<QByteArray>() << y << u << v) << red;
+    QTest::newRow("IMC2") << QVideoFrame::Format_IMC2 << w * h * 3 / 2 << w
+                          << (QList<QByteArray>() << y << u.repeated(w / 2) + v.repeated(w / 2)) << red;
+    QTest::newRow("IMC3") << QVideoFrame::Format_IMC3 << w * h * 2 << w
+                          << (QList<QByteArray>() << y << v << u) << red;
+    QTest::newRow("IMC4") << QVideoFrame::Format_IMC4 << w * h * 3 / 2 << w
+                          << (QList<QByteArray>() << y << v.repeated(w / 2) + u.repeated(w / 2)) << red;
+    QTest::newRow("AYUV444") << QVideoFrame::Format_AYUV444 << w * h * 4 << w * 4
+                             << (QList<QByteArray>() << QByteArray(1, char(255)) + y + u + v) << red;
+    QTest::newRow("YUV444") << QVideoFrame::Format_YUV444 << w * h * 3 << w * 3
+                            << (QList<QByteArray>() << y + u + v) << red;
+    QTest::newRow("Y8") << QVideoFrame::Format_Y8 << w * h << w
+                        << (QList<QByteArray>() << QByteArray(1, char(128))) << grey;
+    QTest::newRow("Y16") << QVideoFrame::Format_Y16 << w * h * 2 << w * 2
+                         << (QList<QByteArray>() << QByteArray(2, char(128))) << grey;
+
+    // Little endian, P010 keeps the 10 bits of 4 * 81, 4 * 90 and 4 * 240 in the high bits.
+    QTest::newRow("P010") << QVideoFrame::Format_P010 << w * h * 3 << w * 2
+                          << (QList<QByteArray>() << QByteArray::fromHex("0051")
+                                                  << QByteArray::fromHex("005a00f0")) << red;
+    QTest::newRow("P016") << QVideoFrame::Format_P016 << w * h * 3 << w * 2
+                          << (QList<QByteArray>() << QByteArray::fromHex("5151")
+                                                  << QByteArray::fromHex("5a5af0f0")) << red;
+}
+
+void tst_QDeclarativeVideoOutput::renderFormat()
+{
+    QFETCH(QVideoFrame::PixelFormat, pixelFormat);
+    QFETCH(int, bytes);
+    QFETCH(int, bytesPerLine);
+    QFETCH(QList<QByteArray>, planes);
+    QFETCH(QColor, expected);
+
+    QQuickView view;
+    QQmlComponent component(view.engine());
+    component.loadUrl(QUrl("qrc:/main.qml"));
+
+    QScopedPointer<QQuickItem> videoOutput(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY(videoOutput);
+    videoOutput->setParentItem(view.contentItem());
+    videoOutput->setProperty("fillMode", QVariant(int(QDeclarativeVideoOutput::Stretch)));
+
+    view.resize(150, 100);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    if (view.rendererInterface()->graphicsApi() != QSGRendererInterface::OpenGL)
+        QSKIP("Video frames are uploaded to textures with OpenGL only");
+
+    SurfaceHolder holder(this);
+    videoOutput->setProperty("source", QVariant::fromValue(static_cast<QObject*>(&holder)));
+    QVERIFY(holder.videoSurface());
+    QVERIFY(holder.videoSurface()->supportedPixelFormats().contains(pixelFormat));
+
+    const QSize size(16, 16);
+    const QVideoFrame frame = patternFrame(pixelFormat, size, bytes, bytesPerLine, planes);
+    QVERIFY(frame.isValid());
+
+    QVERIFY(holder.videoSurface()->start(QVideoSurfaceFormat(size, pixelFormat)));
+    QVERIFY(holder.videoSurface()->present(frame));
+
+    QTRY_VERIFY2(fuzzyCompareColor(centerColor(&view), expected), qPrintable(centerColor(&view).name()));
+
+    holder.videoSurface()->stop();
+}
+
 void tst_QDeclarativeVideoOutput::mappingPoint()
 {
     QFETCH(QPointF, point);
@@ -0,0 +1,12 @@
+TARGET = tst_qgstvideobuffer
+
+QT += multimedia-private multimediagsttools-private testlib
+
+CONFIG += testcase
+
+QMAKE_USE += gstreamer
+qtConfig(gstreamer_allocators): \
+    QMAKE_USE += gstreamer_allocators
+
+SOURCES += \
+    tst_qgstvideobuffer.cpp
@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/gsttools
+
+#include <QtTest/QtTest>
+#include <QtCore/qtemporaryfile.h>
+
+#include <QtMultimedia/private/qtmultimediaglobal_p.h>
+#include <private/qgstvideobuffer_p.h>
+#include <qvideoframe.h>
+
+#if QT_CONFIG(gstreamer_allocators)
+#include <gst/allocators/gstdmabuf.h>
+#include <unistd.h>
+#endif
+
+class tst_QGstVideoBuffer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void systemMemoryHasNoDmaBufHandle();
+    void dmaBufHandle();
+    void dmaBufMapFallback();
+
+private:
+#if QT_CONFIG(gstreamer_allocators)
+    GstBuffer *createDmaBufBuffer(QTemporaryFile *file, const GstVideoInfo &info);
+#endif
+};
+
+void tst_QGstVideoBuffer::initTestCase()
+{
+#if !QT_CONFIG(gstreamer_allocators) || !GST_CHECK_VERSION(1,0,0)
+    QSKIP("dma-buf export requires the GStreamer 1.0 allocators library");
+#endif
+    gst_init(NULL, NULL);
+}
+
+#if QT_CONFIG(gstreamer_allocators)
+
+// The dma-buf allocator only needs a file descriptor which can be mapped, so a regular file
+// stands in for the buffers of a v4l2 or GPU driver.
+GstBuffer *tst_QGstVideoBuffer::createDmaBufBuffer(QTemporaryFile *file, const GstVideoInfo &info)
+{
+    if (!file->open() || !file->resize(GST_VIDEO_INFO_SIZE(&info)))
+        return 0;
+
+    GstAllocator *allocator = gst_dmabuf_allocator_new();
+    GstMemory *memory = gst_dmabuf_allocator_alloc(
+                allocator, ::dup(file->handle()), GST_VIDEO_INFO_SIZE(&info));
+    gst_object_unref(allocator);
+
+    GstBuffer *buffer = gst_buffer_new();
+    gst_buffer_append_memory(buffer, memory);
+    return buffer;
+}
+
+#endif
+
+void tst_QGstVideoBuffer::systemMemoryHasNoDmaBufHandle()
+{
+#if QT_CONFIG(gstreamer_allocators)
+    GstVideoInfo info;
+    gst_video_info_set_format(&info, GST_VIDEO_FORMAT_NV12, 64, 48);
+
+    GstBuffer *buffer = gst_buffer_new_allocate(NULL, GST_VIDEO_INFO_SIZE(&info), NULL);
+    QVERIFY(QGstVideoBuffer::dmaBufHandle(buffer, info).isNull());
+    gst_buffer_unref(buffer);
+#endif
+}
+
+void tst_QGstVideoBuffer::dmaBufHandle()
+{
+#if QT_CONFIG(gstreamer_allocators)
+    GstVideoInfo info;
+    gst_video_info_set_format(&info, GST_VIDEO_FORMAT_NV12, 64, 48);
+
+    QTemporaryFile file;
+    GstBuffer *buffer = createDmaBufBuffer(&file, info);
+    QVERIFY(buffer);
+
+    const int fd = gst_dmabuf_memory_get_fd(gst_buffer_peek_memory(buffer, 0));
+
+    const QVariant handle = QGstVideoBuffer::dmaBufHandle(buffer, info);
+    QVERIFY(!handle.isNull());
+
+    const QVariantMap planes = handle.toMap();
+    const QVariantList fds = planes.value(QStringLiteral("fds")).toList();
+    const QVariantList offsets = planes.value(QStringLiteral("offsets")).toList();
+    const QVariantList strides = planes.value(QStringLiteral("strides")).toList();
+
+    QCOMPARE(fds.count(), 2);
+    QCOMPARE(offsets.count(), 2);
+    QCOMPARE(strides.count(), 2);
+
+    QCOMPARE(fds.at(0).toInt(), fd);
+    QCOMPARE(fds.at(1).toInt(), fd);
+    QCOMPARE(offsets.at(0).toLongLong(), qint64(0));
+    QCOMPARE(offsets.at(1).toLongLong(), qint64(GST_VIDEO_INFO_PLANE_OFFSET(&info, 1)));
+    QCOMPARE(strides.at(0).toInt(), GST_VIDEO_INFO_PLANE_STRIDE(&info, 0));
+    QCOMPARE(strides.at(1).toInt(), GST_VIDEO_INFO_PLANE_STRIDE(&info, 1));
+
+    gst_buffer_unref(buffer);
+#endif
+}
+
+void tst_QGstVideoBuffer::dmaBufMapFallback()
+{
+#if QT_CONFIG(gstreamer_allocators)
+    GstVideoInfo info;
+    gst_video_info_set_format(&info, GST_VIDEO_FORMAT_NV12, 64, 48);
+
+    QTemporaryFile file;
+    GstBuffer *buffer = createDmaBufBuffer(&file, info);
+    QVERIFY(buffer);
+
+    QVideoFrame frame(
+                new QGstVideoBuffer(buffer, info, QAbstractVideoBuffer::DmaBufHandle,
+                                    QGstVideoBuffer::dmaBufHandle(buffer, info)),
+                QSize(64, 48),
+                QVideoFrame::Format_NV12);
+    gst_buffer_unref(buffer);
+
+    QCOMPARE(frame.handleType(), QAbstractVideoBuffer::DmaBufHandle);
+    QVERIFY(!frame.handle().isNull());
+
+    // Consumers which can't import the dma-buf map the frame as usual.
+    QVERIFY(frame.map(QAbstractVideoBuffer::WriteOnly));
+    QCOMPARE(frame.planeCount(), 2);
+    memset(frame.bits(0), 0x10, frame.bytesPerLine(0) * 48);
+    memset(frame.bits(1), 0x80, frame.bytesPerLine(1) * 24);
+    frame.unmap();
+
+    const QByteArray contents = file.readAll();
+    QCOMPARE(contents.size(), int(GST_VIDEO_INFO_SIZE(&info)));
+    QCOMPARE(contents.at(0), char(0x10));
+    QCOMPARE(contents.at(int(GST_VIDEO_INFO_PLANE_OFFSET(&info, 1))), char(0x80));
+#endif
+}
+
+QTEST_MAIN(tst_QGstVideoBuffer)
+
+#include "tst_qgstvideobuffer.moc"
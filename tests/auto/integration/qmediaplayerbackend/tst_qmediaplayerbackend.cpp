@@ -33,6 +33,8 @@
 #include "qmediaplayer.h"
 #include "qaudioprobe.h"
 #include "qvideoprobe.h"
+#include "qmediaseekcontrol.h"
+#include "qmediathumbnailcontrol.h"
 #include <qmediaplaylist.h>
 #include <qmediametadata.h>
 
@@ -78,6 +80,10 @@ private slots:
     void surfaceTest();
     void metadata();
     void playerStateAtEOS();
+    void seekFlags();
+    void thumbnail();
+    void thumbnailCancel();
+    void thumbnailCacheMediaChange();
 
 private:
     QMediaContent selectVideoFile(const QStringList& mediaCandidates);
@@ -1439,6 +1445,168 @@ void tst_QMediaPlayerBackend::playerStateAtEOS()
     QVERIFY(endOfMediaReceived);
 }
 
+void tst_QMediaPlayerBackend::seekFlags()
+{
+    if (localVideoFile.isNull())
+        QSKIP("No supported video file");
+
+    QMediaPlayer player;
+
+    QMediaSeekControl *control = player.service()->requestControl<QMediaSeekControl *>();
+    if (!control)
+        QSKIP("Seek control is not available");
+
+    QSignalSpy flagsSpy(control, &QMediaSeekControl::seekFlagsChanged);
+
+    control->setSeekFlags(QMediaSeekControl::Accurate);
+    QCOMPARE(control->seekFlags(), QMediaSeekControl::SeekFlags(QMediaSeekControl::Accurate));
+    QCOMPARE(flagsSpy.count(), 1);
+
+    TestVideoSurface *surface = new TestVideoSurface;
+    player.setVideoOutput(surface);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        player.setMedia(localVideoFile);
+        player.pause();
+        QTRY_COMPARE(player.state(), QMediaPlayer::PausedState);
+        QTRY_VERIFY(!surface->m_frameList.isEmpty());
+
+        if (surface->m_frameList.back().startTime() < 0)
+            QSKIP("No timestamp");
+
+        // An accurate seek lands on the requested frame rather than on a
+        // key frame, so the flags must have reached the playback session.
+        surface->m_frameList.clear();
+        const qint64 position = 7020;
+        player.setPosition(position);
+        QTRY_VERIFY(!surface->m_frameList.isEmpty()
+                    && qAbs(surface->m_frameList.back().startTime() / 1000 - position) < 100);
+
+        // The flags are kept for the next media.
+        player.stop();
+        player.setMedia(QMediaContent());
+        QCOMPARE(control->seekFlags(), QMediaSeekControl::SeekFlags(QMediaSeekControl::Accurate));
+        surface->m_frameList.clear();
+    }
+
+    QCOMPARE(flagsSpy.count(), 1);
+
+    player.service()->releaseControl(control);
+}
+
+void tst_QMediaPlayerBackend::thumbnail()
+{
+    if (localVideoFile.isNull())
+        QSKIP("No supported video file");
+
+    QMediaPlayer player;
+
+    QMediaThumbnailControl *control = player.service()->requestControl<QMediaThumbnailControl *>();
+    if (!control)
+        QSKIP("Thumbnail control is not available");
+
+    QSignalSpy spy(control, &QMediaThumbnailControl::thumbnailReady);
+
+    player.setMedia(localVideoFile);
+
+    // The test video is red at 7 seconds.
+    const int id = control->requestThumbnail(7000, QSize(80, 60), QMediaSeekControl::Accurate);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, 10000);
+    QCOMPARE(spy.at(0).at(0).toInt(), id);
+    QCOMPARE(spy.at(0).at(1).toLongLong(), qint64(7000));
+
+    const QImage image = spy.at(0).at(2).value<QImage>();
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.size(), QSize(80, 60));
+    QVERIFY(qRed(image.pixel(40, 30)) >= 200);
+    QVERIFY(qGreen(image.pixel(40, 30)) < 56);
+    QVERIFY(qBlue(image.pixel(40, 30)) < 56);
+
+    // Playback isn't affected by grabbing thumbnails.
+    QCOMPARE(player.state(), QMediaPlayer::StoppedState);
+    QCOMPARE(player.position(), qint64(0));
+
+    player.service()->releaseControl(control);
+}
+
+void tst_QMediaPlayerBackend::thumbnailCancel()
+{
+    if (localVideoFile.isNull())
+        QSKIP("No supported video file");
+
+    QMediaPlayer player;
+
+    QMediaThumbnailControl *control = player.service()->requestControl<QMediaThumbnailControl *>();
+    if (!control)
+        QSKIP("Thumbnail control is not available");
+
+    QSignalSpy spy(control, &QMediaThumbnailControl::thumbnailReady);
+
+    player.setMedia(localVideoFile);
+
+    const int first = control->requestThumbnail(3000, QSize(80, 60), QMediaSeekControl::Accurate);
+    const int second = control->requestThumbnail(9000, QSize(80, 60), QMediaSeekControl::Accurate);
+    control->cancelRequests();
+
+    // Requests are served in order, so once this one is answered the
+    // cancelled ones would have been too.
+    const int third = control->requestThumbnail(12000, QSize(80, 60), QMediaSeekControl::Accurate);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, 10000);
+    QCOMPARE(spy.at(0).at(0).toInt(), third);
+
+    QTest::qWait(250);
+    for (const QList<QVariant> &arguments : qAsConst(spy)) {
+        QVERIFY(arguments.at(0).toInt() != first);
+        QVERIFY(arguments.at(0).toInt() != second);
+    }
+
+    player.service()->releaseControl(control);
+}
+
+void tst_QMediaPlayerBackend::thumbnailCacheMediaChange()
+{
+    if (localVideoFile.isNull())
+        QSKIP("No supported video file");
+
+    QMediaPlayer player;
+
+    QMediaThumbnailControl *control = player.service()->requestControl<QMediaThumbnailControl *>();
+    if (!control)
+        QSKIP("Thumbnail control is not available");
+
+    QSignalSpy spy(control, &QMediaThumbnailControl::thumbnailReady);
+
+    player.setMedia(localVideoFile);
+
+    control->requestThumbnail(7000, QSize(80, 60), QMediaSeekControl::Accurate);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, 10000);
+    QVERIFY(!spy.at(0).at(2).value<QImage>().isNull());
+
+    // A repeated request is answered from the cache, still asynchronously.
+    int id = control->requestThumbnail(7000, QSize(80, 60), QMediaSeekControl::Accurate);
+    QCOMPARE(spy.count(), 1);
+    QTRY_COMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(0).toInt(), id);
+    QVERIFY(!spy.at(1).at(2).value<QImage>().isNull());
+
+    // Without media there is nothing to grab, a stale cache entry would
+    // still produce an image.
+    player.setMedia(QMediaContent());
+    id = control->requestThumbnail(7000, QSize(80, 60), QMediaSeekControl::Accurate);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 3, 10000);
+    QCOMPARE(spy.at(2).at(0).toInt(), id);
+    QVERIFY(spy.at(2).at(2).value<QImage>().isNull());
+
+    // The thumbnail is grabbed again from the new media.
+    player.setMedia(localVideoFile);
+    id = control->requestThumbnail(7000, QSize(80, 60), QMediaSeekControl::Accurate);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 4, 10000);
+    QCOMPARE(spy.at(3).at(0).toInt(), id);
+    QVERIFY(!spy.at(3).at(2).value<QImage>().isNull());
+
+    player.service()->releaseControl(control);
+}
+
 TestVideoSurface::TestVideoSurface(bool storeFrames):
     m_totalFrames(0),
     m_storeFrames(storeFrames)
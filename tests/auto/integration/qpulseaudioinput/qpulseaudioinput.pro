@@ -0,0 +1,23 @@
+TARGET = tst_qpulseaudioinput
+
+QT += core multimedia-private testlib
+
+# This is more of a system test, it needs a PulseAudio server
+CONFIG += testcase
+
+QMAKE_USE += pulseaudio
+
+INCLUDEPATH += ../../../../src/plugins/pulseaudio
+
+HEADERS += ../../../../src/plugins/pulseaudio/qaudiodeviceinfo_pulse.h \
+           ../../../../src/plugins/pulseaudio/qaudiooutput_pulse.h \
+           ../../../../src/plugins/pulseaudio/qaudioinput_pulse.h \
+           ../../../../src/plugins/pulseaudio/qpulseaudioengine.h \
+           ../../../../src/plugins/pulseaudio/qpulsehelpers.h
+
+SOURCES += tst_qpulseaudioinput.cpp \
+           ../../../../src/plugins/pulseaudio/qaudiodeviceinfo_pulse.cpp \
+           ../../../../src/plugins/pulseaudio/qaudiooutput_pulse.cpp \
+           ../../../../src/plugins/pulseaudio/qaudioinput_pulse.cpp \
+           ../../../../src/plugins/pulseaudio/qpulseaudioengine.cpp \
+           ../../../../src/plugins/pulseaudio/qpulsehelpers.cpp
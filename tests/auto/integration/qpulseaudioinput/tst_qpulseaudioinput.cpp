@@ -0,0 +1,246 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/plugins/pulseaudio
+
+#include <QtTest/QtTest>
+#include <QtCore/qelapsedtimer.h>
+
+#include "qaudioinput_pulse.h"
+#include "qpulseaudioengine.h"
+
+#include <new>
+#include <stdlib.h>
+
+// Counts the allocations made while allocationCounting is set, on any thread,
+// so that the PulseAudio mainloop filling the ring buffer is covered as well.
+static QAtomicInt allocationCounting;
+static QAtomicInt allocationCount;
+
+void *operator new(std::size_t size)
+{
+    if (allocationCounting.load())
+        allocationCount.ref();
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+static const char NullSinkName[] = "tst_qpulseaudioinput";
+
+static void moduleIndexCallback(pa_context *context, uint32_t index, void *userdata)
+{
+    Q_UNUSED(context);
+
+    *static_cast<uint32_t *>(userdata) = index;
+    pa_threaded_mainloop_signal(QPulseAudioEngine::instance()->mainloop(), 0);
+}
+
+static void successCallback(pa_context *context, int success, void *userdata)
+{
+    Q_UNUSED(context);
+    Q_UNUSED(success);
+    Q_UNUSED(userdata);
+
+    pa_threaded_mainloop_signal(QPulseAudioEngine::instance()->mainloop(), 0);
+}
+
+// Discards what a pull mode input writes to it.
+class NullDevice : public QIODevice
+{
+public:
+    NullDevice() : m_written(0) { open(QIODevice::WriteOnly | QIODevice::Unbuffered); }
+
+    bool isSequential() const override { return true; }
+    qint64 written() const { return m_written; }
+
+protected:
+    qint64 readData(char *data, qint64 len) override
+    {
+        Q_UNUSED(data);
+        Q_UNUSED(len);
+        return 0;
+    }
+
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        Q_UNUSED(data);
+        m_written += len;
+        return len;
+    }
+
+private:
+    qint64 m_written;
+};
+
+class tst_QPulseAudioInput : public QObject
+{
+    Q_OBJECT
+public:
+    tst_QPulseAudioInput(QObject *parent = 0)
+        : QObject(parent)
+        , m_moduleIndex(PA_INVALID_INDEX)
+    {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void noAllocationsFromNullSource_data();
+    void noAllocationsFromNullSource();
+
+private:
+    uint32_t m_moduleIndex;
+};
+
+void tst_QPulseAudioInput::initTestCase()
+{
+    QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
+    if (!pulseEngine->context() || pa_context_get_state(pulseEngine->context()) != PA_CONTEXT_READY)
+        QSKIP("No PulseAudio server available");
+
+    // The monitor of a null sink is a source of silence that runs in real time
+    // without any hardware.
+    const QByteArray arguments = QByteArray("sink_name=") + NullSinkName;
+
+    pulseEngine->lock();
+    pa_operation *operation = pa_context_load_module(pulseEngine->context(), "module-null-sink",
+                                                     arguments.constData(),
+                                                     moduleIndexCallback, &m_moduleIndex);
+    if (operation) {
+        pulseEngine->wait(operation);
+        pa_operation_unref(operation);
+    }
+    pulseEngine->unlock();
+
+    if (m_moduleIndex == PA_INVALID_INDEX)
+        QSKIP("Unable to load module-null-sink");
+}
+
+void tst_QPulseAudioInput::cleanupTestCase()
+{
+    if (m_moduleIndex == PA_INVALID_INDEX)
+        return;
+
+    QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
+    pulseEngine->lock();
+    pa_operation *operation = pa_context_unload_module(pulseEngine->context(), m_moduleIndex,
+                                                       successCallback, 0);
+    if (operation) {
+        pulseEngine->wait(operation);
+        pa_operation_unref(operation);
+    }
+    pulseEngine->unlock();
+}
+
+void tst_QPulseAudioInput::noAllocationsFromNullSource_data()
+{
+    QTest::addColumn<bool>("pullMode");
+    QTest::addColumn<qreal>("volume");
+
+    QTest::newRow("pull") << true << qreal(1);
+    QTest::newRow("pull with volume") << true << qreal(0.5);
+    QTest::newRow("push") << false << qreal(1);
+    QTest::newRow("push with volume") << false << qreal(0.5);
+}
+
+void tst_QPulseAudioInput::noAllocationsFromNullSource()
+{
+    QFETCH(bool, pullMode);
+    QFETCH(qreal, volume);
+
+    QAudioFormat format;
+    format.setSampleRate(44100);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    QPulseAudioInput input(QByteArray(NullSinkName) + ".monitor");
+    input.setFormat(format);
+    input.setVolume(volume);
+
+    NullDevice sink;
+    QByteArray buffer(format.bytesForDuration(100000), '\0');
+    qint64 pushed = 0;
+
+    if (pullMode) {
+        input.start(&sink);
+    } else {
+        QIODevice *source = input.start();
+        QVERIFY(source);
+        connect(source, &QIODevice::readyRead, this, [&]() {
+            qint64 read;
+            while ((read = source->read(buffer.data(), buffer.size())) > 0)
+                pushed += read;
+        });
+    }
+    QCOMPARE(input.error(), QAudio::NoError);
+    QVERIFY(input.state() != QAudio::StoppedState);
+
+    auto captured = [&]() { return pullMode ? sink.written() : pushed; };
+
+    // Let the stream settle, the first fragments and state changes may allocate.
+    QTRY_VERIFY(captured() >= format.bytesForDuration(500000));
+    const qint64 warmedUp = captured();
+
+    allocationCount.store(0);
+    allocationCounting.store(1);
+
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < 1000)
+        QTest::qWait(10);
+
+    allocationCounting.store(0);
+
+    input.stop();
+
+    QCOMPARE(allocationCount.load(), 0);
+    QVERIFY(captured() - warmedUp >= format.bytesForDuration(500000));
+}
+
+QTEST_GUILESS_MAIN(tst_QPulseAudioInput)
+
+#include "tst_qpulseaudioinput.moc"
@@ -0,0 +1,10 @@
+TARGET = tst_audiofilewriter
+INCLUDEPATH += ../../../../src/plugins/audiocapture
+HEADERS += ../../../../src/plugins/audiocapture/audiofilewriter.h \
+           ../../../../src/plugins/audiocapture/audiocaptureprobecontrol.h
+SOURCES += tst_audiofilewriter.cpp \
+           ../../../../src/plugins/audiocapture/audiofilewriter.cpp \
+           ../../../../src/plugins/audiocapture/audiocaptureprobecontrol.cpp
+
+QT += multimedia-private testlib
+CONFIG += testcase
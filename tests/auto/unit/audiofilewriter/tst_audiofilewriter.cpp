@@ -0,0 +1,223 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/plugins/audiocapture
+
+#include <QtTest/QtTest>
+#include <QtCore/qendian.h>
+#include <QtCore/qtemporarydir.h>
+
+#include "audiofilewriter.h"
+
+static const int HeaderSize = 80;
+
+static quint16 le16(const QByteArray &data, int offset)
+{
+    return qFromLittleEndian<quint16>(data.constData() + offset);
+}
+
+static quint32 le32(const QByteArray &data, int offset)
+{
+    return qFromLittleEndian<quint32>(data.constData() + offset);
+}
+
+static quint64 le64(const QByteArray &data, int offset)
+{
+    return le32(data, offset) | quint64(le32(data, offset + 4)) << 32;
+}
+
+static QAudioFormat audioFormat(int sampleRate, int channelCount, int sampleSize,
+                                QAudioFormat::SampleType sampleType)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channelCount);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+    return format;
+}
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+class tst_AudioFileWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void wavHeader_data();
+    void wavHeader();
+    void rf64Header();
+    void record();
+    void droppedBytes();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void tst_AudioFileWriter::wavHeader_data()
+{
+    QTest::addColumn<QAudioFormat>("format");
+    QTest::addColumn<qint64>("dataSize");
+    QTest::addColumn<int>("audioFormat");
+
+    QTest::newRow("empty") << audioFormat(44100, 2, 16, QAudioFormat::SignedInt) << qint64(0) << 1;
+    QTest::newRow("mono 8 bit") << audioFormat(8000, 1, 8, QAudioFormat::UnSignedInt) << qint64(8000) << 1;
+    QTest::newRow("stereo float") << audioFormat(48000, 2, 32, QAudioFormat::Float) << qint64(384000) << 3;
+    // The largest size a RIFF file can describe.
+    QTest::newRow("4 GB") << audioFormat(48000, 2, 16, QAudioFormat::SignedInt)
+                          << qint64(0xffffffffLL - (HeaderSize - 8)) << 1;
+}
+
+void tst_AudioFileWriter::wavHeader()
+{
+    QFETCH(QAudioFormat, format);
+    QFETCH(qint64, dataSize);
+    QFETCH(int, audioFormat);
+
+    const QByteArray header = AudioFileWriter::wavHeader(format, dataSize);
+    QCOMPARE(header.size(), HeaderSize);
+
+    const int blockAlign = format.channelCount() * format.sampleSize() / 8;
+
+    QCOMPARE(header.mid(0, 4), QByteArray("RIFF"));
+    QCOMPARE(le32(header, 4), quint32(HeaderSize - 8 + dataSize));
+    QCOMPARE(header.mid(8, 4), QByteArray("WAVE"));
+
+    // Room for the ds64 chunk, skipped by readers until it's needed.
+    QCOMPARE(header.mid(12, 4), QByteArray("JUNK"));
+    QCOMPARE(le32(header, 16), quint32(28));
+
+    QCOMPARE(header.mid(48, 4), QByteArray("fmt "));
+    QCOMPARE(le32(header, 52), quint32(16));
+    QCOMPARE(int(le16(header, 56)), audioFormat);
+    QCOMPARE(int(le16(header, 58)), format.channelCount());
+    QCOMPARE(int(le32(header, 60)), format.sampleRate());
+    QCOMPARE(int(le32(header, 64)), format.sampleRate() * blockAlign);
+    QCOMPARE(int(le16(header, 68)), blockAlign);
+    QCOMPARE(int(le16(header, 70)), format.sampleSize());
+
+    QCOMPARE(header.mid(72, 4), QByteArray("data"));
+    QCOMPARE(le32(header, 76), quint32(dataSize));
+}
+
+void tst_AudioFileWriter::rf64Header()
+{
+    const QAudioFormat format = audioFormat(48000, 2, 16, QAudioFormat::SignedInt);
+    const qint64 dataSize = 5LL * 1024 * 1024 * 1024;
+
+    // One byte past what a RIFF header can describe switches to RF64.
+    QCOMPARE(AudioFileWriter::wavHeader(format, 0xffffffffLL - (HeaderSize - 8) + 1).mid(0, 4),
+             QByteArray("RF64"));
+
+    const QByteArray header = AudioFileWriter::wavHeader(format, dataSize);
+    QCOMPARE(header.size(), HeaderSize);
+
+    QCOMPARE(header.mid(0, 4), QByteArray("RF64"));
+    QCOMPARE(le32(header, 4), quint32(0xffffffff));
+    QCOMPARE(header.mid(8, 4), QByteArray("WAVE"));
+
+    QCOMPARE(header.mid(12, 4), QByteArray("ds64"));
+    QCOMPARE(le32(header, 16), quint32(28));
+    QCOMPARE(le64(header, 20), quint64(HeaderSize - 8 + dataSize));
+    QCOMPARE(le64(header, 28), quint64(dataSize));
+    QCOMPARE(le64(header, 36), quint64(dataSize / 4));
+    QCOMPARE(le32(header, 44), quint32(0));
+
+    QCOMPARE(header.mid(48, 4), QByteArray("fmt "));
+    QCOMPARE(header.mid(72, 4), QByteArray("data"));
+    QCOMPARE(le32(header, 76), quint32(0xffffffff));
+}
+
+void tst_AudioFileWriter::record()
+{
+    QVERIFY(m_dir.isValid());
+
+    const QAudioFormat format = audioFormat(8000, 1, 16, QAudioFormat::SignedInt);
+
+    QByteArray data(format.bytesForDuration(1000000), Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i);
+
+    AudioFileWriter writer;
+    QSignalSpy failedSpy(&writer, &AudioFileWriter::writeFailed);
+    writer.setFileName(m_dir.filePath(QStringLiteral("record.wav")));
+    QVERIFY(writer.open(format, true));
+
+    // Written the way the audio input does, in periods.
+    for (int offset = 0; offset < data.size(); offset += 1600)
+        QCOMPARE(writer.write(data.constData() + offset, qMin(1600, data.size() - offset)),
+                 qint64(qMin(1600, data.size() - offset)));
+
+    writer.close();
+    QCOMPARE(writer.droppedBytes(), qint64(0));
+    QCOMPARE(failedSpy.count(), 0);
+
+    const QByteArray contents = readFile(writer.fileName());
+    QCOMPARE(contents.size(), HeaderSize + data.size());
+    QCOMPARE(contents.left(HeaderSize), AudioFileWriter::wavHeader(format, data.size()));
+    QCOMPARE(contents.mid(HeaderSize), data);
+}
+
+void tst_AudioFileWriter::droppedBytes()
+{
+    QVERIFY(m_dir.isValid());
+
+    const QAudioFormat format = audioFormat(8000, 1, 8, QAudioFormat::UnSignedInt);
+
+    AudioFileWriter writer;
+    writer.setFileName(m_dir.filePath(QStringLiteral("dropped.wav")));
+    QVERIFY(writer.open(format, true));
+
+    // Far more than is queued for the writer thread at once; what doesn't fit
+    // is dropped rather than blocking the caller.
+    const QByteArray data(64 * 1024 * 1024, 'x');
+    QCOMPARE(writer.write(data), qint64(data.size()));
+
+    writer.close();
+    const qint64 dropped = writer.droppedBytes();
+    QVERIFY(dropped > 0);
+    QVERIFY(dropped < data.size());
+
+    // The header describes exactly the data that made it to the file.
+    const QByteArray contents = readFile(writer.fileName());
+    const qint64 written = data.size() - dropped;
+    QCOMPARE(qint64(contents.size()), HeaderSize + written);
+    QCOMPARE(contents.left(HeaderSize), AudioFileWriter::wavHeader(format, written));
+}
+
+QTEST_GUILESS_MAIN(tst_AudioFileWriter)
+
+#include "tst_audiofilewriter.moc"
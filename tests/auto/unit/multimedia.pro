@@ -1,6 +1,7 @@
 
 TEMPLATE = subdirs
 SUBDIRS += \
+    audiofilewriter \
     qabstractvideobuffer \
     qabstractvideosurface \
     qaudiorecorder \
@@ -19,19 +20,30 @@ SUBDIRS += \
     qmediapluginloader \
     qmediarecorder \
     qmediaresource \
+    qmediaseekcontrol \
     qmediaservice \
     qmediaserviceprovider \
+    qmediathumbnailcontrol \
     qmediatimerange \
     qmetadatareadercontrol \
     qmetadatawritercontrol \
     qradiodata \
     qradiotuner \
     qvideoencodersettingscontrol \
+    qabstractvideofilter \
     qvideoframe \
+    qvideoframepool \
     qvideosurfaceformat \
     qwavedecoder \
     qaudiobuffer \
+    qaudioformatconverter \
+    qaudioconvertingdevice \
+    qaudioringbuffer \
+    qaudioanalyzer \
+    qaudiostatistics \
     qaudiodecoder \
     qaudioprobe \
     qvideoprobe \
     qsamplecache
+
+linux: SUBDIRS += qsharedmemoryvideo
@@ -105,6 +105,8 @@ void tst_QAbstractVideoBuffer::handleType_data()
     ADD_ENUM_TEST(XvShmImageHandle);
     ADD_ENUM_TEST(QPixmapHandle);
     ADD_ENUM_TEST(CoreImageHandle);
+    ADD_ENUM_TEST(EGLImageHandle);
+    ADD_ENUM_TEST(DmaBufHandle);
 
     // User handles are different
 
@@ -0,0 +1,13 @@
+CONFIG += testcase
+TARGET = tst_qabstractvideofilter
+
+QT += core multimedia-private testlib
+
+HEADERS += \
+        ../../../../src/qtmultimediaquicktools/qdeclarativevideofilterpipeline_p.h
+
+SOURCES += \
+        tst_qabstractvideofilter.cpp \
+        ../../../../src/qtmultimediaquicktools/qdeclarativevideofilterpipeline.cpp
+
+INCLUDEPATH += ../../../../src/qtmultimediaquicktools
@@ -0,0 +1,277 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qsemaphore.h>
+
+#include <QtMultimedia/qabstractvideofilter.h>
+#include <private/qabstractvideofilter_p.h>
+#include <private/qmemoryvideobuffer_p.h>
+
+#include "qdeclarativevideofilterpipeline_p.h"
+
+QT_USE_NAMESPACE
+
+class tst_QAbstractVideoFilter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void defaults();
+    void properties();
+    void statistics();
+    void pipeline();
+    void pipelineOrder();
+    void pipelineDropsFrames();
+    void pipelineSubmissionOrder();
+};
+
+class TestFilterRunnable : public QVideoFilterRunnable
+{
+public:
+    TestFilterRunnable(QAtomicInt *runCount, QSemaphore *gate, int tag)
+        : m_runCount(runCount), m_gate(gate), m_tag(tag) { }
+
+    QVideoFrame run(QVideoFrame *input, const QVideoSurfaceFormat &, RunFlags flags) override
+    {
+        if (m_gate)
+            m_gate->acquire();
+        m_runCount->ref();
+
+        QVideoFrame output(new QMemoryVideoBuffer(QByteArray(16, char(0)), 8),
+                           input->size(), input->pixelFormat());
+        QStringList tags = input->metaData(QLatin1String("tags")).toStringList();
+        tags.append(QString::number(m_tag));
+        output.setMetaData(QLatin1String("tags"), tags);
+        output.setMetaData(QLatin1String("lastInChain"), bool(flags & LastInChain));
+        return output;
+    }
+
+private:
+    QAtomicInt *m_runCount;
+    QSemaphore *m_gate;
+    int m_tag;
+};
+
+class TestFilter : public QAbstractVideoFilter
+{
+public:
+    TestFilter(int tag = 0, QSemaphore *gate = nullptr)
+        : m_tag(tag), m_gate(gate) { }
+
+    QVideoFilterRunnable *createFilterRunnable() override
+    {
+        return new TestFilterRunnable(&runCount, m_gate, m_tag);
+    }
+
+    QAtomicInt runCount;
+
+private:
+    int m_tag;
+    QSemaphore *m_gate;
+};
+
+static QVideoFrame createFrame(qint64 startTime)
+{
+    QVideoFrame frame(new QMemoryVideoBuffer(QByteArray(16, char(0)), 8),
+                      QSize(2, 2), QVideoFrame::Format_ARGB32);
+    frame.setStartTime(startTime);
+    frame.setEndTime(startTime + 1000);
+    return frame;
+}
+
+static QVideoFrame waitForResult(QDeclarativeVideoFilterPipeline *pipeline)
+{
+    QVideoFrame result;
+    QTest::qWaitFor([&]() {
+        result = pipeline->takeResult();
+        return result.isValid();
+    }, 5000);
+    return result;
+}
+
+void tst_QAbstractVideoFilter::defaults()
+{
+    TestFilter filter;
+
+    QVERIFY(filter.isActive());
+    QVERIFY(!filter.isAsynchronous());
+    QCOMPARE(filter.maximumPendingFrames(), 2);
+    QCOMPARE(filter.processedFrameCount(), quint64(0));
+    QCOMPARE(filter.droppedFrameCount(), quint64(0));
+    QCOMPARE(filter.lastLatency(), qint64(0));
+    QCOMPARE(filter.averageLatency(), qint64(0));
+    QCOMPARE(filter.maximumLatency(), qint64(0));
+}
+
+void tst_QAbstractVideoFilter::properties()
+{
+    TestFilter filter;
+    QSignalSpy asynchronousSpy(&filter, SIGNAL(asynchronousChanged()));
+    QSignalSpy pendingSpy(&filter, SIGNAL(maximumPendingFramesChanged()));
+
+    filter.setAsynchronous(true);
+    QVERIFY(filter.isAsynchronous());
+    QCOMPARE(asynchronousSpy.count(), 1);
+    filter.setAsynchronous(true);
+    QCOMPARE(asynchronousSpy.count(), 1);
+
+    filter.setMaximumPendingFrames(4);
+    QCOMPARE(filter.maximumPendingFrames(), 4);
+    QCOMPARE(pendingSpy.count(), 1);
+
+    // At least one frame must be able to enter the pipeline.
+    filter.setMaximumPendingFrames(0);
+    QCOMPARE(filter.maximumPendingFrames(), 1);
+    QCOMPARE(pendingSpy.count(), 2);
+}
+
+void tst_QAbstractVideoFilter::statistics()
+{
+    TestFilter filter;
+    QAbstractVideoFilterPrivate *d = QAbstractVideoFilterPrivate::get(&filter);
+
+    d->recordProcessedFrame(100);
+    d->recordProcessedFrame(300);
+    d->recordProcessedFrame(200);
+    d->recordDroppedFrame();
+
+    QCOMPARE(filter.processedFrameCount(), quint64(3));
+    QCOMPARE(filter.droppedFrameCount(), quint64(1));
+    QCOMPARE(filter.lastLatency(), qint64(200));
+    QCOMPARE(filter.averageLatency(), qint64(200));
+    QCOMPARE(filter.maximumLatency(), qint64(300));
+
+    filter.resetStatistics();
+    QCOMPARE(filter.processedFrameCount(), quint64(0));
+    QCOMPARE(filter.droppedFrameCount(), quint64(0));
+    QCOMPARE(filter.lastLatency(), qint64(0));
+    QCOMPARE(filter.averageLatency(), qint64(0));
+    QCOMPARE(filter.maximumLatency(), qint64(0));
+}
+
+void tst_QAbstractVideoFilter::pipeline()
+{
+    TestFilter filter(1);
+    filter.setAsynchronous(true);
+
+    QDeclarativeVideoFilterPipeline pipeline;
+    QVERIFY(pipeline.isEmpty());
+    QVERIFY(!pipeline.submit(createFrame(0), QVideoSurfaceFormat()));
+
+    pipeline.setFilters(QList<QAbstractVideoFilter *>() << &filter, true);
+    QVERIFY(!pipeline.isEmpty());
+
+    QSignalSpy readySpy(&pipeline, SIGNAL(resultReady()));
+    QVERIFY(pipeline.submit(createFrame(40000), QVideoSurfaceFormat()));
+
+    const QVideoFrame result = waitForResult(&pipeline);
+    QVERIFY(result.isValid());
+    QTRY_COMPARE(readySpy.count(), 1);
+    QCOMPARE(result.metaData(QLatin1String("tags")).toStringList(), QStringList() << QLatin1String("1"));
+    QVERIFY(result.metaData(QLatin1String("lastInChain")).toBool());
+    // The result carries the timestamps of the frame it was computed from.
+    QCOMPARE(result.startTime(), qint64(40000));
+    QCOMPARE(result.endTime(), qint64(41000));
+
+    QCOMPARE(pipeline.pendingFrameCount(), 0);
+    QCOMPARE(filter.processedFrameCount(), quint64(1));
+    QVERIFY(filter.lastLatency() >= 0);
+
+    pipeline.clear();
+    QVERIFY(pipeline.isEmpty());
+}
+
+void tst_QAbstractVideoFilter::pipelineOrder()
+{
+    TestFilter first(1);
+    TestFilter second(2);
+
+    QDeclarativeVideoFilterPipeline pipeline;
+    pipeline.setFilters(QList<QAbstractVideoFilter *>() << &first << &second, false);
+
+    QVERIFY(pipeline.submit(createFrame(0), QVideoSurfaceFormat()));
+    const QVideoFrame result = waitForResult(&pipeline);
+    QVERIFY(result.isValid());
+    QCOMPARE(result.metaData(QLatin1String("tags")).toStringList(),
+             QStringList() << QLatin1String("1") << QLatin1String("2"));
+    // A synchronous filter follows the pipeline.
+    QVERIFY(!result.metaData(QLatin1String("lastInChain")).toBool());
+}
+
+void tst_QAbstractVideoFilter::pipelineDropsFrames()
+{
+    QSemaphore gate;
+    TestFilter filter(1, &gate);
+    filter.setMaximumPendingFrames(2);
+
+    QDeclarativeVideoFilterPipeline pipeline;
+    pipeline.setFilters(QList<QAbstractVideoFilter *>() << &filter, true);
+
+    QVERIFY(pipeline.submit(createFrame(0), QVideoSurfaceFormat()));
+    QVERIFY(pipeline.submit(createFrame(1000), QVideoSurfaceFormat()));
+    QVERIFY(!pipeline.submit(createFrame(2000), QVideoSurfaceFormat()));
+    QCOMPARE(pipeline.pendingFrameCount(), 2);
+    QCOMPARE(filter.droppedFrameCount(), quint64(1));
+
+    gate.release(2);
+    QTRY_COMPARE(pipeline.pendingFrameCount(), 0);
+    QCOMPARE(filter.runCount.load(), 2);
+
+    // Only the newest result is presented.
+    const QVideoFrame result = pipeline.takeResult();
+    QCOMPARE(result.startTime(), qint64(1000));
+    QVERIFY(!pipeline.takeResult().isValid());
+}
+
+void tst_QAbstractVideoFilter::pipelineSubmissionOrder()
+{
+    QSemaphore gate;
+    TestFilter filter(1, &gate);
+    filter.setMaximumPendingFrames(3);
+
+    QDeclarativeVideoFilterPipeline pipeline;
+    pipeline.setFilters(QList<QAbstractVideoFilter *>() << &filter, true);
+
+    // After seeking back, and without timestamps, the newest frame isn't
+    // the one with the largest timestamp.
+    QVERIFY(pipeline.submit(createFrame(5000), QVideoSurfaceFormat()));
+    QVERIFY(pipeline.submit(createFrame(-1), QVideoSurfaceFormat()));
+    QVERIFY(pipeline.submit(createFrame(1000), QVideoSurfaceFormat()));
+
+    gate.release(3);
+    QTRY_COMPARE(pipeline.pendingFrameCount(), 0);
+
+    const QVideoFrame result = pipeline.takeResult();
+    QCOMPARE(result.startTime(), qint64(1000));
+    QVERIFY(!pipeline.takeResult().isValid());
+}
+
+QTEST_MAIN(tst_QAbstractVideoFilter)
+
+#include "tst_qabstractvideofilter.moc"
@@ -0,0 +1,6 @@
+TARGET = tst_qaudioanalyzer
+
+QT += multimedia-private testlib
+CONFIG += testcase
+
+SOURCES += tst_qaudioanalyzer.cpp
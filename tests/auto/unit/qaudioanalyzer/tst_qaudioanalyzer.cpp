@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <QtCore/qmath.h>
+
+#include <qaudioanalyzer.h>
+#include <qaudiobuffer.h>
+#include <qaudioformat.h>
+
+QT_USE_NAMESPACE
+
+static const int SampleRate = 48000;
+
+// Two channels of the same sine, the right one at half the amplitude of the left one.
+static QAudioBuffer stereoSine(int firstFrame, int frames, double frequency, float amplitude)
+{
+    QAudioFormat format;
+    format.setSampleRate(SampleRate);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    QByteArray data(format.bytesForFrames(frames), Qt::Uninitialized);
+    qint16 *samples = reinterpret_cast<qint16 *>(data.data());
+    for (int i = 0; i < frames; ++i) {
+        const float value = amplitude * qSin(2 * M_PI * frequency * (firstFrame + i) / SampleRate);
+        samples[2 * i] = qint16(qRound(value * 32767));
+        samples[2 * i + 1] = qint16(qRound(value * 32767 / 2));
+    }
+
+    return QAudioBuffer(data, format, format.durationForFrames(firstFrame));
+}
+
+class tst_QAudioAnalyzer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaults();
+    void spectrumSize_data();
+    void spectrumSize();
+    void levels();
+    void spectrum();
+    void updateInterval_data();
+    void updateInterval();
+    void reset();
+};
+
+void tst_QAudioAnalyzer::defaults()
+{
+    QAudioAnalyzer analyzer;
+
+    QCOMPARE(analyzer.updateInterval(), 50);
+    QCOMPARE(analyzer.spectrumSize(), 1024);
+    QCOMPARE(analyzer.droppedBufferCount(), quint64(0));
+    QVERIFY(!analyzer.analysis().isValid());
+    QCOMPARE(analyzer.analysis().startTime(), qint64(-1));
+    QCOMPARE(analyzer.analysis().channelCount(), 0);
+    QVERIFY(analyzer.analysis().spectrum().isEmpty());
+}
+
+void tst_QAudioAnalyzer::spectrumSize_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("disabled") << 0 << 0;
+    QTest::newRow("negative") << -1 << 0;
+    QTest::newRow("too small") << 1 << 32;
+    QTest::newRow("power of two") << 2048 << 2048;
+    QTest::newRow("rounded up") << 1000 << 1024;
+    QTest::newRow("too large") << 100000 << 16384;
+}
+
+void tst_QAudioAnalyzer::spectrumSize()
+{
+    QFETCH(int, size);
+    QFETCH(int, expected);
+
+    QAudioAnalyzer analyzer;
+    analyzer.setSpectrumSize(size);
+    QCOMPARE(analyzer.spectrumSize(), expected);
+}
+
+void tst_QAudioAnalyzer::levels()
+{
+    QAudioAnalyzer analyzer;
+    QSignalSpy spy(&analyzer, SIGNAL(analysisChanged()));
+
+    // 50 milliseconds at 48 kHz.
+    analyzer.analyze(stereoSine(0, 2400, 1000, 0.5f));
+    QTRY_COMPARE(spy.count(), 1);
+
+    const QAudioAnalysis analysis = analyzer.analysis();
+    QVERIFY(analysis.isValid());
+    QCOMPARE(analysis.startTime(), qint64(0));
+    QCOMPARE(analysis.duration(), qint64(50000));
+    QCOMPARE(analysis.sampleRate(), SampleRate);
+    QCOMPARE(analysis.channelCount(), 2);
+
+    QVERIFY(qAbs(analysis.rms(0) - 0.5f * M_SQRT1_2) < 1e-3);
+    QVERIFY(qAbs(analysis.rms(1) - 0.25f * M_SQRT1_2) < 1e-3);
+    QVERIFY(qAbs(analysis.peak(0) - 0.5f) < 1e-3);
+    QVERIFY(qAbs(analysis.peak(1) - 0.25f) < 1e-3);
+
+    QCOMPARE(analysis.rms(2), 0.0f);
+    QCOMPARE(analysis.peak(-1), 0.0f);
+}
+
+void tst_QAudioAnalyzer::spectrum()
+{
+    QAudioAnalyzer analyzer;
+    QSignalSpy spy(&analyzer, SIGNAL(analysisChanged()));
+
+    // Bin 32 of 1024 at 48 kHz is 1500 Hz, right at the center of the bin.
+    analyzer.analyze(stereoSine(0, 2400, 1500, 0.5f));
+    QTRY_COMPARE(spy.count(), 1);
+
+    const QAudioAnalysis analysis = analyzer.analysis();
+    const QVector<float> spectrum = analysis.spectrum();
+    QCOMPARE(spectrum.size(), 512);
+
+    int loudest = 0;
+    for (int bin = 1; bin < spectrum.size(); ++bin) {
+        if (spectrum.at(bin) > spectrum.at(loudest))
+            loudest = bin;
+    }
+    QCOMPARE(loudest, 32);
+    QCOMPARE(analysis.frequencyAt(loudest), qreal(1500));
+
+    // The channels are mixed down to mono.
+    QVERIFY(qAbs(spectrum.at(32) - 0.375f) < 1e-2);
+    QVERIFY(spectrum.at(64) < 1e-3);
+
+    analyzer.setSpectrumSize(0);
+    analyzer.analyze(stereoSine(2400, 2400, 1500, 0.5f));
+    QTRY_COMPARE(spy.count(), 2);
+    QVERIFY(analyzer.analysis().spectrum().isEmpty());
+    QVERIFY(analyzer.analysis().rms(0) > 0);
+}
+
+void tst_QAudioAnalyzer::updateInterval_data()
+{
+    QTest::addColumn<int>("interval");
+    QTest::addColumn<int>("bufferFrames");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("buffer per update") << 50 << 2400 << 20;
+    QTest::newRow("updates per buffer") << 10 << 4800 << 100;
+    QTest::newRow("buffers per update") << 100 << 960 << 10;
+    QTest::newRow("unaligned") << 50 << 1000 << 20;
+}
+
+void tst_QAudioAnalyzer::updateInterval()
+{
+    QFETCH(int, interval);
+    QFETCH(int, bufferFrames);
+    QFETCH(int, expected);
+
+    QAudioAnalyzer analyzer;
+    analyzer.setUpdateInterval(interval);
+    QCOMPARE(analyzer.updateInterval(), interval);
+
+    QSignalSpy spy(&analyzer, SIGNAL(analysisChanged()));
+
+    // One second of audio, the rate of analyses follows the audio rather than the wall clock.
+    const int framesPerUpdate = SampleRate * interval / 1000;
+    for (int frame = 0; frame < SampleRate; frame += bufferFrames) {
+        analyzer.analyze(stereoSine(frame, bufferFrames, 1000, 0.5f));
+        QTRY_COMPARE(spy.count(), (frame + bufferFrames) / framesPerUpdate);
+    }
+    QCOMPARE(spy.count(), expected);
+    QCOMPARE(analyzer.droppedBufferCount(), quint64(0));
+
+    const QAudioAnalysis analysis = analyzer.analysis();
+    QCOMPARE(analysis.duration(), qint64(interval) * 1000);
+    QCOMPARE(analysis.startTime(), qint64(1000000 - interval * 1000));
+}
+
+void tst_QAudioAnalyzer::reset()
+{
+    QAudioAnalyzer analyzer;
+    QSignalSpy spy(&analyzer, SIGNAL(analysisChanged()));
+
+    analyzer.analyze(stereoSine(0, 1200, 1000, 0.5f));
+    analyzer.reset();
+    analyzer.analyze(stereoSine(1200, 1200, 1000, 0.5f));
+
+    // The frames before the reset don't count towards the update.
+    QTest::qWait(100);
+    QCOMPARE(spy.count(), 0);
+
+    analyzer.analyze(stereoSine(2400, 1200, 1000, 0.5f));
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(analyzer.analysis().startTime(), qint64(25000));
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioAnalyzer)
+
+#include "tst_qaudioanalyzer.moc"
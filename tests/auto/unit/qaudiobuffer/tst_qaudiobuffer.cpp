@@ -48,6 +48,10 @@ private Q_SLOTS:
     void durations();
     void durations_data();
     void stereoSample();
+    void convertedData_data();
+    void convertedData();
+    void sharedConversion();
+    void unsupportedConversion();
 
 private:
     QAudioFormat mFormat;
@@ -391,6 +395,133 @@ void tst_QAudioBuffer::stereoSample()
     QCOMPARE(s32f.average(), 0.0f);
 }
 
+void tst_QAudioBuffer::convertedData_data()
+{
+    QTest::addColumn<int>("channelCount");
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<QAudioFormat::SampleType>("sampleType");
+    QTest::addColumn<QAudioFormat::Endian>("byteOrder");
+
+    // Odd frame counts and channel counts cover the SIMD leftovers and the generic path.
+    QTest::newRow("mono int16") << 1 << 16 << QAudioFormat::SignedInt << QAudioFormat::LittleEndian;
+    QTest::newRow("stereo int16") << 2 << 16 << QAudioFormat::SignedInt << QAudioFormat::LittleEndian;
+    QTest::newRow("stereo int16 big endian") << 2 << 16 << QAudioFormat::SignedInt << QAudioFormat::BigEndian;
+    QTest::newRow("stereo uint16") << 2 << 16 << QAudioFormat::UnSignedInt << QAudioFormat::LittleEndian;
+    QTest::newRow("stereo float") << 2 << 32 << QAudioFormat::Float << QAudioFormat::LittleEndian;
+    QTest::newRow("3 channels int32") << 3 << 32 << QAudioFormat::SignedInt << QAudioFormat::LittleEndian;
+    QTest::newRow("6 channels uint8") << 6 << 8 << QAudioFormat::UnSignedInt << QAudioFormat::LittleEndian;
+}
+
+void tst_QAudioBuffer::convertedData()
+{
+    QFETCH(int, channelCount);
+    QFETCH(int, sampleSize);
+    QFETCH(QAudioFormat::SampleType, sampleType);
+    QFETCH(QAudioFormat::Endian, byteOrder);
+
+    QAudioFormat format;
+    format.setChannelCount(channelCount);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(byteOrder);
+    format.setSampleRate(8000);
+    format.setCodec("audio/pcm");
+
+    // Each sample holds (channel + 1) / 8, negated on odd frames.
+    const int frames = 2503;
+    QByteArray bytes(format.bytesForFrames(frames), '\0');
+    uchar *sample = reinterpret_cast<uchar *>(bytes.data());
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int channel = 0; channel < channelCount; ++channel, sample += sampleSize / 8) {
+            const double value = (frame % 2 ? -1 : 1) * (channel + 1) / 8.0;
+            quint32 raw;
+            if (sampleType == QAudioFormat::Float) {
+                const float f = float(value);
+                memcpy(&raw, &f, sizeof(raw));
+            } else {
+                raw = quint32(qint32(value * (1u << (sampleSize - 1))));
+                if (sampleType == QAudioFormat::UnSignedInt)
+                    raw ^= 1u << (sampleSize - 1);
+            }
+            for (int i = 0; i < sampleSize / 8; ++i) {
+                const int shift = byteOrder == QAudioFormat::LittleEndian ? 8 * i : sampleSize - 8 * (i + 1);
+                sample[i] = uchar(raw >> shift);
+            }
+        }
+    }
+
+    const QAudioBuffer buffer(bytes, format);
+    QCOMPARE(buffer.frameCount(), frames);
+
+    const float *interleaved = buffer.constFloatData();
+    const float *planar = buffer.constFloatData(QAudioBuffer::Planar);
+    const qint16 *interleaved16 = buffer.constInt16Data();
+    const qint16 *planar16 = buffer.constInt16Data(QAudioBuffer::Planar);
+    QVERIFY(interleaved);
+    QVERIFY(planar);
+    QVERIFY(interleaved16);
+    QVERIFY(planar16);
+
+    QVector<float> copy(buffer.sampleCount());
+    QVERIFY(buffer.convertTo(copy.data(), QAudioBuffer::Planar));
+    QVector<qint16> copy16(buffer.sampleCount());
+    QVERIFY(buffer.convertTo(copy16.data()));
+
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int channel = 0; channel < channelCount; ++channel) {
+            const float expected = (frame % 2 ? -1 : 1) * (channel + 1) / 8.0f;
+            const qint16 expected16 = qint16(expected * 32768);
+            const int i = frame * channelCount + channel;
+            const int p = channel * frames + frame;
+            QCOMPARE(interleaved[i], expected);
+            QCOMPARE(planar[p], expected);
+            QCOMPARE(copy[p], expected);
+            QCOMPARE(interleaved16[i], expected16);
+            QCOMPARE(planar16[p], expected16);
+            QCOMPARE(copy16[i], expected16);
+        }
+    }
+}
+
+void tst_QAudioBuffer::sharedConversion()
+{
+    QAudioFormat format;
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setSampleRate(8000);
+    format.setCodec("audio/pcm");
+
+    QAudioBuffer buffer(QByteArray(400, '\0'), format);
+    const QAudioBuffer copy = buffer;
+
+    // Converted once for all the copies.
+    const float *converted = buffer.constFloatData();
+    QVERIFY(converted);
+    QCOMPARE(copy.constFloatData(), converted);
+    QCOMPARE(converted[0], 0.0f);
+
+    // Writing detaches, and the conversion follows the new samples.
+    qint16 *samples = static_cast<qint16 *>(buffer.data());
+    samples[0] = 16384;
+    QCOMPARE(buffer.constFloatData()[0], 0.5f);
+    QCOMPARE(copy.constFloatData(), converted);
+    QCOMPARE(copy.constFloatData()[0], 0.0f);
+}
+
+void tst_QAudioBuffer::unsupportedConversion()
+{
+    QVERIFY(!mNull->constFloatData());
+    QVERIFY(!mNull->constInt16Data(QAudioBuffer::Planar));
+
+    float sample;
+    QVERIFY(!mNull->convertTo(&sample));
+
+    QAudioFormat format = mFormat;
+    format.setCodec("audio/mpeg");
+    const QAudioBuffer compressed(QByteArray(400, '\0'), format);
+    QVERIFY(!compressed.constFloatData());
+}
 
 QTEST_APPLESS_MAIN(tst_QAudioBuffer);
 
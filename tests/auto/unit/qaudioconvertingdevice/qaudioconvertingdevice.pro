@@ -0,0 +1,11 @@
+TARGET = tst_qaudioconvertingdevice
+
+QT += multimedia-private testlib
+CONFIG += testcase
+
+# The mock audio backend is linked into the test as a static plugin.
+DEFINES += QT_STATICPLUGIN
+
+SOURCES += tst_qaudioconvertingdevice.cpp
+
+OTHER_FILES += mockaudio.json
@@ -0,0 +1,462 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <QtCore/qplugin.h>
+
+#include <qaudioinput.h>
+#include <qaudiooutput.h>
+#include <qaudiosystemplugin.h>
+#include <private/qaudioconvertingdevice_p.h>
+#include <private/qaudioformatconverter_p.h>
+#include <private/qaudiosystempluginext_p.h>
+
+QT_USE_NAMESPACE
+
+static const char mockDeviceName[] = "Mock";
+
+static QAudioFormat nativeFormat()
+{
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+    return format;
+}
+
+static QAudioFormat floatFormat()
+{
+    QAudioFormat format = nativeFormat();
+    format.setSampleSize(32);
+    format.setSampleType(QAudioFormat::Float);
+    return format;
+}
+
+static QByteArray floatSamples(int frames)
+{
+    QByteArray data(frames * floatFormat().bytesPerFrame(), Qt::Uninitialized);
+    float *samples = reinterpret_cast<float *>(data.data());
+    for (int i = 0; i < frames * 2; ++i)
+        samples[i] = float(i % 100) / 100.0f - 0.5f;
+    return data;
+}
+
+static QByteArray converted(const QByteArray &data, const QAudioFormat &from, const QAudioFormat &to)
+{
+    QAudioFormatConverter converter(from, to, QAudioFormatConverter::defaultQuality());
+    QByteArray result(converter.outputBytesFor(data.size()), Qt::Uninitialized);
+    result.resize(converter.convert(data.constData(), data.size(), result.data()));
+    return result;
+}
+
+// Stands in for the device of a backend or an application, taking at most
+// `accept` bytes per write when it's not negative.
+class MockSink : public QIODevice
+{
+public:
+    MockSink() : accept(-1) { open(QIODevice::WriteOnly | QIODevice::Unbuffered); }
+
+    bool isSequential() const override { return true; }
+
+    QByteArray data;
+    int accept;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *buffer, qint64 len) override
+    {
+        const qint64 written = accept < 0 ? len : qMin<qint64>(len, accept);
+        data.append(buffer, int(written));
+        return written;
+    }
+};
+
+class MockSource : public QIODevice
+{
+public:
+    MockSource() { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return data.size() + QIODevice::bytesAvailable(); }
+
+    QByteArray data;
+
+protected:
+    qint64 writeData(const char *, qint64) override { return -1; }
+    qint64 readData(char *buffer, qint64 maxlen) override
+    {
+        const int read = int(qMin<qint64>(maxlen, data.size()));
+        memcpy(buffer, data.constData(), read);
+        data.remove(0, read);
+        return read;
+    }
+};
+
+class MockAudioOutput : public QAbstractAudioOutput, public QAudioStatisticsExtension
+{
+    Q_OBJECT
+    Q_INTERFACES(QAudioStatisticsExtension)
+public:
+    MockAudioOutput() : freeBytes(0), latency(-1), m_state(QAudio::StoppedState) { instance = this; }
+    ~MockAudioOutput() { if (instance == this) instance = nullptr; }
+
+    void start(QIODevice *) override { m_state = QAudio::ActiveState; }
+    QIODevice *start() override { m_state = QAudio::ActiveState; return &sink; }
+    void stop() override { m_state = QAudio::StoppedState; }
+    void reset() override {}
+    void suspend() override {}
+    void resume() override {}
+    int bytesFree() const override { return freeBytes; }
+    int periodSize() const override { return 1920; }
+    void setBufferSize(int) override {}
+    int bufferSize() const override { return 19200; }
+    void setNotifyInterval(int) override {}
+    int notifyInterval() const override { return 1000; }
+    qint64 processedUSecs() const override { return 0; }
+    qint64 elapsedUSecs() const override { return 0; }
+    QAudio::Error error() const override { return QAudio::NoError; }
+    QAudio::State state() const override { return m_state; }
+    void setFormat(const QAudioFormat &format) override { m_format = format; }
+    QAudioFormat format() const override { return m_format; }
+
+    QAudioStatistics statistics() const override
+    {
+        QAudioStatistics statistics;
+        statistics.setLatencyUSecs(latency);
+        return statistics;
+    }
+
+    static MockAudioOutput *instance;
+
+    MockSink sink;
+    int freeBytes;
+    qint64 latency;
+
+private:
+    QAudioFormat m_format;
+    QAudio::State m_state;
+};
+
+MockAudioOutput *MockAudioOutput::instance = nullptr;
+
+class MockAudioInput : public QAbstractAudioInput
+{
+    Q_OBJECT
+public:
+    MockAudioInput() : m_state(QAudio::StoppedState) { instance = this; }
+    ~MockAudioInput() { if (instance == this) instance = nullptr; }
+
+    void start(QIODevice *device) override { target = device; m_state = QAudio::ActiveState; }
+    QIODevice *start() override { m_state = QAudio::ActiveState; return &source; }
+    void stop() override { m_state = QAudio::StoppedState; }
+    void reset() override {}
+    void suspend() override {}
+    void resume() override {}
+    int bytesReady() const override { return int(source.bytesAvailable()); }
+    int periodSize() const override { return 1920; }
+    void setBufferSize(int) override {}
+    int bufferSize() const override { return 19200; }
+    void setNotifyInterval(int) override {}
+    int notifyInterval() const override { return 1000; }
+    qint64 processedUSecs() const override { return 0; }
+    qint64 elapsedUSecs() const override { return 0; }
+    QAudio::Error error() const override { return QAudio::NoError; }
+    QAudio::State state() const override { return m_state; }
+    void setFormat(const QAudioFormat &format) override { m_format = format; }
+    QAudioFormat format() const override { return m_format; }
+    void setVolume(qreal) override {}
+    qreal volume() const override { return 1.0; }
+
+    static MockAudioInput *instance;
+
+    MockSource source;
+    QPointer<QIODevice> target;
+
+private:
+    QAudioFormat m_format;
+    QAudio::State m_state;
+};
+
+MockAudioInput *MockAudioInput::instance = nullptr;
+
+// Supports nothing but nativeFormat().
+class MockAudioDeviceInfo : public QAbstractAudioDeviceInfo
+{
+public:
+    QAudioFormat preferredFormat() const override { return nativeFormat(); }
+    bool isFormatSupported(const QAudioFormat &format) const override { return format == nativeFormat(); }
+    QString deviceName() const override { return QLatin1String(mockDeviceName); }
+    QStringList supportedCodecs() override { return QStringList() << nativeFormat().codec(); }
+    QList<int> supportedSampleRates() override { return QList<int>() << nativeFormat().sampleRate(); }
+    QList<int> supportedChannelCounts() override { return QList<int>() << nativeFormat().channelCount(); }
+    QList<int> supportedSampleSizes() override { return QList<int>() << nativeFormat().sampleSize(); }
+    QList<QAudioFormat::Endian> supportedByteOrders() override { return QList<QAudioFormat::Endian>() << nativeFormat().byteOrder(); }
+    QList<QAudioFormat::SampleType> supportedSampleTypes() override { return QList<QAudioFormat::SampleType>() << nativeFormat().sampleType(); }
+};
+
+class MockAudioSystemPlugin : public QAudioSystemPlugin
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "org.qt-project.qt.audiosystemfactory/5.0" FILE "mockaudio.json")
+public:
+    QList<QByteArray> availableDevices(QAudio::Mode) const override
+    {
+        return QList<QByteArray>() << QByteArray(mockDeviceName);
+    }
+    QAbstractAudioInput *createInput(const QByteArray &) override { return new MockAudioInput; }
+    QAbstractAudioOutput *createOutput(const QByteArray &) override { return new MockAudioOutput; }
+    QAbstractAudioDeviceInfo *createDeviceInfo(const QByteArray &, QAudio::Mode) override
+    {
+        return new MockAudioDeviceInfo;
+    }
+};
+
+Q_IMPORT_PLUGIN(MockAudioSystemPlugin)
+
+static QAudioDeviceInfo mockDevice(QAudio::Mode mode)
+{
+    const QList<QAudioDeviceInfo> devices = QAudioDeviceInfo::availableDevices(mode);
+    for (const QAudioDeviceInfo &device : devices) {
+        if (device.deviceName() == QLatin1String(mockDeviceName))
+            return device;
+    }
+    return QAudioDeviceInfo();
+}
+
+class tst_QAudioConvertingDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void outputShortWrite();
+    void outputStatistics();
+    void outputReset();
+    void inputShortWrite();
+    void inputBytesReady();
+    void factoryOutput();
+    void factoryInput();
+};
+
+void tst_QAudioConvertingDevice::outputShortWrite()
+{
+    MockAudioOutput *backend = new MockAudioOutput;
+    backend->setFormat(nativeFormat());
+    QAudioConvertingOutput output(backend, floatFormat(), QAudioFormatConverter::defaultQuality());
+
+    // Room for 1000 frames, of which the backend's device takes 250 at a time.
+    backend->freeBytes = 1000 * nativeFormat().bytesPerFrame();
+    backend->sink.accept = 250 * nativeFormat().bytesPerFrame();
+    QCOMPARE(output.bytesFree(), 1000 * floatFormat().bytesPerFrame());
+
+    QIODevice *device = output.start();
+    QVERIFY(device);
+
+    // All of the input is converted, what the backend didn't take is held back.
+    const QByteArray first = floatSamples(1000);
+    QCOMPARE(device->write(first), qint64(first.size()));
+    QCOMPARE(backend->sink.data.size(), 250 * nativeFormat().bytesPerFrame());
+    QCOMPARE(output.bytesFree(), 250 * floatFormat().bytesPerFrame());
+
+    // Nothing new is accepted until the held back audio is written.
+    const QByteArray second = floatSamples(100);
+    QCOMPARE(device->write(second), qint64(0));
+    QCOMPARE(backend->sink.data.size(), 500 * nativeFormat().bytesPerFrame());
+
+    backend->sink.accept = -1;
+    QCOMPARE(device->write(second), qint64(second.size()));
+    QCOMPARE(backend->sink.data.size(), 1100 * nativeFormat().bytesPerFrame());
+
+    QCOMPARE(backend->sink.data, converted(first + second, floatFormat(), nativeFormat()));
+    QCOMPARE(output.bytesFree(), 1000 * floatFormat().bytesPerFrame());
+}
+
+void tst_QAudioConvertingDevice::outputStatistics()
+{
+    MockAudioOutput *backend = new MockAudioOutput;
+    backend->setFormat(nativeFormat());
+    backend->latency = 10000;
+    QAudioConvertingOutput output(backend, floatFormat(), QAudioFormatConverter::defaultQuality());
+
+    QCOMPARE(output.statistics().latencyUSecs(), qint64(10000));
+
+    backend->freeBytes = 1000 * nativeFormat().bytesPerFrame();
+    backend->sink.accept = 520 * nativeFormat().bytesPerFrame();
+
+    QIODevice *device = output.start();
+    QVERIFY(device);
+    QCOMPARE(device->write(floatSamples(1000)), qint64(1000 * floatFormat().bytesPerFrame()));
+
+    // The 480 frames held back are 10 ms of audio the backend doesn't know about.
+    const QAudioStatistics statistics = output.statistics();
+    QCOMPARE(statistics.latencyUSecs(), qint64(20000));
+    QCOMPARE(statistics.bytesBuffered(), 480 * floatFormat().bytesPerFrame());
+}
+
+void tst_QAudioConvertingDevice::outputReset()
+{
+    MockAudioOutput *backend = new MockAudioOutput;
+    backend->setFormat(nativeFormat());
+    QAudioConvertingOutput output(backend, floatFormat(), QAudioFormatConverter::defaultQuality());
+
+    backend->freeBytes = 1000 * nativeFormat().bytesPerFrame();
+    backend->sink.accept = 0;
+
+    QIODevice *device = output.start();
+    QVERIFY(device);
+    QCOMPARE(device->write(floatSamples(1000)), qint64(1000 * floatFormat().bytesPerFrame()));
+    QCOMPARE(output.bytesFree(), 0);
+
+    // Resetting drops the audio held back along with the backend's.
+    output.reset();
+    QCOMPARE(output.bytesFree(), 1000 * floatFormat().bytesPerFrame());
+
+    backend->sink.accept = -1;
+    const QByteArray data = floatSamples(10);
+    QCOMPARE(device->write(data), qint64(data.size()));
+    QCOMPARE(backend->sink.data, converted(data, floatFormat(), nativeFormat()));
+}
+
+void tst_QAudioConvertingDevice::inputShortWrite()
+{
+    MockAudioInput *backend = new MockAudioInput;
+    backend->setFormat(nativeFormat());
+    QAudioConvertingInput input(backend, floatFormat(), QAudioFormatConverter::defaultQuality());
+
+    MockSink sink;
+    sink.accept = 100 * floatFormat().bytesPerFrame();
+    input.start(&sink);
+    QVERIFY(backend->target);
+
+    // The backend's writes always succeed, the application's device catches up.
+    const QByteArray first = converted(floatSamples(300), floatFormat(), nativeFormat());
+    QCOMPARE(backend->target->write(first), qint64(first.size()));
+    QCOMPARE(sink.data.size(), 100 * floatFormat().bytesPerFrame());
+
+    const QByteArray second = converted(floatSamples(50), floatFormat(), nativeFormat());
+    QCOMPARE(backend->target->write(second), qint64(0));
+    QCOMPARE(sink.data.size(), 200 * floatFormat().bytesPerFrame());
+
+    sink.accept = -1;
+    QCOMPARE(backend->target->write(second), qint64(second.size()));
+    QCOMPARE(sink.data, converted(first + second, nativeFormat(), floatFormat()));
+}
+
+void tst_QAudioConvertingDevice::inputBytesReady()
+{
+    MockAudioInput *backend = new MockAudioInput;
+    backend->setFormat(nativeFormat());
+    QAudioConvertingInput input(backend, floatFormat(), QAudioFormatConverter::defaultQuality());
+
+    QIODevice *device = input.start();
+    QVERIFY(device);
+
+    const QByteArray data = converted(floatSamples(2), floatFormat(), nativeFormat());
+    const int frameBytes = nativeFormat().bytesPerFrame();
+
+    // One and a half frames; the half frame stays in the converting device.
+    backend->source.data = data.left(frameBytes + frameBytes / 2);
+    QCOMPARE(input.bytesReady(), floatFormat().bytesPerFrame());
+    QCOMPARE(device->read(1024).size(), floatFormat().bytesPerFrame());
+    QCOMPARE(input.bytesReady(), 0);
+
+    // The rest of the frame completes the one held back.
+    backend->source.data = data.mid(frameBytes + frameBytes / 2);
+    QCOMPARE(input.bytesReady(), floatFormat().bytesPerFrame());
+    QCOMPARE(device->read(1024).size(), floatFormat().bytesPerFrame());
+    QCOMPARE(input.bytesReady(), 0);
+}
+
+void tst_QAudioConvertingDevice::factoryOutput()
+{
+    const QAudioDeviceInfo info = mockDevice(QAudio::AudioOutput);
+    if (info.isNull())
+        QSKIP("The mock audio plugin wasn't loaded");
+
+    {
+        // The native format is used as is.
+        QAudioOutput output(info, nativeFormat());
+        QVERIFY(MockAudioOutput::instance);
+        QCOMPARE(MockAudioOutput::instance->format(), nativeFormat());
+
+        MockAudioOutput::instance->freeBytes = 4096;
+        QCOMPARE(output.bytesFree(), 4096);
+    }
+
+    QAudioOutput output(info, floatFormat());
+    MockAudioOutput *backend = MockAudioOutput::instance;
+    QVERIFY(backend);
+    QCOMPARE(backend->format(), nativeFormat());
+    QCOMPARE(output.format(), floatFormat());
+
+    backend->freeBytes = 1000 * nativeFormat().bytesPerFrame();
+    QCOMPARE(output.bytesFree(), 1000 * floatFormat().bytesPerFrame());
+
+    backend->sink.accept = 400 * nativeFormat().bytesPerFrame();
+    QIODevice *device = output.start();
+    QVERIFY(device);
+
+    const QByteArray data = floatSamples(1000);
+    QCOMPARE(device->write(data), qint64(data.size()));
+    QCOMPARE(output.bytesFree(), 400 * floatFormat().bytesPerFrame());
+
+    backend->sink.accept = -1;
+    const QByteArray tail = floatSamples(10);
+    QCOMPARE(device->write(tail), qint64(tail.size()));
+    QCOMPARE(backend->sink.data, converted(data + tail, floatFormat(), nativeFormat()));
+}
+
+void tst_QAudioConvertingDevice::factoryInput()
+{
+    const QAudioDeviceInfo info = mockDevice(QAudio::AudioInput);
+    if (info.isNull())
+        QSKIP("The mock audio plugin wasn't loaded");
+
+    QAudioInput input(info, floatFormat());
+    MockAudioInput *backend = MockAudioInput::instance;
+    QVERIFY(backend);
+    QCOMPARE(backend->format(), nativeFormat());
+    QCOMPARE(input.format(), floatFormat());
+
+    QIODevice *device = input.start();
+    QVERIFY(device);
+
+    const QByteArray data = converted(floatSamples(100), floatFormat(), nativeFormat());
+    backend->source.data = data;
+    QCOMPARE(input.bytesReady(), 100 * floatFormat().bytesPerFrame());
+    QCOMPARE(device->read(100 * floatFormat().bytesPerFrame()),
+             converted(data, nativeFormat(), floatFormat()));
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioConvertingDevice)
+
+#include "tst_qaudioconvertingdevice.moc"
@@ -0,0 +1,6 @@
+TARGET = tst_qaudioformatconverter
+
+QT += multimedia-private testlib
+CONFIG += testcase
+
+SOURCES += tst_qaudioformatconverter.cpp
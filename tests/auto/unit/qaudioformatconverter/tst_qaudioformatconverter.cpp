@@ -0,0 +1,355 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <QtCore/qendian.h>
+#include <QtCore/qmath.h>
+
+#include <qaudioformat.h>
+#include <private/qaudioformatconverter_p.h>
+
+QT_USE_NAMESPACE
+
+Q_DECLARE_METATYPE(QAudioFormatConverter::Quality)
+
+static QAudioFormat pcmFormat(int sampleRate, int channelCount, int sampleSize,
+                              QAudioFormat::SampleType sampleType,
+                              QAudioFormat::Endian byteOrder = QAudioFormat::LittleEndian)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channelCount);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(byteOrder);
+    format.setCodec(QStringLiteral("audio/pcm"));
+    return format;
+}
+
+static QVector<float> sine(int frames, int sampleRate, double frequency, float amplitude)
+{
+    QVector<float> samples(frames);
+    for (int i = 0; i < frames; ++i)
+        samples[i] = amplitude * float(qSin(2 * M_PI * frequency * i / sampleRate));
+    return samples;
+}
+
+class tst_QAudioFormatConverter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void canConvert();
+    void passthrough();
+    void sampleFormats_data();
+    void sampleFormats();
+    void saturation();
+    void defaultChannelMatrix();
+    void customChannelMatrix();
+    void resampleLength_data();
+    void resampleLength();
+    void resampleSine_data();
+    void resampleSine();
+    void reset();
+};
+
+void tst_QAudioFormatConverter::canConvert()
+{
+    const QAudioFormat s16 = pcmFormat(44100, 2, 16, QAudioFormat::SignedInt);
+    QVERIFY(QAudioFormatConverter::canConvert(s16, pcmFormat(48000, 6, 24, QAudioFormat::UnSignedInt)));
+    QVERIFY(QAudioFormatConverter::canConvert(s16, pcmFormat(8000, 1, 32, QAudioFormat::Float)));
+
+    QVERIFY(!QAudioFormatConverter::canConvert(s16, QAudioFormat()));
+    QVERIFY(!QAudioFormatConverter::canConvert(s16, pcmFormat(48000, 2, 64, QAudioFormat::Float)));
+
+    QAudioFormat compressed = s16;
+    compressed.setCodec(QStringLiteral("audio/mpeg"));
+    QVERIFY(!QAudioFormatConverter::canConvert(compressed, s16));
+
+    QAudioFormatConverter converter(s16, compressed);
+    QVERIFY(!converter.isValid());
+    QCOMPARE(converter.outputBytesFor(4096), 0);
+}
+
+void tst_QAudioFormatConverter::passthrough()
+{
+    const QAudioFormat format = pcmFormat(44100, 2, 16, QAudioFormat::SignedInt);
+    QAudioFormatConverter converter(format, format);
+    QVERIFY(converter.isValid());
+    QVERIFY(converter.isPassthrough());
+
+    QByteArray input(4000, '\0');
+    for (int i = 0; i < input.size(); ++i)
+        input[i] = char(i * 13);
+    QByteArray output(converter.outputBytesFor(input.size()), '\0');
+
+    QCOMPARE(converter.convert(input.constData(), input.size(), output.data()), input.size());
+    QCOMPARE(output, input);
+}
+
+void tst_QAudioFormatConverter::sampleFormats_data()
+{
+    QTest::addColumn<QAudioFormat>("format");
+    QTest::addColumn<int>("tolerance");
+
+    QTest::newRow("UInt8") << pcmFormat(8000, 1, 8, QAudioFormat::UnSignedInt) << 256;
+    QTest::newRow("Int8") << pcmFormat(8000, 1, 8, QAudioFormat::SignedInt) << 256;
+    QTest::newRow("UInt16 big endian") << pcmFormat(8000, 1, 16, QAudioFormat::UnSignedInt, QAudioFormat::BigEndian) << 0;
+    QTest::newRow("Int16 big endian") << pcmFormat(8000, 1, 16, QAudioFormat::SignedInt, QAudioFormat::BigEndian) << 0;
+    QTest::newRow("Int24") << pcmFormat(8000, 1, 24, QAudioFormat::SignedInt) << 0;
+    QTest::newRow("Int24 big endian") << pcmFormat(8000, 1, 24, QAudioFormat::SignedInt, QAudioFormat::BigEndian) << 0;
+    QTest::newRow("UInt24") << pcmFormat(8000, 1, 24, QAudioFormat::UnSignedInt) << 0;
+    QTest::newRow("Int32") << pcmFormat(8000, 1, 32, QAudioFormat::SignedInt) << 0;
+    QTest::newRow("UInt32 big endian") << pcmFormat(8000, 1, 32, QAudioFormat::UnSignedInt, QAudioFormat::BigEndian) << 0;
+    QTest::newRow("Float") << pcmFormat(8000, 1, 32, QAudioFormat::Float) << 0;
+    QTest::newRow("Float big endian") << pcmFormat(8000, 1, 32, QAudioFormat::Float, QAudioFormat::BigEndian) << 0;
+}
+
+void tst_QAudioFormatConverter::sampleFormats()
+{
+    QFETCH(QAudioFormat, format);
+    QFETCH(int, tolerance);
+
+    // Goes through the format and back to 16 bits. Odd lengths cover the SIMD leftovers.
+    const QAudioFormat s16 = pcmFormat(8000, 1, 16, QAudioFormat::SignedInt);
+    const QVector<qint16> input = { 0, 1000, -1000, 32767, -32768, 12345, -54, 7, 256, -256, 16384 };
+
+    QAudioFormatConverter to(s16, format);
+    QAudioFormatConverter from(format, s16);
+
+    const int inputBytes = input.size() * int(sizeof(qint16));
+    QByteArray converted(to.outputBytesFor(inputBytes), '\0');
+    QCOMPARE(converted.size(), input.size() * format.sampleSize() / 8);
+    QCOMPARE(to.convert(input.constData(), inputBytes, converted.data()), converted.size());
+
+    QVector<qint16> output(input.size());
+    QCOMPARE(from.convert(converted.constData(), converted.size(), output.data()), inputBytes);
+
+    for (int i = 0; i < input.size(); ++i)
+        QVERIFY2(qAbs(output.at(i) - input.at(i)) <= tolerance, qPrintable(QString::number(i)));
+}
+
+void tst_QAudioFormatConverter::saturation()
+{
+    const QAudioFormat f32 = pcmFormat(8000, 1, 32, QAudioFormat::Float);
+    const QVector<float> input = { 2.0f, -2.0f, 1e9f, -1e9f, 1.0f, -1.0f, 0.5f, 0.0f, 3.0f };
+    const QVector<qint16> expected = { 32767, -32768, 32767, -32768, 32767, -32768, 16384, 0, 32767 };
+
+    const QAudioFormat formats[] = {
+        pcmFormat(8000, 1, 16, QAudioFormat::SignedInt),
+        pcmFormat(8000, 1, 16, QAudioFormat::SignedInt, QAudioFormat::BigEndian)
+    };
+    for (const QAudioFormat &s16 : formats) {
+        QAudioFormatConverter converter(f32, s16);
+        QByteArray output(input.size() * 2, '\0');
+        QCOMPARE(converter.convert(input.constData(), input.size() * 4, output.data()), output.size());
+
+        for (int i = 0; i < input.size(); ++i) {
+            const uchar *sample = reinterpret_cast<const uchar *>(output.constData()) + i * 2;
+            const qint16 value = s16.byteOrder() == QAudioFormat::BigEndian
+                    ? qFromBigEndian<qint16>(sample) : qFromLittleEndian<qint16>(sample);
+            QCOMPARE(value, expected.at(i));
+        }
+    }
+}
+
+void tst_QAudioFormatConverter::defaultChannelMatrix()
+{
+    const QAudioFormat mono = pcmFormat(8000, 1, 32, QAudioFormat::Float);
+    const QAudioFormat stereo = pcmFormat(8000, 2, 32, QAudioFormat::Float);
+    const QAudioFormat surround = pcmFormat(8000, 6, 32, QAudioFormat::Float);
+
+    float output[6];
+
+    // Mono goes to the front pair only.
+    QAudioFormatConverter upmix(mono, surround);
+    const float one = 0.5f;
+    upmix.convert(&one, sizeof(float), output);
+    QCOMPARE(output[0], 0.5f);
+    QCOMPARE(output[1], 0.5f);
+    QCOMPARE(output[2], 0.0f);
+    QCOMPARE(output[5], 0.0f);
+
+    QAudioFormatConverter toMono(stereo, mono);
+    const float pair[2] = { 1.0f, 0.0f };
+    toMono.convert(pair, sizeof(pair), output);
+    QCOMPARE(output[0], 0.5f);
+
+    // A full scale 5.1 frame doesn't clip, and LFE is left out.
+    QAudioFormatConverter downmix(surround, stereo);
+    const float full[6] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    downmix.convert(full, sizeof(full), output);
+    QVERIFY(qAbs(output[0] - 1.0f) < 1e-6f);
+    QVERIFY(qAbs(output[1] - 1.0f) < 1e-6f);
+
+    const float lfe[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+    downmix.convert(lfe, sizeof(lfe), output);
+    QCOMPARE(output[0], 0.0f);
+    QCOMPARE(output[1], 0.0f);
+}
+
+void tst_QAudioFormatConverter::customChannelMatrix()
+{
+    const QAudioFormat stereo = pcmFormat(8000, 2, 32, QAudioFormat::Float);
+    QAudioFormatConverter converter(stereo, stereo);
+    QVERIFY(converter.isPassthrough());
+
+    // Swap left and right.
+    const QVector<float> swap = { 0.0f, 1.0f, 1.0f, 0.0f };
+    converter.setChannelMatrix(swap);
+    QCOMPARE(converter.channelMatrix(), swap);
+    QVERIFY(!converter.isPassthrough());
+
+    const float input[4] = { 0.25f, -0.5f, 0.75f, -1.0f };
+    float output[4];
+    QCOMPARE(converter.convert(input, sizeof(input), output), int(sizeof(output)));
+    QCOMPARE(output[0], -0.5f);
+    QCOMPARE(output[1], 0.25f);
+    QCOMPARE(output[2], -1.0f);
+    QCOMPARE(output[3], 0.75f);
+
+    QTest::ignoreMessage(QtWarningMsg, "QAudioFormatConverter: channel matrix of size 2, expected 4");
+    converter.setChannelMatrix(QVector<float>(2, 1.0f));
+    QCOMPARE(converter.channelMatrix(), swap);
+}
+
+void tst_QAudioFormatConverter::resampleLength_data()
+{
+    QTest::addColumn<int>("inputRate");
+    QTest::addColumn<int>("outputRate");
+    QTest::addColumn<QAudioFormatConverter::Quality>("quality");
+
+    QTest::newRow("44100 to 48000, fast") << 44100 << 48000 << QAudioFormatConverter::FastQuality;
+    QTest::newRow("44100 to 48000, medium") << 44100 << 48000 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("48000 to 44100, high") << 48000 << 44100 << QAudioFormatConverter::HighQuality;
+    QTest::newRow("8000 to 96000, medium") << 8000 << 96000 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("96000 to 8000, high") << 96000 << 8000 << QAudioFormatConverter::HighQuality;
+    QTest::newRow("22050 to 44100, fast") << 22050 << 44100 << QAudioFormatConverter::FastQuality;
+}
+
+void tst_QAudioFormatConverter::resampleLength()
+{
+    QFETCH(int, inputRate);
+    QFETCH(int, outputRate);
+    QFETCH(QAudioFormatConverter::Quality, quality);
+
+    const QAudioFormat in = pcmFormat(inputRate, 2, 16, QAudioFormat::SignedInt);
+    const QAudioFormat out = pcmFormat(outputRate, 2, 16, QAudioFormat::SignedInt);
+    QAudioFormatConverter converter(in, out, quality);
+    QVERIFY(converter.isValid());
+    QVERIFY(!converter.isPassthrough());
+
+    // Uneven pieces, some larger than the internal chunk size.
+    const int pieces[] = { 4, 1000, 12, 8000, 4 * 1023, 4 * 1025, 400 };
+    QByteArray input(8000, '\0');
+    int total = 0;
+    for (int bytes : pieces) {
+        const int expected = converter.outputBytesFor(bytes);
+        QByteArray output(expected, '\0');
+        QCOMPARE(converter.convert(input.constData(), bytes, output.data()), expected);
+        total += expected;
+
+        // inputBytesFor() is the largest input that fits.
+        const int limit = converter.inputBytesFor(expected + out.bytesPerFrame());
+        QVERIFY(converter.outputBytesFor(limit) <= expected + out.bytesPerFrame());
+        QVERIFY(converter.outputBytesFor(limit + in.bytesPerFrame()) > expected + out.bytesPerFrame());
+    }
+
+    // Apart from the filter delay, the length scales with the rates.
+    int frames = 0;
+    for (int bytes : pieces)
+        frames += bytes / in.bytesPerFrame();
+    const qint64 ideal = qint64(frames) * outputRate / inputRate;
+    const int produced = total / out.bytesPerFrame();
+    QVERIFY(produced <= ideal + 1);
+    QVERIFY(produced >= ideal - 512 * qMax(1, outputRate / inputRate));
+}
+
+void tst_QAudioFormatConverter::resampleSine_data()
+{
+    QTest::addColumn<int>("inputRate");
+    QTest::addColumn<int>("outputRate");
+    QTest::addColumn<QAudioFormatConverter::Quality>("quality");
+    QTest::addColumn<double>("tolerance");
+
+    QTest::newRow("44100 to 48000, fast") << 44100 << 48000 << QAudioFormatConverter::FastQuality << 5e-3;
+    QTest::newRow("44100 to 48000, medium") << 44100 << 48000 << QAudioFormatConverter::MediumQuality << 1e-3;
+    QTest::newRow("44100 to 48000, high") << 44100 << 48000 << QAudioFormatConverter::HighQuality << 1e-3;
+    QTest::newRow("48000 to 16000, medium") << 48000 << 16000 << QAudioFormatConverter::MediumQuality << 1e-3;
+    QTest::newRow("16000 to 44100, high") << 16000 << 44100 << QAudioFormatConverter::HighQuality << 2e-3;
+}
+
+void tst_QAudioFormatConverter::resampleSine()
+{
+    QFETCH(int, inputRate);
+    QFETCH(int, outputRate);
+    QFETCH(QAudioFormatConverter::Quality, quality);
+    QFETCH(double, tolerance);
+
+    const QAudioFormat in = pcmFormat(inputRate, 1, 32, QAudioFormat::Float);
+    const QAudioFormat out = pcmFormat(outputRate, 1, 32, QAudioFormat::Float);
+    QAudioFormatConverter converter(in, out, quality);
+
+    const double frequency = 1000;
+    const QVector<float> input = sine(inputRate, inputRate, frequency, 0.5f);
+    QVector<float> output(converter.outputBytesFor(input.size() * 4) / 4);
+    QCOMPARE(converter.convert(input.constData(), input.size() * 4, output.data()), output.size() * 4);
+    QVERIFY(output.size() > outputRate * 9 / 10);
+
+    // The first output frame is centered on the first input frame. Skip the filter's
+    // response to the start of the signal.
+    double maximumError = 0;
+    for (int i = 256; i < output.size(); ++i) {
+        const double expected = 0.5 * qSin(2 * M_PI * frequency * i / outputRate);
+        maximumError = qMax(maximumError, qAbs(expected - output.at(i)));
+    }
+    QVERIFY2(maximumError < tolerance, qPrintable(QString::number(maximumError)));
+}
+
+void tst_QAudioFormatConverter::reset()
+{
+    const QAudioFormat in = pcmFormat(44100, 1, 16, QAudioFormat::SignedInt);
+    const QAudioFormat out = pcmFormat(48000, 1, 16, QAudioFormat::SignedInt);
+    QAudioFormatConverter converter(in, out);
+
+    QByteArray input(2000, '\x40');
+    const int first = converter.outputBytesFor(input.size());
+    QByteArray output(first, '\0');
+    converter.convert(input.constData(), input.size(), output.data());
+    QVERIFY(converter.outputBytesFor(input.size()) > first);
+
+    converter.reset();
+    QCOMPARE(converter.outputBytesFor(input.size()), first);
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioFormatConverter)
+
+#include "tst_qaudioformatconverter.moc"
@@ -55,6 +55,7 @@ private slots:
     void testRecorderDeleteRecorder();
     void testRecorderDeleteProbe();
     void testMediaObject();
+    void testDeliveryMode();
 
 private:
     QAudioRecorder *recorder;
@@ -178,6 +179,27 @@ void tst_QAudioProbe::testMediaObject()
     delete object;
 }
 
+void tst_QAudioProbe::testDeliveryMode()
+{
+    QAudioProbe probe;
+    QCOMPARE(probe.deliveryMode(), QAudioProbe::QueuedDelivery);
+    QCOMPARE(probe.bufferSize(), 8);
+    QCOMPARE(probe.overflowPolicy(), QAudioProbe::DropOldest);
+
+    probe.setDeliveryMode(QAudioProbe::BufferedDelivery);
+    probe.setBufferSize(0);
+    probe.setOverflowPolicy(QAudioProbe::BlockOnOverflow);
+    QCOMPARE(probe.deliveryMode(), QAudioProbe::BufferedDelivery);
+    QCOMPARE(probe.bufferSize(), 1);
+    QCOMPARE(probe.overflowPolicy(), QAudioProbe::BlockOnOverflow);
+
+    // The mock control does not implement the delivery modes.
+    QAudioRecorder recorder;
+    QVERIFY(probe.setSource(&recorder));
+    QVERIFY(!probe.isDeliveryModeSupported());
+    QCOMPARE(probe.droppedBufferCount(), quint64(0));
+}
+
 QTEST_GUILESS_MAIN(tst_QAudioProbe)
 
 #include "tst_qaudioprobe.moc"
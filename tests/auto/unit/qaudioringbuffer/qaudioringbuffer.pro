@@ -0,0 +1,6 @@
+TARGET = tst_qaudioringbuffer
+
+QT += multimedia-private testlib
+CONFIG += testcase
+
+SOURCES += tst_qaudioringbuffer.cpp
@@ -0,0 +1,212 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <QtCore/qthread.h>
+
+#include <private/qaudioringbuffer_p.h>
+
+class tst_QAudioRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeAndRead();
+    void wrapAround();
+    void full();
+    void regions();
+    void reset();
+    void producerConsumer();
+};
+
+void tst_QAudioRingBuffer::writeAndRead()
+{
+    QAudioRingBuffer buffer(16);
+    QCOMPARE(buffer.size(), 16);
+    QCOMPARE(buffer.used(), 0);
+    QCOMPARE(buffer.free(), 16);
+
+    QCOMPARE(buffer.write("0123456789", 10), 10);
+    QCOMPARE(buffer.used(), 10);
+    QCOMPARE(buffer.free(), 6);
+
+    char data[16];
+    QCOMPARE(buffer.read(data, 4), 4);
+    QCOMPARE(QByteArray(data, 4), QByteArray("0123"));
+    QCOMPARE(buffer.read(data, 16), 6);
+    QCOMPARE(QByteArray(data, 6), QByteArray("456789"));
+    QCOMPARE(buffer.read(data, 16), 0);
+    QCOMPARE(buffer.used(), 0);
+}
+
+void tst_QAudioRingBuffer::wrapAround()
+{
+    QAudioRingBuffer buffer(7);
+
+    QByteArray written;
+    QByteArray read;
+    char data[7];
+    for (int i = 0; i < 100; ++i) {
+        const QByteArray chunk = QByteArray::number(i).rightJustified(1 + i % 5, 'x');
+        QCOMPARE(buffer.write(chunk.constData(), chunk.size()), chunk.size());
+        written += chunk;
+
+        const int n = buffer.read(data, 1 + i % 6);
+        read += QByteArray(data, n);
+
+        // Keep enough room for the next chunk.
+        while (buffer.free() < 5) {
+            const int m = buffer.read(data, 3);
+            read += QByteArray(data, m);
+        }
+    }
+    const int n = buffer.read(data, sizeof(data));
+    read += QByteArray(data, n);
+
+    QCOMPARE(read, written);
+}
+
+void tst_QAudioRingBuffer::full()
+{
+    QAudioRingBuffer buffer(8);
+
+    QCOMPARE(buffer.write("0123456789", 10), 8);
+    QCOMPARE(buffer.free(), 0);
+    QCOMPARE(buffer.write("0", 1), 0);
+
+    char data[4];
+    QCOMPARE(buffer.read(data, 3), 3);
+    QCOMPARE(buffer.write("89", 2), 2);
+    QCOMPARE(buffer.free(), 1);
+
+    char all[8];
+    QCOMPARE(buffer.read(all, 8), 7);
+    QCOMPARE(QByteArray(all, 7), QByteArray("3456789"));
+}
+
+void tst_QAudioRingBuffer::regions()
+{
+    QAudioRingBuffer buffer(8);
+
+    buffer.write("012345", 6);
+    char data[4];
+    buffer.read(data, 4);
+
+    // The free space wraps, only the part up to the end is one region.
+    QAudioRingBuffer::Region region = buffer.acquireWriteRegion(6);
+    QCOMPARE(region.second, 2);
+    memcpy(region.first, "ab", 2);
+    buffer.releaseWriteRegion(region);
+
+    region = buffer.acquireWriteRegion(6);
+    QCOMPARE(region.second, 4);
+    memcpy(region.first, "cdef", 4);
+    buffer.releaseWriteRegion(region);
+
+    QCOMPARE(buffer.acquireWriteRegion(1).second, 0);
+
+    region = buffer.acquireReadRegion(8);
+    QCOMPARE(QByteArray(region.first, region.second), QByteArray("45ab"));
+    buffer.releaseReadRegion(region);
+
+    region = buffer.acquireReadRegion(8);
+    QCOMPARE(QByteArray(region.first, region.second), QByteArray("cdef"));
+    buffer.releaseReadRegion(QAudioRingBuffer::Region(region.first, 1));
+    QCOMPARE(buffer.used(), 3);
+}
+
+void tst_QAudioRingBuffer::reset()
+{
+    QAudioRingBuffer buffer(8);
+
+    buffer.write("012345", 6);
+    buffer.reset();
+    QCOMPARE(buffer.used(), 0);
+    QCOMPARE(buffer.acquireWriteRegion(8).second, 8);
+}
+
+class RingBufferProducer : public QThread
+{
+public:
+    RingBufferProducer(QAudioRingBuffer *buffer, int total)
+        : m_buffer(buffer), m_total(total) {}
+
+protected:
+    void run() override
+    {
+        char chunk[37];
+        int produced = 0;
+        while (produced < m_total) {
+            const int size = qMin(int(sizeof(chunk)), m_total - produced);
+            for (int i = 0; i < size; ++i)
+                chunk[i] = char((produced + i) & 0xff);
+
+            int written = 0;
+            while (written < size) {
+                written += m_buffer->write(chunk + written, size - written);
+                if (written < size)
+                    QThread::yieldCurrentThread();
+            }
+            produced += size;
+        }
+    }
+
+private:
+    QAudioRingBuffer *m_buffer;
+    int m_total;
+};
+
+void tst_QAudioRingBuffer::producerConsumer()
+{
+    const int total = 1 << 20;
+    QAudioRingBuffer buffer(256);
+    RingBufferProducer producer(&buffer, total);
+    producer.start();
+
+    char data[53];
+    int consumed = 0;
+    bool inOrder = true;
+    while (consumed < total) {
+        const int n = buffer.read(data, sizeof(data));
+        for (int i = 0; i < n; ++i)
+            inOrder &= data[i] == char((consumed + i) & 0xff);
+        consumed += n;
+        if (n == 0)
+            QThread::yieldCurrentThread();
+    }
+
+    QVERIFY(producer.wait());
+    QVERIFY(inOrder);
+    QCOMPARE(buffer.used(), 0);
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioRingBuffer)
+
+#include "tst_qaudioringbuffer.moc"
@@ -0,0 +1,6 @@
+TARGET = tst_qaudiostatistics
+
+QT += multimedia-private testlib
+CONFIG += testcase
+
+SOURCES += tst_qaudiostatistics.cpp
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+
+#include <qaudiostatistics.h>
+#include <private/qaudiostatistics_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QAudioStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaults();
+    void setters();
+    void copies();
+    void jitterMeter();
+};
+
+void tst_QAudioStatistics::defaults()
+{
+    const QAudioStatistics statistics;
+    QCOMPARE(statistics.latencyUSecs(), qint64(-1));
+    QCOMPARE(statistics.bytesBuffered(), 0);
+    QCOMPARE(statistics.underrunCount(), 0);
+    QCOMPARE(statistics.overrunCount(), 0);
+    QCOMPARE(statistics.maxCallbackJitterUSecs(), qint64(0));
+}
+
+void tst_QAudioStatistics::setters()
+{
+    QAudioStatistics statistics;
+    statistics.setLatencyUSecs(42000);
+    statistics.setBytesBuffered(8820);
+    statistics.setUnderrunCount(3);
+    statistics.setOverrunCount(2);
+    statistics.setMaxCallbackJitterUSecs(1500);
+
+    QCOMPARE(statistics.latencyUSecs(), qint64(42000));
+    QCOMPARE(statistics.bytesBuffered(), 8820);
+    QCOMPARE(statistics.underrunCount(), 3);
+    QCOMPARE(statistics.overrunCount(), 2);
+    QCOMPARE(statistics.maxCallbackJitterUSecs(), qint64(1500));
+}
+
+void tst_QAudioStatistics::copies()
+{
+    QAudioStatistics statistics;
+    statistics.setUnderrunCount(1);
+
+    QAudioStatistics copy = statistics;
+    copy.setUnderrunCount(5);
+    QCOMPARE(statistics.underrunCount(), 1);
+    QCOMPARE(copy.underrunCount(), 5);
+
+    statistics = copy;
+    QCOMPARE(statistics.underrunCount(), 5);
+
+    const QVariant variant = QVariant::fromValue(statistics);
+    QCOMPARE(variant.value<QAudioStatistics>().underrunCount(), 5);
+}
+
+void tst_QAudioStatistics::jitterMeter()
+{
+    // The ticks come right after each other, so the jitter is about the expected interval.
+    const qint64 interval = 1000000;
+
+    QAudioJitterMeter meter;
+    meter.tick(interval);
+    QCOMPARE(meter.maxJitterUSecs(), qint64(0));
+
+    meter.tick(interval);
+    const qint64 jitter = meter.maxJitterUSecs();
+    QVERIFY(jitter > interval / 2);
+    QVERIFY(jitter <= interval);
+
+    // The gap after a pause isn't measured.
+    meter.pause();
+    meter.tick(0);
+    QCOMPARE(meter.maxJitterUSecs(), jitter);
+
+    meter.reset();
+    QCOMPARE(meter.maxJitterUSecs(), qint64(0));
+    meter.tick(interval);
+    QCOMPARE(meter.maxJitterUSecs(), qint64(0));
+}
+
+QTEST_MAIN(tst_QAudioStatistics)
+
+#include "tst_qaudiostatistics.moc"
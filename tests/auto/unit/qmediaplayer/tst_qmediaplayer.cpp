@@ -118,6 +118,8 @@ private slots:
     void testMediaStatus_data();
     void testMediaStatus();
     void testPlaylist();
+    void testGaplessPlaylist();
+    void testPreparedMedia();
 #ifndef QT_NO_BEARERMANAGEMENT
     void testNetworkAccess();
 #endif
@@ -1066,6 +1068,116 @@ void tst_QMediaPlayer::testDestructor()
     mockProvider->deleteServiceOnRelease = false;
 }
 
+void tst_QMediaPlayer::testGaplessPlaylist()
+{
+    QMediaContent content0(QUrl(QLatin1String("test://audio/song1.mp3")));
+    QMediaContent content1(QUrl(QLatin1String("test://audio/song2.mp3")));
+    QMediaContent content2(QUrl(QLatin1String("test://audio/song3.mp3")));
+
+    MockGaplessPlaybackControl *gaplessControl = mockService->mockGaplessControl;
+
+    mockService->setIsValid(true);
+    mockService->setState(QMediaPlayer::StoppedState, QMediaPlayer::NoMedia);
+
+    QMediaPlaylist *playlist = new QMediaPlaylist;
+    playlist->addMedia(content0);
+    playlist->addMedia(content1);
+    player->setPlaylist(playlist);
+
+    playlist->setCurrentIndex(0);
+    QCOMPARE(player->currentMedia(), content0);
+    QCOMPARE(gaplessControl->nextMedia(), content1);
+
+    // The next media follows changes to the playlist.
+    playlist->addMedia(content2);
+    QCOMPARE(gaplessControl->nextMedia(), content1);
+    playlist->removeMedia(1);
+    QCOMPARE(gaplessControl->nextMedia(), content2);
+    playlist->insertMedia(1, content1);
+    QCOMPARE(gaplessControl->nextMedia(), content1);
+
+    player->play();
+    QCOMPARE(player->state(), QMediaPlayer::PlayingState);
+
+    QSignalSpy stateSpy(player, SIGNAL(stateChanged(QMediaPlayer::State)));
+    QSignalSpy statusSpy(player, SIGNAL(mediaStatusChanged(QMediaPlayer::MediaStatus)));
+
+    // When the backend switches to the next media on its own, the playlist advances
+    // without the media being loaded again.
+    mockService->setMedia(content1);
+    gaplessControl->advance();
+    QCOMPARE(playlist->currentIndex(), 1);
+    QCOMPARE(player->currentMedia(), content1);
+    QCOMPARE(player->state(), QMediaPlayer::PlayingState);
+    QCOMPARE(gaplessControl->nextMedia(), content2);
+    QCOMPARE(stateSpy.count(), 0);
+    QCOMPARE(statusSpy.count(), 0);
+
+    // The last item has nothing queued after it.
+    mockService->setMedia(content2);
+    gaplessControl->advance();
+    QCOMPARE(playlist->currentIndex(), 2);
+    QCOMPARE(player->currentMedia(), content2);
+    QCOMPARE(gaplessControl->nextMedia(), QMediaContent());
+
+    // Looping playlists wrap around to the first item.
+    playlist->setPlaybackMode(QMediaPlaylist::Loop);
+    QCOMPARE(gaplessControl->nextMedia(), content0);
+
+    // A regular change of the current item still loads the media.
+    playlist->setCurrentIndex(1);
+    QCOMPARE(mockService->mockControl->media(), content1);
+    QCOMPARE(gaplessControl->nextMedia(), content2);
+
+    // Detaching the playlist clears the queued media.
+    player->setPlaylist(0);
+    QCOMPARE(gaplessControl->nextMedia(), QMediaContent());
+
+    delete playlist;
+}
+
+void tst_QMediaPlayer::testPreparedMedia()
+{
+    QMediaContent content0(QUrl(QLatin1String("test://video/movie1.mp4")));
+    QMediaContent content1(QUrl(QLatin1String("test://video/movie2.mp4")));
+
+    MockPreparationControl *preparationControl = mockService->mockPreparationControl;
+
+    mockService->setIsValid(true);
+    mockService->setState(QMediaPlayer::StoppedState, QMediaPlayer::NoMedia);
+
+    QSignalSpy spy(player, SIGNAL(preparedMediaChanged(QMediaContent)));
+
+    QCOMPARE(player->preparedMedia(), QMediaContent());
+
+    player->prepareMedia(content0);
+    QCOMPARE(preparationControl->preparedMedia(), content0);
+    QCOMPARE(player->preparedMedia(), content0);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(qvariant_cast<QMediaContent>(spy.last().value(0)), content0);
+
+    player->prepareMedia(content0);
+    QCOMPARE(spy.count(), 1);
+
+    player->prepareMedia(content1);
+    QCOMPARE(player->preparedMedia(), content1);
+    QCOMPARE(spy.count(), 2);
+
+    // Playlists and resources are loaded by the player, they can't be prepared.
+    QMediaPlaylist playlist;
+    QTest::ignoreMessage(QtWarningMsg, "QMediaPlayer::prepareMedia: only plain URLs can be prepared");
+    player->prepareMedia(QMediaContent(&playlist));
+    QTest::ignoreMessage(QtWarningMsg, "QMediaPlayer::prepareMedia: only plain URLs can be prepared");
+    player->prepareMedia(QMediaContent(QUrl(QLatin1String("qrc:/testdata/nokia-tune.mp3"))));
+    QCOMPARE(player->preparedMedia(), content1);
+    QCOMPARE(spy.count(), 2);
+
+    // Changes made by the service, like consuming the prepared media, are forwarded.
+    preparationControl->setPreparedMedia(QMediaContent());
+    QCOMPARE(player->preparedMedia(), QMediaContent());
+    QCOMPARE(spy.count(), 3);
+}
+
 #ifndef QT_NO_BEARERMANAGEMENT
 void tst_QMediaPlayer::testNetworkAccess()
 {
@@ -69,6 +69,7 @@ public slots:
 private slots:
     void construction();
     void append();
+    void appendMany();
     void insert();
     void clear();
     void removeMedia();
@@ -175,6 +176,40 @@ void tst_QMediaPlaylist::append()
     QCOMPARE(insertedSignalSpy.count(), 0);
 }
 
+void tst_QMediaPlaylist::appendMany()
+{
+    QMediaPlaylist playlist;
+    playlist.addMedia(content1);
+
+    QList<QMediaContent> contentList;
+    for (int i = 0; i < 10000; ++i)
+        contentList.append(QMediaContent(QUrl::fromLocalFile(QString::number(i))));
+
+    QSignalSpy aboutToBeInsertedSignalSpy(&playlist, SIGNAL(mediaAboutToBeInserted(int,int)));
+    QSignalSpy insertedSignalSpy(&playlist, SIGNAL(mediaInserted(int,int)));
+
+    QVERIFY(playlist.addMedia(contentList));
+    QCOMPARE(playlist.mediaCount(), 10001);
+
+    // The whole range is reported at once.
+    QCOMPARE(aboutToBeInsertedSignalSpy.count(), 1);
+    QCOMPARE(aboutToBeInsertedSignalSpy.first()[0].toInt(), 1);
+    QCOMPARE(aboutToBeInsertedSignalSpy.first()[1].toInt(), 10000);
+    QCOMPARE(insertedSignalSpy.count(), 1);
+    QCOMPARE(insertedSignalSpy.first()[0].toInt(), 1);
+    QCOMPARE(insertedSignalSpy.first()[1].toInt(), 10000);
+
+    QCOMPARE(playlist.media(0), content1);
+    QCOMPARE(playlist.media(1), contentList.first());
+    QCOMPARE(playlist.media(10000), contentList.last());
+
+    QSignalSpy removedSignalSpy(&playlist, SIGNAL(mediaRemoved(int,int)));
+    QVERIFY(playlist.removeMedia(1, 10000));
+    QCOMPARE(removedSignalSpy.count(), 1);
+    QCOMPARE(playlist.mediaCount(), 1);
+    QCOMPARE(playlist.media(0), content1);
+}
+
 void tst_QMediaPlaylist::insert()
 {
     QMediaPlaylist playlist;
@@ -704,6 +739,15 @@ void tst_QMediaPlaylist::shuffle()
 
     QVERIFY(contentList != shuffledContentList);
 
+    // The same items are still there, once each.
+    QStringList urls;
+    for (const QMediaContent &content : qAsConst(shuffledContentList))
+        urls.append(content.canonicalUrl().toLocalFile());
+    urls.sort();
+    urls.removeDuplicates();
+    QCOMPARE(urls.count(), contentList.count());
+    for (const QMediaContent &content : qAsConst(contentList))
+        QVERIFY(shuffledContentList.contains(content));
 }
 
 void tst_QMediaPlaylist::readOnlyPlaylist()
@@ -49,6 +49,9 @@ private slots:
     void currentItemOnce();
     void currentItemInLoop();
     void randomPlayback();
+    void randomPlaybackCycle();
+    void mediaInsertedBeforeCurrent();
+    void mediaRemovedBeforeCurrent();
 
     void testItemAt();
     void testNextIndex();
@@ -309,6 +312,78 @@ void tst_QMediaPlaylistNavigator::randomPlayback()
 
 }
 
+void tst_QMediaPlaylistNavigator::randomPlaybackCycle()
+{
+    QMediaNetworkPlaylistProvider playlist;
+    QMediaPlaylistNavigator navigator(&playlist);
+    navigator.setPlaybackMode(QMediaPlaylist::Random);
+
+    const int count = 50;
+    QList<QMediaContent> contentList;
+    for (int i = 0; i < count; ++i)
+        contentList.append(QMediaContent(QUrl(QLatin1String("file:///") + QString::number(i))));
+    playlist.addMedia(contentList);
+
+    // Every item is played once before any is repeated.
+    QVector<int> played;
+    for (int i = 0; i < count; ++i) {
+        navigator.next();
+        QVERIFY(navigator.currentIndex() != -1);
+        QVERIFY(!played.contains(navigator.currentIndex()));
+        played.append(navigator.currentIndex());
+    }
+
+    // The next cycle starts over in the same order.
+    navigator.next();
+    QCOMPARE(navigator.currentIndex(), played.first());
+    navigator.previous();
+    QCOMPARE(navigator.currentIndex(), played.last());
+
+    // Jumping continues the cycle from the item jumped to.
+    navigator.jump(played.at(10));
+    QCOMPARE(navigator.nextIndex(), played.at(11));
+    QCOMPARE(navigator.previousIndex(), played.at(9));
+}
+
+void tst_QMediaPlaylistNavigator::mediaInsertedBeforeCurrent()
+{
+    QMediaNetworkPlaylistProvider playlist;
+    QMediaPlaylistNavigator navigator(&playlist);
+
+    QMediaContent content1(QUrl(QLatin1String("file:///1")));
+    QMediaContent content2(QUrl(QLatin1String("file:///2")));
+    QMediaContent content3(QUrl(QLatin1String("file:///3")));
+    QMediaContent content4(QUrl(QLatin1String("file:///4")));
+
+    playlist.addMedia(content1);
+    playlist.addMedia(content2);
+    navigator.jump(1);
+    QCOMPARE(navigator.currentItem(), content2);
+
+    playlist.insertMedia(0, QList<QMediaContent>() << content3 << content4);
+    QCOMPARE(navigator.currentIndex(), 3);
+    QCOMPARE(navigator.currentItem(), content2);
+}
+
+void tst_QMediaPlaylistNavigator::mediaRemovedBeforeCurrent()
+{
+    QMediaNetworkPlaylistProvider playlist;
+    QMediaPlaylistNavigator navigator(&playlist);
+
+    QMediaContent content1(QUrl(QLatin1String("file:///1")));
+    QMediaContent content2(QUrl(QLatin1String("file:///2")));
+    QMediaContent content3(QUrl(QLatin1String("file:///3")));
+    QMediaContent content4(QUrl(QLatin1String("file:///4")));
+
+    playlist.addMedia(QList<QMediaContent>() << content1 << content2 << content3 << content4);
+    navigator.jump(3);
+    QCOMPARE(navigator.currentItem(), content4);
+
+    playlist.removeMedia(1, 2);
+    QCOMPARE(navigator.currentIndex(), 1);
+    QCOMPARE(navigator.currentItem(), content4);
+}
+
 void tst_QMediaPlaylistNavigator::testItemAt()
 {
     QMediaNetworkPlaylistProvider playlist;
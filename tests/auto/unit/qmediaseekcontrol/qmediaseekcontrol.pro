@@ -0,0 +1,9 @@
+CONFIG += testcase
+TARGET = tst_qmediaseekcontrol
+
+QT += multimedia-private testlib
+
+SOURCES += tst_qmediaseekcontrol.cpp
+
+include (../qmultimedia_common/mock.pri)
+include (../qmultimedia_common/mockplayer.pri)
@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <qmediaplayer.h>
+#include <qmediaservice.h>
+#include <qmediaseekcontrol.h>
+
+#include "mockmediaserviceprovider.h"
+#include "mockmediaplayerservice.h"
+
+QT_USE_NAMESPACE
+
+class tst_QMediaSeekControl : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+private slots:
+    void requestControl();
+    void setSeekFlags_data();
+    void setSeekFlags();
+    void flagsSurviveMediaChange();
+
+private:
+    MockMediaServiceProvider *mockProvider;
+    MockMediaPlayerService *mockService;
+    QMediaPlayer *player;
+};
+
+void tst_QMediaSeekControl::initTestCase()
+{
+    qRegisterMetaType<QMediaSeekControl::SeekFlags>();
+}
+
+void tst_QMediaSeekControl::init()
+{
+    mockService = new MockMediaPlayerService;
+    mockProvider = new MockMediaServiceProvider(mockService);
+    QMediaServiceProvider::setDefaultServiceProvider(mockProvider);
+
+    player = new QMediaPlayer;
+}
+
+void tst_QMediaSeekControl::cleanup()
+{
+    delete player;
+    delete mockProvider;
+    delete mockService;
+}
+
+void tst_QMediaSeekControl::requestControl()
+{
+    QVERIFY(player->service());
+
+    QMediaSeekControl *control = player->service()->requestControl<QMediaSeekControl *>();
+    QVERIFY(control);
+    QCOMPARE(control, mockService->mockSeekControl);
+    QCOMPARE(control->seekFlags(), QMediaSeekControl::NoSeekFlags);
+
+    // The control is looked up by its interface id.
+    QMediaControl *byName = player->service()->requestControl(QMediaSeekControl_iid);
+    QCOMPARE(qobject_cast<QMediaSeekControl *>(byName), control);
+
+    player->service()->releaseControl(byName);
+    player->service()->releaseControl(control);
+}
+
+void tst_QMediaSeekControl::setSeekFlags_data()
+{
+    QTest::addColumn<QMediaSeekControl::SeekFlags>("flags");
+
+    QTest::newRow("KeyUnit") << QMediaSeekControl::SeekFlags(QMediaSeekControl::KeyUnit);
+    QTest::newRow("KeyUnit|SnapBefore")
+            << (QMediaSeekControl::KeyUnit | QMediaSeekControl::SnapBefore);
+    QTest::newRow("KeyUnit|SnapAfter")
+            << (QMediaSeekControl::KeyUnit | QMediaSeekControl::SnapAfter);
+    QTest::newRow("Accurate") << QMediaSeekControl::SeekFlags(QMediaSeekControl::Accurate);
+}
+
+void tst_QMediaSeekControl::setSeekFlags()
+{
+    QFETCH(QMediaSeekControl::SeekFlags, flags);
+
+    QMediaSeekControl *control = player->service()->requestControl<QMediaSeekControl *>();
+    QVERIFY(control);
+
+    QSignalSpy spy(control, &QMediaSeekControl::seekFlagsChanged);
+
+    control->setSeekFlags(flags);
+    QCOMPARE(control->seekFlags(), flags);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).value<QMediaSeekControl::SeekFlags>(), flags);
+
+    // Setting the same flags again doesn't notify.
+    control->setSeekFlags(flags);
+    QCOMPARE(spy.count(), 1);
+
+    control->setSeekFlags(QMediaSeekControl::NoSeekFlags);
+    QCOMPARE(control->seekFlags(), QMediaSeekControl::NoSeekFlags);
+    QCOMPARE(spy.count(), 2);
+
+    player->service()->releaseControl(control);
+}
+
+void tst_QMediaSeekControl::flagsSurviveMediaChange()
+{
+    QMediaSeekControl *control = player->service()->requestControl<QMediaSeekControl *>();
+    QVERIFY(control);
+
+    QSignalSpy spy(control, &QMediaSeekControl::seekFlagsChanged);
+
+    control->setSeekFlags(QMediaSeekControl::Accurate);
+    QCOMPARE(spy.count(), 1);
+
+    player->setMedia(QUrl(QLatin1String("file:///some.mp4")));
+    player->setPosition(1000);
+    player->setMedia(QUrl(QLatin1String("file:///other.mp4")));
+
+    QCOMPARE(control->seekFlags(), QMediaSeekControl::SeekFlags(QMediaSeekControl::Accurate));
+    QCOMPARE(spy.count(), 1);
+
+    player->service()->releaseControl(control);
+}
+
+QTEST_GUILESS_MAIN(tst_QMediaSeekControl)
+
+#include "tst_qmediaseekcontrol.moc"
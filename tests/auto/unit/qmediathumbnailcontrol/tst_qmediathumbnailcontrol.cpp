@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <qmediaplayer.h>
+#include <qmediaservice.h>
+#include <qmediathumbnailcontrol.h>
+
+#include "mockmediaserviceprovider.h"
+#include "mockmediaplayerservice.h"
+
+QT_USE_NAMESPACE
+
+class tst_QMediaThumbnailControl : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void init();
+    void cleanup();
+
+private slots:
+    void requestControl();
+    void requestThumbnail();
+    void requestIds();
+    void cancelRequests();
+    void cacheLimit();
+
+private:
+    MockMediaServiceProvider *mockProvider;
+    MockMediaPlayerService *mockService;
+    QMediaPlayer *player;
+};
+
+void tst_QMediaThumbnailControl::init()
+{
+    mockService = new MockMediaPlayerService;
+    mockProvider = new MockMediaServiceProvider(mockService);
+    QMediaServiceProvider::setDefaultServiceProvider(mockProvider);
+
+    player = new QMediaPlayer;
+}
+
+void tst_QMediaThumbnailControl::cleanup()
+{
+    delete player;
+    delete mockProvider;
+    delete mockService;
+}
+
+void tst_QMediaThumbnailControl::requestControl()
+{
+    QVERIFY(player->service());
+
+    QMediaThumbnailControl *control = player->service()->requestControl<QMediaThumbnailControl *>();
+    QVERIFY(control);
+    QCOMPARE(control, mockService->mockThumbnailControl);
+
+    QMediaControl *byName = player->service()->requestControl(QMediaThumbnailControl_iid);
+    QCOMPARE(qobject_cast<QMediaThumbnailControl *>(byName), control);
+
+    player->service()->releaseControl(byName);
+    player->service()->releaseControl(control);
+}
+
+void tst_QMediaThumbnailControl::requestThumbnail()
+{
+    QMediaThumbnailControl *control = player->service()->requestControl<QMediaThumbnailControl *>();
+    QVERIFY(control);
+
+    QSignalSpy spy(control, &QMediaThumbnailControl::thumbnailReady);
+
+    const int id = control->requestThumbnail(2500, QSize(64, 48), QMediaSeekControl::KeyUnit);
+    QVERIFY(id > 0);
+    QCOMPARE(mockService->mockThumbnailControl->m_pendingRequests.count(), 1);
+
+    const MockMediaThumbnailControl::Request request
+            = mockService->mockThumbnailControl->m_pendingRequests.value(id);
+    QCOMPARE(request.position, qint64(2500));
+    QCOMPARE(request.size, QSize(64, 48));
+    QCOMPARE(request.flags, QMediaSeekControl::SeekFlags(QMediaSeekControl::KeyUnit));
+
+    // Nothing is delivered from within the request.
+    QCOMPARE(spy.count(), 0);
+
+    mockService->mockThumbnailControl->deliverPendingRequests();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toInt(), id);
+    QCOMPARE(spy.at(0).at(1).toLongLong(), qint64(2500));
+
+    const QImage image = spy.at(0).at(2).value<QImage>();
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.size(), QSize(64, 48));
+
+    player->service()->releaseControl(control);
+}
+
+void tst_QMediaThumbnailControl::requestIds()
+{
+    QMediaThumbnailControl *control = player->service()->requestControl<QMediaThumbnailControl *>();
+    QVERIFY(control);
+
+    QSignalSpy spy(control, &QMediaThumbnailControl::thumbnailReady);
+
+    // Identical requests are distinct and each one is answered.
+    const int first = control->requestThumbnail(1000, QSize(), QMediaSeekControl::NoSeekFlags);
+    const int second = control->requestThumbnail(1000, QSize(), QMediaSeekControl::NoSeekFlags);
+    const int third = control->requestThumbnail(3000, QSize(), QMediaSeekControl::Accurate);
+    QVERIFY(first != second);
+    QVERIFY(second != third);
+    QVERIFY(first != third);
+
+    mockService->mockThumbnailControl->deliverPendingRequests();
+    QCOMPARE(spy.count(), 3);
+
+    QSet<int> ids;
+    for (const QList<QVariant> &arguments : qAsConst(spy))
+        ids.insert(arguments.at(0).toInt());
+    QCOMPARE(ids, QSet<int>() << first << second << third);
+
+    player->service()->releaseControl(control);
+}
+
+void tst_QMediaThumbnailControl::cancelRequests()
+{
+    QMediaThumbnailControl *control = player->service()->requestControl<QMediaThumbnailControl *>();
+    QVERIFY(control);
+
+    QSignalSpy spy(control, &QMediaThumbnailControl::thumbnailReady);
+
+    control->requestThumbnail(1000, QSize(32, 24), QMediaSeekControl::NoSeekFlags);
+    control->requestThumbnail(2000, QSize(32, 24), QMediaSeekControl::NoSeekFlags);
+    control->cancelRequests();
+
+    mockService->mockThumbnailControl->deliverPendingRequests();
+    QCOMPARE(spy.count(), 0);
+
+    // Requests made after cancelling are answered again.
+    const int id = control->requestThumbnail(3000, QSize(32, 24), QMediaSeekControl::NoSeekFlags);
+    mockService->mockThumbnailControl->deliverPendingRequests();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toInt(), id);
+
+    player->service()->releaseControl(control);
+}
+
+void tst_QMediaThumbnailControl::cacheLimit()
+{
+    QMediaThumbnailControl *control = player->service()->requestControl<QMediaThumbnailControl *>();
+    QVERIFY(control);
+
+    QCOMPARE(control->cacheLimit(), 1024);
+
+    control->setCacheLimit(4096);
+    QCOMPARE(control->cacheLimit(), 4096);
+
+    // Zero disables caching, negative limits are clamped.
+    control->setCacheLimit(0);
+    QCOMPARE(control->cacheLimit(), 0);
+    control->setCacheLimit(-1);
+    QCOMPARE(control->cacheLimit(), 0);
+
+    player->service()->releaseControl(control);
+}
+
+QTEST_GUILESS_MAIN(tst_QMediaThumbnailControl)
+
+#include "tst_qmediathumbnailcontrol.moc"
@@ -59,6 +59,8 @@ private slots:
     void testClear();
     void testComparisons();
     void testArithmetic();
+    void testManyIntervals();
+    void testSelfArithmetic();
 };
 
 void tst_QMediaTimeRange::testIntervalCtor()
@@ -788,6 +790,84 @@ void tst_QMediaTimeRange::testArithmetic()
     QVERIFY(a.latestTime() == 14);
 }
 
+static bool matches(const QMediaTimeRange &range, const QVector<bool> &covered)
+{
+    for (int time = -1; time <= covered.size(); ++time) {
+        const bool expected = time >= 0 && time < covered.size() && covered.at(time);
+        if (range.contains(time) != expected)
+            return false;
+    }
+
+    // Intervals must be disjoint and not adjacent
+    const QList<QMediaTimeInterval> intervals = range.intervals();
+    for (int i = 1; i < intervals.count(); ++i) {
+        if (intervals.at(i).start() <= intervals.at(i - 1).end() + 1)
+            return false;
+    }
+    return true;
+}
+
+void tst_QMediaTimeRange::testManyIntervals()
+{
+    // Compare against a plain bitmap, with enough intervals to use the
+    // merging code paths of addTimeRange() and removeTimeRange().
+    QRandomGenerator random(1234);
+    QVector<bool> covered(2000, false);
+    QMediaTimeRange range;
+
+    for (int round = 0; round < 50; ++round) {
+        QMediaTimeRange other;
+        QVector<bool> otherCovered(covered.size(), false);
+        const int count = random.bounded(1, 40);
+        for (int i = 0; i < count; ++i) {
+            const int start = random.bounded(covered.size());
+            const int end = qMin(covered.size() - 1, start + random.bounded(30));
+            other.addInterval(start, end);
+            for (int t = start; t <= end; ++t)
+                otherCovered[t] = true;
+        }
+        QVERIFY(matches(other, otherCovered));
+
+        const bool add = round % 3 != 2;
+        if (add)
+            range += other;
+        else
+            range -= other;
+
+        for (int t = 0; t < covered.size(); ++t) {
+            if (otherCovered.at(t))
+                covered[t] = add;
+        }
+        QVERIFY(matches(range, covered));
+    }
+
+    // Single intervals spanning many existing ones
+    range.addInterval(100, 1900);
+    range.removeInterval(150, 1850);
+    QCOMPARE(range.contains(99), covered.at(99));
+    QVERIFY(range.contains(100));
+    QVERIFY(range.contains(149));
+    QVERIFY(!range.contains(150));
+    QVERIFY(!range.contains(1850));
+    QVERIFY(range.contains(1851));
+    QVERIFY(range.contains(1900));
+}
+
+void tst_QMediaTimeRange::testSelfArithmetic()
+{
+    QMediaTimeRange range;
+    for (int i = 0; i < 20; ++i)
+        range.addInterval(i * 10, i * 10 + 5);
+
+    const QMediaTimeRange copy = range;
+    range += range;
+    QCOMPARE(range, copy);
+
+    range -= range;
+    QVERIFY(range.isEmpty());
+    QCOMPARE(copy.intervals().count(), 20);
+}
+
 QTEST_MAIN(tst_QMediaTimeRange)
 
 #include "tst_qmediatimerange.moc"
@@ -0,0 +1,69 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef MOCKGAPLESSPLAYBACKCONTROL_H
+#define MOCKGAPLESSPLAYBACKCONTROL_H
+
+#include <qmediagaplessplaybackcontrol.h>
+
+class MockGaplessPlaybackControl : public QMediaGaplessPlaybackControl
+{
+    friend class MockMediaPlayerService;
+
+public:
+    MockGaplessPlaybackControl()
+        : QMediaGaplessPlaybackControl()
+    {
+    }
+
+    QMediaContent nextMedia() const
+    {
+        return m_nextMedia;
+    }
+
+    void setNextMedia(const QMediaContent &media)
+    {
+        if (media != m_nextMedia)
+            emit nextMediaChanged(m_nextMedia = media);
+    }
+
+    bool isCrossfadeSupported() const { return false; }
+    qreal crossfadeTime() const { return 0; }
+    void setCrossfadeTime(qreal) {}
+
+    void advance()
+    {
+        m_nextMedia = QMediaContent();
+        emit nextMediaChanged(m_nextMedia);
+        emit advancedToNextMedia();
+    }
+
+    QMediaContent m_nextMedia;
+};
+
+#endif // MOCKGAPLESSPLAYBACKCONTROL_H
@@ -39,6 +39,10 @@
 #include "mockvideowindowcontrol.h"
 #include "mockaudiorolecontrol.h"
 #include "mockcustomaudiorolecontrol.h"
+#include "mockgaplessplaybackcontrol.h"
+#include "mockpreparationcontrol.h"
+#include "mockmediaseekcontrol.h"
+#include "mockmediathumbnailcontrol.h"
 
 class MockMediaPlayerService : public QMediaService
 {
@@ -50,6 +54,10 @@ public:
         mockControl = new MockMediaPlayerControl;
         mockAudioRoleControl = new MockAudioRoleControl;
         mockCustomAudioRoleControl = new MockCustomAudioRoleControl;
+        mockGaplessControl = new MockGaplessPlaybackControl;
+        mockPreparationControl = new MockPreparationControl;
+        mockSeekControl = new MockMediaSeekControl;
+        mockThumbnailControl = new MockMediaThumbnailControl;
         mockStreamsControl = new MockStreamsControl;
         mockNetworkControl = new MockNetworkAccessControl;
         rendererControl = new MockVideoRendererControl;
@@ -59,6 +67,16 @@ public:
         windowRef = 0;
         enableAudioRole = true;
         enableCustomAudioRole = true;
+
+        // Like the backends, release the probe's streaming thread when stopping.
+        connect(mockControl, &MockMediaPlayerControl::stateChanged,
+                mockVideoProbeControl, [this](QMediaPlayer::State state) {
+            mockVideoProbeControl->setFlushing(state == QMediaPlayer::StoppedState);
+        });
+        connect(mockControl, &MockMediaPlayerControl::mediaChanged,
+                mockVideoProbeControl, [this]() {
+            mockVideoProbeControl->resetDroppedCount();
+        });
     }
 
     ~MockMediaPlayerService()
@@ -66,6 +84,10 @@ public:
         delete mockControl;
         delete mockAudioRoleControl;
         delete mockCustomAudioRoleControl;
+        delete mockGaplessControl;
+        delete mockPreparationControl;
+        delete mockSeekControl;
+        delete mockThumbnailControl;
         delete mockStreamsControl;
         delete mockNetworkControl;
         delete rendererControl;
@@ -98,6 +120,14 @@ public:
 
         if (qstrcmp(iid, QMediaNetworkAccessControl_iid) == 0)
             return mockNetworkControl;
+        if (qstrcmp(iid, QMediaGaplessPlaybackControl_iid) == 0)
+            return mockGaplessControl;
+        if (qstrcmp(iid, QMediaPreparationControl_iid) == 0)
+            return mockPreparationControl;
+        if (qstrcmp(iid, QMediaSeekControl_iid) == 0)
+            return mockSeekControl;
+        if (qstrcmp(iid, QMediaThumbnailControl_iid) == 0)
+            return mockThumbnailControl;
         return 0;
     }
 
@@ -158,6 +188,13 @@ public:
         enableCustomAudioRole = true;
         mockCustomAudioRoleControl->m_customAudioRole.clear();
 
+        mockGaplessControl->m_nextMedia = QMediaContent();
+        mockPreparationControl->m_preparedMedia = QMediaContent();
+
+        mockSeekControl->m_seekFlags = QMediaSeekControl::NoSeekFlags;
+        mockThumbnailControl->m_pendingRequests.clear();
+        mockThumbnailControl->m_cacheLimit = 1024;
+
         mockNetworkControl->_current = QNetworkConfiguration();
         mockNetworkControl->_configurations = QList<QNetworkConfiguration>();
     }
@@ -165,6 +202,10 @@ public:
     MockMediaPlayerControl *mockControl;
     MockAudioRoleControl *mockAudioRoleControl;
     MockCustomAudioRoleControl *mockCustomAudioRoleControl;
+    MockGaplessPlaybackControl *mockGaplessControl;
+    MockPreparationControl *mockPreparationControl;
+    MockMediaSeekControl *mockSeekControl;
+    MockMediaThumbnailControl *mockThumbnailControl;
     MockStreamsControl *mockStreamsControl;
     MockNetworkAccessControl *mockNetworkControl;
     MockVideoRendererControl *rendererControl;
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef MOCKMEDIATHUMBNAILCONTROL_H
+#define MOCKMEDIATHUMBNAILCONTROL_H
+
+#include <qmediathumbnailcontrol.h>
+
+#include <QtCore/qmap.h>
+#include <QtCore/qsize.h>
+#include <QtGui/qimage.h>
+
+class MockMediaThumbnailControl : public QMediaThumbnailControl
+{
+    friend class MockMediaPlayerService;
+
+public:
+    struct Request
+    {
+        qint64 position;
+        QSize size;
+        QMediaSeekControl::SeekFlags flags;
+    };
+
+    MockMediaThumbnailControl()
+        : QMediaThumbnailControl()
+        , m_cacheLimit(1024)
+        , m_nextRequestId(0)
+    {
+    }
+
+    int requestThumbnail(qint64 position, const QSize &size, QMediaSeekControl::SeekFlags flags)
+    {
+        const Request request = { position, size, flags };
+        const int id = ++m_nextRequestId;
+        m_pendingRequests.insert(id, request);
+        return id;
+    }
+
+    void cancelRequests()
+    {
+        m_pendingRequests.clear();
+    }
+
+    int cacheLimit() const
+    {
+        return m_cacheLimit;
+    }
+
+    void setCacheLimit(int kilobytes)
+    {
+        m_cacheLimit = qMax(kilobytes, 0);
+    }
+
+    // Completes every pending request with a solid image of the requested size.
+    void deliverPendingRequests()
+    {
+        const QMap<int, Request> requests = m_pendingRequests;
+        m_pendingRequests.clear();
+
+        for (auto it = requests.cbegin(); it != requests.cend(); ++it) {
+            const QSize size = it->size.isValid() ? it->size : QSize(160, 120);
+            QImage image(size, QImage::Format_RGB32);
+            image.fill(Qt::red);
+            emit thumbnailReady(it.key(), it->position, image);
+        }
+    }
+
+    QMap<int, Request> m_pendingRequests;
+    int m_cacheLimit;
+    int m_nextRequestId;
+};
+
+#endif // MOCKMEDIATHUMBNAILCONTROL_H
@@ -10,6 +10,10 @@ HEADERS *= \
     ../qmultimedia_common/mockmedianetworkaccesscontrol.h \
     ../qmultimedia_common/mockvideoprobecontrol.h \
     ../qmultimedia_common/mockaudiorolecontrol.h \
-    ../qmultimedia_common/mockcustomaudiorolecontrol.h
+    ../qmultimedia_common/mockcustomaudiorolecontrol.h \
+    ../qmultimedia_common/mockgaplessplaybackcontrol.h \
+    ../qmultimedia_common/mockpreparationcontrol.h \
+    ../qmultimedia_common/mockmediaseekcontrol.h \
+    ../qmultimedia_common/mockmediathumbnailcontrol.h
 
 include(mockvideo.pri)
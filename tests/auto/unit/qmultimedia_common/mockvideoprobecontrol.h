@@ -30,19 +30,43 @@
 #define MOCKVIDEOPROBECONTROL_H
 
 #include "qmediavideoprobecontrol.h"
+#include <qvideoframe.h>
+#include <private/qmediaprobedelivery_p.h>
 
-class MockVideoProbeControl : public QMediaVideoProbeControl
+class MockVideoProbeControl : public QMediaVideoProbeControl, public QMediaProbeQueue<QVideoFrame>
 {
     Q_OBJECT
+    Q_INTERFACES(QMediaProbeDelivery)
 public:
     MockVideoProbeControl(QObject *parent = 0):
         QMediaVideoProbeControl(parent)
     {
     }
 
-    ~MockVideoProbeControl() {}
+    ~MockVideoProbeControl() { clearQueue(); }
 
-private:
+    // Called by tests, possibly from another thread, like a streaming thread would.
+    void probeFrame(const QVideoFrame &frame)
+    {
+        switch (enqueue(frame)) {
+        case DeliverNow:
+            emit videoFrameProbed(frame);
+            break;
+        case ScheduleDelivery:
+            QMetaObject::invokeMethod(this, "frameProbed", Qt::QueuedConnection);
+            break;
+        case Ignore:
+            break;
+        }
+    }
+
+private slots:
+    void frameProbed()
+    {
+        const QQueue<QVideoFrame> frames = takeQueued();
+        for (const QVideoFrame &frame : frames)
+            emit videoFrameProbed(frame);
+    }
 };
 
 #endif // MOCKVIDEOPROBECONTROL_H
@@ -56,6 +56,8 @@ private slots:
     void present_data();
     void present();
     void presentOpaqueFrame();
+    void presentScaledFrame();
+    void framePacing();
 
 #if QT_CONFIG(opengl)
 
@@ -551,6 +553,116 @@ void tst_QPainterVideoSurface::presentOpaqueFrame()
     QCOMPARE(surface.error(), QAbstractVideoSurface::IncorrectFormatError);
 }
 
+void tst_QPainterVideoSurface::presentScaledFrame()
+{
+    QPainterVideoSurface surface;
+
+    QImage image(64, 64, QImage::Format_RGB32);
+    image.fill(Qt::black);
+
+    QVideoSurfaceFormat format(QSize(16, 16), QVideoFrame::Format_RGB32);
+
+    QVERIFY(surface.start(format));
+
+    QVideoFrame frameA(16 * 16 * 4, QSize(16, 16), 16 * 4, QVideoFrame::Format_RGB32);
+    QVERIFY(frameA.map(QAbstractVideoBuffer::WriteOnly));
+    std::fill_n(reinterpret_cast<quint32 *>(frameA.bits()), 16 * 16, 0xffff0000);
+    frameA.unmap();
+
+    QVERIFY(surface.present(frameA));
+
+    {
+        QPainter painter(&image);
+        surface.paint(&painter, QRect(0, 0, 64, 64));
+    }
+    QCOMPARE(surface.error(), QAbstractVideoSurface::NoError);
+    QCOMPARE(image.pixel(0, 0), 0xffff0000);
+    QCOMPARE(image.pixel(63, 63), 0xffff0000);
+
+    {   // Repainting without a new frame reuses the scaled image.
+        image.fill(Qt::black);
+        QPainter painter(&image);
+        surface.paint(&painter, QRect(0, 0, 64, 64));
+    }
+    QCOMPARE(surface.error(), QAbstractVideoSurface::NoError);
+    QCOMPARE(image.pixel(32, 32), 0xffff0000);
+
+    {   // A different target size rescales the frame.
+        image.fill(Qt::black);
+        QPainter painter(&image);
+        surface.paint(&painter, QRect(0, 0, 32, 32));
+    }
+    QCOMPARE(image.pixel(31, 31), 0xffff0000);
+    QCOMPARE(image.pixel(32, 32), 0xff000000);
+
+    QVideoFrame frameB(16 * 16 * 4, QSize(16, 16), 16 * 4, QVideoFrame::Format_RGB32);
+    QVERIFY(frameB.map(QAbstractVideoBuffer::WriteOnly));
+    std::fill_n(reinterpret_cast<quint32 *>(frameB.bits()), 16 * 16, 0xff0000ff);
+    frameB.unmap();
+
+    surface.setReady(true);
+    QVERIFY(surface.present(frameB));
+
+    {   // A new frame invalidates the scaled image.
+        QPainter painter(&image);
+        surface.paint(&painter, QRect(0, 0, 64, 64));
+    }
+    QCOMPARE(surface.error(), QAbstractVideoSurface::NoError);
+    QCOMPARE(image.pixel(0, 0), 0xff0000ff);
+    QCOMPARE(image.pixel(63, 63), 0xff0000ff);
+}
+
+void tst_QPainterVideoSurface::framePacing()
+{
+    QPainterVideoSurface surface;
+    surface.setRefreshRate(100);
+    QCOMPARE(surface.isFramePacingEnabled(), false);
+
+    surface.setFramePacingEnabled(true);
+    QCOMPARE(surface.isFramePacingEnabled(), true);
+
+    QSignalSpy frameSpy(&surface, SIGNAL(frameChanged()));
+
+    QVideoSurfaceFormat format(QSize(16, 16), QVideoFrame::Format_RGB32);
+    QVERIFY(surface.start(format));
+
+    QVideoFrame frameA(16 * 16 * 4, QSize(16, 16), 16 * 4, QVideoFrame::Format_RGB32);
+    frameA.setStartTime(0);
+
+    // The frame is queued and presented on the next tick.
+    QVERIFY(surface.present(frameA));
+    QCOMPARE(frameSpy.count(), 0);
+    QTRY_COMPARE(frameSpy.count(), 1);
+    QCOMPARE(surface.presentedFrameCount(), 1);
+    QCOMPARE(surface.isReady(), false);
+
+    // Frames are accepted while the current one is still to be painted.
+    for (int i = 1; i <= 3; ++i) {
+        QVideoFrame frame(16 * 16 * 4, QSize(16, 16), 16 * 4, QVideoFrame::Format_RGB32);
+        frame.setStartTime(i * 1000);
+        QVERIFY(surface.present(frame));
+    }
+    QTest::qWait(50);
+    QCOMPARE(frameSpy.count(), 1);
+
+    // Only the most recent due frame is presented, the others missed their slot.
+    surface.setReady(true);
+    QTRY_COMPARE(frameSpy.count(), 2);
+    QCOMPARE(surface.presentedFrameCount(), 2);
+    QCOMPARE(surface.droppedFrameCount(), 2);
+    QVERIFY(surface.lateFrameCount() >= 2);
+
+    // An empty frame flushes the surface immediately.
+    QVERIFY(surface.present(QVideoFrame()));
+    QCOMPARE(frameSpy.count(), 3);
+    QCOMPARE(surface.presentedFrameCount(), 2);
+
+    QVideoFrame frameB(16 * 16 * 4, QSize(32, 32), 16 * 4, QVideoFrame::Format_RGB32);
+    QVERIFY(!surface.present(frameB));
+    QCOMPARE(surface.error(), QAbstractVideoSurface::IncorrectFormatError);
+    QCOMPARE(surface.isActive(), false);
+}
+
 #if QT_CONFIG(opengl)
 
 void tst_QPainterVideoSurface::shaderType()
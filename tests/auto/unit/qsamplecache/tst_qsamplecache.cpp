@@ -30,6 +30,7 @@
 
 #include <QtTest/QtTest>
 #include <private/qsamplecache_p.h>
+#include <qaudiodecoder.h>
 
 class tst_QSampleCache : public QObject
 {
@@ -44,6 +45,8 @@ private slots:
     void testEnoughCapacity();
     void testNotEnoughCapacity();
     void testInvalidFile();
+    void testDiskCache();
+    void testDecodeToDiskCache();
 
 private:
 
@@ -181,6 +184,126 @@ void tst_QSampleCache::testInvalidFile()
     QVERIFY(!cache.isCached(QUrl::fromLocalFile("invalid")));
 }
 
+void tst_QSampleCache::testDiskCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // Anything that isn't a WAV file is looked up by content before being decoded.
+    const QByteArray encoded("not a wave file, but decoded already");
+    QFile source(dir.filePath("sample.ogg"));
+    QVERIFY(source.open(QIODevice::WriteOnly));
+    QCOMPARE(source.write(encoded), qint64(encoded.size()));
+    source.close();
+
+    QAudioFormat format;
+    format.setSampleRate(22050);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec("audio/pcm");
+
+    QByteArray pcm(22050 * 4, '\0');
+    for (int i = 0; i < pcm.size(); ++i)
+        pcm[i] = char(i);
+
+    QByteArray header(64, '\0');
+    uchar *h = reinterpret_cast<uchar *>(header.data());
+    memcpy(h, "QPCM", 4);
+    qToLittleEndian<quint32>(1, h + 4);
+    qToLittleEndian<qint32>(format.sampleRate(), h + 8);
+    qToLittleEndian<qint32>(format.channelCount(), h + 12);
+    qToLittleEndian<qint32>(format.sampleSize(), h + 16);
+    qToLittleEndian<qint32>(format.sampleType(), h + 20);
+    qToLittleEndian<qint32>(format.byteOrder(), h + 24);
+    qToLittleEndian<qint64>(pcm.size(), h + 32);
+
+    const QByteArray hash = QCryptographicHash::hash(encoded, QCryptographicHash::Sha1).toHex();
+    QFile decoded(dir.filePath(QString::fromLatin1(hash) + ".pcm"));
+    QVERIFY(decoded.open(QIODevice::WriteOnly));
+    QCOMPARE(decoded.write(header + pcm), qint64(header.size() + pcm.size()));
+    decoded.close();
+
+    QSampleCache cache;
+    cache.setDiskCacheDirectory(dir.path());
+    QCOMPARE(cache.diskCacheDirectory(), dir.path());
+
+    QSample* sample = cache.requestSample(QUrl::fromLocalFile(source.fileName()));
+    QVERIFY(sample);
+    QTRY_COMPARE(sample->state(), QSample::Ready);
+    QCOMPARE(sample->format(), format);
+    QCOMPARE(sample->data(), pcm);
+    QTRY_VERIFY(!cache.isLoading());
+    sample->release();
+}
+
+void tst_QSampleCache::testDecodeToDiskCache()
+{
+    QAudioDecoder decoder;
+    if (!decoder.isAvailable())
+        QSKIP("Audio decoder service is not available");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = QFINDTESTDATA("testdata/nokia-tune.mp3");
+    QVERIFY(!fileName.isEmpty());
+    const QUrl url = QUrl::fromLocalFile(fileName);
+
+    QFile source(fileName);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    const QByteArray hash = QCryptographicHash::hash(source.readAll(), QCryptographicHash::Sha1).toHex();
+    const QString cacheFileName = dir.filePath(QString::fromLatin1(hash) + ".pcm");
+
+    QAudioFormat format;
+    int size = 0;
+    {
+        QSampleCache cache;
+        cache.setDiskCacheDirectory(dir.path());
+
+        QSample *sample = cache.requestSample(url);
+        QVERIFY(sample);
+        QTRY_VERIFY_WITH_TIMEOUT(sample->state() == QSample::Ready || sample->state() == QSample::Error, 10000);
+        if (sample->state() == QSample::Error) {
+            sample->release();
+            QSKIP("MP3 decoding is not supported");
+        }
+
+        format = sample->format();
+        size = sample->data().size();
+        QVERIFY(format.isValid());
+        QVERIFY(size > 0);
+        QTRY_VERIFY(!cache.isLoading());
+        sample->release();
+    }
+
+    // The decoded audio was saved under the hash of the encoded file.
+    QVERIFY(QFile::exists(cacheFileName));
+    QFile cacheFile(cacheFileName);
+    QCOMPARE(cacheFile.size(), qint64(64 + size));
+
+    // Mark the cached audio, so that decoding again would be noticed.
+    QByteArray marked(size, '\0');
+    for (int i = 0; i < marked.size(); ++i)
+        marked[i] = char(i * 7);
+    QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+    QVERIFY(cacheFile.seek(64));
+    QCOMPARE(cacheFile.write(marked), qint64(size));
+    cacheFile.close();
+
+    QSampleCache cache;
+    cache.setDiskCacheDirectory(dir.path());
+
+    QSample *sample = cache.requestSample(url);
+    QVERIFY(sample);
+    QTRY_COMPARE(sample->state(), QSample::Ready);
+    QCOMPARE(sample->format(), format);
+    QCOMPARE(sample->data(), marked);
+    QTRY_VERIFY(!cache.isLoading());
+    sample->release();
+}
+
 QTEST_MAIN(tst_QSampleCache)
 
 #include "tst_qsamplecache.moc"
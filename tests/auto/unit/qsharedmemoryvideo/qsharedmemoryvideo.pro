@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qsharedmemoryvideo
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_qsharedmemoryvideo.cpp
@@ -0,0 +1,417 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qabstractvideosurface.h>
+#include <qsharedmemoryvideosource.h>
+#include <qsharedmemoryvideosurface.h>
+#include <qvideosurfaceformat.h>
+#include <private/qsharedmemoryvideo_p.h>
+
+#if defined(Q_OS_LINUX)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+class tst_QSharedMemoryVideo : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+
+    void connectConsumers();
+    void nameInUse();
+    void staleSocket();
+    void frameContent();
+    void planarFrame();
+    void readOnly();
+    void droppedFrames();
+    void surfaceDelivery();
+    void publisherStops();
+    void frameOutlivesPublisher();
+    void validateSlotHeader_data();
+    void validateSlotHeader();
+
+private:
+    QVideoFrame createFrame(const QSize &size, uchar value, qint64 startTime = -1);
+
+    QString m_name;
+};
+
+class TestSurface : public QAbstractVideoSurface
+{
+public:
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(
+            QAbstractVideoBuffer::HandleType type) const override
+    {
+        if (type != QAbstractVideoBuffer::NoHandle)
+            return QList<QVideoFrame::PixelFormat>();
+        return QList<QVideoFrame::PixelFormat>() << QVideoFrame::Format_RGB32;
+    }
+
+    bool present(const QVideoFrame &frame) override
+    {
+        frames.append(frame);
+        return true;
+    }
+
+    QList<QVideoFrame> frames;
+};
+
+void tst_QSharedMemoryVideo::init()
+{
+    static int count = 0;
+    m_name = QString::fromLatin1("tst_qsharedmemoryvideo-%1-%2")
+            .arg(QCoreApplication::applicationPid()).arg(++count);
+}
+
+QVideoFrame tst_QSharedMemoryVideo::createFrame(const QSize &size, uchar value, qint64 startTime)
+{
+    QVideoFrame frame(size.width() * size.height() * 4, size, size.width() * 4,
+                      QVideoFrame::Format_RGB32);
+    frame.map(QAbstractVideoBuffer::WriteOnly);
+    memset(frame.bits(), value, frame.mappedBytes());
+    frame.unmap();
+    frame.setStartTime(startTime);
+    return frame;
+}
+
+void tst_QSharedMemoryVideo::connectConsumers()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    QVERIFY(surface.isListening());
+    QCOMPARE(surface.name(), m_name);
+    QCOMPARE(surface.consumerCount(), 0);
+
+    QSharedMemoryVideoSource source1(m_name);
+    QSharedMemoryVideoSource source2(m_name);
+    QSignalSpy connectedSpy(&source1, &QSharedMemoryVideoSource::connectedChanged);
+
+    QVERIFY(source1.open());
+    QVERIFY(source1.isConnected());
+    QCOMPARE(connectedSpy.count(), 1);
+    QVERIFY(source2.open());
+    QTRY_COMPARE(surface.consumerCount(), 2);
+
+    source2.close();
+    QVERIFY(!source2.isConnected());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+
+    QSharedMemoryVideoSource missing(m_name + QLatin1String("-missing"));
+    QVERIFY(!missing.open());
+    QVERIFY(!missing.isConnected());
+}
+
+void tst_QSharedMemoryVideo::nameInUse()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    QVERIFY(surface.isListening());
+
+    {
+        // The live publisher keeps its socket.
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression("failed to listen"));
+        QSharedMemoryVideoSurface other(m_name);
+        QVERIFY(!other.isListening());
+    }
+
+    QSharedMemoryVideoSource source(m_name);
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+}
+
+void tst_QSharedMemoryVideo::staleSocket()
+{
+#if defined(Q_OS_LINUX)
+    // Leave a socket behind like a crashed publisher would.
+    const QByteArray path = QFile::encodeName(QSharedMemoryVideo::socketPath(m_name));
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    qstrncpy(address.sun_path, path.constData(), sizeof(address.sun_path));
+
+    const int socket = ::socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    QVERIFY(socket != -1);
+    QCOMPARE(::bind(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+    ::close(socket);
+    QVERIFY(QFile::exists(QFile::decodeName(path)));
+
+    QSharedMemoryVideoSurface surface(m_name);
+    QVERIFY(surface.isListening());
+
+    QSharedMemoryVideoSource source(m_name);
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+#else
+    QSKIP("Shared memory video is only supported on Linux");
+#endif
+}
+
+void tst_QSharedMemoryVideo::frameContent()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    QSharedMemoryVideoSource source(m_name);
+    QSignalSpy frameSpy(&source, &QSharedMemoryVideoSource::frameAvailable);
+
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+
+    QVERIFY(surface.start(QVideoSurfaceFormat(QSize(64, 48), QVideoFrame::Format_RGB32)));
+    QVERIFY(surface.present(createFrame(QSize(64, 48), 0x5a, 4000)));
+
+    QTRY_COMPARE(frameSpy.count(), 1);
+
+    QVideoFrame frame = source.latestFrame();
+    QVERIFY(frame.isValid());
+    QCOMPARE(frame.size(), QSize(64, 48));
+    QCOMPARE(frame.pixelFormat(), QVideoFrame::Format_RGB32);
+    QCOMPARE(frame.startTime(), qint64(4000));
+
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadOnly));
+    QCOMPARE(frame.bytesPerLine(), 64 * 4);
+    QCOMPARE(frame.mappedBytes(), 64 * 48 * 4);
+    QCOMPARE(frame.bits()[0], uchar(0x5a));
+    QCOMPARE(frame.bits()[frame.mappedBytes() - 1], uchar(0x5a));
+    frame.unmap();
+}
+
+void tst_QSharedMemoryVideo::planarFrame()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    QSharedMemoryVideoSource source(m_name);
+    QSignalSpy frameSpy(&source, &QSharedMemoryVideoSource::frameAvailable);
+
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+
+    const QSize size(32, 16);
+    QVideoFrame input(32 * 16 * 3 / 2, size, 32, QVideoFrame::Format_YUV420P);
+    QVERIFY(input.map(QAbstractVideoBuffer::WriteOnly));
+    QCOMPARE(input.planeCount(), 3);
+    memset(input.bits(0), 1, 32 * 16);
+    memset(input.bits(1), 2, 16 * 8);
+    memset(input.bits(2), 3, 16 * 8);
+    input.unmap();
+
+    QVERIFY(surface.start(QVideoSurfaceFormat(size, QVideoFrame::Format_YUV420P)));
+    QVERIFY(surface.present(input));
+    QTRY_COMPARE(frameSpy.count(), 1);
+
+    QVideoFrame frame = source.latestFrame();
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadOnly));
+    QCOMPARE(frame.planeCount(), 3);
+    QCOMPARE(frame.bytesPerLine(0), 32);
+    QCOMPARE(frame.bytesPerLine(1), 16);
+    QCOMPARE(frame.bits(0)[0], uchar(1));
+    QCOMPARE(frame.bits(1)[0], uchar(2));
+    QCOMPARE(frame.bits(2)[16 * 8 - 1], uchar(3));
+    frame.unmap();
+}
+
+void tst_QSharedMemoryVideo::readOnly()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    QSharedMemoryVideoSource source(m_name);
+    QSignalSpy frameSpy(&source, &QSharedMemoryVideoSource::frameAvailable);
+
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+
+    QVERIFY(surface.start(QVideoSurfaceFormat(QSize(16, 16), QVideoFrame::Format_RGB32)));
+    QVERIFY(surface.present(createFrame(QSize(16, 16), 1)));
+    QTRY_COMPARE(frameSpy.count(), 1);
+
+    QVideoFrame frame = source.latestFrame();
+    QVERIFY(!frame.map(QAbstractVideoBuffer::ReadWrite));
+    QVERIFY(!frame.map(QAbstractVideoBuffer::WriteOnly));
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadOnly));
+    frame.unmap();
+}
+
+void tst_QSharedMemoryVideo::droppedFrames()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    surface.setSlotCount(2);
+    QCOMPARE(surface.slotCount(), 2);
+
+    QSharedMemoryVideoSource source(m_name);
+    QSignalSpy frameSpy(&source, &QSharedMemoryVideoSource::frameAvailable);
+
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+
+    QVERIFY(surface.start(QVideoSurfaceFormat(QSize(16, 16), QVideoFrame::Format_RGB32)));
+
+    // Hold on to the frames of both slots.
+    QList<QVideoFrame> held;
+    for (int i = 0; i < 2; ++i) {
+        QVERIFY(surface.present(createFrame(QSize(16, 16), i)));
+        QTRY_COMPARE(frameSpy.count(), i + 1);
+        held.append(source.latestFrame());
+    }
+
+    QVERIFY(surface.present(createFrame(QSize(16, 16), 2)));
+    QCOMPARE(surface.droppedFrameCount(), 1);
+
+    // Releasing the older frame frees its slot.
+    held.removeFirst();
+    source.close();
+    QVERIFY(surface.present(createFrame(QSize(16, 16), 3)));
+    QCOMPARE(surface.droppedFrameCount(), 1);
+}
+
+void tst_QSharedMemoryVideo::surfaceDelivery()
+{
+    QSharedMemoryVideoSurface surface(m_name);
+    QSharedMemoryVideoSource source(m_name);
+    TestSurface output;
+    source.setVideoSurface(&output);
+    QCOMPARE(source.videoSurface(), &output);
+
+    QVERIFY(source.open());
+    QTRY_COMPARE(surface.consumerCount(), 1);
+
+    QVERIFY(surface.start(QVideoSurfaceFormat(QSize(16, 16), QVideoFrame::Format_RGB32)));
+    QVERIFY(surface.present(createFrame(QSize(16, 16), 1)));
+
+    QTRY_COMPARE(output.frames.count(), 1);
+    QVERIFY(output.isActive());
+    QCOMPARE(output.surfaceFormat().frameSize(), QSize(16, 16));
+
+    // A surface set later gets the latest frame right away.
+    TestSurface other;
+    source.setVideoSurface(&other);
+    QVERIFY(!output.isActive());
+    QVERIFY(other.isActive());
+    QCOMPARE(other.frames.count(), 1);
+}
+
+void tst_QSharedMemoryVideo::publisherStops()
+{
+    QSharedMemoryVideoSource source(m_name);
+    TestSurface output;
+    source.setVideoSurface(&output);
+
+    {
+        QSharedMemoryVideoSurface surface(m_name);
+        QVERIFY(source.open());
+        QTRY_COMPARE(surface.consumerCount(), 1);
+
+        QVERIFY(surface.start(QVideoSurfaceFormat(QSize(16, 16), QVideoFrame::Format_RGB32)));
+        QVERIFY(surface.present(createFrame(QSize(16, 16), 1)));
+        QTRY_VERIFY(output.isActive());
+
+        surface.stop();
+        QTRY_VERIFY(!output.isActive());
+        QVERIFY(!source.latestFrame().isValid());
+        QVERIFY(source.isConnected());
+    }
+
+    QTRY_VERIFY(!source.isConnected());
+}
+
+void tst_QSharedMemoryVideo::frameOutlivesPublisher()
+{
+    QSharedMemoryVideoSource source(m_name);
+    QSignalSpy frameSpy(&source, &QSharedMemoryVideoSource::frameAvailable);
+    QVideoFrame frame;
+
+    {
+        QSharedMemoryVideoSurface surface(m_name);
+        QVERIFY(source.open());
+        QTRY_COMPARE(surface.consumerCount(), 1);
+
+        QVERIFY(surface.start(QVideoSurfaceFormat(QSize(16, 16), QVideoFrame::Format_RGB32)));
+        QVERIFY(surface.present(createFrame(QSize(16, 16), 0x7f)));
+        QTRY_COMPARE(frameSpy.count(), 1);
+        frame = source.latestFrame();
+    }
+
+    QTRY_VERIFY(!source.isConnected());
+
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadOnly));
+    QCOMPARE(frame.bits()[0], uchar(0x7f));
+    frame.unmap();
+}
+
+void tst_QSharedMemoryVideo::validateSlotHeader_data()
+{
+    QTest::addColumn<int>("pixelFormat");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("planeCount");
+    QTest::addColumn<int>("bytesPerLine");
+    QTest::addColumn<int>("lastPlaneOffset");
+    QTest::addColumn<bool>("valid");
+
+    // The slot has 4096 bytes, as much as a 32x32 RGB32 frame takes.
+    QTest::newRow("rgb32") << int(QVideoFrame::Format_RGB32) << QSize(32, 32) << 1 << 128 << 0 << true;
+    QTest::newRow("yuv420p") << int(QVideoFrame::Format_YUV420P) << QSize(32, 32) << 3 << 32 << 1280 << true;
+    QTest::newRow("user format") << int(QVideoFrame::Format_User) << QSize(32, 32) << 1 << 128 << 0 << true;
+    QTest::newRow("invalid format") << int(QVideoFrame::Format_Invalid) << QSize(32, 32) << 1 << 128 << 0 << false;
+    QTest::newRow("unknown format") << int(QVideoFrame::Format_User - 1) << QSize(32, 32) << 1 << 128 << 0 << false;
+    QTest::newRow("empty") << int(QVideoFrame::Format_RGB32) << QSize(0, 32) << 1 << 128 << 0 << false;
+    QTest::newRow("negative") << int(QVideoFrame::Format_RGB32) << QSize(32, -1) << 1 << 128 << 0 << false;
+    QTest::newRow("no planes") << int(QVideoFrame::Format_RGB32) << QSize(32, 32) << 0 << 128 << 0 << false;
+    QTest::newRow("too many planes") << int(QVideoFrame::Format_RGB32) << QSize(32, 32) << 5 << 128 << 0 << false;
+    QTest::newRow("plane too large") << int(QVideoFrame::Format_RGB32) << QSize(32, 33) << 1 << 128 << 0 << false;
+    QTest::newRow("line too long") << int(QVideoFrame::Format_RGB32) << QSize(32, 32) << 1 << 129 << 0 << false;
+    QTest::newRow("negative line") << int(QVideoFrame::Format_RGB32) << QSize(32, 32) << 1 << -128 << 0 << false;
+    QTest::newRow("plane outside") << int(QVideoFrame::Format_YUV420P) << QSize(32, 32) << 3 << 32 << 3900 << false;
+    QTest::newRow("negative offset") << int(QVideoFrame::Format_YUV420P) << QSize(32, 32) << 3 << 32 << -16 << false;
+}
+
+void tst_QSharedMemoryVideo::validateSlotHeader()
+{
+    QFETCH(int, pixelFormat);
+    QFETCH(QSize, size);
+    QFETCH(int, planeCount);
+    QFETCH(int, bytesPerLine);
+    QFETCH(int, lastPlaneOffset);
+    QFETCH(bool, valid);
+
+    QSharedMemoryVideo::SlotHeader header;
+    memset(static_cast<void *>(&header), 0, sizeof(header));
+    header.pixelFormat = pixelFormat;
+    header.width = size.width();
+    header.height = size.height();
+    header.mappedBytes = 1024;
+    header.planeCount = planeCount;
+    for (int plane = 0; plane < qMin(planeCount, int(QSharedMemoryVideo::MaximumPlanes)); ++plane) {
+        header.bytesPerLine[plane] = plane == 0 ? bytesPerLine : bytesPerLine / 2;
+        header.planeOffset[plane] = plane == 0 ? 0 : 1024;
+    }
+    if (planeCount > 1 && planeCount <= QSharedMemoryVideo::MaximumPlanes)
+        header.planeOffset[planeCount - 1] = lastPlaneOffset;
+
+    QCOMPARE(QSharedMemoryVideo::isValidFrame(header, 4096), valid);
+}
+
+QTEST_MAIN(tst_QSharedMemoryVideo)
+
+#include "tst_qsharedmemoryvideo.moc"
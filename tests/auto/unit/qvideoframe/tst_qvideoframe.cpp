@@ -791,6 +791,14 @@ void tst_QVideoFrame::mapPlanes_data()
             << QVideoFrame(8096, QSize(60, 64), 64, QVideoFrame::Format_IMC4)
             << (QList<int>() << 64 << 64)
             << (QList<int>() << 4096);
+    QTest::newRow("Format_P010")
+            << QVideoFrame(12288, QSize(60, 64), 128, QVideoFrame::Format_P010)
+            << (QList<int>() << 128 << 128)
+            << (QList<int>() << 8192);
+    QTest::newRow("Format_P016")
+            << QVideoFrame(12288, QSize(60, 64), 128, QVideoFrame::Format_P016)
+            << (QList<int>() << 128 << 128)
+            << (QList<int>() << 8192);
     QTest::newRow("Format_IMC1")
             << QVideoFrame(8096, QSize(60, 64), 64, QVideoFrame::Format_IMC1)
             << (QList<int>() << 64 << 64 << 64)
@@ -985,6 +993,12 @@ void tst_QVideoFrame::formatConversion_data()
     QTest::newRow("QVideoFrame::Format_AdobeDng")
             << QImage::Format_Invalid
             << QVideoFrame::Format_AdobeDng;
+    QTest::newRow("QVideoFrame::Format_P010")
+            << QImage::Format_Invalid
+            << QVideoFrame::Format_P010;
+    QTest::newRow("QVideoFrame::Format_P016")
+            << QImage::Format_Invalid
+            << QVideoFrame::Format_P016;
     QTest::newRow("QVideoFrame::Format_User")
             << QImage::Format_Invalid
             << QVideoFrame::Format_User;
@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qvideoframepool
+
+QT += core multimedia testlib
+
+SOURCES += tst_qvideoframepool.cpp
@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+
+#include <qvideoframepool.h>
+
+class tst_QVideoFramePool : public QObject
+{
+    Q_OBJECT
+private slots:
+    void allocate();
+    void recycle();
+    void separateLayouts();
+    void maximumBufferCount();
+    void outlivePool();
+    void invalidSize();
+};
+
+void tst_QVideoFramePool::allocate()
+{
+    QVideoFramePool pool;
+
+    QVideoFrame frame = pool.allocate(64 * 48 * 4, QSize(64, 48), 64 * 4, QVideoFrame::Format_RGB32);
+    QVERIFY(frame.isValid());
+    QCOMPARE(frame.size(), QSize(64, 48));
+    QCOMPARE(frame.pixelFormat(), QVideoFrame::Format_RGB32);
+    QCOMPARE(frame.handleType(), QAbstractVideoBuffer::NoHandle);
+
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadWrite));
+    QCOMPARE(frame.mappedBytes(), 64 * 48 * 4);
+    QCOMPARE(frame.bytesPerLine(), 64 * 4);
+    QVERIFY(frame.bits());
+    frame.unmap();
+
+    QCOMPARE(pool.hitCount(), 0);
+    QCOMPARE(pool.missCount(), 1);
+    QCOMPARE(pool.freeBufferCount(), 0);
+}
+
+void tst_QVideoFramePool::recycle()
+{
+    QVideoFramePool pool;
+
+    uchar *bits = 0;
+    {
+        QVideoFrame frame = pool.allocate(64 * 48 * 4, QSize(64, 48), 64 * 4, QVideoFrame::Format_RGB32);
+        QVERIFY(frame.map(QAbstractVideoBuffer::WriteOnly));
+        bits = frame.bits();
+
+        QVideoFrame copy = frame;
+        frame = QVideoFrame();
+        // Still referenced by the copy.
+        QCOMPARE(pool.freeBufferCount(), 0);
+    }
+    QCOMPARE(pool.freeBufferCount(), 1);
+
+    QVideoFrame frame = pool.allocate(64 * 48 * 4, QSize(64, 48), 64 * 4, QVideoFrame::Format_RGB32);
+    QCOMPARE(pool.freeBufferCount(), 0);
+    QCOMPARE(pool.hitCount(), 1);
+    QCOMPARE(pool.missCount(), 1);
+
+    // The buffer is returned unmapped and with the same memory.
+    QVERIFY(!frame.isMapped());
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadOnly));
+    QCOMPARE(frame.bits(), bits);
+    frame.unmap();
+
+    pool.resetStatistics();
+    QCOMPARE(pool.hitCount(), 0);
+    QCOMPARE(pool.missCount(), 0);
+}
+
+void tst_QVideoFramePool::separateLayouts()
+{
+    QVideoFramePool pool;
+
+    pool.allocate(64 * 48 * 4, QSize(64, 48), 64 * 4, QVideoFrame::Format_RGB32);
+    QCOMPARE(pool.freeBufferCount(), 1);
+
+    // Same number of bytes, different format.
+    QVideoFrame frame = pool.allocate(64 * 48 * 4, QSize(64, 48), 64 * 4, QVideoFrame::Format_ARGB32);
+    QCOMPARE(pool.hitCount(), 0);
+    QCOMPARE(pool.missCount(), 2);
+    QCOMPARE(pool.freeBufferCount(), 1);
+
+    frame = pool.allocate(32 * 48 * 4, QSize(32, 48), 32 * 4, QVideoFrame::Format_RGB32);
+    QCOMPARE(pool.missCount(), 3);
+    QCOMPARE(pool.freeBufferCount(), 2);
+
+    frame = pool.allocate(64 * 48 * 4, QSize(64, 48), 64 * 4, QVideoFrame::Format_ARGB32);
+    QCOMPARE(pool.hitCount(), 1);
+
+    pool.clear();
+    QCOMPARE(pool.freeBufferCount(), 0);
+}
+
+void tst_QVideoFramePool::maximumBufferCount()
+{
+    QVideoFramePool pool(2);
+    QCOMPARE(pool.maximumBufferCount(), 2);
+
+    {
+        QList<QVideoFrame> frames;
+        for (int i = 0; i < 4; ++i)
+            frames.append(pool.allocate(16 * 16, QSize(16, 16), 16, QVideoFrame::Format_Y8));
+    }
+    QCOMPARE(pool.freeBufferCount(), 2);
+
+    pool.setMaximumBufferCount(1);
+    QCOMPARE(pool.maximumBufferCount(), 1);
+    QCOMPARE(pool.freeBufferCount(), 1);
+
+    pool.setMaximumBufferCount(0);
+    QCOMPARE(pool.freeBufferCount(), 0);
+
+    pool.allocate(16 * 16, QSize(16, 16), 16, QVideoFrame::Format_Y8);
+    QCOMPARE(pool.freeBufferCount(), 0);
+}
+
+void tst_QVideoFramePool::outlivePool()
+{
+    QVideoFrame frame;
+    {
+        QVideoFramePool pool;
+        frame = pool.allocate(16 * 16, QSize(16, 16), 16, QVideoFrame::Format_Y8);
+    }
+
+    QVERIFY(frame.isValid());
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadWrite));
+    memset(frame.bits(), 0xff, frame.mappedBytes());
+    frame.unmap();
+
+    frame = QVideoFrame();
+}
+
+void tst_QVideoFramePool::invalidSize()
+{
+    QVideoFramePool pool;
+
+    QVERIFY(!pool.allocate(0, QSize(16, 16), 16, QVideoFrame::Format_Y8).isValid());
+    QVERIFY(!pool.allocate(-1, QSize(16, 16), 16, QVideoFrame::Format_Y8).isValid());
+    QCOMPARE(pool.missCount(), 0);
+}
+
+QTEST_MAIN(tst_QVideoFramePool)
+
+#include "tst_qvideoframepool.moc"
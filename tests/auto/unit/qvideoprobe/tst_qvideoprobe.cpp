@@ -56,6 +56,15 @@ private slots:
     void testPlayerDeleteRecorder();
     void testPlayerDeleteProbe();
     void testRecorder();
+    void testQueuedDelivery();
+    void testDirectDelivery();
+    void testBufferedDelivery_data();
+    void testBufferedDelivery();
+    void testBlockOnOverflow();
+    void testBlockOnOverflowTimeout();
+    void testStopWhileBlocked();
+    void testSharedDelivery();
+    void testDroppedCountReset();
 
 private:
     QMediaPlayer *player;
@@ -171,6 +180,253 @@ void tst_QVideoProbe::testRecorder()
     QVERIFY(!probe.isActive());
 }
 
+static QVideoFrame createFrame(qint64 startTime)
+{
+    QVideoFrame frame(16, QSize(2, 2), 8, QVideoFrame::Format_ARGB32);
+    frame.setStartTime(startTime);
+    return frame;
+}
+
+static QList<qint64> startTimes(const QSignalSpy &spy)
+{
+    QList<qint64> times;
+    for (const QList<QVariant> &arguments : spy)
+        times.append(arguments.at(0).value<QVideoFrame>().startTime());
+    return times;
+}
+
+void tst_QVideoProbe::testQueuedDelivery()
+{
+    player = new QMediaPlayer;
+
+    QVideoProbe probe;
+    QCOMPARE(probe.deliveryMode(), QVideoProbe::QueuedDelivery);
+    QVERIFY(probe.setSource(player));
+    QVERIFY(probe.isDeliveryModeSupported());
+
+    QSignalSpy spy(&probe, SIGNAL(videoFrameProbed(QVideoFrame)));
+    MockVideoProbeControl *control = mockMediaPlayerService->mockVideoProbeControl;
+    control->probeFrame(createFrame(1));
+    control->probeFrame(createFrame(2));
+    control->probeFrame(createFrame(3));
+    QCOMPARE(spy.count(), 0);
+
+    // Only the most recent frame is delivered, the others are counted.
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(startTimes(spy), QList<qint64>() << 3);
+    QCOMPARE(probe.droppedFrameCount(), quint64(2));
+}
+
+void tst_QVideoProbe::testDirectDelivery()
+{
+    player = new QMediaPlayer;
+
+    QVideoProbe probe;
+    probe.setDeliveryMode(QVideoProbe::DirectDelivery);
+    QVERIFY(probe.setSource(player));
+    QCOMPARE(mockMediaPlayerService->mockVideoProbeControl->deliveryMode(),
+             QMediaProbeDelivery::DirectDelivery);
+
+    QSignalSpy spy(&probe, SIGNAL(videoFrameProbed(QVideoFrame)));
+    MockVideoProbeControl *control = mockMediaPlayerService->mockVideoProbeControl;
+    control->probeFrame(createFrame(1));
+    control->probeFrame(createFrame(2));
+
+    // Delivered synchronously, nothing dropped.
+    QCOMPARE(startTimes(spy), QList<qint64>() << 1 << 2);
+    QCOMPARE(probe.droppedFrameCount(), quint64(0));
+}
+
+void tst_QVideoProbe::testBufferedDelivery_data()
+{
+    QTest::addColumn<QVideoProbe::OverflowPolicy>("policy");
+    QTest::addColumn<QList<qint64> >("delivered");
+
+    QTest::newRow("drop oldest") << QVideoProbe::DropOldest << (QList<qint64>() << 3 << 4 << 5);
+    QTest::newRow("drop newest") << QVideoProbe::DropNewest << (QList<qint64>() << 1 << 2 << 3);
+}
+
+void tst_QVideoProbe::testBufferedDelivery()
+{
+    QFETCH(QVideoProbe::OverflowPolicy, policy);
+    QFETCH(QList<qint64>, delivered);
+
+    player = new QMediaPlayer;
+
+    QVideoProbe probe;
+    probe.setDeliveryMode(QVideoProbe::BufferedDelivery);
+    probe.setBufferSize(3);
+    probe.setOverflowPolicy(policy);
+    QVERIFY(probe.setSource(player));
+
+    QSignalSpy spy(&probe, SIGNAL(videoFrameProbed(QVideoFrame)));
+    MockVideoProbeControl *control = mockMediaPlayerService->mockVideoProbeControl;
+    for (int i = 1; i <= 5; ++i)
+        control->probeFrame(createFrame(i));
+
+    QTRY_COMPARE(spy.count(), 3);
+    QCOMPARE(startTimes(spy), delivered);
+    QCOMPARE(probe.droppedFrameCount(), quint64(2));
+}
+
+class ProbeThread : public QThread
+{
+public:
+    ProbeThread(MockVideoProbeControl *control, int count = 4)
+        : control(control), count(count) { }
+    void run() override
+    {
+        for (int i = 1; i <= count; ++i)
+            control->probeFrame(createFrame(i));
+    }
+    MockVideoProbeControl *control;
+    int count;
+};
+
+void tst_QVideoProbe::testBlockOnOverflow()
+{
+    player = new QMediaPlayer;
+
+    QVideoProbe probe;
+    probe.setDeliveryMode(QVideoProbe::BufferedDelivery);
+    probe.setBufferSize(2);
+    probe.setOverflowPolicy(QVideoProbe::BlockOnOverflow);
+    QVERIFY(probe.setSource(player));
+
+    QSignalSpy spy(&probe, SIGNAL(videoFrameProbed(QVideoFrame)));
+    ProbeThread thread(mockMediaPlayerService->mockVideoProbeControl);
+    thread.start();
+
+    // The streaming thread waits for the receivers instead of dropping frames.
+    QTRY_COMPARE(spy.count(), 4);
+    QVERIFY(thread.wait(5000));
+    QCOMPARE(startTimes(spy), QList<qint64>() << 1 << 2 << 3 << 4);
+    QCOMPARE(probe.droppedFrameCount(), quint64(0));
+}
+
+void tst_QVideoProbe::testBlockOnOverflowTimeout()
+{
+    player = new QMediaPlayer;
+
+    QVideoProbe probe;
+    probe.setDeliveryMode(QVideoProbe::BufferedDelivery);
+    probe.setBufferSize(1);
+    probe.setOverflowPolicy(QVideoProbe::BlockOnOverflow);
+    QVERIFY(probe.setSource(player));
+
+    // Nothing is delivered while this thread doesn't return to the event loop,
+    // the streaming thread gives up waiting and drops the second frame.
+    ProbeThread thread(mockMediaPlayerService->mockVideoProbeControl, 2);
+    thread.start();
+    QVERIFY(thread.wait(5000));
+    QCOMPARE(probe.droppedFrameCount(), quint64(1));
+
+    QSignalSpy spy(&probe, SIGNAL(videoFrameProbed(QVideoFrame)));
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(startTimes(spy), QList<qint64>() << 1);
+}
+
+void tst_QVideoProbe::testStopWhileBlocked()
+{
+    player = new QMediaPlayer;
+    mockMediaPlayerService->setIsValid(true);
+    mockMediaPlayerService->setMedia(QMediaContent(QUrl("file:///dummy.mp4")));
+
+    QVideoProbe probe;
+    probe.setDeliveryMode(QVideoProbe::BufferedDelivery);
+    probe.setBufferSize(1);
+    probe.setOverflowPolicy(QVideoProbe::BlockOnOverflow);
+    QVERIFY(probe.setSource(player));
+
+    player->play();
+    QCOMPARE(player->state(), QMediaPlayer::PlayingState);
+
+    MockVideoProbeControl *control = mockMediaPlayerService->mockVideoProbeControl;
+    ProbeThread thread(control, 100);
+    thread.start();
+    // Without returning to the event loop, the thread blocks on the second frame.
+    QTest::qSleep(100);
+    QVERIFY(thread.isRunning());
+
+    // Stopping releases the blocked streaming thread right away, the remaining
+    // frames are ignored instead of each waiting for the timeout.
+    player->stop();
+    QVERIFY(control->isFlushing());
+    QVERIFY(thread.wait(5000));
+
+    QSignalSpy spy(&probe, SIGNAL(videoFrameProbed(QVideoFrame)));
+    QTest::qWait(50);
+    QCOMPARE(spy.count(), 0);
+}
+
+void tst_QVideoProbe::testSharedDelivery()
+{
+    player = new QMediaPlayer;
+    MockVideoProbeControl *control = mockMediaPlayerService->mockVideoProbeControl;
+
+    QVideoProbe direct;
+    direct.setDeliveryMode(QVideoProbe::DirectDelivery);
+    QVERIFY(direct.setSource(player));
+    QCOMPARE(control->deliveryMode(), QMediaProbeDelivery::DirectDelivery);
+
+    {
+        // A queued probe must not get called on the streaming thread.
+        QVideoProbe queued;
+        QVERIFY(queued.setSource(player));
+        QCOMPARE(control->deliveryMode(), QMediaProbeDelivery::QueuedDelivery);
+        QCOMPARE(direct.deliveryMode(), QVideoProbe::DirectDelivery);
+
+        QVideoProbe buffered;
+        buffered.setDeliveryMode(QVideoProbe::BufferedDelivery);
+        buffered.setBufferSize(4);
+        buffered.setOverflowPolicy(QVideoProbe::BlockOnOverflow);
+        QVERIFY(buffered.setSource(player));
+        QCOMPARE(control->deliveryMode(), QMediaProbeDelivery::BufferedDelivery);
+        QCOMPARE(control->bufferSize(), 4);
+        QCOMPARE(control->overflowPolicy(), QMediaProbeDelivery::BlockOnOverflow);
+
+        // Blocking is only used when all buffering probes agree.
+        QVideoProbe dropping;
+        dropping.setDeliveryMode(QVideoProbe::BufferedDelivery);
+        dropping.setBufferSize(2);
+        dropping.setOverflowPolicy(QVideoProbe::DropNewest);
+        QVERIFY(dropping.setSource(player));
+        QCOMPARE(control->bufferSize(), 4);
+        QCOMPARE(control->overflowPolicy(), QMediaProbeDelivery::DropNewest);
+
+        // Settings are independent of the order the probes were changed in.
+        buffered.setBufferSize(4);
+        QCOMPARE(control->overflowPolicy(), QMediaProbeDelivery::DropNewest);
+    }
+
+    // The remaining probe gets its own settings back.
+    QCOMPARE(control->deliveryMode(), QMediaProbeDelivery::DirectDelivery);
+}
+
+void tst_QVideoProbe::testDroppedCountReset()
+{
+    player = new QMediaPlayer;
+    MockVideoProbeControl *control = mockMediaPlayerService->mockVideoProbeControl;
+
+    QVideoProbe first;
+    QVERIFY(first.setSource(player));
+    control->probeFrame(createFrame(1));
+    control->probeFrame(createFrame(2));
+    QCOMPARE(first.droppedFrameCount(), quint64(1));
+
+    // Only drops after attaching are reported.
+    QVideoProbe second;
+    QVERIFY(second.setSource(player));
+    QCOMPARE(second.droppedFrameCount(), quint64(0));
+    control->probeFrame(createFrame(3));
+    QCOMPARE(first.droppedFrameCount(), quint64(2));
+    QCOMPARE(second.droppedFrameCount(), quint64(1));
+
+    player->setMedia(QUrl("file:///other.mp4"));
+    QCOMPARE(first.droppedFrameCount(), quint64(0));
+    QCOMPARE(second.droppedFrameCount(), quint64(0));
+}
+
 QTEST_GUILESS_MAIN(tst_QVideoProbe)
 
 #include "tst_qvideoprobe.moc"
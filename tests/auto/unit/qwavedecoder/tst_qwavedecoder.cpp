@@ -65,6 +65,11 @@ private slots:
 
     void readAllAtOnce();
     void readPerByte();
+    void seek();
+    void dataOffset();
+    void trailingChunk();
+    void rf64();
+    void floatExtensible();
 };
 
 Q_DECLARE_METATYPE(tst_QWaveDecoder::Corruption)
@@ -120,11 +125,11 @@ void tst_QWaveDecoder::file_data()
     // The next file has extra data in the wave header.
     QTest::newRow("File isawav_1_16_44100_le_2.wav") << testFilePath("isawav_1_16_44100_le_2.wav")  << tst_QWaveDecoder::None << 1 << 16 << 44100 << QAudioFormat::LittleEndian;
 
-    // 32 bit waves are not supported
-    QTest::newRow("File isawav_1_32_8000_le.wav") << testFilePath("isawav_1_32_8000_le.wav")  << tst_QWaveDecoder::FormatDescriptor << 1 << 32 << 8000 << QAudioFormat::LittleEndian;
-    QTest::newRow("File isawav_1_32_44100_le.wav") << testFilePath("isawav_1_32_44100_le.wav")  << tst_QWaveDecoder::FormatDescriptor << 1 << 32 << 44100 << QAudioFormat::LittleEndian;
-    QTest::newRow("File isawav_2_32_8000_be.wav") << testFilePath("isawav_2_32_8000_be.wav")  << tst_QWaveDecoder::FormatDescriptor << 2 << 32 << 8000 << QAudioFormat::BigEndian;
-    QTest::newRow("File isawav_2_32_44100_be.wav") << testFilePath("isawav_2_32_44100_be.wav")  << tst_QWaveDecoder::FormatDescriptor << 2 << 32 << 44100 << QAudioFormat::BigEndian;
+    // 32 bit waves use WAVE_FORMAT_EXTENSIBLE
+    QTest::newRow("File isawav_1_32_8000_le.wav") << testFilePath("isawav_1_32_8000_le.wav")  << tst_QWaveDecoder::None << 1 << 32 << 8000 << QAudioFormat::LittleEndian;
+    QTest::newRow("File isawav_1_32_44100_le.wav") << testFilePath("isawav_1_32_44100_le.wav")  << tst_QWaveDecoder::None << 1 << 32 << 44100 << QAudioFormat::LittleEndian;
+    QTest::newRow("File isawav_2_32_8000_be.wav") << testFilePath("isawav_2_32_8000_be.wav")  << tst_QWaveDecoder::None << 2 << 32 << 8000 << QAudioFormat::BigEndian;
+    QTest::newRow("File isawav_2_32_44100_be.wav") << testFilePath("isawav_2_32_44100_be.wav")  << tst_QWaveDecoder::None << 2 << 32 << 44100 << QAudioFormat::BigEndian;
 }
 
 void tst_QWaveDecoder::file()
@@ -299,6 +304,173 @@ void tst_QWaveDecoder::readPerByte()
     stream.close();
 }
 
+static QByteArray chunk(const char *id, const QByteArray &data)
+{
+    QByteArray chunk(id, 4);
+    char size[4];
+    qToLittleEndian<quint32>(data.size(), size);
+    chunk.append(size, 4);
+    chunk.append(data);
+    return chunk;
+}
+
+static QByteArray formatChunk(quint16 formatTag, int channels, int sampleRate, int sampleSize,
+                              quint16 subFormat = 0)
+{
+    QByteArray data(formatTag == 0xfffe ? 40 : 16, 0);
+    char *fmt = data.data();
+    qToLittleEndian<quint16>(formatTag, fmt);
+    qToLittleEndian<quint16>(channels, fmt + 2);
+    qToLittleEndian<quint32>(sampleRate, fmt + 4);
+    qToLittleEndian<quint32>(sampleRate * channels * sampleSize / 8, fmt + 8);
+    qToLittleEndian<quint16>(channels * sampleSize / 8, fmt + 12);
+    qToLittleEndian<quint16>(sampleSize, fmt + 14);
+    if (formatTag == 0xfffe) {
+        qToLittleEndian<quint16>(22, fmt + 16);
+        qToLittleEndian<quint16>(sampleSize, fmt + 18);
+        qToLittleEndian<quint16>(subFormat, fmt + 24);
+    }
+    return chunk("fmt ", data);
+}
+
+static QByteArray samples(int count)
+{
+    QByteArray data(count, 0);
+    for (int i = 0; i < count; ++i)
+        data[i] = char(i);
+    return data;
+}
+
+void tst_QWaveDecoder::seek()
+{
+    QFile stream;
+    stream.setFileName(testFilePath("isawav_1_16_8000_le.wav"));
+    stream.open(QIODevice::ReadOnly);
+
+    QVERIFY(stream.isOpen());
+
+    QWaveDecoder waveDecoder(&stream);
+    QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+
+    QTRY_COMPARE(validFormatSpy.count(), 1);
+    QVERIFY(!waveDecoder.isSequential());
+
+    const QByteArray all = waveDecoder.readAll();
+    QCOMPARE(all.size(), int(waveDecoder.size()));
+    QVERIFY(waveDecoder.atEnd());
+
+    QVERIFY(waveDecoder.seek(100));
+    QCOMPARE(waveDecoder.pos(), qint64(100));
+    QCOMPARE(waveDecoder.bytesAvailable(), waveDecoder.size() - 100);
+    QCOMPARE(waveDecoder.read(10), all.mid(100, 10));
+
+    QVERIFY(waveDecoder.reset());
+    QCOMPARE(waveDecoder.read(10), all.left(10));
+
+    QVERIFY(!waveDecoder.seek(-1));
+    QVERIFY(!waveDecoder.seek(waveDecoder.size() + 1));
+
+    stream.close();
+}
+
+void tst_QWaveDecoder::dataOffset()
+{
+    QFile stream;
+    stream.setFileName(testFilePath("isawav_1_16_44100_le_2.wav"));
+    stream.open(QIODevice::ReadOnly);
+
+    QVERIFY(stream.isOpen());
+
+    QWaveDecoder waveDecoder(&stream);
+    QCOMPARE(waveDecoder.dataOffset(), qint64(-1));
+
+    QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+    QTRY_COMPARE(validFormatSpy.count(), 1);
+
+    // RIFF header, an 18 byte fmt chunk and the data chunk header.
+    QCOMPARE(waveDecoder.dataOffset(), qint64(12 + 26 + 8));
+
+    const QByteArray decoded = waveDecoder.read(64);
+
+    QFile file(testFilePath("isawav_1_16_44100_le_2.wav"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(file.seek(waveDecoder.dataOffset()));
+    QCOMPARE(file.read(64), decoded);
+
+    stream.close();
+}
+
+void tst_QWaveDecoder::trailingChunk()
+{
+    const QByteArray data = samples(400);
+    QByteArray body = QByteArray("WAVE") + formatChunk(1, 1, 8000, 16)
+            + chunk("data", data) + chunk("LIST", QByteArray(32, 'x'));
+    QBuffer buffer;
+    buffer.setData(chunk("RIFF", body));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QWaveDecoder waveDecoder(&buffer);
+    QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+    QTRY_COMPARE(validFormatSpy.count(), 1);
+
+    QCOMPARE(waveDecoder.size(), qint64(400));
+    QCOMPARE(waveDecoder.readAll(), data);
+    QCOMPARE(waveDecoder.bytesAvailable(), qint64(0));
+}
+
+void tst_QWaveDecoder::rf64()
+{
+    const QByteArray data = samples(1600);
+
+    QByteArray ds64(28, 0);
+    qToLittleEndian<quint32>(data.size(), ds64.data() + 8);
+    qToLittleEndian<quint32>(data.size() / 4, ds64.data() + 16);
+
+    QByteArray file("RF64\xff\xff\xff\xffWAVE", 12);
+    file += chunk("ds64", ds64);
+    file += formatChunk(0xfffe, 2, 8000, 16, 1);
+    file += QByteArray("data\xff\xff\xff\xff", 8) + data;
+
+    QBuffer buffer;
+    buffer.setData(file);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QWaveDecoder waveDecoder(&buffer);
+    QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+    QSignalSpy parsingErrorSpy(&waveDecoder, SIGNAL(parsingError()));
+    QTRY_COMPARE(validFormatSpy.count(), 1);
+    QCOMPARE(parsingErrorSpy.count(), 0);
+
+    QAudioFormat format = waveDecoder.audioFormat();
+    QCOMPARE(format.channelCount(), 2);
+    QCOMPARE(format.sampleRate(), 8000);
+    QCOMPARE(format.sampleSize(), 16);
+    QCOMPARE(format.sampleType(), QAudioFormat::SignedInt);
+    QCOMPARE(format.byteOrder(), QAudioFormat::LittleEndian);
+
+    QCOMPARE(waveDecoder.size(), qint64(data.size()));
+    QCOMPARE(waveDecoder.duration(), 50);
+    QCOMPARE(waveDecoder.dataOffset(), qint64(file.size() - data.size()));
+    QCOMPARE(waveDecoder.readAll(), data);
+}
+
+void tst_QWaveDecoder::floatExtensible()
+{
+    const QByteArray data = samples(320);
+    QByteArray body = QByteArray("WAVE") + formatChunk(0xfffe, 1, 16000, 32, 3) + chunk("data", data);
+    QBuffer buffer;
+    buffer.setData(chunk("RIFF", body));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QWaveDecoder waveDecoder(&buffer);
+    QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+    QTRY_COMPARE(validFormatSpy.count(), 1);
+
+    QCOMPARE(waveDecoder.audioFormat().sampleType(), QAudioFormat::Float);
+    QCOMPARE(waveDecoder.audioFormat().sampleSize(), 32);
+    QCOMPARE(waveDecoder.duration(), 5);
+}
+
 QTEST_MAIN(tst_QWaveDecoder)
 
 #include "tst_qwavedecoder.moc"
@@ -0,0 +1,13 @@
+TEMPLATE = subdirs
+SUBDIRS += \
+    qaudiobuffer \
+    qaudioformatconverter \
+    qaudiohelpers \
+    qmediatimerange \
+    qplaylistfileparser \
+    qsamplecache \
+    qvideoframe \
+    qwavedecoder
+
+qtHaveModule(multimediagsttools): \
+    SUBDIRS += qgstvideobuffer
@@ -0,0 +1,5 @@
+TARGET = tst_bench_qaudiobuffer
+
+QT += core multimedia testlib
+
+SOURCES += tst_bench_qaudiobuffer.cpp
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+
+#include <qaudiobuffer.h>
+
+Q_DECLARE_METATYPE(QAudioBuffer::SampleLayout)
+
+class tst_QAudioBuffer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void convertTo_data();
+    void convertTo();
+};
+
+void tst_QAudioBuffer::convertTo_data()
+{
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<QAudioFormat::SampleType>("sampleType");
+    QTest::addColumn<bool>("toInt16");
+    QTest::addColumn<QAudioBuffer::SampleLayout>("layout");
+
+    QTest::newRow("Int16 to float") << 16 << QAudioFormat::SignedInt << false << QAudioBuffer::Interleaved;
+    QTest::newRow("Int16 to planar float") << 16 << QAudioFormat::SignedInt << false << QAudioBuffer::Planar;
+    QTest::newRow("Int16 to planar int16") << 16 << QAudioFormat::SignedInt << true << QAudioBuffer::Planar;
+    QTest::newRow("Float to planar float") << 32 << QAudioFormat::Float << false << QAudioBuffer::Planar;
+    QTest::newRow("Float to int16") << 32 << QAudioFormat::Float << true << QAudioBuffer::Interleaved;
+    QTest::newRow("Int32 to planar int16") << 32 << QAudioFormat::SignedInt << true << QAudioBuffer::Planar;
+}
+
+void tst_QAudioBuffer::convertTo()
+{
+    QFETCH(int, sampleSize);
+    QFETCH(QAudioFormat::SampleType, sampleType);
+    QFETCH(bool, toInt16);
+    QFETCH(QAudioBuffer::SampleLayout, layout);
+
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(2);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    // A typical probe buffer, 20ms.
+    QByteArray samples(format.bytesForDuration(20000), '\0');
+    for (int i = 0; i < samples.size(); ++i)
+        samples[i] = char(i * 7);
+    const QAudioBuffer buffer(samples, format);
+
+    QVector<float> floats(buffer.sampleCount());
+    QVector<qint16> ints(buffer.sampleCount());
+
+    QBENCHMARK {
+        if (toInt16)
+            buffer.convertTo(ints.data(), layout);
+        else
+            buffer.convertTo(floats.data(), layout);
+    }
+}
+
+QTEST_MAIN(tst_QAudioBuffer)
+
+#include "tst_bench_qaudiobuffer.moc"
@@ -0,0 +1,5 @@
+TARGET = tst_bench_qaudioformatconverter
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_bench_qaudioformatconverter.cpp
@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+
+#include <qaudioformat.h>
+#include <private/qaudioformatconverter_p.h>
+
+Q_DECLARE_METATYPE(QAudioFormatConverter::Quality)
+
+static QAudioFormat pcmFormat(int sampleRate, int channelCount, int sampleSize,
+                              QAudioFormat::SampleType sampleType)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channelCount);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+    return format;
+}
+
+class tst_QAudioFormatConverter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void convert_data();
+    void convert();
+};
+
+void tst_QAudioFormatConverter::convert_data()
+{
+    QTest::addColumn<QAudioFormat>("inputFormat");
+    QTest::addColumn<QAudioFormat>("outputFormat");
+    QTest::addColumn<QAudioFormatConverter::Quality>("quality");
+
+    const QAudioFormat s16 = pcmFormat(48000, 2, 16, QAudioFormat::SignedInt);
+    const QAudioFormat f32 = pcmFormat(48000, 2, 32, QAudioFormat::Float);
+
+    QTest::newRow("Int16 to Float") << s16 << f32 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("Float to Int16") << f32 << s16 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("Int24 to Int16")
+            << pcmFormat(48000, 2, 24, QAudioFormat::SignedInt) << s16 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("5.1 to stereo")
+            << pcmFormat(48000, 6, 16, QAudioFormat::SignedInt) << s16 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("mono to stereo")
+            << pcmFormat(48000, 1, 16, QAudioFormat::SignedInt) << s16 << QAudioFormatConverter::MediumQuality;
+
+    const QAudioFormat cd = pcmFormat(44100, 2, 16, QAudioFormat::SignedInt);
+    QTest::newRow("44100 to 48000, fast") << cd << s16 << QAudioFormatConverter::FastQuality;
+    QTest::newRow("44100 to 48000, medium") << cd << s16 << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("44100 to 48000, high") << cd << s16 << QAudioFormatConverter::HighQuality;
+    QTest::newRow("48000 to 44100, medium") << s16 << cd << QAudioFormatConverter::MediumQuality;
+    QTest::newRow("48000 to 16000 mono, medium")
+            << s16 << pcmFormat(16000, 1, 16, QAudioFormat::SignedInt) << QAudioFormatConverter::MediumQuality;
+}
+
+void tst_QAudioFormatConverter::convert()
+{
+    QFETCH(QAudioFormat, inputFormat);
+    QFETCH(QAudioFormat, outputFormat);
+    QFETCH(QAudioFormatConverter::Quality, quality);
+
+    QAudioFormatConverter converter(inputFormat, outputFormat, quality);
+    QVERIFY(converter.isValid());
+
+    // One second of audio, converted a period of 20ms at a time like a backend would.
+    const int length = inputFormat.bytesForDuration(1000000);
+    const int period = inputFormat.bytesForDuration(20000);
+    QByteArray source(length, '\0');
+    for (int i = 0; i < length; ++i)
+        source[i] = char(i * 7);
+    QByteArray destination(converter.outputBytesFor(period) * 2, '\0');
+
+    QBENCHMARK {
+        for (int offset = 0; offset + period <= length; offset += period)
+            converter.convert(source.constData() + offset, period, destination.data());
+    }
+}
+
+QTEST_MAIN(tst_QAudioFormatConverter)
+
+#include "tst_bench_qaudioformatconverter.moc"
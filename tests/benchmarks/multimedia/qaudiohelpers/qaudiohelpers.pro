@@ -0,0 +1,5 @@
+TARGET = tst_bench_qaudiohelpers
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_bench_qaudiohelpers.cpp
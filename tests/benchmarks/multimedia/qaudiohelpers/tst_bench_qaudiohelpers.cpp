@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qaudioformat.h>
+#include <private/qaudiohelpers_p.h>
+
+class tst_QAudioHelpers : public QObject
+{
+    Q_OBJECT
+private slots:
+    void multiplySamples_data();
+    void multiplySamples();
+};
+
+void tst_QAudioHelpers::multiplySamples_data()
+{
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<QAudioFormat::SampleType>("sampleType");
+    QTest::addColumn<qreal>("factor");
+
+    QTest::newRow("UInt8") << 8 << QAudioFormat::UnSignedInt << qreal(0.5);
+    QTest::newRow("Int16") << 16 << QAudioFormat::SignedInt << qreal(0.5);
+    QTest::newRow("Int16 unity") << 16 << QAudioFormat::SignedInt << qreal(1.0);
+    QTest::newRow("Int32") << 32 << QAudioFormat::SignedInt << qreal(0.5);
+    QTest::newRow("Float") << 32 << QAudioFormat::Float << qreal(0.5);
+}
+
+void tst_QAudioHelpers::multiplySamples()
+{
+    QFETCH(int, sampleSize);
+    QFETCH(QAudioFormat::SampleType, sampleType);
+    QFETCH(qreal, factor);
+
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(2);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    // One second of audio, with some non zero content.
+    const int length = format.bytesForDuration(1000000);
+    QByteArray source(length, '\0');
+    for (int i = 0; i < length; ++i)
+        source[i] = char(i * 7);
+    QByteArray destination(length, '\0');
+
+    QBENCHMARK {
+        QAudioHelperInternal::qMultiplySamples(factor, format, source.constData(),
+                                               destination.data(), length);
+    }
+}
+
+QTEST_MAIN(tst_QAudioHelpers)
+
+#include "tst_bench_qaudiohelpers.moc"
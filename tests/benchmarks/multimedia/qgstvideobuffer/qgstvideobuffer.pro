@@ -0,0 +1,7 @@
+TARGET = tst_bench_qgstvideobuffer
+
+QT += core multimedia-private multimediagsttools-private testlib
+
+QMAKE_USE += gstreamer
+
+SOURCES += tst_bench_qgstvideobuffer.cpp
@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qgstvideobuffer_p.h>
+#include <private/qvideoframe_p.h>
+#include <qvideoframe.h>
+
+#include <gst/gst.h>
+
+class tst_QGstVideoBuffer : public QObject
+{
+    Q_OBJECT
+public:
+    enum Consumer {
+        None,
+        MapFrame,
+        ConvertToImage
+    };
+    Q_ENUM(Consumer)
+
+private slots:
+    void initTestCase();
+
+    void pipeline_data();
+    void pipeline();
+};
+
+#if GST_CHECK_VERSION(1,0,0)
+
+namespace {
+
+struct HandoffContext
+{
+    tst_QGstVideoBuffer::Consumer consumer;
+    GstVideoInfo info;
+    bool haveInfo;
+    int frames;
+};
+
+// Does what a video sink does with each buffer: wrap it in a QVideoFrame
+// and map it, or convert it to a QImage like the video probes of some
+// applications.
+void handoff(GstElement *, GstBuffer *buffer, GstPad *pad, gpointer userData)
+{
+    HandoffContext *context = static_cast<HandoffContext *>(userData);
+
+    if (!context->haveInfo) {
+        GstCaps *caps = gst_pad_get_current_caps(pad);
+        context->haveInfo = caps && gst_video_info_from_caps(&context->info, caps);
+        if (caps)
+            gst_caps_unref(caps);
+        if (!context->haveInfo)
+            return;
+    }
+
+    QVideoFrame frame(new QGstVideoBuffer(buffer, context->info),
+                      QSize(context->info.width, context->info.height),
+                      QVideoFrame::Format_YUV420P);
+
+    if (context->consumer == tst_QGstVideoBuffer::MapFrame) {
+        if (frame.map(QAbstractVideoBuffer::ReadOnly)) {
+            frame.unmap();
+            ++context->frames;
+        }
+    } else if (!qt_imageFromVideoFrame(frame).isNull()) {
+        ++context->frames;
+    }
+}
+
+}
+
+#endif
+
+void tst_QGstVideoBuffer::initTestCase()
+{
+#if !GST_CHECK_VERSION(1,0,0)
+    QSKIP("The benchmark requires GStreamer 1.0");
+#endif
+    gst_init(NULL, NULL);
+}
+
+void tst_QGstVideoBuffer::pipeline_data()
+{
+    QTest::addColumn<Consumer>("consumer");
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("baseline 1920x1080") << None << QSize(1920, 1080);
+    QTest::newRow("map 1920x1080") << MapFrame << QSize(1920, 1080);
+    QTest::newRow("baseline 320x240") << None << QSize(320, 240);
+    QTest::newRow("image 320x240") << ConvertToImage << QSize(320, 240);
+}
+
+void tst_QGstVideoBuffer::pipeline()
+{
+#if GST_CHECK_VERSION(1,0,0)
+    QFETCH(Consumer, consumer);
+    QFETCH(QSize, size);
+
+    const int frameCount = 100;
+
+    // Runs headless, as fast as the elements allow.
+    const QByteArray description = QStringLiteral(
+                "videotestsrc num-buffers=%1 pattern=black "
+                "! video/x-raw,format=I420,width=%2,height=%3 "
+                "! fakesink name=sink sync=false")
+            .arg(frameCount).arg(size.width()).arg(size.height()).toLatin1();
+
+    QBENCHMARK {
+        GError *error = 0;
+        GstElement *pipeline = gst_parse_launch(description.constData(), &error);
+        if (error) {
+            const QString message = QString::fromUtf8(error->message);
+            g_error_free(error);
+            QSKIP(qPrintable(message));
+        }
+        QVERIFY(pipeline);
+
+        HandoffContext context = { consumer, GstVideoInfo(), false, 0 };
+        if (consumer != None) {
+            GstElement *sink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
+            g_object_set(G_OBJECT(sink), "signal-handoffs", TRUE, NULL);
+            g_signal_connect(sink, "handoff", G_CALLBACK(handoff), &context);
+            gst_object_unref(GST_OBJECT(sink));
+        }
+
+        gst_element_set_state(pipeline, GST_STATE_PLAYING);
+
+        GstBus *bus = gst_element_get_bus(pipeline);
+        GstMessage *message = gst_bus_timed_pop_filtered(
+                    bus, GST_CLOCK_TIME_NONE, GstMessageType(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+        const bool eos = message && GST_MESSAGE_TYPE(message) == GST_MESSAGE_EOS;
+        if (message)
+            gst_message_unref(message);
+        gst_object_unref(GST_OBJECT(bus));
+
+        gst_element_set_state(pipeline, GST_STATE_NULL);
+        gst_object_unref(GST_OBJECT(pipeline));
+
+        QVERIFY(eos);
+        if (consumer != None)
+            QCOMPARE(context.frames, frameCount);
+    }
+#endif
+}
+
+QTEST_MAIN(tst_QGstVideoBuffer)
+
+#include "tst_bench_qgstvideobuffer.moc"
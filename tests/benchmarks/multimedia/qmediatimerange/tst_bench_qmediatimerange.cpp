@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qmediatimerange.h>
+
+class tst_QMediaTimeRange : public QObject
+{
+    Q_OBJECT
+private slots:
+    void addInterval_data();
+    void addInterval();
+    void addFragments_data();
+    void addFragments();
+    void removeInterval_data();
+    void removeInterval();
+    void contains_data();
+    void contains();
+    void addTimeRange_data();
+    void addTimeRange();
+    void intervals_data();
+    void intervals();
+
+private:
+    void addCountColumn();
+};
+
+// A range of count one second fragments with one second gaps between them,
+// like the buffered parts of a long recording.
+static QMediaTimeRange fragmentedRange(int count, qint64 offset = 0)
+{
+    QMediaTimeRange range;
+    for (int i = 0; i < count; ++i)
+        range.addInterval(offset + i * 2000, offset + i * 2000 + 999);
+    return range;
+}
+
+void tst_QMediaTimeRange::addCountColumn()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void tst_QMediaTimeRange::addInterval_data()
+{
+    addCountColumn();
+}
+
+void tst_QMediaTimeRange::addInterval()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange base = fragmentedRange(count);
+    const qint64 middle = count * 1000;
+
+    // Insert a new interval into a gap in the middle.
+    QBENCHMARK {
+        QMediaTimeRange range = base;
+        range.addInterval(middle + 1200, middle + 1800);
+    }
+}
+
+void tst_QMediaTimeRange::addFragments_data()
+{
+    addCountColumn();
+}
+
+void tst_QMediaTimeRange::addFragments()
+{
+    QFETCH(int, count);
+
+    // Buffered fragments arriving in order, each extending the last interval.
+    QBENCHMARK {
+        QMediaTimeRange range = fragmentedRange(count);
+        for (int i = 0; i < count; ++i)
+            range.addInterval(count * 2000 + i * 100, count * 2000 + i * 100 + 99);
+    }
+}
+
+void tst_QMediaTimeRange::removeInterval_data()
+{
+    addCountColumn();
+}
+
+void tst_QMediaTimeRange::removeInterval()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange base = fragmentedRange(count);
+    const qint64 middle = count * 1000;
+
+    // Split an interval in the middle.
+    QBENCHMARK {
+        QMediaTimeRange range = base;
+        range.removeInterval(middle + 100, middle + 200);
+    }
+}
+
+void tst_QMediaTimeRange::contains_data()
+{
+    addCountColumn();
+}
+
+void tst_QMediaTimeRange::contains()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange range = fragmentedRange(count);
+    const qint64 end = count * 2000;
+
+    // Query the range once per frame of 40 ms over the whole duration.
+    QBENCHMARK {
+        int found = 0;
+        for (qint64 time = 0; time < end; time += 40)
+            found += range.contains(time);
+        QVERIFY(found > 0);
+    }
+}
+
+void tst_QMediaTimeRange::addTimeRange_data()
+{
+    addCountColumn();
+}
+
+void tst_QMediaTimeRange::addTimeRange()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange a = fragmentedRange(count);
+    const QMediaTimeRange b = fragmentedRange(count, 1000);
+
+    // Filling the gaps of one range with the other.
+    QBENCHMARK {
+        QMediaTimeRange range = a;
+        range += b;
+        QVERIFY(range.isContinuous());
+    }
+}
+
+void tst_QMediaTimeRange::intervals_data()
+{
+    addCountColumn();
+}
+
+void tst_QMediaTimeRange::intervals()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange range = fragmentedRange(count);
+
+    QBENCHMARK {
+        const QList<QMediaTimeInterval> intervals = range.intervals();
+        Q_UNUSED(intervals);
+    }
+}
+
+QTEST_MAIN(tst_QMediaTimeRange)
+
+#include "tst_bench_qmediatimerange.moc"
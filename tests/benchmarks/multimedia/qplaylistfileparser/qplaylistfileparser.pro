@@ -0,0 +1,5 @@
+TARGET = tst_bench_qplaylistfileparser
+
+QT += core network multimedia-private testlib
+
+SOURCES += tst_bench_qplaylistfileparser.cpp
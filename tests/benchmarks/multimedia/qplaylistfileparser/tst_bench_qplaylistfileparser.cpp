@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+
+#include <qmediacontent.h>
+#include <private/qplaylistfileparser_p.h>
+
+class tst_QPlaylistFileParser : public QObject
+{
+    Q_OBJECT
+private slots:
+    void parse_data();
+    void parse();
+};
+
+void tst_QPlaylistFileParser::parse_data()
+{
+    QTest::addColumn<QString>("mimeType");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<int>("count");
+
+    const int count = 10000;
+
+    QByteArray m3u("#EXTM3U\n");
+    for (int i = 0; i < count; ++i) {
+        m3u += "#EXTINF:180,Artist - Title " + QByteArray::number(i) + '\n';
+        m3u += "file:///music/album/track" + QByteArray::number(i) + ".mp3\n";
+    }
+
+    QByteArray pls("[playlist]\n");
+    for (int i = 1; i <= count; ++i) {
+        const QByteArray n = QByteArray::number(i);
+        pls += "File" + n + "=http://example.com/stream" + n + ".mp3\n";
+        pls += "Title" + n + "=Title " + n + '\n';
+        pls += "Length" + n + "=-1\n";
+    }
+    pls += "NumberOfEntries=" + QByteArray::number(count) + "\nVersion=2\n";
+
+    QTest::newRow("m3u") << QStringLiteral("audio/x-mpegurl") << m3u << count;
+    QTest::newRow("pls") << QStringLiteral("audio/x-scpls") << pls << count;
+}
+
+void tst_QPlaylistFileParser::parse()
+{
+    QFETCH(QString, mimeType);
+    QFETCH(QByteArray, data);
+    QFETCH(int, count);
+
+    const QMediaContent media(QMediaResource(QUrl(), mimeType));
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        QPlaylistFileParser parser;
+        QSignalSpy newItemSpy(&parser, SIGNAL(newItem(QVariant)));
+        QSignalSpy finishedSpy(&parser, SIGNAL(finished()));
+
+        // A stream which is already complete is parsed synchronously.
+        parser.start(media, &buffer);
+
+        QCOMPARE(finishedSpy.count(), 1);
+        QCOMPARE(newItemSpy.count(), count);
+    }
+}
+
+QTEST_MAIN(tst_QPlaylistFileParser)
+
+#include "tst_bench_qplaylistfileparser.moc"
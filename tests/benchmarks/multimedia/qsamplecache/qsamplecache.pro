@@ -0,0 +1,7 @@
+TARGET = tst_bench_qsamplecache
+
+QT += core network multimedia-private testlib
+
+include(../shared/wavefile.pri)
+
+SOURCES += tst_bench_qsamplecache.cpp
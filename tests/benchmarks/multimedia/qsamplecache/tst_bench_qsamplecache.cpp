@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qtemporaryfile.h>
+
+#include <private/qsamplecache_p.h>
+
+#include "wavefile.h"
+
+class tst_QSampleCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void loadSample_data();
+    void loadSample();
+};
+
+void tst_QSampleCache::loadSample_data()
+{
+    QTest::addColumn<int>("milliseconds");
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("100 ms") << 100 << false;
+    QTest::newRow("10 s") << 10000 << false;
+    QTest::newRow("10 s cached") << 10000 << true;
+}
+
+void tst_QSampleCache::loadSample()
+{
+    QFETCH(int, milliseconds);
+    QFETCH(bool, cached);
+
+    QTemporaryFile file(QDir::tempPath() + QLatin1String("/tst_bench_qsamplecache_XXXXXX.wav"));
+    QVERIFY(file.open());
+    file.write(createWave(48 * milliseconds * 4));
+    file.close();
+
+    const QUrl url = QUrl::fromLocalFile(file.fileName());
+
+    QSampleCache cache;
+    // Without capacity, released samples are unloaded and every request loads the file again.
+    cache.setCapacity(cached ? 64 * 1024 * 1024 : 0);
+
+    QBENCHMARK {
+        QSample *sample = cache.requestSample(url);
+        QSignalSpy readySpy(sample, SIGNAL(ready()));
+        // The sample is loaded in the cache's loading thread, which sets the state before
+        // emitting ready(), so the spy catches the signal of any sample still loading here.
+        if (sample->state() != QSample::Ready && sample->state() != QSample::Error)
+            QVERIFY(readySpy.wait());
+        QCOMPARE(sample->state(), QSample::Ready);
+        sample->release();
+    }
+}
+
+QTEST_MAIN(tst_QSampleCache)
+
+#include "tst_bench_qsamplecache.moc"
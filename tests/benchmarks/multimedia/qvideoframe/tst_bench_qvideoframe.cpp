@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qvideoframe.h>
+#include <qvideoframepool.h>
+#include <private/qvideoframe_p.h>
+
+class tst_QVideoFrame : public QObject
+{
+    Q_OBJECT
+private slots:
+    void create_data();
+    void create();
+    void createPooled_data();
+    void createPooled();
+    void copy();
+    void mapUnmap_data();
+    void mapUnmap();
+    void mapReadOnlyNested();
+    void metaData();
+    void imageFromVideoFrame_data();
+    void imageFromVideoFrame();
+};
+
+void tst_QVideoFrame::create_data()
+{
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("null") << QSize();
+    QTest::newRow("176x144") << QSize(176, 144);
+    QTest::newRow("1920x1080") << QSize(1920, 1080);
+}
+
+void tst_QVideoFrame::create()
+{
+    QFETCH(QSize, size);
+
+    if (size.isEmpty()) {
+        QBENCHMARK {
+            QVideoFrame frame;
+            Q_UNUSED(frame);
+        }
+    } else {
+        const int bytesPerLine = size.width() * 4;
+        QBENCHMARK {
+            QVideoFrame frame(bytesPerLine * size.height(), size, bytesPerLine,
+                              QVideoFrame::Format_RGB32);
+            Q_UNUSED(frame);
+        }
+    }
+}
+
+void tst_QVideoFrame::createPooled_data()
+{
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("176x144") << QSize(176, 144);
+    QTest::newRow("1920x1080") << QSize(1920, 1080);
+}
+
+void tst_QVideoFrame::createPooled()
+{
+    QFETCH(QSize, size);
+
+    QVideoFramePool pool;
+    const int bytesPerLine = size.width() * 4;
+
+    QBENCHMARK {
+        QVideoFrame frame = pool.allocate(bytesPerLine * size.height(), size, bytesPerLine,
+                                          QVideoFrame::Format_RGB32);
+        Q_UNUSED(frame);
+    }
+}
+
+void tst_QVideoFrame::copy()
+{
+    QVideoFrame frame(1920 * 1080 * 4, QSize(1920, 1080), 1920 * 4, QVideoFrame::Format_RGB32);
+
+    QBENCHMARK {
+        QVideoFrame copy(frame);
+        copy.setStartTime(0);
+    }
+}
+
+void tst_QVideoFrame::mapUnmap_data()
+{
+    QTest::addColumn<QAbstractVideoBuffer::MapMode>("mode");
+
+    QTest::newRow("ReadOnly") << QAbstractVideoBuffer::ReadOnly;
+    QTest::newRow("WriteOnly") << QAbstractVideoBuffer::WriteOnly;
+    QTest::newRow("ReadWrite") << QAbstractVideoBuffer::ReadWrite;
+}
+
+void tst_QVideoFrame::mapUnmap()
+{
+    QFETCH(QAbstractVideoBuffer::MapMode, mode);
+
+    QVideoFrame frame(1920 * 1080 * 3 / 2, QSize(1920, 1080), 1920, QVideoFrame::Format_YUV420P);
+
+    QBENCHMARK {
+        frame.map(mode);
+        frame.unmap();
+    }
+    QVERIFY(!frame.isMapped());
+}
+
+void tst_QVideoFrame::mapReadOnlyNested()
+{
+    QVideoFrame frame(1920 * 1080 * 3 / 2, QSize(1920, 1080), 1920, QVideoFrame::Format_YUV420P);
+    QVERIFY(frame.map(QAbstractVideoBuffer::ReadOnly));
+
+    // Additional read only mappings, as done by probes and filters sharing a frame.
+    QBENCHMARK {
+        frame.map(QAbstractVideoBuffer::ReadOnly);
+        frame.unmap();
+    }
+
+    frame.unmap();
+    QVERIFY(!frame.isMapped());
+}
+
+void tst_QVideoFrame::metaData()
+{
+    QVideoFrame frame(1920 * 1080 * 4, QSize(1920, 1080), 1920 * 4, QVideoFrame::Format_RGB32);
+
+    QBENCHMARK {
+        QVideoFrame copy(frame);
+        copy.availableMetaData();
+        copy.metaData(QStringLiteral("key"));
+    }
+}
+
+void tst_QVideoFrame::imageFromVideoFrame_data()
+{
+    QTest::addColumn<QVideoFrame::PixelFormat>("pixelFormat");
+    QTest::addColumn<int>("bytesPerLine");
+    QTest::addColumn<int>("bytes");
+
+    const int width = 1920;
+    const int height = 1080;
+
+    QTest::newRow("RGB32") << QVideoFrame::Format_RGB32 << width * 4 << width * height * 4;
+    QTest::newRow("YUV420P") << QVideoFrame::Format_YUV420P << width << width * height * 3 / 2;
+    QTest::newRow("NV12") << QVideoFrame::Format_NV12 << width << width * height * 3 / 2;
+    QTest::newRow("UYVY") << QVideoFrame::Format_UYVY << width * 2 << width * height * 2;
+}
+
+void tst_QVideoFrame::imageFromVideoFrame()
+{
+    QFETCH(QVideoFrame::PixelFormat, pixelFormat);
+    QFETCH(int, bytesPerLine);
+    QFETCH(int, bytes);
+
+    QVideoFrame frame(bytes, QSize(1920, 1080), bytesPerLine, pixelFormat);
+
+    QBENCHMARK {
+        const QImage image = qt_imageFromVideoFrame(frame);
+        Q_UNUSED(image);
+    }
+    QVERIFY(!qt_imageFromVideoFrame(frame).isNull());
+}
+
+QTEST_MAIN(tst_QVideoFrame)
+
+#include "tst_bench_qvideoframe.moc"
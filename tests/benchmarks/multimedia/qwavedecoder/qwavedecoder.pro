@@ -0,0 +1,7 @@
+TARGET = tst_bench_qwavedecoder
+
+QT += core multimedia-private testlib
+
+include(../shared/wavefile.pri)
+
+SOURCES += tst_bench_qwavedecoder.cpp
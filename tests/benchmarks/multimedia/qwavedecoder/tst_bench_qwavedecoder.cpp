@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+
+#include <private/qwavedecoder_p.h>
+
+#include "wavefile.h"
+
+class tst_QWaveDecoder : public QObject
+{
+    Q_OBJECT
+private slots:
+    void parseHeader_data();
+    void parseHeader();
+    void readData();
+};
+
+void tst_QWaveDecoder::parseHeader_data()
+{
+    QTest::addColumn<bool>("extensible");
+
+    QTest::newRow("PCM") << false;
+    QTest::newRow("Extensible float") << true;
+}
+
+void tst_QWaveDecoder::parseHeader()
+{
+    QFETCH(bool, extensible);
+
+    const QByteArray wave = createWave(4096, extensible);
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.setData(wave);
+        buffer.open(QIODevice::ReadOnly);
+
+        QWaveDecoder decoder(&buffer);
+        QSignalSpy formatKnownSpy(&decoder, SIGNAL(formatKnown()));
+
+        // The header is parsed from a zero timer.
+        QVERIFY(formatKnownSpy.wait());
+    }
+}
+
+void tst_QWaveDecoder::readData()
+{
+    // Ten seconds of audio, read in chunks of the usual audio output period size.
+    const QByteArray wave = createWave(48000 * 4 * 10, false);
+    QByteArray chunk(4096, '\0');
+
+    QBuffer buffer;
+    buffer.setData(wave);
+    buffer.open(QIODevice::ReadOnly);
+
+    QWaveDecoder decoder(&buffer);
+    QSignalSpy formatKnownSpy(&decoder, SIGNAL(formatKnown()));
+    QTRY_COMPARE(formatKnownSpy.count(), 1);
+
+    QBENCHMARK {
+        decoder.seek(0);
+        qint64 total = 0;
+        qint64 read;
+        while ((read = decoder.read(chunk.data(), chunk.size())) > 0)
+            total += read;
+        QCOMPARE(total, qint64(48000 * 4 * 10));
+    }
+}
+
+QTEST_MAIN(tst_QWaveDecoder)
+
+#include "tst_bench_qwavedecoder.moc"
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef WAVEFILE_H
+#define WAVEFILE_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qendian.h>
+
+inline void appendLE16(QByteArray *data, quint16 value)
+{
+    char bytes[2];
+    qToLittleEndian(value, bytes);
+    data->append(bytes, 2);
+}
+
+inline void appendLE32(QByteArray *data, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, bytes);
+    data->append(bytes, 4);
+}
+
+// A 48 kHz stereo file of silence, 16 bit PCM or 32 bit float in a
+// WAVE_FORMAT_EXTENSIBLE header.
+inline QByteArray createWave(int dataSize, bool extensible = false)
+{
+    const quint16 bitsPerSample = extensible ? 32 : 16;
+    const quint16 blockAlign = 2 * bitsPerSample / 8;
+
+    QByteArray format;
+    appendLE16(&format, extensible ? 0xfffe : 1);
+    appendLE16(&format, 2);
+    appendLE32(&format, 48000);
+    appendLE32(&format, 48000 * blockAlign);
+    appendLE16(&format, blockAlign);
+    appendLE16(&format, bitsPerSample);
+    if (extensible) {
+        static const char floatSubFormat[] = {
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+            char(0x80), 0x00, 0x00, char(0xaa), 0x00, 0x38, char(0x9b), 0x71
+        };
+        appendLE16(&format, 22);
+        appendLE16(&format, bitsPerSample);
+        appendLE32(&format, 0x3);
+        format.append(floatSubFormat, sizeof(floatSubFormat));
+    }
+
+    QByteArray wave("RIFF");
+    appendLE32(&wave, 4 + 8 + format.size() + 8 + dataSize);
+    wave.append("WAVE");
+    wave.append("fmt ");
+    appendLE32(&wave, format.size());
+    wave.append(format);
+    wave.append("data");
+    appendLE32(&wave, dataSize);
+    wave.append(QByteArray(dataSize, '\0'));
+
+    return wave;
+}
+
+#endif // WAVEFILE_H
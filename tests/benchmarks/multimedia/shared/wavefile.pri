@@ -0,0 +1,5 @@
+# WAVE file generation shared by the audio benchmarks
+INCLUDEPATH += $$PWD
+
+HEADERS *= \
+    $$PWD/wavefile.h